@@ -1244,6 +1244,11 @@ dma_rw(struct bio_desc *biod)
 	if (!biod->bd_async_post) {
 		iod_dma_wait(biod);
 		D_DEBUG(DB_IO, "Wait DMA done, type:%d\n", biod->bd_type);
+	} else if (biod->bd_type == BIO_IOD_TYPE_FETCH && biod->bd_inflights == 0) {
+		/* Nothing issued for async fetch, complete it right here */
+		iod_dma_completion(biod, biod->bd_result);
+		iod_release_buffer(biod);
+		dma_drop_iod(iod_dma_buf(biod));
 	}
 }
 
@@ -1472,8 +1477,12 @@ iod_prep_internal(struct bio_desc *biod, unsigned int type, void *bulk_ctxt,
 	biod->bd_result = 0;
 
 	/* Load data from media to buffer on read */
-	if (biod->bd_type == BIO_IOD_TYPE_FETCH)
+	if (biod->bd_type == BIO_IOD_TYPE_FETCH) {
 		dma_rw(biod);
+		/* Async fetch result is delivered to the completion callback */
+		if (biod->bd_async_post)
+			return 0;
+	}
 
 	if (biod->bd_result) {
 		rc = biod->bd_result;
@@ -463,7 +463,12 @@ struct bio_desc {
 	struct bio_bulk_hdl    **bd_bulk_hdls;
 	unsigned int		 bd_bulk_max;
 	unsigned int		 bd_bulk_cnt;
-	/* Customized completion callback for bio_iod_post() */
+	/*
+	 * Customized completion callback for bio_iod_post(), or for bio_iod_prep() of
+	 * async fetch (FETCH type with 'bd_async_post' set), the callback is responsible
+	 * for copying out the data and setting 'bd_dma_done', the DMA buffer is released
+	 * once it returns.
+	 */
 	void			 (*bd_completion)(void *cb_arg, int err);
 	void			*bd_comp_arg;
 	/* SG lists involved in this io descriptor */
@@ -541,11 +546,14 @@ extern struct bio_faulty_criteria	glb_criteria;
 extern bool		bio_scm_rdma;
 extern bool		bio_spdk_inited;
 extern bool                             bio_vmd_enabled;
+extern bool		bio_wal_replay_ra;
 extern unsigned int	bio_chk_sz;
 extern unsigned int	bio_chk_cnt_max;
 extern unsigned int	bio_numa_node;
 extern unsigned int	bio_spdk_max_unmap_cnt;
 extern unsigned int	bio_max_async_sz;
+extern unsigned int	bio_wal_group_us;
+extern unsigned int	bio_wal_group_sz;
 
 int xs_poll_completion(struct bio_xs_context *ctxt, unsigned int *inflights,
 		       uint64_t timeout);
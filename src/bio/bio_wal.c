@@ -664,13 +664,38 @@ off2lba(struct wal_super_info *si, unsigned int blk_off)
 	return (uint64_t)(blk_off + WAL_HDR_BLKS) * si->si_header.wh_blk_bytes;
 }
 
+/*
+ * Group commit: consecutive transactions are packed into contiguous WAL blocks and
+ * submitted by a single WAL write. The first committer of a group (leader) keeps the
+ * group open for at most 'bio_wal_group_us' microseconds or 'bio_wal_group_sz' bytes,
+ * the transactions committed in between (followers) join the group and wait for the
+ * completion of their own transaction.
+ */
+struct wal_group {
+	d_list_t		 wg_txs;		/* Member transactions, in ID order */
+	struct bio_desc		*wg_biod;		/* IOD for the group WAL I/O */
+	uint64_t		 wg_start_id;		/* ID of the first transaction */
+	uint64_t		 wg_open_ts;		/* Group open time in us */
+	uint64_t		 wg_delay;		/* Queuing delay of the group in us */
+	uint32_t		 wg_blks;		/* Total blocks used by the group */
+	uint32_t		 wg_tx_cnt;		/* Number of member transactions */
+	uint32_t		 wg_ref;		/* Members haven't finished */
+	int			 wg_rc;			/* Group WAL I/O submit result */
+};
+
 struct wal_tx_desc {
 	d_list_t		 td_link;
+	d_list_t		 td_grp_link;		/* Link to wal_group::wg_txs */
 	struct wal_super_info	*td_si;
-	struct bio_desc		*td_biod_tx;		/* IOD for WAL I/O */
+	struct wal_group	*td_group;
+	struct umem_wal_tx	*td_tx;
+	struct data_csum_array	*td_dc_arr;
+	struct wal_blks_desc	 td_blk_desc;
+	ABT_eventual		 td_done;		/* Set on tx completion */
 	struct bio_desc		*td_biod_data;		/* IOD for async data I/O */
 	uint64_t		 td_id;
 	uint32_t		 td_blks;		/* Blocks used by this tx */
+	uint32_t		 td_grp_off;		/* Block offset within the group */
 	int			 td_error;
 	unsigned int		 td_wal_complete:1;	/* Indicating WAL I/O completed */
 };
@@ -719,17 +744,15 @@ tx_completed(struct wal_tx_desc *wal_tx)
 static void
 wal_tx_completion(struct wal_tx_desc *wal_tx, bool complete_next)
 {
-	struct bio_desc		*biod_tx = wal_tx->td_biod_tx;
 	struct wal_super_info	*si = wal_tx->td_si;
 	struct wal_tx_desc	*next;
 	bool			 try_wakeup = false;
 
 	D_ASSERT(!d_list_empty(&wal_tx->td_link));
-	D_ASSERT(biod_tx != NULL);
+	D_ASSERT(wal_tx->td_done != ABT_EVENTUAL_NULL);
 	D_ASSERT(si != NULL);
 
 	next = wal_tx_next(wal_tx);
-	biod_tx->bd_result = wal_tx->td_error;
 
 	if (wal_tx->td_error) {
 		/* Rollback unused ID */
@@ -758,9 +781,7 @@ wal_tx_completion(struct wal_tx_desc *wal_tx, bool complete_next)
 	D_ASSERT(si->si_pending_tx > 0);
 	si->si_pending_tx--;
 
-	/* The ABT_eventual could be NULL if WAL I/O IOD failed on DMA mapping in bio_iod_prep() */
-	if (biod_tx->bd_dma_done != ABT_EVENTUAL_NULL)
-		ABT_eventual_set(biod_tx->bd_dma_done, NULL, 0);
+	ABT_eventual_set(wal_tx->td_done, NULL, 0);
 
 	/*
 	 * To ensure the UNDO (for failed transactions) is performed before starting new
@@ -782,18 +803,24 @@ wal_tx_completion(struct wal_tx_desc *wal_tx, bool complete_next)
 	}
 }
 
-/* Transaction WAL I/O completion */
+/* Group WAL I/O completion */
 static void
 wal_completion(void *arg, int err)
 {
-	struct wal_tx_desc	*wal_tx = arg;
+	struct wal_group	*grp = arg;
+	struct wal_tx_desc	*wal_tx;
 
-	wal_tx->td_wal_complete = 1;
-	if (err)
-		wal_tx->td_error = err;
+	d_list_for_each_entry(wal_tx, &grp->wg_txs, td_grp_link) {
+		wal_tx->td_wal_complete = 1;
+		if (err)
+			wal_tx->td_error = err;
+	}
 
-	if (tx_completed(wal_tx))
-		wal_tx_completion(wal_tx, true);
+	/* Member could have been completed along with its prior transaction */
+	d_list_for_each_entry(wal_tx, &grp->wg_txs, td_grp_link) {
+		if (!d_list_empty(&wal_tx->td_link) && tx_completed(wal_tx))
+			wal_tx_completion(wal_tx, true);
+	}
 }
 
 /* Transaction associated data I/O (to data blob) completion */
@@ -883,24 +910,34 @@ generate_data_csum(struct bio_meta_context *mc, struct bio_desc *biod_data,
 	return rc;
 }
 
+/*
+ * A follower can get here while the leader is still in wal_group_wait() and the group IOD
+ * isn't allocated yet, it waits on its completion eventual. Self polling never groups, so
+ * the caller is always the leader and the group IOD has been submitted.
+ */
 static void
-wait_tx_committed(struct wal_tx_desc *wal_tx)
+wait_tx_committed(struct bio_meta_context *mc, struct wal_tx_desc *wal_tx)
 {
-	struct bio_desc		*biod_tx = wal_tx->td_biod_tx;
-	struct bio_desc		*biod_data = wal_tx->td_biod_data;
-	struct bio_xs_context	*xs_ctxt = biod_tx->bd_ctxt->bic_xs_ctxt;
+	struct bio_xs_context	*xs_ctxt = mc->mc_wal->bic_xs_ctxt;
+	struct bio_desc		*biod_tx;
 	int			 rc;
 
-	D_ASSERT(biod_tx->bd_dma_done != ABT_EVENTUAL_NULL);
+	D_ASSERT(wal_tx->td_done != ABT_EVENTUAL_NULL);
 	D_ASSERT(xs_ctxt != NULL);
 
+	/* Completed on group WAL I/O submit failure */
+	if (d_list_empty(&wal_tx->td_link))
+		return;
+
 	if (xs_ctxt->bxc_self_polling) {
+		biod_tx = wal_tx->td_group->wg_biod;
+		D_ASSERT(biod_tx != NULL);
 		D_DEBUG(DB_IO, "Self poll completion\n");
 		rc = xs_poll_completion(xs_ctxt, &biod_tx->bd_inflights, 0);
 		if (rc)
 			D_ERROR("Self pool completion failed. "DF_RC"\n", DP_RC(rc));
-	} else if (biod_tx->bd_inflights != 0 || biod_data != NULL) {
-		rc = ABT_eventual_wait(biod_tx->bd_dma_done, NULL);
+	} else {
+		rc = ABT_eventual_wait(wal_tx->td_done, NULL);
 		if (rc != ABT_SUCCESS)
 			D_ERROR("ABT_eventual_wait failed. %d\n", rc);
 	}
@@ -908,22 +945,238 @@ wait_tx_committed(struct wal_tx_desc *wal_tx)
 	D_ASSERT(d_list_empty(&wal_tx->td_link));
 }
 
+static inline bool
+wal_group_enabled(struct bio_meta_context *mc)
+{
+	return bio_wal_group_us != 0 && !mc->mc_wal->bic_xs_ctxt->bxc_self_polling;
+}
+
+static inline uint32_t
+wal_group_max_blks(struct wal_super_info *si)
+{
+	uint32_t	max_blks = bio_wal_group_sz / si->si_header.wh_blk_bytes;
+
+	return min(max(max_blks, 1), WAL_MAX_TRANS_BLKS);
+}
+
+/* Join the open group or open a new one, return true if the caller is the group leader */
+static int
+wal_group_join(struct bio_meta_context *mc, struct wal_tx_desc *wal_tx, bool *leader)
+{
+	struct wal_super_info	*si = &mc->mc_wal_info;
+	struct wal_group	*grp = si->si_open_group;
+
+	*leader = false;
+	if (grp != NULL && grp->wg_blks + wal_tx->td_blks > wal_group_max_blks(si)) {
+		/* Group is full, close it and the leader will stop waiting */
+		si->si_open_group = NULL;
+		grp = NULL;
+	}
+
+	if (grp == NULL) {
+		D_ALLOC_PTR(grp);
+		if (grp == NULL)
+			return -DER_NOMEM;
+
+		D_INIT_LIST_HEAD(&grp->wg_txs);
+		grp->wg_start_id = wal_tx->td_id;
+		grp->wg_open_ts = daos_getutime();
+		if (wal_group_enabled(mc))
+			si->si_open_group = grp;
+		*leader = true;
+	}
+
+	D_ASSERT(wal_next_id(si, grp->wg_start_id, grp->wg_blks) == wal_tx->td_id ||
+		 grp->wg_blks == 0);
+	wal_tx->td_group = grp;
+	wal_tx->td_grp_off = grp->wg_blks;
+	d_list_add_tail(&wal_tx->td_grp_link, &grp->wg_txs);
+	grp->wg_blks += wal_tx->td_blks;
+	grp->wg_tx_cnt++;
+	grp->wg_ref++;
+
+	return 0;
+}
+
+static void
+wal_group_leave(struct wal_tx_desc *wal_tx)
+{
+	struct wal_group	*grp = wal_tx->td_group;
+
+	D_ASSERT(grp != NULL && grp->wg_ref > 0);
+	d_list_del_init(&wal_tx->td_grp_link);
+	wal_tx->td_group = NULL;
+
+	grp->wg_ref--;
+	if (grp->wg_ref > 0)
+		return;
+
+	D_ASSERT(d_list_empty(&grp->wg_txs));
+	if (grp->wg_biod != NULL)
+		bio_iod_free(grp->wg_biod);
+	D_FREE(grp);
+}
+
+/* Leader waits for more transactions joining the group */
+static void
+wal_group_wait(struct wal_super_info *si, struct wal_group *grp)
+{
+	while (si->si_open_group == grp) {
+		if ((daos_getutime() - grp->wg_open_ts) >= bio_wal_group_us)
+			break;
+		bio_yield(NULL);
+	}
+
+	if (si->si_open_group == grp)
+		si->si_open_group = NULL;
+	grp->wg_delay = daos_getutime() - grp->wg_open_ts;
+}
+
+/* Get the DMA buffer regions of a member transaction from the group SGL */
+static void
+wal_group_tx_sgl(struct wal_super_info *si, struct bio_sglist *grp_sgl,
+		 struct wal_tx_desc *wal_tx, struct bio_sglist *bsgl, struct bio_iov *iovs)
+{
+	struct bio_iov	*biov = &grp_sgl->bs_iovs[0];
+	unsigned int	 blk_bytes = si->si_header.wh_blk_bytes;
+	uint64_t	 start = (uint64_t)wal_tx->td_grp_off * blk_bytes;
+	uint64_t	 len = (uint64_t)wal_tx->td_blks * blk_bytes;
+
+	if (start >= bio_iov2len(biov)) {
+		D_ASSERT(grp_sgl->bs_nr_out == 2);
+		start -= bio_iov2len(biov);
+		biov = &grp_sgl->bs_iovs[1];
+	}
+	D_ASSERT(start < bio_iov2len(biov));
+
+	iovs[0] = *biov;
+	iovs[0].bi_buf = biov->bi_buf + start;
+	iovs[0].bi_data_len = min(len, bio_iov2len(biov) - start);
+	bsgl->bs_iovs = iovs;
+	bsgl->bs_nr = 2;
+	bsgl->bs_nr_out = 1;
+
+	/* The transaction wraps */
+	if (bio_iov2len(&iovs[0]) < len) {
+		D_ASSERT(biov == &grp_sgl->bs_iovs[0] && grp_sgl->bs_nr_out == 2);
+		iovs[1] = grp_sgl->bs_iovs[1];
+		iovs[1].bi_data_len = len - bio_iov2len(&iovs[0]);
+		D_ASSERT(bio_iov2len(&iovs[1]) <= bio_iov2len(&grp_sgl->bs_iovs[1]));
+		bsgl->bs_nr_out = 2;
+	}
+}
+
+/* Submit the group WAL I/O, called by group leader */
+static int
+wal_group_submit(struct bio_meta_context *mc, struct wal_group *grp)
+{
+	struct wal_super_info	*si = &mc->mc_wal_info;
+	struct wal_tx_desc	*wal_tx;
+	struct bio_desc		*biod, *biod_data;
+	struct bio_sglist	*bsgl, tx_sgl;
+	struct bio_iov		 tx_iovs[2];
+	bio_addr_t		 addr = { 0 };
+	unsigned int		 blks, start_off;
+	unsigned int		 tot_blks = si->si_header.wh_tot_blks;
+	unsigned int		 blk_bytes = si->si_header.wh_blk_bytes;
+	int			 iov_nr, rc;
+
+	if (si->si_open_group == grp)
+		wal_group_wait(si, grp);
+
+	D_DEBUG(DB_IO, "MC:%p WAL group commit ID:"DF_U64" txs:%u blks:%u delay:"DF_U64"us\n",
+		mc, grp->wg_start_id, grp->wg_tx_cnt, grp->wg_blks, grp->wg_delay);
+
+	biod = bio_iod_alloc(mc->mc_wal, NULL, 1, BIO_IOD_TYPE_UPDATE);
+	if (biod == NULL) {
+		rc = -DER_NOMEM;
+		goto failed;
+	}
+	grp->wg_biod = biod;
+
+	/* Figure out the regions in WAL for this group */
+	start_off = id2off(grp->wg_start_id);
+	D_ASSERT(start_off < tot_blks);
+	if ((start_off + grp->wg_blks) <= tot_blks) {
+		iov_nr = 1;
+		blks = grp->wg_blks;
+	} else {
+		iov_nr = 2;
+		blks = (tot_blks - start_off);
+	}
+
+	bsgl = bio_iod_sgl(biod, 0);
+	rc = bio_sgl_init(bsgl, iov_nr);
+	if (rc)
+		goto failed;
+
+	bio_addr_set(&addr, DAOS_MEDIA_NVME, off2lba(si, start_off));
+	bio_iov_set(&bsgl->bs_iovs[0], addr, (uint64_t)blks * blk_bytes);
+	if (iov_nr == 2) {
+		bio_addr_set(&addr, DAOS_MEDIA_NVME, off2lba(si, 0));
+		blks = grp->wg_blks - blks;
+		bio_iov_set(&bsgl->bs_iovs[1], addr, (uint64_t)blks * blk_bytes);
+	}
+	bsgl->bs_nr_out = iov_nr;
+
+	/*
+	 * Map the WAL regions to DMA buffer, bio_iod_prep() can guarantee FIFO order
+	 * when it has to yield and wait for DMA buffer.
+	 */
+	rc = bio_iod_prep(biod, BIO_CHK_TYPE_LOCAL, NULL, 0);
+	if (rc) {
+		D_ERROR("WAL IOD prepare failed. "DF_RC"\n", DP_RC(rc));
+		goto failed;
+	}
+
+	d_list_for_each_entry(wal_tx, &grp->wg_txs, td_grp_link) {
+		/* Fill DMA buffer with transaction entries */
+		wal_group_tx_sgl(si, bsgl, wal_tx, &tx_sgl, &tx_iovs[0]);
+		fill_trans_blks(mc, &tx_sgl, wal_tx->td_tx, wal_tx->td_dc_arr, blk_bytes,
+				&wal_tx->td_blk_desc);
+
+		/* Set proper completion callbacks for data I/O */
+		biod_data = wal_tx->td_biod_data;
+		wal_tx->td_biod_data = NULL;
+		if (biod_data != NULL) {
+			if (biod_data->bd_inflights == 0) {
+				wal_tx->td_error = biod_data->bd_result;
+			} else {
+				biod_data->bd_completion = data_completion;
+				biod_data->bd_comp_arg = wal_tx;
+				wal_tx->td_biod_data = biod_data;
+			}
+		}
+	}
+	biod->bd_completion = wal_completion;
+	biod->bd_comp_arg = grp;
+
+	rc = bio_iod_post_async(biod, 0);
+	if (rc)
+		D_ERROR("WAL commit failed. "DF_RC"\n", DP_RC(rc));
+	grp->wg_rc = rc;
+	return rc;
+
+failed:
+	grp->wg_rc = rc;
+	/* Data I/O completion hasn't been attached yet */
+	d_list_for_each_entry(wal_tx, &grp->wg_txs, td_grp_link)
+		wal_tx->td_biod_data = NULL;
+	wal_completion(grp, rc);
+	return rc;
+}
+
 int
 bio_wal_commit(struct bio_meta_context *mc, struct umem_wal_tx *tx, struct bio_desc *biod_data,
 	       struct bio_wal_stats *stats)
 {
 	struct wal_super_info	*si = &mc->mc_wal_info;
-	struct bio_desc		*biod = NULL;
-	struct bio_sglist	*bsgl;
-	bio_addr_t		 addr = { 0 };
 	struct wal_tx_desc	 wal_tx = { 0 };
-	struct wal_blks_desc	 blk_desc = { 0 };
 	struct data_csum_array	 dc_arr;
-	unsigned int		 blks, unused_off;
-	unsigned int		 tot_blks = si->si_header.wh_tot_blks;
 	unsigned int		 blk_bytes = si->si_header.wh_blk_bytes;
 	uint64_t		 tx_id = tx->utx_id;
-	int			 iov_nr, rc;
+	bool			 leader;
+	int			 rc;
 
 	/* Bypass WAL commit, used for performance evaluation only */
 	if (daos_io_bypass & IOBP_WAL_COMMIT) {
@@ -943,102 +1196,62 @@ bio_wal_commit(struct bio_meta_context *mc, struct umem_wal_tx *tx, struct bio_d
 
 	/* Calculate the required log blocks for this transaction */
 	calc_trans_blks(umem_tx_act_nr(tx) + dc_arr.dca_nr, umem_tx_act_payload_sz(tx),
-			blk_bytes, &blk_desc);
+			blk_bytes, &wal_tx.td_blk_desc);
 
-	D_ASSERT(blk_desc.bd_blks > 0);
-	if (blk_desc.bd_blks > WAL_MAX_TRANS_BLKS) {
-		D_ERROR("Too large transaction (%u blocks)\n", blk_desc.bd_blks);
+	D_ASSERT(wal_tx.td_blk_desc.bd_blks > 0);
+	if (wal_tx.td_blk_desc.bd_blks > WAL_MAX_TRANS_BLKS) {
+		D_ERROR("Too large transaction (%u blocks)\n", wal_tx.td_blk_desc.bd_blks);
 		rc = -DER_INVAL;
 		goto out;
 	}
 
-	biod = bio_iod_alloc(mc->mc_wal, NULL, 1, BIO_IOD_TYPE_UPDATE);
-	if (biod == NULL) {
-		rc = -DER_NOMEM;
+	rc = ABT_eventual_create(0, &wal_tx.td_done);
+	if (rc != ABT_SUCCESS) {
+		rc = dss_abterr2der(rc);
 		goto out;
 	}
 
-	/* Figure out the regions in WAL for this transaction */
 	D_ASSERT(wal_id_cmp(si, tx_id, si->si_unused_id) == 0);
-	unused_off = id2off(si->si_unused_id);
-	D_ASSERT(unused_off < tot_blks);
-	if ((unused_off + blk_desc.bd_blks) <= tot_blks) {
-		iov_nr = 1;
-		blks = blk_desc.bd_blks;
-	} else {
-		iov_nr = 2;
-		blks = (tot_blks - unused_off);
-	}
+	wal_tx.td_id = si->si_unused_id;
+	wal_tx.td_si = si;
+	wal_tx.td_tx = tx;
+	wal_tx.td_dc_arr = &dc_arr;
+	wal_tx.td_biod_data = biod_data;
+	wal_tx.td_blks = wal_tx.td_blk_desc.bd_blks;
 
-	bsgl = bio_iod_sgl(biod, 0);
-	rc = bio_sgl_init(bsgl, iov_nr);
+	rc = wal_group_join(mc, &wal_tx, &leader);
 	if (rc)
 		goto out;
 
-	bio_addr_set(&addr, DAOS_MEDIA_NVME, off2lba(si, unused_off));
-	bio_iov_set(&bsgl->bs_iovs[0], addr, (uint64_t)blks * blk_bytes);
-	if (iov_nr == 2) {
-		bio_addr_set(&addr, DAOS_MEDIA_NVME, off2lba(si, 0));
-		blks = blk_desc.bd_blks - blks;
-		bio_iov_set(&bsgl->bs_iovs[1], addr, (uint64_t)blks * blk_bytes);
-	}
-	bsgl->bs_nr_out = iov_nr;
-
-	wal_tx.td_id = si->si_unused_id;
-	wal_tx.td_si = si;
-	wal_tx.td_biod_tx = biod;
-	wal_tx.td_biod_data = NULL;
-	wal_tx.td_blks = blk_desc.bd_blks;
-	/* Track in pending list from now on, since it could yield in bio_iod_prep() */
+	/* Track in pending list from now on, since it could yield before WAL I/O submitted */
 	d_list_add_tail(&wal_tx.td_link, &si->si_pending_list);
 	si->si_pending_tx++;
 
 	if (stats) {
-		stats->ws_size = (blk_desc.bd_blks - 1) * blk_bytes + blk_desc.bd_tail_off;
+		stats->ws_size = (wal_tx.td_blk_desc.bd_blks - 1) * blk_bytes +
+				 wal_tx.td_blk_desc.bd_tail_off;
 		stats->ws_qd = si->si_pending_tx;
 	}
 
 	/* Update next unused ID */
-	si->si_unused_id = wal_next_id(si, si->si_unused_id, blk_desc.bd_blks);
+	si->si_unused_id = wal_next_id(si, si->si_unused_id, wal_tx.td_blk_desc.bd_blks);
 
-	/*
-	 * Map the WAL regions to DMA buffer, bio_iod_prep() can guarantee FIFO order
-	 * when it has to yield and wait for DMA buffer.
-	 */
-	rc = bio_iod_prep(biod, BIO_CHK_TYPE_LOCAL, NULL, 0);
-	if (rc) {
-		D_ERROR("WAL IOD prepare failed. "DF_RC"\n", DP_RC(rc));
-		wal_completion(&wal_tx, rc);
-		D_ASSERT(d_list_empty(&wal_tx.td_link));
-		goto out;
-	}
+	if (leader)
+		wal_group_submit(mc, wal_tx.td_group);
 
-	/* Fill DMA buffer with transaction entries */
-	fill_trans_blks(mc, bsgl, tx, &dc_arr, blk_bytes, &blk_desc);
+	/* Wait for WAL commit completion */
+	wait_tx_committed(mc, &wal_tx);
 
-	/* Set proper completion callbacks for data I/O & WAL I/O */
-	if (biod_data != NULL) {
-		if (biod_data->bd_inflights == 0) {
-			wal_tx.td_error = biod_data->bd_result;
-		} else {
-			biod_data->bd_completion = data_completion;
-			biod_data->bd_comp_arg = &wal_tx;
-			wal_tx.td_biod_data = biod_data;
-		}
+	rc = wal_tx.td_group->wg_rc;
+	if (stats && leader) {
+		stats->ws_batch = wal_tx.td_group->wg_tx_cnt;
+		stats->ws_batch_delay = wal_tx.td_group->wg_delay;
 	}
-	biod->bd_completion = wal_completion;
-	biod->bd_comp_arg = &wal_tx;
-
-	rc = bio_iod_post_async(biod, 0);
-	if (rc)
-		D_ERROR("WAL commit failed. "DF_RC"\n", DP_RC(rc));
-
-	/* Wait for WAL commit completion */
-	wait_tx_committed(&wal_tx);
+	wal_group_leave(&wal_tx);
 out:
+	if (wal_tx.td_done != ABT_EVENTUAL_NULL)
+		ABT_eventual_free(&wal_tx.td_done);
 	free_data_csum(&dc_arr);
-	if (biod != NULL)
-		bio_iod_free(biod);
 	return rc;
 }
 
@@ -1132,36 +1345,28 @@ bio_wal_flush_header(struct bio_meta_context *mc)
 	return write_header(mc, mc->mc_wal, hdr, sizeof(*hdr), &hdr->wh_csum);
 }
 
+/* Fill the BIO SGL for loading 'max_blks' WAL blocks starting from block offset 'off' */
 static int
-load_wal(struct bio_meta_context *mc, char *buf, unsigned int max_blks, uint64_t tx_id)
+wal_load_sgl(struct wal_super_info *si, struct bio_sglist *bsgl, unsigned int max_blks,
+	     unsigned int off)
 {
-	struct wal_super_info	*si = &mc->mc_wal_info;
 	unsigned int		 tot_blks = si->si_header.wh_tot_blks;
 	unsigned int		 blk_bytes = si->si_header.wh_blk_bytes;
-	struct bio_sglist	 bsgl;
 	struct bio_iov		*biov;
-	d_sg_list_t		 sgl;
-	d_iov_t			 iov;
-	unsigned int		 nr_blks, blks, off;
+	unsigned int		 nr_blks, blks;
 	bio_addr_t		 addr = { 0 };
 	int			 iov_nr, rc;
 
-	d_iov_set(&iov, buf, max_blks * blk_bytes);
-	sgl.sg_iovs = &iov;
-	sgl.sg_nr = 1;
-	sgl.sg_nr_out = 0;
-
 	/* Read in 1MB sized IOVs */
 	nr_blks = (1UL << 20) / blk_bytes;
 	D_ASSERT(nr_blks > 0);
 	iov_nr = (max_blks + nr_blks - 1) / nr_blks + 1;
-	rc = bio_sgl_init(&bsgl, iov_nr);
+	rc = bio_sgl_init(bsgl, iov_nr);
 	if (rc)
 		return rc;
 
-	off = id2off(tx_id);
 	while (max_blks > 0) {
-		biov = &bsgl.bs_iovs[bsgl.bs_nr_out];
+		biov = &bsgl->bs_iovs[bsgl->bs_nr_out];
 
 		bio_addr_set(&addr, DAOS_MEDIA_NVME, off2lba(si, off));
 		blks = min(max_blks, nr_blks);
@@ -1169,15 +1374,37 @@ load_wal(struct bio_meta_context *mc, char *buf, unsigned int max_blks, uint64_t
 			blks = tot_blks - off;
 		bio_iov_set(biov, addr, (uint64_t)blks * blk_bytes);
 
-		bsgl.bs_nr_out++;
+		bsgl->bs_nr_out++;
 		max_blks -= blks;
 		off += blks;
 		if (off == tot_blks)
 			off = 0;
-		D_ASSERT(bsgl.bs_nr_out <= iov_nr);
+		D_ASSERT(bsgl->bs_nr_out <= iov_nr);
 	}
 	/* Adjust the bs_nr for following bio_readv() */
-	bsgl.bs_nr = bsgl.bs_nr_out;
+	bsgl->bs_nr = bsgl->bs_nr_out;
+
+	return 0;
+}
+
+static int
+load_wal(struct bio_meta_context *mc, char *buf, unsigned int max_blks, uint64_t tx_id)
+{
+	struct wal_super_info	*si = &mc->mc_wal_info;
+	unsigned int		 blk_bytes = si->si_header.wh_blk_bytes;
+	struct bio_sglist	 bsgl = { 0 };
+	d_sg_list_t		 sgl;
+	d_iov_t			 iov;
+	int			 rc;
+
+	d_iov_set(&iov, buf, max_blks * blk_bytes);
+	sgl.sg_iovs = &iov;
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 0;
+
+	rc = wal_load_sgl(si, &bsgl, max_blks, id2off(tx_id));
+	if (rc)
+		return rc;
 
 	rc = bio_readv(mc->mc_wal, &bsgl, &sgl);
 	bio_sgl_fini(&bsgl);
@@ -1185,6 +1412,106 @@ load_wal(struct bio_meta_context *mc, char *buf, unsigned int max_blks, uint64_t
 	return rc;
 }
 
+/*
+ * WAL read-ahead for replay: the next WAL window is loaded asynchronously while the
+ * transactions in current window are being verified and replayed.
+ */
+struct wal_replay_ra {
+	struct bio_desc		*ra_biod;	/* In-flight read-ahead IOD */
+	char			*ra_buf;	/* Buffer for read-ahead data */
+	unsigned int		 ra_len;	/* Read-ahead length in bytes */
+	int			 ra_result;	/* Read-ahead result */
+	unsigned int		 ra_done:1;	/* Read-ahead completed */
+};
+
+static void
+ra_completion(void *arg, int err)
+{
+	struct wal_replay_ra	*ra = arg;
+	struct bio_desc		*biod = ra->ra_biod;
+	d_sg_list_t		 sgl;
+	d_iov_t			 iov;
+
+	D_ASSERT(biod != NULL);
+	ra->ra_result = biod->bd_result ? biod->bd_result : err;
+
+	/* Copy out the data, the DMA buffer will be released right after this completion */
+	if (ra->ra_result == 0) {
+		d_iov_set(&iov, ra->ra_buf, ra->ra_len);
+		sgl.sg_iovs = &iov;
+		sgl.sg_nr = 1;
+		sgl.sg_nr_out = 0;
+
+		ra->ra_result = bio_iod_copy(biod, &sgl, 1);
+	}
+	ra->ra_done = 1;
+
+	D_ASSERT(biod->bd_dma_done != ABT_EVENTUAL_NULL);
+	ABT_eventual_set(biod->bd_dma_done, NULL, 0);
+}
+
+/*
+ * Start loading 'max_blks' WAL blocks starting from block offset 'off'. The read-ahead
+ * is best effort, it's skipped when DMA buffer is under pressure.
+ */
+static void
+wal_ra_start(struct bio_meta_context *mc, struct wal_replay_ra *ra, unsigned int max_blks,
+	     unsigned int off)
+{
+	struct wal_super_info	*si = &mc->mc_wal_info;
+	struct bio_desc		*biod;
+	int			 rc;
+
+	D_ASSERT(ra->ra_biod == NULL);
+	ra->ra_done = 0;
+	ra->ra_result = 0;
+	ra->ra_len = max_blks * si->si_header.wh_blk_bytes;
+
+	biod = bio_iod_alloc(mc->mc_wal, NULL, 1, BIO_IOD_TYPE_FETCH);
+	if (biod == NULL)
+		return;
+
+	rc = wal_load_sgl(si, bio_iod_sgl(biod, 0), max_blks, off);
+	if (rc)
+		goto failed;
+
+	/*
+	 * Don't wait for DMA buffer or I/O completion, the DMA buffer is released in
+	 * completion callback once the data is copied out.
+	 */
+	biod->bd_async_post = 1;
+	biod->bd_non_blocking = 1;
+	biod->bd_completion = ra_completion;
+	biod->bd_comp_arg = ra;
+	ra->ra_biod = biod;
+
+	rc = bio_iod_prep(biod, BIO_CHK_TYPE_LOCAL, NULL, 0);
+	if (rc) {
+		D_DEBUG(DB_IO, "Skip WAL read-ahead. "DF_RC"\n", DP_RC(rc));
+		ra->ra_biod = NULL;
+		goto failed;
+	}
+	return;
+failed:
+	bio_iod_free(biod);
+}
+
+/* Wait for the in-flight read-ahead, return true if the read-ahead data is ready */
+static bool
+wal_ra_wait(struct wal_replay_ra *ra)
+{
+	if (ra->ra_biod != NULL) {
+		/* bio_iod_free() waits for the completion of async IOD */
+		bio_iod_free(ra->ra_biod);
+		ra->ra_biod = NULL;
+		D_ASSERT(ra->ra_done);
+		if (ra->ra_result)
+			D_ERROR("WAL read-ahead failed. "DF_RC"\n", DP_RC(ra->ra_result));
+	}
+
+	return ra->ra_done && ra->ra_result == 0;
+}
+
 /* Check if a tx_id is known to be committed */
 static bool
 tx_known_committed(struct wal_super_info *si, uint64_t tx_id)
@@ -1648,15 +1975,18 @@ bio_wal_replay(struct bio_meta_context *mc, struct bio_wal_rp_stats *wrs,
 	struct wal_super_info	*si = &mc->mc_wal_info;
 	struct wal_trans_head	*hdr;
 	unsigned int		 blk_bytes = si->si_header.wh_blk_bytes;
+	unsigned int		 tot_blks = si->si_header.wh_tot_blks;
 	struct wal_blks_desc	 blk_desc = { 0 };
+	struct wal_replay_ra	 ra = { 0 };
 	char			*buf, *dbuf = NULL;
 	struct umem_action	*act;
-	unsigned int		 max_blks = WAL_MAX_TRANS_BLKS, blk_off;
+	unsigned int		 max_blks = WAL_MAX_TRANS_BLKS, blk_off, left_blks;
 	unsigned int		 nr_replayed = 0, tight_loop, dbuf_len = 0;
 	uint64_t		 tx_id, start_id, unmap_start, unmap_end;
 	int			 rc;
 	uint64_t		 total_bytes = 0, rpl_entries = 0, total_tx = 0;
 	uint64_t                 s_us = 0;
+	bool			 read_ahead;
 
 	if (DAOS_FAIL_CHECK(DAOS_WAL_NO_REPLAY))
 		return 0;
@@ -1665,6 +1995,20 @@ bio_wal_replay(struct bio_meta_context *mc, struct bio_wal_rp_stats *wrs,
 	if (buf == NULL)
 		return -DER_NOMEM;
 
+	/*
+	 * Read-ahead relies on the NVMe poller to complete the I/O and release DMA buffer,
+	 * otherwise, the DMA buffer waiters from replay callback could never be waken up.
+	 */
+	read_ahead = bio_wal_replay_ra && !mc->mc_wal->bic_xs_ctxt->bxc_self_polling &&
+		     tot_blks > max_blks;
+	if (read_ahead) {
+		D_ALLOC(ra.ra_buf, max_blks * blk_bytes);
+		if (ra.ra_buf == NULL) {
+			rc = -DER_NOMEM;
+			goto out;
+		}
+	}
+
 	D_ALLOC(act, sizeof(*act) + UMEM_ACT_PAYLOAD_MAX_LEN);
 	if (act == NULL) {
 		rc = -DER_NOMEM;
@@ -1678,14 +2022,30 @@ bio_wal_replay(struct bio_meta_context *mc, struct bio_wal_rp_stats *wrs,
 	if (wrs != NULL)
 		s_us = daos_getutime();
 
+	blk_off = 0;
+	left_blks = max_blks;
 load_wal:
 	tight_loop = 0;
-	blk_off = 0;
-	rc = load_wal(mc, buf, max_blks, tx_id);
-	if (rc) {
-		D_ERROR("Failed to load WAL. "DF_RC"\n", DP_RC(rc));
-		goto out;
+	/*
+	 * The read-ahead window starts right after current window. When the last tx in
+	 * current window is incomplete, move it to the buffer head and append read-ahead data.
+	 */
+	if (blk_off != 0 && wal_ra_wait(&ra)) {
+		if (left_blks)
+			memmove(buf, buf + blk_off * blk_bytes, left_blks * blk_bytes);
+		memcpy(buf + left_blks * blk_bytes, ra.ra_buf, (max_blks - left_blks) * blk_bytes);
+	} else {
+		memset(buf, 0, max_blks * blk_bytes);
+		rc = load_wal(mc, buf, max_blks, tx_id);
+		if (rc) {
+			D_ERROR("Failed to load WAL. "DF_RC"\n", DP_RC(rc));
+			goto out;
+		}
 	}
+	blk_off = 0;
+
+	if (read_ahead)
+		wal_ra_start(mc, &ra, max_blks, (id2off(tx_id) + max_blks) % tot_blks);
 
 	while (1) {
 		/* Something went wrong, it's impossible to replay the whole WAL */
@@ -1708,10 +2068,14 @@ load_wal:
 				rc = -DER_INVAL;
 				break;
 			}
-			memset(buf, 0, max_blks * blk_bytes);
+			left_blks = max_blks - blk_off;
 			goto load_wal;
 		}
 
+		/* Data verification reads data blob, don't let it wait for DMA buffer */
+		if (!tx_known_committed(si, tx_id))
+			wal_ra_wait(&ra);
+
 		rc = verify_tx(mc, (char *)hdr, &blk_desc, &dbuf, &dbuf_len);
 		if (rc)
 			break;
@@ -1739,7 +2103,7 @@ load_wal:
 		tx_id = wal_next_id(si, tx_id, blk_desc.bd_blks);
 
 		if (blk_off == max_blks) {
-			memset(buf, 0, max_blks * blk_bytes);
+			left_blks = 0;
 			goto load_wal;
 		}
 
@@ -1756,6 +2120,7 @@ load_wal:
 		}
 	}
 out:
+	wal_ra_wait(&ra);
 	if (rc >= 0) {
 		D_DEBUG(DB_IO, "Replayed %u WAL transactions\n", nr_replayed);
 		D_ASSERT(si->si_commit_blks == 0 || wal_id_cmp(si, tx_id, si->si_commit_id) > 0);
@@ -1793,11 +2158,13 @@ out:
 			wrs->wrs_sz = total_bytes;
 			wrs->wrs_entries = rpl_entries;
 			wrs->wrs_tx_cnt = total_tx;
+			wrs->wrs_tput = wrs->wrs_tm ? total_bytes * 1000000 / wrs->wrs_tm : 0;
 		}
 	} else {
 		D_ERROR("WAL replay failed, "DF_RC"\n", DP_RC(rc));
 	}
 
+	D_FREE(ra.ra_buf);
 	D_FREE(dbuf);
 	D_FREE(act);
 	D_FREE(buf);
@@ -1880,6 +2247,7 @@ wal_close(struct bio_meta_context *mc)
 	int			 rc;
 
 	D_ASSERT(d_list_empty(&si->si_pending_list));
+	D_ASSERT(si->si_open_group == NULL);
 	D_ASSERT(si->si_tx_failed == 0);
 	if (si->si_rsrv_waiters > 0)
 		wakeup_reserve_waiters(si, true);
@@ -1921,6 +2289,7 @@ wal_open(struct bio_meta_context *mc)
 	}
 
 	D_INIT_LIST_HEAD(&si->si_pending_list);
+	si->si_open_group = NULL;
 	si->si_rsrv_waiters = 0;
 	si->si_pending_tx = 0;
 	si->si_tx_failed = 0;
@@ -2109,6 +2478,23 @@ bio_wal_query(struct bio_meta_context *mc, struct bio_wal_info *info)
 	info->wi_unused_id = si->si_unused_id;
 }
 
+uint64_t
+bio_wal_ckp_target(struct bio_meta_context *mc, uint32_t nr_blks)
+{
+	struct wal_super_info	*si = &mc->mc_wal_info;
+	uint64_t		 target_id;
+
+	if (nr_blks >= wal_used_blks(si))
+		return si->si_commit_id;
+
+	target_id = wal_next_id(si, si->si_ckp_id, si->si_ckp_blks);
+	target_id = wal_next_id(si, target_id, nr_blks);
+	if (wal_id_cmp(si, target_id, si->si_commit_id) > 0)
+		target_id = si->si_commit_id;
+
+	return target_id;
+}
+
 bool
 bio_meta_is_empty(struct bio_meta_context *mc)
 {
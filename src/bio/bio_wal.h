@@ -98,6 +98,7 @@ struct wal_super_info {
 	uint32_t		si_commit_blks;	/* Blocks used by last committed ID */
 	uint64_t                si_unused_id;   /* Next unused ID */
 	d_list_t		si_pending_list;/* Pending transactions */
+	struct wal_group       *si_open_group;	/* Group accepting new transactions */
 	ABT_cond		si_rsrv_wq;	/* FIFO waitqueue for WAL ID reserving */
 	ABT_mutex		si_mutex;	/* For si_rsrv_wq */
 	unsigned int		si_rsrv_waiters;/* Number of waiters in reserve waitqueue */
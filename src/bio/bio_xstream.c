@@ -62,6 +62,12 @@ unsigned int bio_spdk_subsys_timeout = 25000;	/* ms */
 /* How many blob unmap calls can be called in a row */
 unsigned int bio_spdk_max_unmap_cnt = 32;
 unsigned int bio_max_async_sz = (1UL << 15) /* 32k */;
+/* WAL group commit window in us, 0 means group commit is disabled */
+unsigned int bio_wal_group_us;
+/* Max WAL group commit size in bytes, defaults to and is capped at bio_max_async_sz */
+unsigned int bio_wal_group_sz;
+/* Read-ahead WAL blocks on WAL replay */
+bool bio_wal_replay_ra = true;
 
 struct bio_nvme_data {
 	ABT_mutex		 bd_mutex;
@@ -276,6 +282,25 @@ bio_nvme_init(const char *nvme_conf, int numa_node, unsigned int mem_size,
 	d_getenv_uint("DAOS_MAX_ASYNC_SZ", &bio_max_async_sz);
 	D_INFO("Max async data size is set to %u bytes\n", bio_max_async_sz);
 
+	d_getenv_uint("DAOS_WAL_GROUP_US", &bio_wal_group_us);
+	/*
+	 * Like the large data I/O in bio_iod_post_async(), a group WAL I/O larger than
+	 * bio_max_async_sz gets reordered with the async data I/O of the members and stalls
+	 * the tx pipeline, that defeats the group commit.
+	 */
+	bio_wal_group_sz = bio_max_async_sz;
+	d_getenv_uint("DAOS_WAL_GROUP_SZ", &bio_wal_group_sz);
+	if (bio_wal_group_sz > bio_max_async_sz) {
+		D_WARN("WAL group commit size %u is capped at max async data size %u\n",
+		       bio_wal_group_sz, bio_max_async_sz);
+		bio_wal_group_sz = bio_max_async_sz;
+	}
+	D_INFO("WAL group commit window is set to %u us, max size %u bytes\n",
+	       bio_wal_group_us, bio_wal_group_sz);
+
+	d_getenv_bool("DAOS_WAL_REPLAY_RA", &bio_wal_replay_ra);
+	D_INFO("WAL replay read-ahead is %s\n", bio_wal_replay_ra ? "enabled" : "disabled");
+
 	/* Hugepages disabled */
 	if (mem_size == 0) {
 		D_INFO("Set per-xstream DMA buffer upper bound to %u %uMB chunks\n",
@@ -155,13 +155,17 @@ crt_context_init(struct crt_context *ctx)
 	D_INIT_LIST_HEAD(&ctx->cc_quotas.rpc_waitq);
 	D_INIT_LIST_HEAD(&ctx->cc_link);
 
+	rc = crt_rpc_cache_init(ctx);
+	if (rc != 0)
+		D_GOTO(out_mutex_destroy, rc);
+
 	/* create timeout binheap */
 	bh_node_cnt = CRT_DEFAULT_CREDITS_PER_EP_CTX * 64;
 	rc          = d_binheap_create_inplace(DBH_FT_NOLOCK, bh_node_cnt, NULL /* priv */,
 					       &crt_timeout_bh_ops, &ctx->cc_bh_timeout);
 	if (rc != 0) {
 		D_ERROR("d_binheap_create() failed, " DF_RC "\n", DP_RC(rc));
-		D_GOTO(out_mutex_destroy, rc);
+		D_GOTO(out_cache_fini, rc);
 	}
 
 	/* create epi table, use external lock */
@@ -178,6 +182,8 @@ crt_context_init(struct crt_context *ctx)
 
 out_binheap_destroy:
 	d_binheap_destroy_inplace(&ctx->cc_bh_timeout);
+out_cache_fini:
+	crt_rpc_cache_fini(ctx);
 out_mutex_destroy:
 	D_MUTEX_DESTROY(&ctx->cc_quotas.mutex);
 	D_MUTEX_DESTROY(&ctx->cc_mutex);
@@ -858,6 +864,7 @@ crt_context_destroy(crt_context_t crt_ctx, int force)
 	D_RWLOCK_UNLOCK(&crt_gdata.cg_rwlock);
 
 	D_MUTEX_DESTROY(&ctx->cc_mutex);
+	crt_rpc_cache_fini(ctx);
 	D_DEBUG(DB_TRACE, "destroyed context (idx %d, force %d)\n", ctx->cc_idx, force);
 	D_FREE(ctx);
 
@@ -377,7 +377,7 @@ crt_corpc_req_create(crt_context_t crt_ctx, crt_group_t *grp,
 
 	grp_priv = crt_grp_pub2priv(grp);
 
-	rc = crt_rpc_priv_alloc(opc, &rpc_priv, false /* forward */);
+	rc = crt_rpc_priv_alloc(crt_ctx, opc, &rpc_priv, false /* forward */);
 	if (rc != 0) {
 		D_ERROR("crt_rpc_priv_alloc(opc: %#x) failed: "DF_RC"\n", opc,
 			DP_RC(rc));
@@ -1091,13 +1091,19 @@ crt_grp_priv_create(struct crt_grp_priv **grp_priv_created,
 
 	grp_priv->gp_size = 0;
 	grp_priv->gp_refcount = 1;
-	rc = D_RWLOCK_INIT(&grp_priv->gp_rwlock, NULL);
+	rc = crt_tree_cache_init(grp_priv);
 	if (rc)
 		D_GOTO(out_swim_lock, rc);
 
+	rc = D_RWLOCK_INIT(&grp_priv->gp_rwlock, NULL);
+	if (rc)
+		D_GOTO(out_tree_cache, rc);
+
 	*grp_priv_created = grp_priv;
 	return rc;
 
+out_tree_cache:
+	crt_tree_cache_fini(grp_priv);
 out_swim_lock:
 	D_SPIN_DESTROY(&csm->csm_lock);
 out_grpid:
@@ -1148,6 +1154,7 @@ crt_grp_priv_destroy(struct crt_grp_priv *grp_priv)
 
 	/* destroy the members */
 	grp_priv_fini_membs(grp_priv);
+	crt_tree_cache_fini(grp_priv);
 
 	if (!grp_priv->gp_primary) {
 		struct crt_grp_priv *grp_priv_prim = grp_priv->gp_priv_prim;
@@ -2372,6 +2379,7 @@ grp_regen_linear_list(struct crt_grp_priv *grp_priv)
 	}
 
 	linear_list->rl_nr = grp_priv->gp_size;
+	grp_priv->gp_membs.cgm_gen++;
 
 	return 0;
 }
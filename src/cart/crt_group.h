@@ -39,6 +39,32 @@ struct crt_grp_membs {
 	d_rank_list_t	*cgm_list;
 	/* linear list of members. Only used when pmix is disabled */
 	d_rank_list_t	*cgm_linear_list;
+	/* bumped each time cgm_linear_list changes */
+	uint64_t	cgm_gen;
+};
+
+/* Max number of filtered member lists cached per group (see crt_tree.c) */
+#define CRT_TREE_CACHE_MAX	(8)
+
+/* Member list of a group after applying a filter, used to build trees */
+struct crt_tree_ent {
+	/* link to crt_tree_cache::tc_list */
+	d_list_t	 te_link;
+	/* crt_grp_membs::cgm_gen the entry is built from */
+	uint64_t	 te_gen;
+	/* sorted filter ranks, NULL for no filter */
+	d_rank_list_t	*te_filter;
+	/* sorted member ranks after filtering */
+	d_rank_list_t	*te_ranks;
+	uint32_t	 te_ref;
+	bool		 te_invert;
+};
+
+struct crt_tree_cache {
+	pthread_spinlock_t	 tc_lock;
+	/* LRU list of crt_tree_ent */
+	d_list_t		 tc_list;
+	uint32_t		 tc_nr;
 };
 
 struct crt_grp_priv_sec {
@@ -80,6 +106,9 @@ struct crt_grp_priv {
 	 */
 	struct crt_swim_membs	 gp_membs_swim;
 
+	/* cache of filtered member lists for tree topo calculations */
+	struct crt_tree_cache	 gp_tree_cache;
+
 	/* size (number of membs) of group */
 	uint32_t		 gp_size;
 	/*
@@ -130,6 +159,7 @@ static inline int
 grp_priv_set_membs(struct crt_grp_priv *priv, d_rank_list_t *list)
 {
 	if (!priv->gp_primary) {
+		priv->gp_membs.cgm_gen++;
 		/* For secondary groups we populate linear list */
 		return d_rank_list_dup_sort_uniq(
 					&priv->gp_membs.cgm_linear_list,
@@ -987,6 +987,18 @@ crt_hg_ctx_init_tm(struct crt_hg_context *hg_ctx, int idx)
 			     "net/%s/hg/resp_sent/ctx_%u", prov, idx);
 	if (rc)
 		DL_WARN(rc, "Failed to create hg resp sent counter");
+
+	rc = d_tm_add_metric(&metrics->chm_empty_polls, D_TM_COUNTER,
+			     "Network polls without any completion, adaptive progress only",
+			     "polls", "net/%s/hg/empty_polls/ctx_%u", prov, idx);
+	if (rc)
+		DL_WARN(rc, "Failed to create hg empty polls counter");
+
+	rc = d_tm_add_metric(&metrics->chm_poll_completions, D_TM_STATS_GAUGE,
+			     "Completions triggered per non-empty poll, adaptive progress only",
+			     "completions", "net/%s/hg/poll_completions/ctx_%u", prov, idx);
+	if (rc)
+		DL_WARN(rc, "Failed to create hg poll completions gauge");
 }
 
 int
@@ -1050,6 +1062,10 @@ crt_hg_ctx_init(struct crt_hg_context *hg_ctx, crt_provider_t provider, int idx,
 
 	hg_ctx->chc_hgctx = hg_context;
 
+	hg_ctx->chc_progress_adaptive = crt_get_prov_gdata(primary, provider)->cpg_progress_adaptive;
+	hg_ctx->chc_poll_rate         = 0;
+	hg_ctx->chc_poll_backoff      = 0;
+
 	/* TODO: need to create separate bulk class and bulk context? */
 	hg_ctx->chc_bulkctx = hg_ctx->chc_hgctx;
 	hg_ctx->chc_bulkcla = hg_ctx->chc_hgcla;
@@ -1197,7 +1213,7 @@ crt_rpc_handler_common(hg_handle_t hg_hdl)
 	 */
 	rpc_tmp.crp_pub.cr_opc = opc;
 
-	rc = crt_rpc_priv_alloc(opc, &rpc_priv, false /* forward */);
+	rc = crt_rpc_priv_alloc(crt_ctx, opc, &rpc_priv, false /* forward */);
 	if (unlikely(rc != 0)) {
 		if (rc == -DER_UNREG) {
 			D_ERROR("opc: %#x, lookup failed.\n", opc);
@@ -1646,12 +1662,126 @@ crt_hg_reply_error_send(struct crt_rpc_priv *rpc_priv, int error_code)
 	rpc_priv->crp_reply_pending = 0;
 }
 
+/*
+ * account the completions triggered by one crt_hg_progress() call, only in adaptive mode to keep
+ * the metrics updates out of the default progress loop
+ */
+static inline void
+crt_hg_poll_account(struct crt_hg_context *hg_ctx, unsigned int count)
+{
+	/* moving average over the last ~8 polls, scaled by 16 */
+	hg_ctx->chc_poll_rate = hg_ctx->chc_poll_rate - (hg_ctx->chc_poll_rate >> 3) + (count << 1);
+
+	if (count == 0)
+		d_tm_inc_counter(hg_ctx->chc_metrics.chm_empty_polls, 1);
+	else
+		d_tm_set_gauge(hg_ctx->chc_metrics.chm_poll_completions, count);
+}
+
+/* is the context loaded enough to keep polling without waiting? */
+static inline bool
+crt_hg_poll_busy(struct crt_hg_context *hg_ctx)
+{
+	struct crt_context *crt_ctx = container_of(hg_ctx, struct crt_context, cc_hg_ctx);
+
+	if (hg_ctx->chc_poll_rate >= CRT_HG_POLL_BUSY_RATE)
+		return true;
+
+	/* racy read without cc_mutex, it is only a hint */
+	return crt_ctx->cc_bh_timeout.d_bh_nodes_cnt >= CRT_HG_POLL_BUSY_INFLIGHT;
+}
+
+/*
+ * Adaptive flavor of crt_hg_progress(): instead of waiting in HG_Progress()
+ * for the whole \a timeout, busy-poll while the context is loaded, then
+ * double the wait of each HG_Progress() call (up to CRT_HG_POLL_BACKOFF_MAX)
+ * until something completes or \a timeout expires. Completions are triggered
+ * in batches of CRT_HG_TRIGGER_BATCH with network progress in between.
+ */
+static int
+crt_hg_progress_adaptive(struct crt_hg_context *hg_ctx, int64_t timeout)
+{
+	hg_context_t	*hg_context = hg_ctx->chc_hgctx;
+	uint64_t	 end = 0;
+	uint64_t	 now;
+	unsigned int	 hg_timeout;
+	unsigned int	 spins = 0;
+	unsigned int	 total = 0;
+
+	if (timeout > 0)
+		end = d_timeus_secdiff(0) + timeout;
+
+	for (;;) {
+		hg_return_t	hg_ret;
+		unsigned int	count = 0;
+
+		if (timeout == 0 || total > 0) {
+			/* non-blocking, or draining completions */
+			hg_timeout = 0;
+		} else if (spins < CRT_HG_POLL_SPIN_MAX && crt_hg_poll_busy(hg_ctx)) {
+			hg_timeout = 0;
+		} else {
+			hg_timeout = hg_ctx->chc_poll_backoff;
+			if (timeout > 0 && hg_timeout > 0) {
+				now = d_timeus_secdiff(0);
+				if (now >= end)
+					return -DER_TIMEDOUT;
+				hg_timeout = min(hg_timeout, (end - now) / 1000);
+			}
+			hg_ctx->chc_poll_backoff = min(max(hg_ctx->chc_poll_backoff << 1, 1U),
+						       CRT_HG_POLL_BACKOFF_MAX);
+		}
+
+		/** progress RPC execution */
+		hg_ret = HG_Progress(hg_context, hg_timeout);
+		if (hg_ret != HG_SUCCESS && hg_ret != HG_TIMEOUT) {
+			D_ERROR("HG_Progress failed, hg_ret: " DF_HG_RC "\n",
+				DP_HG_RC(hg_ret));
+			return crt_hgret_2_der(hg_ret);
+		}
+
+		/** trigger a bounded batch of completions */
+		hg_ret = HG_Trigger(hg_context, 0, CRT_HG_TRIGGER_BATCH, &count);
+		if (hg_ret == HG_TIMEOUT) {
+			count = 0;
+		} else if (hg_ret != HG_SUCCESS) {
+			D_ERROR("HG_Trigger failed, hg_ret: " DF_HG_RC "\n",
+				DP_HG_RC(hg_ret));
+			return crt_hgret_2_der(hg_ret);
+		}
+
+		total += count;
+		if (count > 0) {
+			hg_ctx->chc_poll_backoff = 0;
+			/* keep draining while full batches are triggered */
+			if (count == CRT_HG_TRIGGER_BATCH && total < CRT_HG_TRIGGER_MAX)
+				continue;
+			break;
+		}
+		if (total > 0)
+			break;
+
+		crt_hg_poll_account(hg_ctx, 0);
+		spins++;
+		if (timeout == 0)
+			return -DER_TIMEDOUT;
+		if (timeout > 0 && d_timeus_secdiff(0) >= end)
+			return -DER_TIMEDOUT;
+	}
+
+	crt_hg_poll_account(hg_ctx, total);
+	return 0;
+}
+
 int
 crt_hg_progress(struct crt_hg_context *hg_ctx, int64_t timeout)
 {
 	hg_context_t		*hg_context;
 	unsigned int		hg_timeout;
-	unsigned int		total = 256;
+	unsigned int		total = CRT_HG_TRIGGER_MAX;
+
+	if (hg_ctx->chc_progress_adaptive)
+		return crt_hg_progress_adaptive(hg_ctx, timeout);
 
 	hg_context = hg_ctx->chc_hgctx;
 
@@ -1689,9 +1819,10 @@ crt_hg_progress(struct crt_hg_context *hg_ctx, int64_t timeout)
 			return crt_hgret_2_der(hg_ret);
 		}
 
-		if (count == 0 || rc)
+		if (count == 0 || rc) {
 			/** nothing to trigger */
 			return rc;
+		}
 
 		/**
 		 * continue network progress and callback processing, but w/o
@@ -128,8 +128,29 @@ struct crt_hg_metrics {
 	struct d_tm_node_t *chm_resp_sent;
 	struct d_tm_node_t *chm_req_recv;
 	struct d_tm_node_t *chm_req_sent;
+	/* poll efficiency */
+	struct d_tm_node_t *chm_empty_polls;
+	struct d_tm_node_t *chm_poll_completions;
 };
 
+/* Max number of completions triggered by one crt_hg_progress() call */
+#define CRT_HG_TRIGGER_MAX		(256)
+
+/*
+ * Adaptive progress mode (D_PROGRESS_ADAPTIVE): busy-poll while the context is
+ * loaded, back off exponentially when it is idle.
+ */
+/* Completions triggered before progressing the network again */
+#define CRT_HG_TRIGGER_BATCH		(32)
+/* Busy-poll while at least this many RPCs are in flight on the context */
+#define CRT_HG_POLL_BUSY_INFLIGHT	(4)
+/* ... or while the average completions per poll (scaled by 16) reaches this */
+#define CRT_HG_POLL_BUSY_RATE		(16)
+/* Empty busy polls before starting to back off */
+#define CRT_HG_POLL_SPIN_MAX		(64)
+/* Max HG_Progress() timeout (in ms) when backing off */
+#define CRT_HG_POLL_BACKOFF_MAX		(16)
+
 /** HG context */
 struct crt_hg_context {
 	/* Flag indicating whether hg class is shared; true for SEP mode */
@@ -143,6 +164,9 @@ struct crt_hg_context {
 	bool               chc_thread_mode_single; /* thread safety */
 	uint64_t              chc_diag_pub_ts;        /* time of last diagnostics pub */
 	struct crt_hg_metrics chc_metrics;            /* HG metrics */
+	bool                  chc_progress_adaptive;  /* adaptive progress mode */
+	uint32_t              chc_poll_rate;          /* avg completions per poll, x16 */
+	uint32_t              chc_poll_backoff;       /* current idle timeout, in ms */
 };
 
 /* crt_hg.c */
@@ -173,6 +197,7 @@ void crt_hg_unpack_cleanup(crt_proc_t proc);
 int crt_hg_unpack_body(struct crt_rpc_priv *rpc_priv, crt_proc_t proc);
 int crt_proc_in_common(crt_proc_t proc, crt_rpc_input_t *data);
 int crt_proc_out_common(crt_proc_t proc, crt_rpc_output_t *data);
+uint32_t crt_rank_set_size(d_rank_list_t *ranks, uint32_t *nruns);
 
 bool crt_provider_is_contig_ep(crt_provider_t provider);
 bool crt_provider_is_port_based(crt_provider_t provider);
@@ -388,6 +388,145 @@ crt_proc_d_sg_list_t(crt_proc_t proc, crt_proc_op_t proc_op, d_sg_list_t *p)
 	return rc;
 }
 
+/*
+ * Size in bytes of \a ranks encoded by crt_proc_rank_set(). \a nruns returns
+ * the number of runs of consecutive ranks if the run encoding is enabled
+ * (CRT_CORPC_RANK_RUNS) and is the smaller one, or zero for the plain encoding.
+ */
+uint32_t
+crt_rank_set_size(d_rank_list_t *ranks, uint32_t *nruns)
+{
+	uint32_t	n = 1;
+	uint32_t	i;
+
+	*nruns = 0;
+	if (ranks == NULL || ranks->rl_nr == 0)
+		return sizeof(uint32_t);
+	if (!crt_gdata.cg_corpc_rank_runs)
+		return (ranks->rl_nr + 1) * sizeof(uint32_t);
+
+	for (i = 1; i < ranks->rl_nr; i++) {
+		if (ranks->rl_ranks[i] != ranks->rl_ranks[i - 1] + 1)
+			n++;
+	}
+
+	/* count and nruns words, then a (first, last) pair per run */
+	if (2 * n + 1 < ranks->rl_nr) {
+		*nruns = n;
+		return (2 * n + 2) * sizeof(uint32_t);
+	}
+
+	return (ranks->rl_nr + 1) * sizeof(uint32_t);
+}
+
+/*
+ * Same as crt_proc_d_rank_list_t(), except that runs of consecutive ranks
+ * (e.g. the excluded ranks of a large system) are encoded as (first, last)
+ * pairs, so the header size depends on the number of runs rather than on
+ * the number of ranks. There is no version in the corpc header, so only the
+ * decoding is unconditional: the encoding is used once every engine has been
+ * upgraded and CRT_CORPC_RANK_RUNS is set.
+ */
+static int
+crt_proc_rank_set(crt_proc_t proc, crt_proc_op_t proc_op, d_rank_list_t **data)
+{
+	d_rank_list_t	*rank_list;
+	uint32_t	*buf;
+	uint32_t	 nr;
+	uint32_t	 nruns;
+	uint32_t	 i;
+	uint32_t	 j;
+	int		 rc = 0;
+
+	switch (proc_op) {
+	case CRT_PROC_ENCODE:
+		rank_list = *data;
+		crt_rank_set_size(rank_list, &nruns);
+		if (nruns == 0)
+			return crt_proc_d_rank_list_t(proc, proc_op, data);
+
+		nr = rank_list->rl_nr;
+		D_ASSERT(nr < CRT_RANK_SET_RUNS);
+		buf    = hg_proc_save_ptr(proc, 2 * sizeof(*buf));
+		buf[0] = nr | CRT_RANK_SET_RUNS;
+		buf[1] = nruns;
+
+		buf = hg_proc_save_ptr(proc, 2 * nruns * sizeof(*buf));
+		j   = 0;
+		for (i = 0; i < nr; i++) {
+			if (i == 0 || rank_list->rl_ranks[i] != rank_list->rl_ranks[i - 1] + 1) {
+				if (i != 0)
+					j++;
+				buf[2 * j] = rank_list->rl_ranks[i];
+			}
+			buf[2 * j + 1] = rank_list->rl_ranks[i];
+		}
+		D_ASSERT(j + 1 == nruns);
+		break;
+	case CRT_PROC_DECODE:
+		buf = hg_proc_save_ptr(proc, sizeof(*buf));
+
+		nr = *buf;
+		if (!(nr & CRT_RANK_SET_RUNS)) {
+			if (nr == 0) {
+				*data = NULL;
+				D_GOTO(out, rc = 0);
+			}
+
+			rank_list = d_rank_list_alloc(nr);
+			if (unlikely(rank_list == NULL))
+				D_GOTO(out, rc = -DER_NOMEM);
+			buf = hg_proc_save_ptr(proc, nr * sizeof(*buf));
+			memcpy(rank_list->rl_ranks, buf, nr * sizeof(*buf));
+			*data = rank_list;
+			D_GOTO(out, rc = 0);
+		}
+
+		nr &= ~CRT_RANK_SET_RUNS;
+		buf   = hg_proc_save_ptr(proc, sizeof(*buf));
+		nruns = *buf;
+		if (unlikely(nr == 0 || nruns == 0 || nruns > nr)) {
+			D_ERROR("invalid rank set, nr %u, nruns %u\n", nr, nruns);
+			D_GOTO(out, rc = -DER_PROTO);
+		}
+
+		rank_list = d_rank_list_alloc(nr);
+		if (unlikely(rank_list == NULL))
+			D_GOTO(out, rc = -DER_NOMEM);
+
+		buf = hg_proc_save_ptr(proc, 2 * nruns * sizeof(*buf));
+		j   = 0;
+		for (i = 0; i < nruns; i++) {
+			d_rank_t rank = buf[2 * i];
+			d_rank_t last = buf[2 * i + 1];
+
+			if (unlikely(rank > last || last - rank >= nr - j)) {
+				D_ERROR("invalid rank run [%u, %u] of rank set (%u ranks)\n",
+					rank, last, nr);
+				d_rank_list_free(rank_list);
+				D_GOTO(out, rc = -DER_PROTO);
+			}
+			do {
+				rank_list->rl_ranks[j++] = rank;
+			} while (rank++ != last);
+		}
+		if (unlikely(j != nr)) {
+			D_ERROR("rank set has %u ranks in runs, %u expected\n", j, nr);
+			d_rank_list_free(rank_list);
+			D_GOTO(out, rc = -DER_PROTO);
+		}
+		*data = rank_list;
+		break;
+	case CRT_PROC_FREE:
+		d_rank_list_free(*data);
+		*data = NULL;
+		break;
+	}
+
+out:
+	return rc;
+}
+
 static inline int
 crt_proc_corpc_hdr(crt_proc_t proc, struct crt_corpc_hdr *hdr)
 {
@@ -410,11 +549,11 @@ crt_proc_corpc_hdr(crt_proc_t proc, struct crt_corpc_hdr *hdr)
 	if (unlikely(rc))
 		D_GOTO(out, rc);
 
-	rc = crt_proc_d_rank_list_t(proc, proc_op, &hdr->coh_filter_ranks);
+	rc = crt_proc_rank_set(proc, proc_op, &hdr->coh_filter_ranks);
 	if (unlikely(rc))
 		D_GOTO(out, rc);
 
-	rc = crt_proc_d_rank_list_t(proc, proc_op, &hdr->coh_inline_ranks);
+	rc = crt_proc_rank_set(proc, proc_op, &hdr->coh_inline_ranks);
 	if (unlikely(rc))
 		D_GOTO(out, rc);
 
@@ -156,6 +156,7 @@ prov_data_init(struct crt_prov_gdata *prov_data, crt_provider_t provider, bool p
 	uint32_t max_expect_size   = 0;
 	uint32_t max_unexpect_size = 0;
 	uint32_t max_num_ctx       = CRT_SRV_CONTEXT_NUM;
+	bool     progress_adaptive = false;
 	int      i;
 	int      rc;
 
@@ -210,6 +211,9 @@ prov_data_init(struct crt_prov_gdata *prov_data, crt_provider_t provider, bool p
 		prov_data->cpg_progress_busy = progress_busy;
 	}
 
+	crt_env_get(D_PROGRESS_ADAPTIVE, &progress_adaptive);
+	prov_data->cpg_progress_adaptive = progress_adaptive;
+
 	for (i = 0; i < CRT_SRV_CONTEXT_NUM; i++)
 		prov_data->cpg_used_idx[i] = false;
 
@@ -241,6 +245,7 @@ crt_gdata_dump(void)
 	DUMP_GDATA_FIELD("%d", cg_server);
 	DUMP_GDATA_FIELD("%d", cg_use_sensors);
 	DUMP_GDATA_FIELD("%d", cg_provider_is_primary);
+	DUMP_GDATA_FIELD("%d", cg_corpc_rank_runs);
 	DUMP_GDATA_FIELD("0x%lx", cg_rpcid);
 	DUMP_GDATA_FIELD("%ld", cg_num_cores);
 	DUMP_GDATA_FIELD("%d", cg_rpc_quota);
@@ -266,6 +271,7 @@ data_init(int server, crt_init_options_t *opt)
 	uint32_t     fi_univ_size   = 0;
 	uint32_t     mem_pin_enable = 0;
 	uint32_t     is_secondary;
+	uint32_t     rank_runs      = 0;
 	uint32_t     post_init = CRT_HG_POST_INIT, post_incr = CRT_HG_POST_INCR;
 	unsigned int mrecv_buf          = CRT_HG_MRECV_BUF;
 	unsigned int mrecv_buf_copy     = 0; /* buf copy disabled by default */
@@ -339,6 +345,10 @@ data_init(int server, crt_init_options_t *opt)
 		crt_gdata.cg_bulk_quota = 0;
 	}
 
+	/* Engines older than the run encoding cannot decode it, so it is opt-in */
+	crt_env_get(CRT_CORPC_RANK_RUNS, &rank_runs);
+	crt_gdata.cg_corpc_rank_runs = (rank_runs != 0);
+
 	/* Must be set on the server when using UCX, will not affect OFI */
 	if (server)
 		d_setenv("UCX_IB_FORK_INIT", "n", 1);
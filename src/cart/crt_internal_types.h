@@ -87,6 +87,7 @@ struct crt_prov_gdata {
 	bool                 cpg_contig_ports;
 	bool                 cpg_inited;
 	bool                 cpg_progress_busy;
+	bool                 cpg_progress_adaptive;
 
 	/** Mutext to protect fields above */
 	pthread_mutex_t      cpg_mutex;
@@ -149,6 +150,8 @@ struct crt_gdata {
 	unsigned int             cg_use_sensors         : 1;
 	/** whether we are on a primary provider */
 	unsigned int             cg_provider_is_primary : 1;
+	/** whether the corpc header rank lists may be encoded as runs */
+	unsigned int             cg_corpc_rank_runs     : 1;
 
 	/** use single thread to access context */
 	bool                     cg_thread_mode_single;
@@ -197,6 +200,7 @@ struct crt_event_cb_priv {
  **/
 #define CRT_ENV_LIST                                                                               \
 	ENV_STR(CRT_ATTACH_INFO_PATH)                                                              \
+	ENV(CRT_CORPC_RANK_RUNS)                                                                   \
 	ENV(CRT_CREDIT_EP_CTX)                                                                     \
 	ENV(CRT_CTX_NUM)                                                                           \
 	ENV(CRT_CXI_INIT_RETRY)                                                                    \
@@ -230,6 +234,7 @@ struct crt_event_cb_priv {
 	ENV(D_PORT_AUTO_ADJUST)                                                                    \
 	ENV(D_THREAD_MODE_SINGLE)                                                                  \
 	ENV(D_PROGRESS_BUSY)                                                                       \
+	ENV(D_PROGRESS_ADAPTIVE)                                                                   \
 	ENV(D_POST_INCR)                                                                           \
 	ENV(D_POST_INIT)                                                                           \
 	ENV(D_MRECV_BUF)                                                                           \
@@ -388,6 +393,25 @@ struct crt_quotas {
 	struct d_tm_node_t     *rpc_quota_exceeded;
 };
 
+/* Number of per-opcode free lists of each context */
+#define CRT_RPC_CACHE_BKT_NR		(64)
+/* Max number of freed RPCs kept in each free list */
+#define CRT_RPC_CACHE_MAX_NUM		(32)
+
+/* Free list of the RPC descriptors (with in/out buffers) of one opcode */
+struct crt_rpc_cache_bkt {
+	/* opcode of the cached RPCs, NULL when the bucket is unused */
+	struct crt_opc_info	*crb_opc_info;
+	d_list_t		 crb_list;
+	int32_t			 crb_num;
+};
+
+/* Per-context cache of freed RPCs, see crt_rpc_priv_alloc() */
+struct crt_rpc_cache {
+	pthread_spinlock_t	 crc_lock;
+	struct crt_rpc_cache_bkt crc_bkts[CRT_RPC_CACHE_BKT_NR];
+};
+
 /*
  * crt_bulk - wrapper struct for crt_bulk_t type
  *
@@ -459,6 +483,9 @@ struct crt_context {
 
 	/** Stores quotas */
 	struct crt_quotas	cc_quotas;
+
+	/** Freed RPCs for reuse */
+	struct crt_rpc_cache	cc_rpc_cache;
 };
 
 /* in-flight RPC req list, be tracked per endpoint for every crt_context */
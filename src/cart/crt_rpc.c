@@ -504,10 +504,111 @@ out:
 }
 
 int
-crt_rpc_priv_alloc(crt_opcode_t opc, struct crt_rpc_priv **priv_allocated,
-		   bool forward)
+crt_rpc_cache_init(struct crt_context *ctx)
 {
+	struct crt_rpc_cache	*cache = &ctx->cc_rpc_cache;
+	int			 i;
+
+	for (i = 0; i < CRT_RPC_CACHE_BKT_NR; i++) {
+		cache->crc_bkts[i].crb_opc_info = NULL;
+		cache->crc_bkts[i].crb_num = 0;
+		D_INIT_LIST_HEAD(&cache->crc_bkts[i].crb_list);
+	}
+
+	return D_SPIN_INIT(&cache->crc_lock, PTHREAD_PROCESS_PRIVATE);
+}
+
+void
+crt_rpc_cache_fini(struct crt_context *ctx)
+{
+	struct crt_rpc_cache	*cache = &ctx->cc_rpc_cache;
 	struct crt_rpc_priv	*rpc_priv;
+	d_list_t		 free_list;
+	int			 i;
+
+	D_INIT_LIST_HEAD(&free_list);
+
+	D_SPIN_LOCK(&cache->crc_lock);
+	for (i = 0; i < CRT_RPC_CACHE_BKT_NR; i++) {
+		d_list_splice_init(&cache->crc_bkts[i].crb_list, &free_list);
+		cache->crc_bkts[i].crb_opc_info = NULL;
+		cache->crc_bkts[i].crb_num = 0;
+	}
+	D_SPIN_UNLOCK(&cache->crc_lock);
+
+	while ((rpc_priv = d_list_pop_entry(&free_list, struct crt_rpc_priv,
+					    crp_tmp_link_submit)))
+		D_FREE(rpc_priv);
+
+	D_SPIN_DESTROY(&cache->crc_lock);
+}
+
+/*
+ * The opcode info of one protocol is a contiguous array (see crt_opc_map_L3),
+ * so the opcodes of a protocol fall into distinct buckets.
+ */
+static inline struct crt_rpc_cache_bkt *
+crt_rpc_cache_bkt(struct crt_context *ctx, struct crt_opc_info *opc_info)
+{
+	uintptr_t idx = (uintptr_t)opc_info / sizeof(*opc_info);
+
+	return &ctx->cc_rpc_cache.crc_bkts[idx % CRT_RPC_CACHE_BKT_NR];
+}
+
+/* Take a freed RPC of \a opc_info from the cache of \a ctx, NULL if none */
+static struct crt_rpc_priv *
+crt_rpc_cache_get(struct crt_context *ctx, struct crt_opc_info *opc_info)
+{
+	struct crt_rpc_cache_bkt	*bkt = crt_rpc_cache_bkt(ctx, opc_info);
+	struct crt_rpc_priv		*rpc_priv = NULL;
+
+	D_SPIN_LOCK(&ctx->cc_rpc_cache.crc_lock);
+	if (bkt->crb_opc_info == opc_info) {
+		rpc_priv = d_list_pop_entry(&bkt->crb_list, struct crt_rpc_priv,
+					    crp_tmp_link_submit);
+		if (rpc_priv != NULL)
+			bkt->crb_num--;
+	}
+	D_SPIN_UNLOCK(&ctx->cc_rpc_cache.crc_lock);
+
+	if (rpc_priv != NULL)
+		memset(rpc_priv, 0, opc_info->coi_rpc_size);
+	return rpc_priv;
+}
+
+/* Returns true if \a rpc_priv is kept in the cache of its context */
+static bool
+crt_rpc_cache_put(struct crt_rpc_priv *rpc_priv)
+{
+	struct crt_context		*ctx = rpc_priv->crp_pub.cr_ctx;
+	struct crt_opc_info		*opc_info = rpc_priv->crp_opc_info;
+	struct crt_rpc_cache_bkt	*bkt;
+	bool				 cached = false;
+
+	/* Forwarded RPCs are allocated without the output buffer */
+	if (ctx == NULL || rpc_priv->crp_forward)
+		return false;
+
+	bkt = crt_rpc_cache_bkt(ctx, opc_info);
+	D_SPIN_LOCK(&ctx->cc_rpc_cache.crc_lock);
+	/* An empty bucket can be taken over by another opcode */
+	if (bkt->crb_num == 0)
+		bkt->crb_opc_info = opc_info;
+	if (bkt->crb_opc_info == opc_info && bkt->crb_num < CRT_RPC_CACHE_MAX_NUM) {
+		d_list_add(&rpc_priv->crp_tmp_link_submit, &bkt->crb_list);
+		bkt->crb_num++;
+		cached = true;
+	}
+	D_SPIN_UNLOCK(&ctx->cc_rpc_cache.crc_lock);
+
+	return cached;
+}
+
+int
+crt_rpc_priv_alloc(struct crt_context *ctx, crt_opcode_t opc,
+		   struct crt_rpc_priv **priv_allocated, bool forward)
+{
+	struct crt_rpc_priv	*rpc_priv = NULL;
 	struct crt_opc_info	*opc_info;
 	int			rc = 0;
 
@@ -531,7 +632,9 @@ crt_rpc_priv_alloc(crt_opcode_t opc, struct crt_rpc_priv **priv_allocated,
 
 	if (forward)
 		D_ALLOC(rpc_priv, opc_info->coi_input_offset);
-	else
+	else if (ctx != NULL)
+		rpc_priv = crt_rpc_cache_get(ctx, opc_info);
+	if (rpc_priv == NULL && !forward)
 		D_ALLOC(rpc_priv, opc_info->coi_rpc_size);
 	if (rpc_priv == NULL)
 		D_GOTO(out, rc = -DER_NOMEM);
@@ -579,6 +682,10 @@ crt_rpc_priv_free(struct crt_rpc_priv *rpc_priv)
 
 	RPC_TRACE(DB_TRACE, rpc_priv, "destroying\n");
 
+	/* Can't touch rpc_priv once it is in the cache */
+	if (crt_rpc_cache_put(rpc_priv))
+		return;
+
 	D_FREE(rpc_priv);
 }
 
@@ -625,7 +732,7 @@ crt_req_create_internal(crt_context_t crt_ctx, crt_endpoint_t *tgt_ep,
 
 	D_ASSERT(crt_ctx != CRT_CONTEXT_NULL && req != NULL);
 
-	rc = crt_rpc_priv_alloc(opc, &rpc_priv, forward);
+	rc = crt_rpc_priv_alloc(crt_ctx, opc, &rpc_priv, forward);
 	if (rc != 0) {
 		D_ERROR("crt_rpc_priv_alloc(%#x) failed, " DF_RC "\n",
 			opc, DP_RC(rc));
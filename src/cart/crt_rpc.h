@@ -39,6 +39,13 @@ enum crt_rpc_flags_internal {
 	CRT_RPC_FLAG_PRIMARY_GRP	= (1U << 17),
 };
 
+/*
+ * The rank lists of the corpc header are encoded as runs of consecutive ranks
+ * when enabled and smaller than the plain list (see crt_rank_set_size()), which
+ * is flagged by this bit in the encoded rank count.
+ */
+#define CRT_RANK_SET_RUNS	(1U << 31)
+
 struct crt_corpc_hdr {
 	/* internal group ID name */
 	d_string_t		 coh_grpid;
@@ -663,9 +670,11 @@ crt_rpc_cb_customized(struct crt_context *crt_ctx,
 }
 
 /* crt_rpc.c */
-int crt_rpc_priv_alloc(crt_opcode_t opc, struct crt_rpc_priv **priv_allocated,
-		       bool forward);
+int crt_rpc_priv_alloc(struct crt_context *ctx, crt_opcode_t opc,
+		       struct crt_rpc_priv **priv_allocated, bool forward);
 void crt_rpc_priv_free(struct crt_rpc_priv *rpc_priv);
+int crt_rpc_cache_init(struct crt_context *ctx);
+void crt_rpc_cache_fini(struct crt_context *ctx);
 void crt_rpc_priv_init(struct crt_rpc_priv *rpc_priv, crt_context_t crt_ctx, bool srv_flag);
 void crt_rpc_priv_fini(struct crt_rpc_priv *rpc_priv);
 int crt_req_create_internal(crt_context_t crt_ctx, crt_endpoint_t *tgt_ep,
@@ -11,73 +11,278 @@
 
 #include "crt_internal.h"
 
+int
+crt_tree_cache_init(struct crt_grp_priv *grp_priv)
+{
+	struct crt_tree_cache	*tc = &grp_priv->gp_tree_cache;
+
+	D_INIT_LIST_HEAD(&tc->tc_list);
+	tc->tc_nr = 0;
+
+	return D_SPIN_INIT(&tc->tc_lock, PTHREAD_PROCESS_PRIVATE);
+}
+
+static void
+crt_tree_ent_free(struct crt_tree_ent *ent)
+{
+	d_rank_list_free(ent->te_filter);
+	d_rank_list_free(ent->te_ranks);
+	D_FREE(ent);
+}
+
+void
+crt_tree_cache_fini(struct crt_grp_priv *grp_priv)
+{
+	struct crt_tree_cache	*tc = &grp_priv->gp_tree_cache;
+	struct crt_tree_ent	*ent;
+
+	while ((ent = d_list_pop_entry(&tc->tc_list, struct crt_tree_ent, te_link)) != NULL) {
+		D_ASSERTF(ent->te_ref == 0, "tree cache entry still referenced: %u\n",
+			  ent->te_ref);
+		crt_tree_ent_free(ent);
+	}
+	tc->tc_nr = 0;
+
+	D_SPIN_DESTROY(&tc->tc_lock);
+}
+
+static void
+crt_tree_ent_put(struct crt_grp_priv *grp_priv, struct crt_tree_ent *ent)
+{
+	struct crt_tree_cache	*tc = &grp_priv->gp_tree_cache;
+	bool			 free_ent;
+
+	D_SPIN_LOCK(&tc->tc_lock);
+	D_ASSERT(ent->te_ref > 0);
+	ent->te_ref--;
+	/* already evicted from the cache, the last user frees it */
+	free_ent = (ent->te_ref == 0 && d_list_empty(&ent->te_link));
+	D_SPIN_UNLOCK(&tc->tc_lock);
+
+	if (free_ent)
+		crt_tree_ent_free(ent);
+}
+
+static bool
+crt_tree_ent_match(struct crt_tree_ent *ent, bool filter_invert, d_rank_list_t *filter)
+{
+	if (ent->te_invert != filter_invert)
+		return false;
+
+	if (ent->te_filter == NULL || filter == NULL)
+		return ent->te_filter == filter;
+
+	return ent->te_filter->rl_nr == filter->rl_nr &&
+	       memcmp(ent->te_filter->rl_ranks, filter->rl_ranks,
+		      filter->rl_nr * sizeof(*filter->rl_ranks)) == 0;
+}
+
+/*
+ * Find the cached member list of \a gen for the (sorted) \a filter, and take
+ * a reference on it. Entries built from an older membership are dropped.
+ */
+static struct crt_tree_ent *
+crt_tree_cache_find(struct crt_grp_priv *grp_priv, uint64_t gen, bool filter_invert,
+		    d_rank_list_t *filter)
+{
+	struct crt_tree_cache	*tc = &grp_priv->gp_tree_cache;
+	struct crt_tree_ent	*ent;
+	struct crt_tree_ent	*tmp;
+	struct crt_tree_ent	*found = NULL;
+	d_list_t		 stale;
+
+	D_INIT_LIST_HEAD(&stale);
+
+	D_SPIN_LOCK(&tc->tc_lock);
+	d_list_for_each_entry_safe(ent, tmp, &tc->tc_list, te_link) {
+		if (ent->te_gen != gen) {
+			d_list_del_init(&ent->te_link);
+			tc->tc_nr--;
+			if (ent->te_ref == 0)
+				d_list_add(&ent->te_link, &stale);
+			continue;
+		}
+
+		if (found == NULL && crt_tree_ent_match(ent, filter_invert, filter)) {
+			found = ent;
+			found->te_ref++;
+			d_list_move(&found->te_link, &tc->tc_list);
+		}
+	}
+	D_SPIN_UNLOCK(&tc->tc_lock);
+
+	while ((ent = d_list_pop_entry(&stale, struct crt_tree_ent, te_link)) != NULL)
+		crt_tree_ent_free(ent);
+
+	return found;
+}
+
+static void
+crt_tree_cache_insert(struct crt_grp_priv *grp_priv, struct crt_tree_ent *ent)
+{
+	struct crt_tree_cache	*tc = &grp_priv->gp_tree_cache;
+	struct crt_tree_ent	*victim = NULL;
+
+	D_SPIN_LOCK(&tc->tc_lock);
+	d_list_add(&ent->te_link, &tc->tc_list);
+	tc->tc_nr++;
+	if (tc->tc_nr > CRT_TREE_CACHE_MAX) {
+		victim = d_list_entry(tc->tc_list.prev, struct crt_tree_ent, te_link);
+		d_list_del_init(&victim->te_link);
+		tc->tc_nr--;
+		/* still in use, freed by crt_tree_ent_put() */
+		if (victim->te_ref != 0)
+			victim = NULL;
+	}
+	D_SPIN_UNLOCK(&tc->tc_lock);
+
+	if (victim != NULL)
+		crt_tree_ent_free(victim);
+}
+
+/* Filter the sorted \a ranks with the sorted \a filter in one pass */
+static void
+crt_tree_filter_sorted(d_rank_list_t *ranks, d_rank_list_t *filter, bool exclude)
+{
+	uint32_t	i;
+	uint32_t	j = 0;
+	uint32_t	nr = 0;
+
+	for (i = 0; i < ranks->rl_nr; i++) {
+		d_rank_t rank = ranks->rl_ranks[i];
+
+		while (j < filter->rl_nr && filter->rl_ranks[j] < rank)
+			j++;
+		if ((j < filter->rl_nr && filter->rl_ranks[j] == rank) != exclude)
+			ranks->rl_ranks[nr++] = rank;
+	}
+	ranks->rl_nr = nr;
+}
+
+/* query the idx of rank within the sorted rank list */
+static int
+crt_tree_rank_idx(d_rank_list_t *ranks, d_rank_t rank, d_rank_t *idx)
+{
+	uint32_t	lo = 0;
+	uint32_t	hi = ranks->rl_nr;
+
+	while (lo < hi) {
+		uint32_t mid = lo + (hi - lo) / 2;
+
+		if (ranks->rl_ranks[mid] < rank)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	if (lo == ranks->rl_nr || ranks->rl_ranks[lo] != rank)
+		return -DER_NONEXIST;
+
+	*idx = lo;
+	return 0;
+}
+
+/*
+ * Get the member list of the group after applying \a filter_ranks, either
+ * from the per-group cache or by building (and caching) it. The caller should
+ * release the returned entry by crt_tree_ent_put(). *result is NULL if all
+ * members are filtered out.
+ */
 static int
 crt_get_filtered_grp_rank_list(struct crt_grp_priv *grp_priv, uint32_t grp_ver,
 			       bool filter_invert, d_rank_list_t *filter_ranks,
 			       d_rank_t root, d_rank_t self, d_rank_t *grp_size,
 			       d_rank_t *grp_root, d_rank_t *grp_self,
-			       d_rank_list_t **result_grp_rank_list,
-			       bool *allocated)
+			       struct crt_tree_ent **result)
 {
+	struct crt_tree_ent	*ent;
 	d_rank_list_t		*grp_rank_list = NULL;
-	d_rank_list_t		*membs;
+	d_rank_list_t		*filter = NULL;
+	uint64_t		 gen = grp_priv->gp_membs.cgm_gen;
 	int			 rc = 0;
 
-	membs = grp_priv_get_membs(grp_priv);
+	if (filter_ranks != NULL && filter_ranks->rl_nr > 0) {
+		rc = d_rank_list_dup_sort_uniq(&filter, filter_ranks);
+		if (rc != 0) {
+			D_ERROR("d_rank_list_dup failed, rc " DF_RC "\n", DP_RC(rc));
+			return rc;
+		}
+	}
+
+	ent = crt_tree_cache_find(grp_priv, gen, filter_invert, filter);
+	if (ent != NULL) {
+		d_rank_list_free(filter);
+		D_GOTO(found, rc = 0);
+	}
 
-	rc = d_rank_list_dup_sort_uniq(&grp_rank_list, membs);
+	rc = d_rank_list_dup_sort_uniq(&grp_rank_list, grp_priv_get_membs(grp_priv));
 	if (rc != 0) {
 		D_ERROR("d_rank_list_dup failed, rc " DF_RC "\n", DP_RC(rc));
 		D_GOTO(out, rc);
 	}
 	D_ASSERT(grp_rank_list != NULL);
-	*allocated = true;
 
 	if (filter_invert) {
-		d_rank_list_filter(filter_ranks, grp_rank_list,
-				   false /* exclude */);
-		if (grp_rank_list->rl_nr != filter_ranks->rl_nr) {
+		uint32_t filter_nr = filter != NULL ? filter->rl_nr : 0;
+
+		if (filter != NULL)
+			crt_tree_filter_sorted(grp_rank_list, filter, false /* exclude */);
+		else
+			grp_rank_list->rl_nr = 0;
+		if (grp_rank_list->rl_nr != filter_nr) {
 			D_ERROR("%u/%u filter ranks (inverted) out of group\n",
-				filter_ranks->rl_nr - grp_rank_list->rl_nr,
-				filter_ranks->rl_nr);
-			d_rank_list_free(grp_rank_list);
-			grp_rank_list = NULL;
+				filter_nr - grp_rank_list->rl_nr, filter_nr);
 			D_GOTO(out, rc = -DER_OOG);
 		}
-	} else if (filter_ranks != NULL && filter_ranks->rl_nr > 0) {
-		d_rank_list_filter(filter_ranks, grp_rank_list,
-				   true /* exclude */);
-		if (grp_rank_list->rl_nr == 0) {
-			D_DEBUG(DB_TRACE, "d_rank_list_filter(group %s) "
-				"get empty.\n", grp_priv->gp_pub.cg_grpid);
-			d_rank_list_free(grp_rank_list);
-			grp_rank_list = NULL;
-			D_GOTO(out, rc = 0);
-		}
+	} else if (filter != NULL) {
+		crt_tree_filter_sorted(grp_rank_list, filter, true /* exclude */);
 	}
-	*grp_size = grp_rank_list->rl_nr;
 
-	rc = d_idx_in_rank_list(grp_rank_list, root, grp_root);
+	if (grp_rank_list->rl_nr == 0) {
+		D_DEBUG(DB_TRACE, "filtered group %s get empty.\n", grp_priv->gp_pub.cg_grpid);
+		*result = NULL;
+		D_GOTO(out, rc = 0);
+	}
+
+	D_ALLOC_PTR(ent);
+	if (ent == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	D_INIT_LIST_HEAD(&ent->te_link);
+	ent->te_gen    = gen;
+	ent->te_invert = filter_invert;
+	ent->te_filter = filter;
+	ent->te_ranks  = grp_rank_list;
+	ent->te_ref    = 1;
+	crt_tree_cache_insert(grp_priv, ent);
+
+found:
+	*grp_size = ent->te_ranks->rl_nr;
+
+	rc = crt_tree_rank_idx(ent->te_ranks, root, grp_root);
 	if (rc != 0) {
-		D_ERROR("d_idx_in_rank_list (group %s, rank %d), "
+		D_ERROR("crt_tree_rank_idx (group %s, rank %d), "
 			"failed, rc: %d.\n", grp_priv->gp_pub.cg_grpid,
 			root, rc);
-		d_rank_list_free(grp_rank_list);
-		D_GOTO(out, rc);
+		crt_tree_ent_put(grp_priv, ent);
+		return rc;
 	}
 
-	rc = d_idx_in_rank_list(grp_rank_list, self, grp_self);
+	rc = crt_tree_rank_idx(ent->te_ranks, self, grp_self);
 	if (rc != 0) {
-		D_ERROR("d_idx_in_rank_list (group %s, rank %d), "
+		D_ERROR("crt_tree_rank_idx (group %s, rank %d), "
 			"failed, rc: %d.\n", grp_priv->gp_pub.cg_grpid,
 			self, rc);
-		d_rank_list_free(grp_rank_list);
-		D_GOTO(out, rc);
+		crt_tree_ent_put(grp_priv, ent);
+		return rc;
 	}
 
+	*result = ent;
+	return 0;
+
 out:
-	if (rc == 0)
-		*result_grp_rank_list = grp_rank_list;
+	d_rank_list_free(grp_rank_list);
+	d_rank_list_free(filter);
 	return rc;
 }
 
@@ -108,9 +313,8 @@ crt_tree_get_nchildren(struct crt_grp_priv *grp_priv, uint32_t grp_ver,
 		       d_rank_list_t *exclude_ranks, int tree_topo,
 		       d_rank_t root, d_rank_t self, uint32_t *nchildren)
 {
-	d_rank_list_t		*grp_rank_list = NULL;
+	struct crt_tree_ent	*ent = NULL;
 	d_rank_t		 grp_root, grp_self;
-	bool			 allocated = false;
 	uint32_t		 tree_type, tree_ratio;
 	uint32_t		 grp_size;
 	struct crt_topo_ops	*tops;
@@ -132,14 +336,14 @@ crt_tree_get_nchildren(struct crt_grp_priv *grp_priv, uint32_t grp_ver,
 					    false /* filter_invert */,
 					    exclude_ranks, root, self,
 					    &grp_size, &grp_root, &grp_self,
-					    &grp_rank_list, &allocated);
+					    &ent);
 	if (rc != 0) {
 		D_ERROR("crt_get_filtered_grp_rank_list(group %s, root %d, "
 			"self %d) failed, rc: %d.\n", grp_priv->gp_pub.cg_grpid,
 			root, self, rc);
 		D_GOTO(out, rc);
 	}
-	if (grp_rank_list == NULL) {
+	if (ent == NULL) {
 		D_ERROR("crt_get_filtered_grp_rank_list(group %s) get empty.\n",
 			grp_priv->gp_pub.cg_grpid);
 		D_GOTO(out, rc = -DER_INVAL);
@@ -155,8 +359,8 @@ crt_tree_get_nchildren(struct crt_grp_priv *grp_priv, uint32_t grp_ver,
 
 out:
 	D_RWLOCK_UNLOCK(&grp_priv->gp_rwlock);
-	if (allocated)
-		d_rank_list_free(grp_rank_list);
+	if (ent != NULL)
+		crt_tree_ent_put(grp_priv, ent);
 	return rc;
 }
 
@@ -173,10 +377,9 @@ crt_tree_get_children(struct crt_grp_priv *grp_priv, uint32_t grp_ver,
 		      int tree_topo, d_rank_t root, d_rank_t self,
 		      d_rank_list_t **children_rank_list, bool *ver_match)
 {
-	d_rank_list_t		*grp_rank_list = NULL;
+	struct crt_tree_ent	*ent = NULL;
 	d_rank_list_t		*result_rank_list = NULL;
 	d_rank_t		 grp_root, grp_self;
-	bool			 allocated = false;
 	uint32_t		 tree_type, tree_ratio;
 	uint32_t		 grp_size, nchildren;
 	uint32_t		 *tree_children;
@@ -209,7 +412,7 @@ crt_tree_get_children(struct crt_grp_priv *grp_priv, uint32_t grp_ver,
 	rc = crt_get_filtered_grp_rank_list(grp_priv, grp_ver, filter_invert,
 					    filter_ranks, root, self, &grp_size,
 					    &grp_root, &grp_self,
-					    &grp_rank_list, &allocated);
+					    &ent);
 	if (rc != 0) {
 		D_ERROR("crt_get_filtered_grp_rank_list(group %s, root %d, "
 			"self %d) failed, rc " DF_RC "\n",
@@ -217,7 +420,7 @@ crt_tree_get_children(struct crt_grp_priv *grp_priv, uint32_t grp_ver,
 		D_GOTO(out, rc);
 	}
 
-	if (grp_rank_list == NULL) {
+	if (ent == NULL) {
 		D_DEBUG(DB_TRACE, "crt_get_filtered_grp_rank_list(group %s) "
 			"get empty.\n", grp_priv->gp_pub.cg_grpid);
 		*children_rank_list = NULL;
@@ -260,15 +463,15 @@ crt_tree_get_children(struct crt_grp_priv *grp_priv, uint32_t grp_ver,
 
 	for (i = 0; i < nchildren; i++)
 		result_rank_list->rl_ranks[i] =
-			grp_rank_list->rl_ranks[tree_children[i]];
+			ent->te_ranks->rl_ranks[tree_children[i]];
 
 	D_FREE(tree_children);
 	*children_rank_list = result_rank_list;
 
 out:
 	D_RWLOCK_UNLOCK(&grp_priv->gp_rwlock);
-	if (allocated)
-		d_rank_list_free(grp_rank_list);
+	if (ent != NULL)
+		crt_tree_ent_put(grp_priv, ent);
 	return rc;
 }
 
@@ -277,9 +480,8 @@ crt_tree_get_parent(struct crt_grp_priv *grp_priv, uint32_t grp_ver,
 		    d_rank_list_t *exclude_ranks, int tree_topo,
 		    d_rank_t root, d_rank_t self, d_rank_t *parent_rank)
 {
-	d_rank_list_t		*grp_rank_list = NULL;
+	struct crt_tree_ent	*ent = NULL;
 	d_rank_t		 grp_root, grp_self;
-	bool			 allocated = false;
 	uint32_t		 tree_type, tree_ratio;
 	uint32_t		 grp_size, tree_parent;
 	struct crt_topo_ops	*tops;
@@ -301,14 +503,14 @@ crt_tree_get_parent(struct crt_grp_priv *grp_priv, uint32_t grp_ver,
 					    false /* filter_invert */,
 					    exclude_ranks, root, self,
 					    &grp_size, &grp_root, &grp_self,
-					    &grp_rank_list, &allocated);
+					    &ent);
 	if (rc != 0) {
 		D_ERROR("crt_get_filtered_grp_rank_list(group %s, root %d, "
 			"self %d) failed, rc: %d.\n", grp_priv->gp_pub.cg_grpid,
 			root, self, rc);
 		D_GOTO(out, rc);
 	}
-	if (grp_rank_list == NULL) {
+	if (ent == NULL) {
 		D_DEBUG(DB_TRACE, "crt_get_filtered_grp_rank_list(group %s) "
 			"get empty.\n", grp_priv->gp_pub.cg_grpid);
 		D_GOTO(out, rc = -DER_INVAL);
@@ -322,12 +524,12 @@ crt_tree_get_parent(struct crt_grp_priv *grp_priv, uint32_t grp_ver,
 			"rc: %d.\n", grp_priv->gp_pub.cg_grpid, root, self, rc);
 	}
 
-	*parent_rank = grp_rank_list->rl_ranks[tree_parent];
+	*parent_rank = ent->te_ranks->rl_ranks[tree_parent];
 
 out:
 	D_RWLOCK_UNLOCK(&grp_priv->gp_rwlock);
-	if (allocated)
-		d_rank_list_free(grp_rank_list);
+	if (ent != NULL)
+		crt_tree_ent_put(grp_priv, ent);
 	return rc;
 }
 
@@ -11,6 +11,9 @@
 #ifndef __CRT_TREE_H__
 #define __CRT_TREE_H__
 
+int crt_tree_cache_init(struct crt_grp_priv *grp_priv);
+void crt_tree_cache_fini(struct crt_grp_priv *grp_priv);
+
 /*
  * Query specific tree topo's number of children, child rank number, or parent
  * rank number.
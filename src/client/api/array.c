@@ -201,6 +201,48 @@ daos_array_write(daos_handle_t oh, daos_handle_t th, daos_array_iod_t *iod,
 	return dc_task_schedule(task, true);
 }
 
+int
+daos_array_read_strided(daos_handle_t oh, daos_handle_t th, daos_array_siod_t *siod,
+			d_sg_list_t *sgl, daos_event_t *ev)
+{
+	daos_array_io_t	*args;
+	tse_task_t	*task;
+	int		 rc;
+
+	rc = dc_task_create(dc_array_read, NULL, ev, &task);
+	if (rc)
+		return rc;
+
+	args = dc_task_get_args(task);
+	args->oh	= oh;
+	args->th	= th;
+	args->siod	= siod;
+	args->sgl	= sgl;
+
+	return dc_task_schedule(task, true);
+}
+
+int
+daos_array_write_strided(daos_handle_t oh, daos_handle_t th, daos_array_siod_t *siod,
+			 d_sg_list_t *sgl, daos_event_t *ev)
+{
+	daos_array_io_t	*args;
+	tse_task_t	*task;
+	int		 rc;
+
+	rc = dc_task_create(dc_array_write, NULL, ev, &task);
+	if (rc)
+		return rc;
+
+	args = dc_task_get_args(task);
+	args->oh	= oh;
+	args->th	= th;
+	args->siod	= siod;
+	args->sgl	= sgl;
+
+	return dc_task_schedule(task, true);
+}
+
 int
 daos_array_punch(daos_handle_t oh, daos_handle_t th,
 		 daos_array_iod_t *iod, daos_event_t *ev)
@@ -97,6 +97,32 @@ daos_kv_put(daos_handle_t oh, daos_handle_t th, uint64_t flags, const char *key,
 	return dc_task_schedule(task, true);
 }
 
+int
+daos_kv_put_multi(daos_handle_t oh, daos_handle_t th, uint64_t flags, uint32_t nr,
+		  const char **keys, daos_size_t *sizes, const void **bufs, int *rcs,
+		  daos_event_t *ev)
+{
+	daos_kv_put_multi_t	*args;
+	tse_task_t		*task;
+	int			 rc;
+
+	rc = dc_task_create(dc_kv_put_multi, NULL, ev, &task);
+	if (rc)
+		return rc;
+
+	args = dc_task_get_args(task);
+	args->oh	= oh;
+	args->th	= th;
+	args->flags	= flags;
+	args->nr	= nr;
+	args->keys	= keys;
+	args->buf_sizes	= sizes;
+	args->bufs	= bufs;
+	args->rcs	= rcs;
+
+	return dc_task_schedule(task, true);
+}
+
 int
 daos_kv_get(daos_handle_t oh, daos_handle_t th, uint64_t flags, const char *key,
 	    daos_size_t *buf_size, void *buf, daos_event_t *ev)
@@ -1004,8 +1004,75 @@ dc_array_update_chunk_size(daos_handle_t oh, daos_size_t chunk_size)
 	return 0;
 }
 
+/*
+ * Ranges of an array IO: either the list of a daos_array_iod_t, or the blocks of a strided
+ * descriptor that are computed one at a time and never materialized as a list.
+ */
+struct io_rgs {
+	daos_array_iod_t	*ir_iod;
+	daos_array_siod_t	*ir_siod;
+	/** number of ranges */
+	daos_size_t		 ir_nr;
+};
+
+static int
+io_rgs_init(struct io_rgs *rgs, daos_array_io_t *args)
+{
+	daos_array_siod_t *siod = args->siod;
+
+	rgs->ir_iod  = args->iod;
+	rgs->ir_siod = siod;
+
+	if (siod == NULL) {
+		if (args->iod == NULL)
+			return -DER_INVAL;
+		rgs->ir_nr = args->iod->arr_nr;
+		return 0;
+	}
+
+	rgs->ir_nr = siod->arr_count;
+	if (siod->arr_count <= 1 || siod->arr_len == 0)
+		return 0;
+
+	/** blocks must not overlap, and the last one must not wrap around */
+	if (siod->arr_stride < siod->arr_len ||
+	    (siod->arr_count - 1) > (UINT64_MAX - siod->arr_idx - siod->arr_len) /
+	    siod->arr_stride) {
+		D_ERROR("Invalid strided iod: idx " DF_U64 ", len %zu, stride %zu, count %zu\n",
+			siod->arr_idx, siod->arr_len, siod->arr_stride, siod->arr_count);
+		return -DER_INVAL;
+	}
+	return 0;
+}
+
+static inline void
+io_rgs_get(struct io_rgs *rgs, daos_size_t u, daos_off_t *idx, daos_size_t *len)
+{
+	D_ASSERT(u < rgs->ir_nr);
+
+	if (rgs->ir_siod != NULL) {
+		*idx = rgs->ir_siod->arr_idx + u * rgs->ir_siod->arr_stride;
+		*len = rgs->ir_siod->arr_len;
+	} else {
+		*idx = rgs->ir_iod->arr_rgs[u].rg_idx;
+		*len = rgs->ir_iod->arr_rgs[u].rg_len;
+	}
+}
+
+static inline void
+io_rgs_set_read(struct io_rgs *rgs, daos_size_t nr_read, daos_size_t nr_short_read)
+{
+	if (rgs->ir_siod != NULL) {
+		rgs->ir_siod->arr_nr_read       = nr_read;
+		rgs->ir_siod->arr_nr_short_read = nr_short_read;
+	} else {
+		rgs->ir_iod->arr_nr_read       = nr_read;
+		rgs->ir_iod->arr_nr_short_read = nr_short_read;
+	}
+}
+
 static bool
-io_extent_same(daos_array_iod_t *iod, d_sg_list_t *sgl, daos_size_t cell_size,
+io_extent_same(struct io_rgs *rgs, d_sg_list_t *sgl, daos_size_t cell_size,
 	       daos_size_t *num_records)
 {
 	daos_size_t rgs_len;
@@ -1014,8 +1081,11 @@ io_extent_same(daos_array_iod_t *iod, d_sg_list_t *sgl, daos_size_t cell_size,
 
 	rgs_len = 0;
 
-	for (u = 0 ; u < iod->arr_nr ; u++)
-		rgs_len += iod->arr_rgs[u].rg_len;
+	if (rgs->ir_siod != NULL)
+		rgs_len = rgs->ir_siod->arr_len * rgs->ir_siod->arr_count;
+	else
+		for (u = 0 ; u < rgs->ir_nr ; u++)
+			rgs_len += rgs->ir_iod->arr_rgs[u].rg_len;
 	*num_records = rgs_len;
 
 	sgl_len = 0;
@@ -1266,7 +1336,10 @@ set_short_read_cb(tse_task_t *task, void *data)
 {
 	struct hole_params	*params = daos_task_get_priv(task);
 	daos_array_io_t		*args;
-	int			i;
+	struct io_rgs		rgs;
+	daos_size_t		nr_read = 0;
+	daos_size_t		nr_short_read = 0;
+	daos_size_t		i;
 	int			rc = task->dt_result;
 
 	D_ASSERT(params != NULL);
@@ -1280,23 +1353,24 @@ set_short_read_cb(tse_task_t *task, void *data)
 	D_ASSERT(args);
 
 	/** adjust the read_nr based on the array size */
-	args->iod->arr_nr_short_read = 0;
-	args->iod->arr_nr_read = 0;
+	rc = io_rgs_init(&rgs, args);
+	D_ASSERT(rc == 0);
 
-	for (i = 0; i < args->iod->arr_nr; i++) {
-		daos_off_t idx = args->iod->arr_rgs[i].rg_idx;
-		daos_size_t len = args->iod->arr_rgs[i].rg_len;
+	for (i = 0; i < rgs.ir_nr; i++) {
+		daos_off_t idx;
+		daos_size_t len;
 
+		io_rgs_get(&rgs, i, &idx, &len);
 		if (params->array_size < idx) {
-			args->iod->arr_nr_short_read += len;
+			nr_short_read += len;
 		} else if (params->array_size >= idx + len) {
-			args->iod->arr_nr_read += len;
+			nr_read += len;
 		} else {
-			args->iod->arr_nr_read += params->array_size - idx;
-			args->iod->arr_nr_short_read += idx + len -
-				params->array_size;
+			nr_read += params->array_size - idx;
+			nr_short_read += idx + len - params->array_size;
 		}
 	}
+	io_rgs_set_read(&rgs, nr_read, nr_short_read);
 
 	/** memset holes to 0 */
 	rc = process_iomap(params, args);
@@ -1310,6 +1384,7 @@ check_short_read_cb(tse_task_t *task, void *data)
 {
 	struct hole_params	*params = daos_task_get_priv(task);
 	daos_array_io_t		*args;
+	struct io_rgs		rgs;
 	struct io_params	*io_list;
 	struct io_params	*current;
 	uint64_t		dkey_val;
@@ -1397,8 +1472,9 @@ next:
 		current = current->next;
 	}
 
-	args->iod->arr_nr_short_read = nr_short_recs;
-	args->iod->arr_nr_read = total_recs - nr_short_recs;
+	rc = io_rgs_init(&rgs, args);
+	D_ASSERT(rc == 0);
+	io_rgs_set_read(&rgs, total_recs - nr_short_recs, nr_short_recs);
 
 	/** no possible short read, do not schedule the get_size */
 	if (nr_short_recs == 0) {
@@ -1429,17 +1505,18 @@ out:
 }
 
 static int
-dc_array_io(daos_handle_t array_oh, daos_handle_t th,
-	    daos_array_iod_t *rg_iod, d_sg_list_t *user_sgl,
-	    daos_opc_t op_type, tse_task_t *task)
+dc_array_io(daos_handle_t array_oh, daos_handle_t th, daos_array_io_t *args,
+	    d_sg_list_t *user_sgl, daos_opc_t op_type, tse_task_t *task)
 {
+	struct io_rgs	rgs;
 	struct dc_array *array = NULL;
 	daos_handle_t	oh;
 	daos_off_t	cur_off; /* offset into user buf to track current pos */
 	daos_size_t	cur_i; /* index into user sgl to track current pos */
 	daos_size_t	records; /* Number of records to access in cur range */
+	daos_size_t	first_records; /* Number of records in the first range */
 	daos_off_t	array_idx; /* object array index of current range */
-	daos_size_t	u; /* index in the array range rg_iod->arr_nr*/
+	daos_size_t	u; /* index in the array ranges rgs.ir_nr */
 	daos_size_t	num_records;
 	daos_off_t	record_i;
 	struct io_params *head = NULL;
@@ -1450,38 +1527,43 @@ dc_array_io(daos_handle_t array_oh, daos_handle_t th,
 	tse_task_t	*stask; /* task for short read and hole mgmt */
 	int		rc;
 
-	if (rg_iod == NULL) {
-		D_ERROR("NULL iod passed\n");
-		D_GOTO(err_task, rc = -DER_INVAL);
+	rc = io_rgs_init(&rgs, args);
+	if (rc) {
+		D_ERROR("NULL or invalid iod passed\n");
+		D_GOTO(err_task, rc);
 	}
 
 	/*
 	 * If we are above the limit, check for small recx size. Just a best effort check for
 	 * extreme cases to reject.
 	 */
-	if (rg_iod->arr_nr > array_list_io_limit) {
+	if (rgs.ir_nr > array_list_io_limit) {
 		daos_size_t i;
 		daos_size_t tiny_count = 0;
+		daos_off_t  idx;
+		daos_size_t len;
 
 		/* quick shortcut check */
-		for (i = 0; i < rg_iod->arr_nr; i = i * 2) {
-			if (rg_iod->arr_rgs[i].rg_len > DAOS_ARRAY_RG_LEN_THD)
+		for (i = 0; i < rgs.ir_nr; i = i * 2) {
+			io_rgs_get(&rgs, i, &idx, &len);
+			if (len > DAOS_ARRAY_RG_LEN_THD)
 				break;
 			if (i == 0)
 				i++;
 		}
 
 		/** Full check if quick check fails */
-		if (i >= rg_iod->arr_nr) {
-			for (i = 0; i < rg_iod->arr_nr; i++) {
-				if (rg_iod->arr_rgs[i].rg_len <= DAOS_ARRAY_RG_LEN_THD)
+		if (i >= rgs.ir_nr) {
+			for (i = 0; i < rgs.ir_nr; i++) {
+				io_rgs_get(&rgs, i, &idx, &len);
+				if (len <= DAOS_ARRAY_RG_LEN_THD)
 					tiny_count++;
 				if (tiny_count > array_list_io_limit)
 					break;
 			}
 			if (tiny_count > array_list_io_limit) {
 				D_ERROR("List io supports a max of %u offsets (using %zu)",
-					array_list_io_limit, rg_iod->arr_nr);
+					array_list_io_limit, rgs.ir_nr);
 				D_GOTO(err_task, rc = -DER_NOTSUPPORTED);
 			}
 		}
@@ -1498,7 +1580,7 @@ dc_array_io(daos_handle_t array_oh, daos_handle_t th,
 	} else if (user_sgl == NULL) {
 		D_ERROR("NULL scatter-gather list passed\n");
 		D_GOTO(err_task, rc = -DER_INVAL);
-	} else if (!io_extent_same(rg_iod, user_sgl, array->cell_size, &tot_num_records)) {
+	} else if (!io_extent_same(&rgs, user_sgl, array->cell_size, &tot_num_records)) {
 		rc = -DER_INVAL;
 		D_ERROR("Unequal extents of memory and array descriptors: " DF_RC "\n", DP_RC(rc));
 		D_GOTO(err_task, rc);
@@ -1510,8 +1592,11 @@ dc_array_io(daos_handle_t array_oh, daos_handle_t th,
 	cur_i = 0;
 	u = 0;
 	num_ios = 0;
-	records = rg_iod->arr_rgs[0].rg_len;
-	array_idx = rg_iod->arr_rgs[0].rg_idx;
+	records = 0;
+	array_idx = 0;
+	if (rgs.ir_nr > 0)
+		io_rgs_get(&rgs, 0, &array_idx, &records);
+	first_records = records;
 
 	head = NULL;
 	D_INIT_LIST_HEAD(&io_task_list);
@@ -1536,7 +1621,7 @@ dc_array_io(daos_handle_t array_oh, daos_handle_t th,
 	 * are not increasing in offset, they probably won't be combined unless
 	 * the separating ranges also belong to the same dkey.
 	 */
-	while (u < rg_iod->arr_nr) {
+	while (u < rgs.ir_nr) {
 		daos_iod_t	*iod;
 		daos_iom_t	*iom;
 		d_sg_list_t	*sgl;
@@ -1546,14 +1631,13 @@ dc_array_io(daos_handle_t array_oh, daos_handle_t th,
 		tse_task_t	*io_task = NULL;
 		struct io_params *params;
 		daos_size_t	i; /* index for iod recx */
+		daos_size_t	recx_cap; /* allocated entries in iod recxs */
 
 		/** In some cases, users can pass an empty range, so skip it. */
-		if (rg_iod->arr_rgs[u].rg_len == 0) {
+		if (records == 0) {
 			u++;
-			if (u < rg_iod->arr_nr) {
-				records = rg_iod->arr_rgs[u].rg_len;
-				array_idx = rg_iod->arr_rgs[u].rg_idx;
-			}
+			if (u < rgs.ir_nr)
+				io_rgs_get(&rgs, u, &array_idx, &records);
 			continue;
 		}
 
@@ -1633,6 +1717,7 @@ dc_array_io(daos_handle_t array_oh, daos_handle_t th,
 		iom->iom_nr	= 0;
 
 		i = 0;
+		recx_cap = 0;
 		dkey_records = 0;
 
 		/*
@@ -1644,13 +1729,20 @@ dc_array_io(daos_handle_t array_oh, daos_handle_t th,
 			daos_off_t	old_array_idx;
 			daos_recx_t	*new_recxs;
 
-			/** add another element to recxs */
-			D_REALLOC_ARRAY(new_recxs, iod->iod_recxs, iod->iod_nr, iod->iod_nr + 1);
-			if (new_recxs == NULL)
-				D_GOTO(err_iotask, rc = -DER_NOMEM);
-
+			/*
+			 * add another element to recxs, growing the array geometrically since a
+			 * list or strided IO can map thousands of small ranges to one dkey.
+			 */
+			if (iod->iod_nr == recx_cap) {
+				daos_size_t new_cap = recx_cap == 0 ? 4 : recx_cap * 2;
+
+				D_REALLOC_ARRAY(new_recxs, iod->iod_recxs, recx_cap, new_cap);
+				if (new_recxs == NULL)
+					D_GOTO(err_iotask, rc = -DER_NOMEM);
+				iod->iod_recxs = new_recxs;
+				recx_cap = new_cap;
+			}
 			iod->iod_nr++;
-			iod->iod_recxs = new_recxs;
 
 			/** set the record access for this range */
 			iod->iod_recxs[i].rx_idx = record_i;
@@ -1677,12 +1769,11 @@ dc_array_io(daos_handle_t array_oh, daos_handle_t th,
 			dkey_records += records;
 
 			/** if there are no more ranges to write, then break */
-			if (rg_iod->arr_nr <= u)
+			if (rgs.ir_nr <= u)
 				break;
 
 			old_array_idx = array_idx;
-			records = rg_iod->arr_rgs[u].rg_len;
-			array_idx = rg_iod->arr_rgs[u].rg_idx;
+			io_rgs_get(&rgs, u, &array_idx, &records);
 
 			/*
 			 * Boundary case where number of records align with the end boundary of the
@@ -1718,8 +1809,7 @@ dc_array_io(daos_handle_t array_oh, daos_handle_t th,
 		 * if the user sgl maps directly to the array range, no need to partition it.
 		 */
 		if ((op_type == DAOS_OPC_ARRAY_PUNCH) ||
-		    (1 == rg_iod->arr_nr && 1 == user_sgl->sg_nr &&
-		     dkey_records == rg_iod->arr_rgs[0].rg_len)) {
+		    (1 == rgs.ir_nr && 1 == user_sgl->sg_nr && dkey_records == first_records)) {
 			sgl = user_sgl;
 			params->user_sgl_used = true;
 		}
@@ -1865,8 +1955,7 @@ dc_array_read(tse_task_t *task)
 {
 	daos_array_io_t *args = daos_task_get_args(task);
 
-	return dc_array_io(args->oh, args->th, args->iod, args->sgl,
-			   DAOS_OPC_ARRAY_READ, task);
+	return dc_array_io(args->oh, args->th, args, args->sgl, DAOS_OPC_ARRAY_READ, task);
 }
 
 int
@@ -1874,8 +1963,7 @@ dc_array_write(tse_task_t *task)
 {
 	daos_array_io_t *args = daos_task_get_args(task);
 
-	return dc_array_io(args->oh, args->th, args->iod, args->sgl,
-			   DAOS_OPC_ARRAY_WRITE, task);
+	return dc_array_io(args->oh, args->th, args, args->sgl, DAOS_OPC_ARRAY_WRITE, task);
 }
 
 int
@@ -1883,8 +1971,7 @@ dc_array_punch(tse_task_t *task)
 {
 	daos_array_io_t *args = daos_task_get_args(task);
 
-	return dc_array_io(args->oh, args->th, args->iod, NULL,
-			   DAOS_OPC_ARRAY_PUNCH, task);
+	return dc_array_io(args->oh, args->th, args, NULL, DAOS_OPC_ARRAY_PUNCH, task);
 }
 
 #define ENUM_DESC_BUF    512
@@ -291,6 +291,28 @@ out:
 	return rc;
 }
 
+void
+decode_entry(const char *buf, daos_size_t len, struct dfs_entry *entry)
+{
+	char value[END_IDX] = {0};
+
+	/** same layout as the iovs of fetch_entry(), a short value leaves the tail zeroed */
+	memcpy(value, buf, min(len, END_IDX));
+	memcpy(&entry->mode, &value[MODE_IDX], sizeof(mode_t));
+	memcpy(&entry->oid, &value[OID_IDX], sizeof(daos_obj_id_t));
+	memcpy(&entry->mtime, &value[MTIME_IDX], sizeof(uint64_t));
+	memcpy(&entry->ctime, &value[CTIME_IDX], sizeof(uint64_t));
+	memcpy(&entry->chunk_size, &value[CSIZE_IDX], sizeof(daos_size_t));
+	memcpy(&entry->oclass, &value[OCLASS_IDX], sizeof(daos_oclass_id_t));
+	memcpy(&entry->mtime_nano, &value[MTIME_NSEC_IDX], sizeof(uint64_t));
+	memcpy(&entry->ctime_nano, &value[CTIME_NSEC_IDX], sizeof(uint64_t));
+	memcpy(&entry->uid, &value[UID_IDX], sizeof(uid_t));
+	memcpy(&entry->gid, &value[GID_IDX], sizeof(gid_t));
+	memcpy(&entry->value_len, &value[SIZE_IDX], sizeof(daos_size_t));
+	memcpy(&entry->obj_hlc, &value[HLC_IDX], sizeof(uint64_t));
+	entry->value = NULL;
+}
+
 int
 remove_entry(dfs_t *dfs, daos_handle_t th, daos_handle_t parent_oh, const char *name, size_t len,
 	     struct dfs_entry entry)
@@ -500,7 +522,6 @@ entry_stat(dfs_t *dfs, daos_handle_t th, daos_handle_t oh, const char *name, siz
 {
 	struct dfs_entry entry = {0};
 	bool             exists;
-	daos_size_t      size;
 	int              rc;
 
 	memset(stbuf, 0, sizeof(struct stat));
@@ -517,6 +538,19 @@ entry_stat(dfs_t *dfs, daos_handle_t th, daos_handle_t oh, const char *name, siz
 	if (obj && (obj->oid.hi != entry.oid.hi || obj->oid.lo != entry.oid.lo))
 		return ENOENT;
 
+	return entry_stat_inode(dfs, th, &entry, obj, get_size, stbuf, obj_hlc);
+}
+
+int
+entry_stat_inode(dfs_t *dfs, daos_handle_t th, struct dfs_entry *ent, struct dfs_obj *obj,
+		 bool get_size, struct stat *stbuf, uint64_t *obj_hlc)
+{
+	struct dfs_entry entry = *ent;
+	daos_size_t      size;
+	int              rc;
+
+	memset(stbuf, 0, sizeof(struct stat));
+
 	switch (entry.mode & S_IFMT) {
 	case S_IFDIR: {
 		daos_handle_t dir_oh;
@@ -410,6 +410,8 @@ int
 fetch_entry(dfs_layout_ver_t ver, daos_handle_t oh, daos_handle_t th, const char *name, size_t len,
 	    bool fetch_sym, bool *exists, struct dfs_entry *entry, int xnr, char *xnames[],
 	    void *xvals[], daos_size_t *xsizes);
+void
+decode_entry(const char *buf, daos_size_t len, struct dfs_entry *entry);
 int
 remove_entry(dfs_t *dfs, daos_handle_t th, daos_handle_t parent_oh, const char *name, size_t len,
 	     struct dfs_entry entry);
@@ -422,6 +424,9 @@ int
 entry_stat(dfs_t *dfs, daos_handle_t th, daos_handle_t oh, const char *name, size_t len,
 	   struct dfs_obj *obj, bool get_size, struct stat *stbuf, uint64_t *obj_hlc);
 int
+entry_stat_inode(dfs_t *dfs, daos_handle_t th, struct dfs_entry *entry, struct dfs_obj *obj,
+		 bool get_size, struct stat *stbuf, uint64_t *obj_hlc);
+int
 get_num_entries(daos_handle_t oh, daos_handle_t th, uint32_t *nr, bool check_empty);
 int
 update_stbuf_times(struct dfs_entry entry, daos_epoch_t max_epoch, struct stat *stbuf,
@@ -38,6 +38,8 @@ static int
 read_cb(tse_task_t *task, void *data)
 {
 	struct dfs_read_params *params;
+	daos_array_io_t        *args;
+	daos_size_t             nr_read;
 	int                     rc = task->dt_result;
 
 	params = daos_task_get_priv(task);
@@ -48,17 +50,20 @@ read_cb(tse_task_t *task, void *data)
 		D_GOTO(out, rc);
 	}
 
+	args    = dc_task_get_args(task);
+	nr_read = args->siod ? args->siod->arr_nr_read : params->arr_iod.arr_nr_read;
+
 	DFS_OP_STAT_INCR(params->dfs, DOS_READ);
-	dfs_update_file_metrics(params->dfs, params->arr_iod.arr_nr_read, 0);
-	*params->read_size = params->arr_iod.arr_nr_read;
+	dfs_update_file_metrics(params->dfs, nr_read, 0);
+	*params->read_size = nr_read;
 out:
 	D_FREE(params);
 	return rc;
 }
 
 static int
-dfs_read_int(dfs_t *dfs, dfs_obj_t *obj, daos_off_t off, dfs_iod_t *iod, d_sg_list_t *sgl,
-	     daos_size_t buf_size, daos_size_t *read_size, daos_event_t *ev)
+dfs_read_int(dfs_t *dfs, dfs_obj_t *obj, daos_off_t off, dfs_iod_t *iod, daos_array_siod_t *siod,
+	     d_sg_list_t *sgl, daos_size_t buf_size, daos_size_t *read_size, daos_event_t *ev)
 {
 	tse_task_t             *task = NULL;
 	daos_array_io_t        *args;
@@ -80,7 +85,9 @@ dfs_read_int(dfs_t *dfs, dfs_obj_t *obj, daos_off_t off, dfs_iod_t *iod, d_sg_li
 	params->read_size = read_size;
 
 	/** set array location */
-	if (iod == NULL) {
+	if (siod != NULL) {
+		params->arr_iod.arr_nr  = 0;
+	} else if (iod == NULL) {
 		params->arr_iod.arr_nr  = 1;
 		params->rg.rg_len       = buf_size;
 		params->rg.rg_idx       = off;
@@ -93,8 +100,9 @@ dfs_read_int(dfs_t *dfs, dfs_obj_t *obj, daos_off_t off, dfs_iod_t *iod, d_sg_li
 	args      = dc_task_get_args(task);
 	args->oh  = obj->oh;
 	args->th  = dfs->th;
-	args->sgl = sgl;
-	args->iod = &params->arr_iod;
+	args->sgl  = sgl;
+	args->iod  = &params->arr_iod;
+	args->siod = siod;
 
 	daos_task_set_priv(task, params);
 	rc = tse_task_register_cbs(task, NULL, NULL, 0, read_cb, NULL, 0);
@@ -170,7 +178,7 @@ dfs_read(dfs_t *dfs, dfs_obj_t *obj, d_sg_list_t *sgl, daos_off_t off, daos_size
 		return 0;
 	}
 
-	return dfs_read_int(dfs, obj, off, NULL, sgl, buf_size, read_size, ev);
+	return dfs_read_int(dfs, obj, off, NULL, NULL, sgl, buf_size, read_size, ev);
 }
 
 int
@@ -216,7 +224,51 @@ dfs_readx(dfs_t *dfs, dfs_obj_t *obj, dfs_iod_t *iod, d_sg_list_t *sgl, daos_siz
 		return 0;
 	}
 
-	return dfs_read_int(dfs, obj, 0, iod, sgl, 0, read_size, ev);
+	return dfs_read_int(dfs, obj, 0, iod, NULL, sgl, 0, read_size, ev);
+}
+
+int
+dfs_read_strided(dfs_t *dfs, dfs_obj_t *obj, daos_array_siod_t *siod, d_sg_list_t *sgl,
+		 daos_size_t *read_size, daos_event_t *ev)
+{
+	int rc;
+
+	if (dfs == NULL || !dfs->mounted)
+		return EINVAL;
+	if (obj == NULL || !S_ISREG(obj->mode))
+		return EINVAL;
+	if (siod == NULL || read_size == NULL)
+		return EINVAL;
+	if ((obj->flags & O_ACCMODE) == O_WRONLY)
+		return EPERM;
+
+	if (siod->arr_count == 0 || siod->arr_len == 0) {
+		*read_size = 0;
+		if (ev) {
+			daos_event_launch(ev);
+			daos_event_complete(ev, 0);
+		}
+		DFS_OP_STAT_INCR(dfs, DOS_READ);
+		return 0;
+	}
+
+	D_DEBUG(DB_TRACE, "DFS Read strided: Off %" PRIu64 ", Len %zu, Stride %zu, Count %zu\n",
+		siod->arr_idx, siod->arr_len, siod->arr_stride, siod->arr_count);
+
+	if (ev == NULL) {
+		rc = daos_array_read_strided(obj->oh, dfs->th, siod, sgl, NULL);
+		if (rc) {
+			D_ERROR("daos_array_read_strided() failed, " DF_RC "\n", DP_RC(rc));
+			return daos_der2errno(rc);
+		}
+
+		DFS_OP_STAT_INCR(dfs, DOS_READ);
+		*read_size = siod->arr_nr_read;
+		dfs_update_file_metrics(dfs, siod->arr_nr_read, 0);
+		return 0;
+	}
+
+	return dfs_read_int(dfs, obj, 0, NULL, siod, sgl, 0, read_size, ev);
 }
 
 int
@@ -322,3 +374,46 @@ dfs_writex(dfs_t *dfs, dfs_obj_t *obj, dfs_iod_t *iod, d_sg_list_t *sgl, daos_ev
 
 	return daos_der2errno(rc);
 }
+
+int
+dfs_write_strided(dfs_t *dfs, dfs_obj_t *obj, daos_array_siod_t *siod, d_sg_list_t *sgl,
+		  daos_event_t *ev)
+{
+	int rc;
+
+	if (dfs == NULL || !dfs->mounted)
+		return EINVAL;
+	if (dfs->amode != O_RDWR)
+		return EPERM;
+	if (obj == NULL || !S_ISREG(obj->mode))
+		return EINVAL;
+	if ((obj->flags & O_ACCMODE) == O_RDONLY)
+		return EPERM;
+	if (siod == NULL)
+		return EINVAL;
+
+	if (siod->arr_count == 0 || siod->arr_len == 0) {
+		if (ev) {
+			daos_event_launch(ev);
+			daos_event_complete(ev, 0);
+		}
+		DFS_OP_STAT_INCR(dfs, DOS_WRITE);
+		return 0;
+	}
+
+	D_DEBUG(DB_TRACE, "DFS Write strided: Off %" PRIu64 ", Len %zu, Stride %zu, Count %zu\n",
+		siod->arr_idx, siod->arr_len, siod->arr_stride, siod->arr_count);
+
+	if (ev)
+		daos_event_errno_rc(ev);
+
+	rc = daos_array_write_strided(obj->oh, DAOS_TX_NONE, siod, sgl, ev);
+	if (rc == 0) {
+		DFS_OP_STAT_INCR(dfs, DOS_WRITE);
+		dfs_update_file_metrics(dfs, 0, siod->arr_len * siod->arr_count);
+	} else {
+		D_ERROR("daos_array_write_strided() failed, " DF_RC "\n", DP_RC(rc));
+	}
+
+	return daos_der2errno(rc);
+}
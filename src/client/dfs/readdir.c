@@ -9,9 +9,43 @@
 #define D_LOGFAC DD_FAC(dfs)
 
 #include <daos/common.h>
+#include <daos/event.h>
+#include <daos/object.h>
+#include <daos/task.h>
 
 #include "dfs_internal.h"
 
+/**
+ * List the entries of a directory, with their inode value when \a with_inode is set. Then each
+ * entry may take two kds, see dc_obj_list_dkey_inline_task_create().
+ */
+static int
+list_entries(dfs_t *dfs, dfs_obj_t *obj, bool with_inode, uint32_t *nr, daos_key_desc_t *kds,
+	     d_sg_list_t *sgl, daos_anchor_t *anchor)
+{
+	daos_key_t  akey;
+	tse_task_t *task;
+	int         rc;
+
+	if (!with_inode)
+		return daos_obj_list_dkey(obj->oh, dfs->th, nr, kds, sgl, anchor, NULL);
+
+	d_iov_set(&akey, INODE_AKEY_NAME, sizeof(INODE_AKEY_NAME) - 1);
+	rc = dc_obj_list_dkey_inline_task_create(obj->oh, dfs->th, &akey, DAOS_IOD_ARRAY, nr, kds,
+						 sgl, anchor, NULL, NULL, &task);
+	if (rc)
+		return rc;
+
+	return dc_task_schedule(task, true);
+}
+
+/** Is the entry at \a idx followed by its inode value? */
+static inline bool
+entry_has_inode(daos_key_desc_t *kds, uint32_t idx, uint32_t number)
+{
+	return idx + 1 < number && kds[idx + 1].kd_val_type == OBJ_ITER_INLINE_VAL;
+}
+
 int
 readdir_int(dfs_t *dfs, dfs_obj_t *obj, daos_anchor_t *anchor, uint32_t *nr, struct dirent *dirs,
 	    struct stat *stbufs)
@@ -19,6 +53,8 @@ readdir_int(dfs_t *dfs, dfs_obj_t *obj, daos_anchor_t *anchor, uint32_t *nr, str
 	daos_key_desc_t *kds;
 	char            *enum_buf;
 	uint32_t         number, key_nr, i;
+	uint32_t         kds_per_entry = stbufs ? 2 : 1;
+	size_t           entry_size    = DFS_MAX_NAME + (stbufs ? END_IDX : 0);
 	d_sg_list_t      sgl;
 	int              rc = 0;
 
@@ -31,30 +67,31 @@ readdir_int(dfs_t *dfs, dfs_obj_t *obj, daos_anchor_t *anchor, uint32_t *nr, str
 	if (dirs == NULL || anchor == NULL)
 		return EINVAL;
 
-	D_ALLOC_ARRAY(kds, *nr);
+	D_ALLOC_ARRAY(kds, *nr * kds_per_entry);
 	if (kds == NULL)
 		return ENOMEM;
 
-	D_ALLOC_ARRAY(enum_buf, *nr * DFS_MAX_NAME);
+	D_ALLOC_ARRAY(enum_buf, *nr * entry_size);
 	if (enum_buf == NULL) {
 		D_FREE(kds);
 		return ENOMEM;
 	}
 
 	key_nr = 0;
-	number = *nr;
+	number = *nr * kds_per_entry;
 	while (!daos_anchor_is_eof(anchor)) {
 		d_iov_t iov;
 		char   *ptr;
 
-		memset(enum_buf, 0, (*nr) * DFS_MAX_NAME);
+		memset(enum_buf, 0, (*nr) * entry_size);
 
 		sgl.sg_nr     = 1;
 		sgl.sg_nr_out = 0;
-		d_iov_set(&iov, enum_buf, (*nr) * DFS_MAX_NAME);
+		d_iov_set(&iov, enum_buf, (*nr) * entry_size);
 		sgl.sg_iovs = &iov;
 
-		rc = daos_obj_list_dkey(obj->oh, dfs->th, &number, kds, &sgl, anchor, NULL);
+		/** the inode of each entry is returned with its name to save a fetch for stat */
+		rc = list_entries(dfs, obj, stbufs != NULL, &number, kds, &sgl, anchor);
 		if (rc)
 			D_GOTO(out, rc = daos_der2errno(rc));
 
@@ -64,19 +101,31 @@ readdir_int(dfs_t *dfs, dfs_obj_t *obj, daos_anchor_t *anchor, uint32_t *nr, str
 			ptr += kds[i].kd_key_len;
 
 			/** stat the entry if requested */
-			if (stbufs) {
-				rc = entry_stat(dfs, dfs->th, obj->oh, dirs[key_nr].d_name,
-						kds[i].kd_key_len, NULL, true, &stbufs[key_nr],
-						NULL);
-				if (rc) {
-					D_ERROR("Failed to stat entry '%s': %d (%s)\n",
-						dirs[key_nr].d_name, rc, strerror(rc));
-					D_GOTO(out, rc);
+			if (stbufs && entry_has_inode(kds, i, number)) {
+				struct dfs_entry entry = {0};
+
+				i++;
+				if (kds[i].kd_key_len == 0) {
+					rc = ENOENT;
+				} else {
+					decode_entry(ptr, kds[i].kd_key_len, &entry);
+					rc = entry_stat_inode(dfs, dfs->th, &entry, NULL, true,
+							      &stbufs[key_nr], NULL);
 				}
+				ptr += kds[i].kd_key_len;
+			} else if (stbufs) {
+				rc = entry_stat(dfs, dfs->th, obj->oh, dirs[key_nr].d_name,
+						strlen(dirs[key_nr].d_name), NULL, true,
+						&stbufs[key_nr], NULL);
+			}
+			if (rc) {
+				D_ERROR("Failed to stat entry '%s': %d (%s)\n",
+					dirs[key_nr].d_name, rc, strerror(rc));
+				D_GOTO(out, rc);
 			}
 			key_nr++;
 		}
-		number = *nr - key_nr;
+		number = (*nr - key_nr) * kds_per_entry;
 		if (number == 0)
 			break;
 	}
@@ -102,14 +151,15 @@ dfs_readdirplus(dfs_t *dfs, dfs_obj_t *obj, daos_anchor_t *anchor, uint32_t *nr,
 	return readdir_int(dfs, obj, anchor, nr, dirs, stbufs);
 }
 
-int
-dfs_iterate(dfs_t *dfs, dfs_obj_t *obj, daos_anchor_t *anchor, uint32_t *nr, size_t size,
-	    dfs_filler_cb_t op, void *udata)
+static int
+iterate_int(dfs_t *dfs, dfs_obj_t *obj, daos_anchor_t *anchor, uint32_t *nr, size_t size,
+	    dfs_filler_cb_t op, dfs_filler_plus_cb_t op_plus, void *udata)
 {
 	daos_key_desc_t *kds;
 	d_sg_list_t      sgl;
 	d_iov_t          iov;
 	uint32_t         num, keys_nr;
+	uint32_t         kds_per_entry = op_plus ? 2 : 1;
 	char            *enum_buf, *ptr;
 	int              rc = 0;
 
@@ -122,12 +172,14 @@ dfs_iterate(dfs_t *dfs, dfs_obj_t *obj, daos_anchor_t *anchor, uint32_t *nr, siz
 	if (anchor == NULL)
 		return EINVAL;
 
-	num = *nr;
+	num = *nr * kds_per_entry;
 	D_ALLOC_ARRAY(kds, num);
 	if (kds == NULL)
 		return ENOMEM;
 
-	/** Allocate a buffer to store the entry keys */
+	/** Allocate a buffer to store the entry keys, and their inode if requested */
+	if (op_plus)
+		size += (size_t)*nr * END_IDX;
 	D_ALLOC_ARRAY(enum_buf, size);
 	if (enum_buf == NULL) {
 		D_FREE(kds);
@@ -148,31 +200,65 @@ dfs_iterate(dfs_t *dfs, dfs_obj_t *obj, daos_anchor_t *anchor, uint32_t *nr, siz
 		 * list num or less entries, but not more than we can fit in
 		 * enum_buf
 		 */
-		rc = daos_obj_list_dkey(obj->oh, dfs->th, &num, kds, &sgl, anchor, NULL);
+		rc = list_entries(dfs, obj, op_plus != NULL, &num, kds, &sgl, anchor);
 		if (rc)
 			D_GOTO(out, rc = daos_der2errno(rc));
 
 		/** for every entry, issue the filler cb */
 		for (i = 0; i < num; i++) {
+			size_t name_len = kds[i].kd_key_len;
+			char  *name     = ptr;
+
+			/** advance pointer to next entry */
+			ptr += name_len;
+			/** adjust size of buffer data remaining */
+			size -= name_len;
+			keys_nr++;
+
 			if (op) {
 				char term_char;
 
-				term_char              = ptr[kds[i].kd_key_len];
-				ptr[kds[i].kd_key_len] = '\0';
-				rc                     = op(dfs, obj, ptr, udata);
+				term_char      = name[name_len];
+				name[name_len] = '\0';
+				rc             = op(dfs, obj, name, udata);
 				if (rc)
 					D_GOTO(out, rc);
 
-				ptr[kds[i].kd_key_len] = term_char;
-			}
+				name[name_len] = term_char;
+			} else if (op_plus) {
+				struct dfs_entry entry  = {0};
+				char             term_char;
+				bool             exists = true;
 
-			/** advance pointer to next entry */
-			ptr += kds[i].kd_key_len;
-			/** adjust size of buffer data remaining */
-			size -= kds[i].kd_key_len;
-			keys_nr++;
+				if (entry_has_inode(kds, i, num)) {
+					i++;
+					exists = kds[i].kd_key_len != 0;
+					if (exists)
+						decode_entry(ptr, kds[i].kd_key_len, &entry);
+					ptr += kds[i].kd_key_len;
+					size -= kds[i].kd_key_len;
+				}
+
+				term_char      = name[name_len];
+				name[name_len] = '\0';
+				if (exists && entry.mode == 0) {
+					/** not returned inline, fetch it */
+					rc = fetch_entry(dfs->layout_v, obj->oh, dfs->th, name,
+							 name_len, false, &exists, &entry, 0, NULL,
+							 NULL, NULL);
+					if (rc)
+						D_GOTO(out, rc);
+				}
+				/** a zero mode tells the caller that the entry was just removed */
+				rc = op_plus(dfs, obj, name, exists ? entry.mode : 0,
+					     exists ? entry.oid : (daos_obj_id_t){0}, udata);
+				if (rc)
+					D_GOTO(out, rc);
+
+				name[name_len] = term_char;
+			}
 		}
-		num = *nr - keys_nr;
+		num = (*nr - keys_nr) * kds_per_entry;
 		/** stop if no more size or entries available to fill */
 		if (size == 0 || num == 0)
 			break;
@@ -187,3 +273,20 @@ out:
 	D_FREE(enum_buf);
 	return rc;
 }
+
+int
+dfs_iterate(dfs_t *dfs, dfs_obj_t *obj, daos_anchor_t *anchor, uint32_t *nr, size_t size,
+	    dfs_filler_cb_t op, void *udata)
+{
+	return iterate_int(dfs, obj, anchor, nr, size, op, NULL, udata);
+}
+
+int
+dfs_iterate_plus(dfs_t *dfs, dfs_obj_t *obj, daos_anchor_t *anchor, uint32_t *nr, size_t size,
+		 dfs_filler_plus_cb_t op, void *udata)
+{
+	if (op == NULL)
+		return EINVAL;
+
+	return iterate_int(dfs, obj, anchor, nr, size, NULL, op, udata);
+}
@@ -70,6 +70,16 @@ struct dfuse_info {
 	ATOMIC uint64_t      di_fh_count;
 	ATOMIC uint64_t      di_pool_count;
 	ATOMIC uint64_t      di_container_count;
+
+	/* Memory limit for readahead buckets, and the amount in use */
+	uint64_t             di_ra_max;
+	ATOMIC uint64_t      di_ra_used;
+
+	/* Memory used by write coalescing buffers, and the inodes which have one pending.  The
+	 * list is protected by di_lock.
+	 */
+	ATOMIC uint64_t      di_wc_used;
+	d_list_t             di_wc_list;
 };
 
 struct dfuse_eq {
@@ -97,6 +107,12 @@ struct dfuse_eq {
  * memory consumption */
 #define DFUSE_MAX_PRE_READ (1024 * 1024 * 4)
 
+/* Default memory limit for readahead, see read.c */
+#define DFUSE_READAHEAD_MAX (256 * DFUSE_MAX_READ)
+
+/* Memory limit for write coalescing buffers, see write.c */
+#define DFUSE_WCOALESCE_MAX (64 * DFUSE_MAX_READ)
+
 /* Launch fuse, and do not return until complete */
 int
 dfuse_launch_fuse(struct dfuse_info *dfuse_info, struct fuse_args *args);
@@ -144,6 +160,25 @@ struct dfuse_pre_read {
 	bool                complete;
 };
 
+/* Readahead stream detection for an open handle, see read.c */
+struct dfuse_ra_stream {
+	/* Position and size of the last read */
+	off_t    ras_last;
+	size_t   ras_len;
+	/* Expected position of the next sequential read */
+	off_t    ras_next;
+	/* Distance between the last two reads */
+	off_t    ras_stride;
+	/* End of the readahead issued so far */
+	off_t    ras_issued;
+	uint64_t ras_reads;
+	/* Number of reads following the current pattern */
+	uint32_t ras_confirm;
+	/* Readahead window, in reads or buckets */
+	uint32_t ras_window;
+	int      ras_kind;
+};
+
 /** what is returned as the handle for fuse fuse_file_info on create/open/opendir */
 struct dfuse_obj_hdl {
 	/** pointer to dfs_t */
@@ -180,6 +215,9 @@ struct dfuse_obj_hdl {
 	bool                      doh_linear_read;
 	bool                      doh_linear_read_eof;
 
+	/* Readahead stream, protected by the active inode lock */
+	struct dfuse_ra_stream    doh_ra;
+
 	/** True if caching is enabled for this file. */
 	bool                      doh_caching;
 
@@ -281,6 +319,12 @@ struct dfuse_readdir_entry {
 	 * This could in theory be a boolean.
 	 */
 	off_t dre_next_offset;
+
+	/* Mode and object ID of this directory entry, as returned with the name. A zero mode means
+	 * that the entry was removed during the enumeration.
+	 */
+	mode_t        dre_mode;
+	daos_obj_id_t dre_oid;
 };
 
 /* Readdir entry as saved by the cache.  These are backwards looking from the current position
@@ -475,8 +519,11 @@ struct dfuse_pool {
 	ACTION(RENAME)                                                                             \
 	ACTION(OPEN)                                                                               \
 	ACTION(PRE_READ)                                                                           \
+	ACTION(READAHEAD_HIT)                                                                      \
+	ACTION(READAHEAD_WASTE)                                                                    \
 	ACTION(READ)                                                                               \
 	ACTION(WRITE)                                                                              \
+	ACTION(WRITE_COALESCED)                                                                    \
 	ACTION(STATFS)
 
 #define DFUSE_STAT_DEFINE(name, ...) DS_##name,
@@ -539,6 +586,8 @@ struct dfuse_cont {
 	bool                    dfc_data_otoc;
 	bool                    dfc_direct_io_disable;
 	bool                          dfc_wb_cache;
+	/* Coalesce small contiguous writes, see write.c */
+	bool                    dfc_wcoalesce;
 
 	/* Set to true if the inode was allocated to this structure, so should be kept on close*/
 	bool                    dfc_save_ino;
@@ -1004,6 +1053,23 @@ struct dfuse_inode_entry {
 	 * acquired and released to flush outstanding writes for getattr, close and forget.
 	 */
 	pthread_rwlock_t          ie_wlock;
+
+	/* Write coalescing, see write.c.  The pending buffer is an event from the write slab, it's
+	 * protected by ie_wc_lock and holds a reference on the active inode.
+	 */
+	pthread_mutex_t           ie_wc_lock;
+	struct dfuse_event       *ie_wc_ev;
+	/* Time the pending buffer was started, in seconds */
+	uint64_t                  ie_wc_time;
+	/* First error from a coalesced write, reported on the next flush or fsync */
+	ATOMIC int                ie_wc_err;
+	/* Entry on di_wc_list while a buffer is pending */
+	d_list_t                  ie_wc_entry;
+	/* Range covering the writes made while coalescing which may still be in flight, protected
+	 * by ie_wc_lock.  A write overlapping it waits for them so writes are not reordered.
+	 */
+	off_t                     ie_wc_start;
+	off_t                     ie_wc_end;
 	/** Last file closed in this directory was read linearly.  Directories only.
 	 *
 	 * Set on close() of a file in the directory to the value of linear_read from the fh.
@@ -1035,14 +1101,30 @@ active_oh_decref(struct dfuse_info *dfuse_info, struct dfuse_obj_hdl *oh);
 void
 active_ie_decref(struct dfuse_info *dfuse_info, struct dfuse_inode_entry *ie);
 
-/* Flush write-back cache writes to a inode.  It does this by waiting for and then releasing an
- * exclusive lock on the inode.  Writes take a shared lock so this will block until all pending
- * writes are complete.
+/* Write out the pending coalesced writes of an inode, if any */
+void
+dfuse_wc_flush(struct dfuse_inode_entry *ie);
+
+/* Return, and clear, the first error of the coalesced writes of an inode */
+int
+dfuse_wc_error(struct dfuse_inode_entry *ie);
+
+/* Write out the coalesced writes which have been pending for too long.
+ *
+ * Returns true if there are buffers still pending.
+ */
+bool
+dfuse_wc_expire(struct dfuse_info *dfuse_info);
+
+/* Flush write-back cache writes to a inode.  It does this by writing out any coalesced writes and
+ * then waiting for and releasing an exclusive lock on the inode.  Writes take a shared lock so
+ * this will block until all pending writes are complete.
  */
 
 #define DFUSE_IE_WFLUSH(_ie)                                                                       \
 	do {                                                                                       \
 		if ((_ie)->ie_dfs->dfc_wb_cache && S_ISREG((_ie)->ie_stat.st_mode)) {              \
+			dfuse_wc_flush(_ie);                                                       \
 			D_RWLOCK_WRLOCK(&(_ie)->ie_wlock);                                         \
 			D_RWLOCK_UNLOCK(&(_ie)->ie_wlock);                                         \
 		}                                                                                  \
@@ -1137,6 +1219,10 @@ dfuse_cache_evict_dir(struct dfuse_info *dfuse_info, struct dfuse_inode_entry *i
 bool
 read_chunk_close(struct dfuse_inode_entry *ie);
 
+/* Drop any readahead data for a range of an inode which is being written to */
+void
+read_chunk_invalidate(struct dfuse_inode_entry *ie, off_t position, size_t len);
+
 /* Metadata caching functions. */
 
 /* Mark the cache as up-to-date from now */
@@ -1178,6 +1264,9 @@ ival_thread_start(struct dfuse_info *dfuse_info);
 void
 ival_thread_stop();
 
+void
+ival_thread_wake(void);
+
 void
 ival_fini();
 
@@ -561,11 +561,12 @@ dfuse_pool_get_handle(struct dfuse_info *dfuse_info, uuid_t pool, struct dfuse_p
 	return dfuse_pool_connect(dfuse_info, uuid_str, _dfp);
 }
 
-#define ATTR_COUNT 6
+#define ATTR_COUNT 7
 
 char const *const cont_attr_names[ATTR_COUNT] = {
     "dfuse-attr-time",    "dfuse-dentry-time", "dfuse-dentry-dir-time",
-    "dfuse-ndentry-time", "dfuse-data-cache",  "dfuse-direct-io-disable"};
+    "dfuse-ndentry-time", "dfuse-data-cache",  "dfuse-direct-io-disable",
+    "dfuse-write-coalesce"};
 
 #define ATTR_TIME_INDEX              0
 #define ATTR_DENTRY_INDEX            1
@@ -573,6 +574,7 @@ char const *const cont_attr_names[ATTR_COUNT] = {
 #define ATTR_NDENTRY_INDEX           3
 #define ATTR_DATA_CACHE_INDEX        4
 #define ATTR_DIRECT_IO_DISABLE_INDEX 5
+#define ATTR_WRITE_COALESCE_INDEX    6
 
 /* Attribute values are of the form "120M", so the buffer does not need to be
  * large.
@@ -698,6 +700,20 @@ dfuse_cont_get_cache(struct dfuse_info *dfuse_info, struct dfuse_cont *dfc)
 			}
 			continue;
 		}
+		if (i == ATTR_WRITE_COALESCE_INDEX) {
+			if (dfuse_char_enabled(buff_addrs[i], sizes[i])) {
+				dfc->dfc_wcoalesce = true;
+				DFUSE_TRA_INFO(dfc, "setting '%s' is enabled", cont_attr_names[i]);
+			} else if (dfuse_char_disabled(buff_addrs[i], sizes[i])) {
+				dfc->dfc_wcoalesce = false;
+				DFUSE_TRA_INFO(dfc, "setting '%s' is disabled", cont_attr_names[i]);
+			} else {
+				DFUSE_TRA_WARNING(dfc, "Failed to parse '%s' for '%s'",
+						  buff_addrs[i], cont_attr_names[i]);
+				dfc->dfc_wcoalesce = false;
+			}
+			continue;
+		}
 
 		rc = dfuse_parse_time(buff_addrs[i], sizes[i], &value);
 		if (rc != 0) {
@@ -734,6 +750,13 @@ dfuse_cont_get_cache(struct dfuse_info *dfuse_info, struct dfuse_cont *dfc)
 
 	if (dfc->dfc_data_timeout != 0 && dfuse_info->di_wb_cache)
 		dfc->dfc_wb_cache = true;
+
+	/* Coalesced writes are replied to before being written so need the write-back cache */
+	if (dfc->dfc_wcoalesce && !dfc->dfc_wb_cache) {
+		DFUSE_TRA_WARNING(dfc, "'%s' disabled as write-back cache is not in use",
+				  cont_attr_names[ATTR_WRITE_COALESCE_INDEX]);
+		dfc->dfc_wcoalesce = false;
+	}
 	rc = 0;
 out:
 	D_FREE(buff);
@@ -1152,11 +1175,13 @@ dfuse_fs_init(struct dfuse_info *dfuse_info)
 		D_GOTO(err, rc = -DER_NOMEM);
 
 	D_INIT_LIST_HEAD(&dfuse_info->di_pool_historic);
+	D_INIT_LIST_HEAD(&dfuse_info->di_wc_list);
 
 	atomic_init(&dfuse_info->di_inode_count, 0);
 	atomic_init(&dfuse_info->di_fh_count, 0);
 	atomic_init(&dfuse_info->di_pool_count, 0);
 	atomic_init(&dfuse_info->di_container_count, 0);
+	atomic_init(&dfuse_info->di_wc_used, 0);
 
 	rc = d_hash_table_create_inplace(D_HASH_FT_LRU | D_HASH_FT_EPHEMERAL, 3, dfuse_info,
 					 &pool_hops, &dfuse_info->di_pool_table);
@@ -1260,6 +1285,9 @@ dfuse_ie_init(struct dfuse_info *dfuse_info, struct dfuse_inode_entry *ie)
 	atomic_fetch_add_relaxed(&dfuse_info->di_inode_count, 1);
 	D_INIT_LIST_HEAD(&ie->ie_evict_entry);
 	D_RWLOCK_INIT(&ie->ie_wlock, 0);
+	D_MUTEX_INIT(&ie->ie_wc_lock, NULL);
+	atomic_init(&ie->ie_wc_err, 0);
+	D_INIT_LIST_HEAD(&ie->ie_wc_entry);
 }
 
 void
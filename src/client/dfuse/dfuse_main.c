@@ -289,6 +289,7 @@ show_help(char *name)
 	    "	   --enable-local-flock	Enable the support of local flock\n"
 	    "	   --disable-caching	Disable all caching\n"
 	    "	   --disable-wb-cache	Use write-through rather than write-back cache\n"
+	    "	   --readahead-max=MiB	Memory limit for readahead, 0 to disable (default 256)\n"
 	    "	-o options		mount style options string\n"
 	    "\n"
 	    "	   --multi-user		Run dfuse in multi user mode\n"
@@ -421,6 +422,8 @@ main(int argc, char **argv)
 	bool               have_thread_count = false;
 	int                pos_index         = 0;
 	char		  *snap_name	     = NULL;
+	char              *end;
+	unsigned long long ra_max;
 	daos_epoch_t	   snap_epoch	     = 0;
 
 	struct option      long_options[] = {{"mountpoint", required_argument, 0, 'm'},
@@ -437,6 +440,7 @@ main(int argc, char **argv)
 					     {"enable-local-flock", no_argument, 0, 'L'},
 					     {"disable-caching", no_argument, 0, 'A'},
 					     {"disable-wb-cache", no_argument, 0, 'B'},
+					     {"readahead-max", required_argument, 0, 'R'},
 					     {"read-only", no_argument, 0, 'r'},
 					     {"snap", required_argument, 0, 's'},
 					     {"snap-epoch", required_argument, 0, 'N'},
@@ -459,6 +463,7 @@ main(int argc, char **argv)
 	dfuse_info->di_wb_cache    = true;
 	dfuse_info->di_eq_count    = 1;
 	dfuse_info->di_local_flock = false;
+	dfuse_info->di_ra_max      = DFUSE_READAHEAD_MAX;
 
 	while (1) {
 		c = getopt_long(argc, argv, "Mm:t:o:fhe:s:N:v", long_options, NULL);
@@ -493,6 +498,18 @@ main(int argc, char **argv)
 		case 'B':
 			dfuse_info->di_wb_cache = false;
 			break;
+		case 'R':
+			/* In MiB, strtoull() would silently accept a negative value */
+			errno  = 0;
+			ra_max = strtoull(optarg, &end, 0);
+			if (errno != 0 || end == optarg || *end != '\0' || strchr(optarg, '-') ||
+			    ra_max > (UINT64_MAX >> 20)) {
+				printf("Invalid readahead-max value '%s'\n", optarg);
+				show_help(argv[0]);
+				D_GOTO(out_debug, rc = -DER_INVAL);
+			}
+			dfuse_info->di_ra_max = (uint64_t)ra_max << 20;
+			break;
 		case 'm':
 			dfuse_info->di_mountpoint = optarg;
 			break;
@@ -201,12 +201,13 @@ out:
 }
 
 /* Main loop for eviction thread.  Spins until ready for exit waking after one second and iterates
- * over all newly expired dentries.
+ * over all newly expired dentries, and coalesced writes.
  */
 static void *
 ival_thread_fn(void *arg)
 {
-	int sleep_time = 1;
+	struct dfuse_info *dfuse_info = arg;
+	int                sleep_time = 1;
 
 	while (1) {
 		struct timespec ts = {};
@@ -231,6 +232,11 @@ ival_thread_fn(void *arg)
 			;
 		if (sleep_time < 2)
 			sleep_time = 2;
+		/* Also write out coalesced writes which have been pending for too long, and check
+		 * again in a second while any are left.
+		 */
+		if (dfuse_wc_expire(dfuse_info))
+			sleep_time = 1;
 		DFUSE_TRA_DEBUG(&ival_data, "Sleeping %d", sleep_time);
 	}
 	return NULL;
@@ -292,7 +298,7 @@ ival_thread_start(struct dfuse_info *dfuse_info)
 
 	ival_data.session = dfuse_info->di_session;
 
-	rc = pthread_create(&ival_thread, NULL, ival_thread_fn, NULL);
+	rc = pthread_create(&ival_thread, NULL, ival_thread_fn, dfuse_info);
 	if (rc != 0)
 		goto out;
 	pthread_setname_np(ival_thread, "dfuse inval");
@@ -301,6 +307,13 @@ out:
 	return rc;
 }
 
+/* Wake the thread early, used to start the timeout of coalesced writes */
+void
+ival_thread_wake(void)
+{
+	sem_post(&ival_sem);
+}
+
 /* Stop thread, remove all inodes from the invalidation queues and teardown all data structures
  * May be called without thread_start() having been called.
  */
@@ -161,53 +161,121 @@ pick_eqt(struct dfuse_info *dfuse_info)
 	return &dfuse_info->di_eqt[eqt_idx % dfuse_info->di_eq_count];
 }
 
-/* Chunk read and coalescing
+/* Readahead
  *
  * This code attempts to predict application and kernel I/O patterns and preemptively read file
  * data ahead of when it's requested.
  *
  * For some kernels read I/O size is limited to 128k when using the page cache or 1Mb when using
- * direct I/O.  To get around the performance impact of them detect when well aligned 128k reads
- * are received and read an entire buffers worth, then for future requests the data should already
- * be in cache.
+ * direct I/O, so even a large sequential read by the application is seen by dfuse as a stream of
+ * small requests, each of which would otherwise be a round trip to the servers.
  *
- * This code is entered when caching is enabled and reads are correctly size/aligned and not in the
- * last CHUNK_SIZE of a file.  When open then the inode contains a single read_chunk_core pointer
- * and this contains a list of read_chunk_data entries, one for each bucket.  Buckets where all
- * slots have been requested are remove from the list and closed when the last request is completed.
+ * Every open handle tracks the stream of reads made through it and once a number of reads have
+ * followed a pattern readahead is started for the handle:
+ * - Sequential, the reads follow each other within RA_SEQ_SLACK.  Readahead is done in RA_CHUNK
+ *   aligned buckets ahead of the current position.
+ * - Strided, the reads are of the same size at a constant distance apart.  Readahead is done for
+ *   the predicted reads only.
+ * The readahead window, in buckets, starts at RA_WINDOW_MIN and is doubled for every read served
+ * from a bucket up to RA_WINDOW_MAX, it's reset whenever the pattern is broken.
  *
- * TODO: Currently there is no code to remove partially read buckets from the list so reading
- * one slot every chunk would leave the entire file contents in memory until close and mean long
- * list traversal times.
+ * Buckets are kept per inode in the active inode chunks list so that they're shared by all open
+ * handles on the file, and each bucket uses a read event from one of the event queue threads so
+ * several of them can be in flight at once.  The memory used by all buckets is limited by
+ * --readahead-max, once reached no new readahead is issued until buckets are released.  Buckets
+ * are released once all of their data has been read, when they have not been accessed for
+ * RA_STALE_SEC or when the file is closed.  Buckets which are released without being read from
+ * are counted as READAHEAD_WASTE, reads served from them as READAHEAD_HIT.
+ *
+ * Readahead is only used for handles which use the page cache, for direct I/O reads the data is
+ * always fetched from DAOS.
  */
 
-#define CHUNK_SIZE (1024 * 1024)
+#define RA_CHUNK      DFUSE_MAX_READ
+#define RA_SEQ_SLACK  RA_CHUNK
+#define RA_CONFIRM    2
+#define RA_WINDOW_MIN 2
+#define RA_WINDOW_MAX 32
+#define RA_STALE_SEC  5
+
+enum {
+	RA_NONE,
+	RA_SEQUENTIAL,
+	RA_STRIDED,
+};
 
 struct read_chunk_data {
-	struct dfuse_event   *ev;
-	struct active_inode  *ia;
-	fuse_req_t            reqs[8];
-	struct dfuse_obj_hdl *ohs[8];
-	d_list_t              list;
-	uint64_t              bucket;
-	struct dfuse_eq      *eqt;
-	int                   rc;
-	int                   entered;
-	ATOMIC int            exited;
-	bool                  exiting;
-	bool                  complete;
+	struct dfuse_event       *ev;
+	struct dfuse_inode_entry *ie;
+	struct dfuse_info        *di;
+	struct dfuse_eq          *eqt;
+	/* Pending read_req entries, replied on completion */
+	d_list_t                  reqs;
+	d_list_t                  list;
+	/* Link on the list of buckets to submit, see chunk_read() */
+	d_list_t                  fetch;
+	/* The file range requested and, once complete, the number of bytes read */
+	off_t                     start;
+	size_t                    size;
+	size_t                    len;
+	/* Number of bytes served from this bucket */
+	size_t                    used;
+	/* Last access in seconds */
+	uint64_t                  atime;
+	/* References, one for the chunks list, one for the in-flight read and one for every reply
+	 * made from the buffer.  Protected by the active inode lock.
+	 */
+	int                       ref;
+	int                       rc;
+	bool                      complete;
 };
 
+static uint64_t
+ra_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+	return now.tv_sec;
+}
+
+/* Drop a reference on a bucket, called with the active inode lock held.
+ *
+ * Returns true if the bucket should be freed by the caller.
+ */
+static bool
+chunk_decref(struct read_chunk_data *cd)
+{
+	D_ASSERT(cd->ref > 0);
+	return --cd->ref == 0;
+}
+
 static void
 chunk_free(struct read_chunk_data *cd)
 {
-	d_list_del(&cd->list);
-	d_slab_release(cd->eqt->de_read_slab, cd->ev);
+	if (cd->ev) {
+		daos_event_fini(&cd->ev->de_ev);
+		d_slab_release(cd->eqt->de_read_slab, cd->ev);
+	}
+	atomic_fetch_sub_relaxed(&cd->di->di_ra_used, RA_CHUNK);
 	D_FREE(cd);
 }
 
-/* Called when the last open file handle on a inode is closed.  This needs to free everything which
- * is complete and for anything that isn't flag it for deletion in the callback.
+/* Remove a bucket from the chunks list, called with the active inode lock held.
+ *
+ * Returns true if the bucket should be freed by the caller.
+ */
+static bool
+chunk_evict(struct read_chunk_data *cd)
+{
+	if (cd->used == 0)
+		DFUSE_IE_STAT_ADD(cd->ie, DS_READAHEAD_WASTE);
+	d_list_del_init(&cd->list);
+	return chunk_decref(cd);
+}
+
+/* Called when the last open file handle on a inode is closed.  Every read in flight holds a
+ * reference on the active inode so at this point all buckets are complete.
  *
  * Returns true if the feature was used.
  */
@@ -215,125 +283,209 @@ bool
 read_chunk_close(struct dfuse_inode_entry *ie)
 {
 	struct read_chunk_data *cd, *cdn;
+	d_list_t                free_list;
 	bool                    rcb = false;
 
+	D_INIT_LIST_HEAD(&free_list);
+
 	D_SPIN_LOCK(&ie->ie_active->lock);
-	if (d_list_empty(&ie->ie_active->chunks))
-		goto out;
+	d_list_for_each_entry_safe(cd, cdn, &ie->ie_active->chunks, list) {
+		rcb = true;
+		D_ASSERT(cd->complete);
+		if (chunk_evict(cd))
+			d_list_add(&cd->list, &free_list);
+	}
+	D_SPIN_UNLOCK(&ie->ie_active->lock);
+
+	d_list_for_each_entry_safe(cd, cdn, &free_list, list)
+		chunk_free(cd);
+
+	return rcb;
+}
+
+void
+read_chunk_invalidate(struct dfuse_inode_entry *ie, off_t position, size_t len)
+{
+	struct read_chunk_data *cd, *cdn;
+	d_list_t                free_list;
 
-	rcb = true;
+	D_INIT_LIST_HEAD(&free_list);
 
+	D_SPIN_LOCK(&ie->ie_active->lock);
 	d_list_for_each_entry_safe(cd, cdn, &ie->ie_active->chunks, list) {
-		if (cd->complete) {
-			chunk_free(cd);
-		} else {
-			cd->exiting = true;
-		}
+		if (cd->start >= position + len || cd->start + cd->size <= position)
+			continue;
+		/* Requests already waiting on the bucket predate the write so can still be served
+		 * from it, so only take it off the list.
+		 */
+		if (chunk_evict(cd))
+			d_list_add(&cd->list, &free_list);
 	}
-out:
 	D_SPIN_UNLOCK(&ie->ie_active->lock);
-	return rcb;
+
+	d_list_for_each_entry_safe(cd, cdn, &free_list, list)
+		chunk_free(cd);
 }
 
+/* Reply to a read request from a complete bucket, the active inode lock should not be held as
+ * this can block.  A bucket shorter than requested means that the end of file was reached so
+ * the reply is truncated.
+ */
 static void
-chunk_cb(struct dfuse_event *ev)
+chunk_reply(struct read_chunk_data *cd, struct dfuse_obj_hdl *oh, fuse_req_t req, off_t position,
+	    size_t len)
 {
-	struct read_chunk_data *cd = ev->de_cd;
-	struct active_inode    *ia = cd->ia;
-	fuse_req_t              req;
-	bool                    done = false;
-
-	cd->rc = ev->de_ev.ev_error;
+	off_t  offset = position - cd->start;
+	size_t reply_len;
 
-	if (cd->rc == 0 && (ev->de_len != CHUNK_SIZE)) {
-		cd->rc = EIO;
-		DS_WARN(cd->rc, "Unexpected short read bucket %ld (%#zx) expected %i got %zi",
-			cd->bucket, cd->bucket * CHUNK_SIZE, CHUNK_SIZE, ev->de_len);
+	if (cd->rc != 0) {
+		DFUSE_REPLY_ERR_RAW(oh, req, cd->rc);
+		return;
 	}
 
-	daos_event_fini(&ev->de_ev);
+	if (offset >= cd->len)
+		reply_len = 0;
+	else
+		reply_len = min(len, cd->len - offset);
 
-	do {
-		int i;
-		req = 0;
+	if (reply_len == len)
+		DFUSE_TRA_DEBUG(oh, "%#zx-%#zx read", position, position + len - 1);
+	else
+		DFUSE_TRA_DEBUG(oh, "%#zx-%#zx read %#zx-%#zx not read (truncated)", position,
+				position + reply_len - 1, position + reply_len,
+				position + len - 1);
 
-		D_SPIN_LOCK(&ia->lock);
+	DFUSE_REPLY_BUFQ(oh, req, cd->ev->de_iov.iov_buf + offset, reply_len);
+}
 
-		if (cd->exiting) {
-			chunk_free(cd);
-			D_SPIN_UNLOCK(&ia->lock);
-			return;
-		}
+/* Mark a bucket as complete and reply to any requests waiting on it */
+static void
+chunk_done(struct read_chunk_data *cd, int rc, size_t len)
+{
+	struct dfuse_inode_entry *ie = cd->ie;
+	struct active_inode      *ia = ie->ie_active;
+	struct read_req          *rr, *rrn;
+	d_list_t                  reqs;
+	bool                      free_cd;
+
+	D_INIT_LIST_HEAD(&reqs);
+
+	D_SPIN_LOCK(&ia->lock);
+	cd->rc       = rc;
+	cd->len      = len;
+	cd->complete = true;
+	/* Take the waiting requests and hold the in-flight reference while replying to them */
+	d_list_splice_init(&cd->reqs, &reqs);
+	D_SPIN_UNLOCK(&ia->lock);
+
+	if (cd->rc != 0)
+		DS_WARN(cd->rc, "Readahead of %#zx-%#zx failed", cd->start,
+			cd->start + cd->size - 1);
+
+	d_list_for_each_entry_safe(rr, rrn, &reqs, list) {
+		d_list_del(&rr->list);
+		chunk_reply(cd, rr->oh, rr->req, rr->position, rr->len);
+		D_FREE(rr);
+	}
 
-		cd->complete = true;
-		for (i = 0; i < 8; i++) {
-			if (cd->reqs[i]) {
-				req         = cd->reqs[i];
-				cd->reqs[i] = 0;
-				break;
-			}
-		}
+	D_SPIN_LOCK(&ia->lock);
+	/* Do not keep failed reads around */
+	if (cd->rc != 0 && !d_list_empty(&cd->list))
+		chunk_evict(cd);
+	free_cd = chunk_decref(cd);
+	D_SPIN_UNLOCK(&ia->lock);
 
-		D_SPIN_UNLOCK(&ia->lock);
+	if (free_cd)
+		chunk_free(cd);
 
-		if (req) {
-			size_t position = (cd->bucket * CHUNK_SIZE) + (i * K128);
+	/* Drop the extra ref on active, the file could be closed before this read completes */
+	active_ie_decref(cd->di, ie);
+}
 
-			if (cd->rc != 0) {
-				DFUSE_REPLY_ERR_RAW(cd->ohs[i], req, cd->rc);
-			} else {
-				DFUSE_TRA_DEBUG(cd->ohs[i], "%#zx-%#zx read", position,
-						position + K128 - 1);
-				DFUSE_REPLY_BUFQ(cd->ohs[i], req, ev->de_iov.iov_buf + (i * K128),
-						 K128);
-			}
+static void
+chunk_cb(struct dfuse_event *ev)
+{
+	chunk_done(ev->de_cd, ev->de_ev.ev_error, ev->de_len);
+}
 
-			if (atomic_fetch_add_relaxed(&cd->exited, 1) == 7)
-				done = true;
-		}
-	} while (req && !done);
+/* Find the bucket which holds all of a range, called with the active inode lock held. */
+static struct read_chunk_data *
+chunk_find(struct active_inode *ia, off_t position, size_t len)
+{
+	struct read_chunk_data *cd;
 
-	if (done) {
-		d_slab_release(cd->eqt->de_read_slab, cd->ev);
-		D_FREE(cd);
+	d_list_for_each_entry(cd, &ia->chunks, list)
+		if (position >= cd->start && position + len <= cd->start + cd->size)
+			return cd;
+	return NULL;
+}
+
+/* Allocate a bucket and add it to the chunks list, called with the active inode lock held.  The
+ * read itself is submitted later by chunk_fetch() once the lock is dropped.
+ */
+static struct read_chunk_data *
+chunk_alloc(struct dfuse_info *dfuse_info, struct dfuse_inode_entry *ie, off_t start, size_t size)
+{
+	struct read_chunk_data *cd;
+
+	if (atomic_fetch_add_relaxed(&dfuse_info->di_ra_used, RA_CHUNK) + RA_CHUNK >
+	    dfuse_info->di_ra_max) {
+		atomic_fetch_sub_relaxed(&dfuse_info->di_ra_used, RA_CHUNK);
+		return NULL;
 	}
+
+	D_ALLOC_PTR(cd);
+	if (cd == NULL) {
+		atomic_fetch_sub_relaxed(&dfuse_info->di_ra_used, RA_CHUNK);
+		return NULL;
+	}
+
+	D_INIT_LIST_HEAD(&cd->reqs);
+	cd->ie    = ie;
+	cd->di    = dfuse_info;
+	cd->start = start;
+	cd->size  = size;
+	cd->atime = ra_now();
+	/* One reference for the list and one for the read */
+	cd->ref   = 2;
+	d_list_add(&cd->list, &ie->ie_active->chunks);
+
+	return cd;
 }
 
-/* Submut a read to dfs.
- *
- * Returns true on success.
+/* Submit the read for a bucket to dfs.  On failure the bucket is completed with the error so that
+ * any waiting requests are replied to.
  */
-static bool
-chunk_fetch(fuse_req_t req, struct dfuse_obj_hdl *oh, struct read_chunk_data *cd, int slot)
+static void
+chunk_fetch(struct read_chunk_data *cd)
 {
-	struct dfuse_info        *dfuse_info = fuse_req_userdata(req);
-	struct dfuse_inode_entry *ie         = oh->doh_ie;
-	struct dfuse_event       *ev;
+	struct dfuse_inode_entry *ie = cd->ie;
+	struct dfuse_event       *ev = NULL;
 	struct dfuse_eq          *eqt;
 	int                       rc;
-	daos_off_t                position = cd->bucket * CHUNK_SIZE;
 
-	eqt = pick_eqt(dfuse_info);
+	/* Take a ref on active for the read, it's dropped in chunk_cb() */
+	atomic_fetch_add_relaxed(&ie->ie_open_count, 1);
+
+	eqt = pick_eqt(cd->di);
 
 	ev = d_slab_acquire(eqt->de_read_slab);
 	if (ev == NULL) {
-		cd->rc = ENOMEM;
-		return false;
+		rc = ENOMEM;
+		goto err;
 	}
 
-	ev->de_iov.iov_len = CHUNK_SIZE;
-	ev->de_req         = req;
+	ev->de_iov.iov_len = cd->size;
+	ev->de_req         = 0;
 	ev->de_cd          = cd;
 	ev->de_sgl.sg_nr   = 1;
 	ev->de_len         = 0;
 	ev->de_complete_cb = chunk_cb;
 
-	cd->ev         = ev;
-	cd->eqt        = eqt;
-	cd->reqs[slot] = req;
-	cd->ohs[slot]  = oh;
+	cd->ev  = ev;
+	cd->eqt = eqt;
 
-	rc = dfs_read(ie->ie_dfs->dfs_ns, ie->ie_obj, &ev->de_sgl, position, &ev->de_len,
+	rc = dfs_read(ie->ie_dfs->dfs_ns, ie->ie_obj, &ev->de_sgl, cd->start, &ev->de_len,
 		      &ev->de_ev);
 	if (rc != 0)
 		goto err;
@@ -344,120 +496,220 @@ chunk_fetch(fuse_req_t req, struct dfuse_obj_hdl *oh, struct read_chunk_data *cd
 	/* Now ensure there are more descriptors for the next request */
 	d_slab_restock(eqt->de_read_slab);
 
-	return true;
+	return;
 
 err:
-	daos_event_fini(&ev->de_ev);
-	d_slab_release(eqt->de_read_slab, ev);
-	cd->rc = rc;
-	return false;
+	if (ev) {
+		daos_event_fini(&ev->de_ev);
+		d_slab_release(eqt->de_read_slab, ev);
+		cd->ev = NULL;
+	}
+	chunk_done(cd, rc, 0);
 }
-
-/* Try and do a bulk read.
+/* Update the stream detection of a handle with a new read, called with the active inode lock held.
  *
- * Returns true if it was able to handle the read.
+ * Returns true if readahead should be issued for the stream.
  */
 static bool
-chunk_read(fuse_req_t req, size_t len, off_t position, struct dfuse_obj_hdl *oh)
+ra_stream_update(struct dfuse_ra_stream *ras, off_t position, size_t len)
 {
-	struct dfuse_inode_entry *ie = oh->doh_ie;
-	struct read_chunk_data   *cd;
-	off_t                     last;
-	uint64_t                  bucket;
-	int                       slot;
-	bool                      submit = false;
-	bool                      rcb;
+	off_t stride = position - ras->ras_last;
+	int   kind   = RA_NONE;
+
+	if (ras->ras_reads != 0) {
+		if (position >= ras->ras_next - RA_SEQ_SLACK &&
+		    position <= ras->ras_next + RA_SEQ_SLACK)
+			kind = RA_SEQUENTIAL;
+		else if (stride > 0 && stride == ras->ras_stride && len == ras->ras_len)
+			kind = RA_STRIDED;
+	}
 
-	if (len != K128)
-		return false;
+	if (kind == RA_NONE || kind != ras->ras_kind) {
+		ras->ras_confirm = kind == RA_NONE ? 0 : 1;
+		ras->ras_window  = RA_WINDOW_MIN;
+		ras->ras_issued  = 0;
+	} else if (ras->ras_confirm < RA_CONFIRM) {
+		ras->ras_confirm++;
+	}
 
-	if ((position % K128) != 0)
-		return false;
+	ras->ras_kind   = kind;
+	ras->ras_stride = stride;
+	ras->ras_last   = position;
+	ras->ras_len    = len;
+	ras->ras_reads++;
+	/* Sequential reads may be seen slightly out of order so track the furthest one */
+	if (kind == RA_SEQUENTIAL)
+		ras->ras_next = max(ras->ras_next, (off_t)(position + len));
+	else
+		ras->ras_next = position + len;
 
-	last = D_ALIGNUP(position + len - 1, CHUNK_SIZE);
+	return ras->ras_confirm >= RA_CONFIRM;
+}
 
-	if (last > oh->doh_ie->ie_stat.st_size)
+/* Allocate buckets for the readahead window of a stream, called with the active inode lock held.
+ * New buckets are added to the fetch list to be submitted once the lock is dropped.
+ */
+static void
+ra_stream_issue(struct dfuse_info *dfuse_info, struct dfuse_obj_hdl *oh, off_t position,
+		d_list_t *fetch_list)
+{
+	struct dfuse_ra_stream   *ras  = &oh->doh_ra;
+	struct dfuse_inode_entry *ie   = oh->doh_ie;
+	off_t                     fsize = ie->ie_stat.st_size;
+	struct read_chunk_data   *cd;
+	off_t                     start;
+	off_t                     end;
+	size_t                    size;
+
+	if (ras->ras_kind == RA_SEQUENTIAL) {
+		start = D_ALIGNUP(position + 1, RA_CHUNK) - RA_CHUNK;
+		end   = start + ras->ras_window * RA_CHUNK;
+		start = max(start, ras->ras_issued);
+		for (; start < end && start < fsize; start += RA_CHUNK) {
+			size = min(RA_CHUNK, fsize - start);
+			if (chunk_find(ie->ie_active, start, size) == NULL) {
+				cd = chunk_alloc(dfuse_info, ie, start, size);
+				if (cd == NULL)
+					break;
+				d_list_add_tail(&cd->fetch, fetch_list);
+			}
+			ras->ras_issued = start + RA_CHUNK;
+		}
+	} else {
+		/* The predicted reads, starting with the next one not already issued */
+		start = max(position + ras->ras_stride, ras->ras_issued);
+		end   = position + ras->ras_window * ras->ras_stride;
+		for (; start <= end && start < fsize; start += ras->ras_stride) {
+			size = min(ras->ras_len, fsize - start);
+			if (chunk_find(ie->ie_active, start, size) == NULL) {
+				cd = chunk_alloc(dfuse_info, ie, start, size);
+				if (cd == NULL)
+					break;
+				d_list_add_tail(&cd->fetch, fetch_list);
+			}
+			ras->ras_issued = start + ras->ras_stride;
+		}
+	}
+}
+
+/* Try and serve a read from readahead, and issue further readahead for the stream.
+ *
+ * Returns true if it was able to handle the read.
+ */
+static bool
+chunk_read(fuse_req_t req, size_t len, off_t position, struct dfuse_obj_hdl *oh)
+{
+	struct dfuse_info        *dfuse_info = fuse_req_userdata(req);
+	struct dfuse_inode_entry *ie         = oh->doh_ie;
+	struct active_inode      *ia         = ie->ie_active;
+	struct read_chunk_data   *cd, *cdn;
+	struct read_chunk_data   *hit        = NULL;
+	struct read_req          *rr         = NULL;
+	d_list_t                  fetch_list;
+	d_list_t                  free_list;
+	uint64_t                  now        = ra_now();
+	bool                      rcb        = false;
+
+	if (!oh->doh_caching || dfuse_info->di_ra_max == 0 || len == 0 || len > RA_CHUNK)
 		return false;
 
-	bucket = D_ALIGNUP(position + len, CHUNK_SIZE);
-	bucket = (bucket / CHUNK_SIZE) - 1;
+	D_INIT_LIST_HEAD(&fetch_list);
+	D_INIT_LIST_HEAD(&free_list);
 
-	slot = (position / K128) % 8;
+	D_SPIN_LOCK(&ia->lock);
 
-	DFUSE_TRA_DEBUG(oh, "read bucket %#zx-%#zx last %#zx size %#zx bucket %ld slot %d",
-			position, position + len - 1, last, ie->ie_stat.st_size, bucket, slot);
+	/* Look for the bucket holding this read, and evict the ones which have been fully read or
+	 * not accessed for some time on the way.
+	 */
+	d_list_for_each_entry_safe(cd, cdn, &ia->chunks, list) {
+		if (hit == NULL && position >= cd->start && position + len <= cd->start + cd->size) {
+			hit = cd;
+			continue;
+		}
+		if (cd->complete && (cd->used >= cd->len || now - cd->atime > RA_STALE_SEC)) {
+			if (chunk_evict(cd))
+				d_list_add(&cd->list, &free_list);
+		}
+	}
 
-	D_SPIN_LOCK(&ie->ie_active->lock);
+	if (ra_stream_update(&oh->doh_ra, position, len)) {
+		/* A read which is part of the stream but was not predicted, fetch it as part of
+		 * the readahead so that it can be replied to with the rest of the bucket.
+		 */
+		if (hit == NULL && oh->doh_ra.ras_kind == RA_SEQUENTIAL &&
+		    D_ALIGNUP(position + 1, RA_CHUNK) >= position + len &&
+		    position < ie->ie_stat.st_size) {
+			off_t start = D_ALIGNUP(position + 1, RA_CHUNK) - RA_CHUNK;
+
+			hit = chunk_alloc(dfuse_info, ie, start,
+					  min(RA_CHUNK, ie->ie_stat.st_size - start));
+			if (hit)
+				d_list_add_tail(&hit->fetch, &fetch_list);
+		}
+		ra_stream_issue(dfuse_info, oh, position, &fetch_list);
+	}
 
-	d_list_for_each_entry(cd, &ie->ie_active->chunks, list)
-		if (cd->bucket == bucket) {
-			/* Remove from list to re-add again later. */
-			d_list_del(&cd->list);
-			goto found;
+	if (hit) {
+		hit->atime = now;
+		hit->used += len;
+		if (!hit->complete) {
+			D_ALLOC_PTR(rr);
+			if (rr) {
+				rr->req      = req;
+				rr->len      = len;
+				rr->position = position;
+				rr->oh       = oh;
+				d_list_add_tail(&rr->list, &hit->reqs);
+				rcb = true;
+			}
+			hit = NULL;
+		} else if (hit->rc != 0) {
+			/* Don't pass fuse an error here, rather return false and the read will be
+			 * tried over the network.
+			 */
+			hit = NULL;
+		} else {
+			/* Hold the bucket while replying from it */
+			hit->ref++;
+			rcb = true;
 		}
+	}
 
-	D_ALLOC_PTR(cd);
-	if (cd == NULL)
-		goto err;
+	if (rcb) {
+		/* Requests served from readahead grow the window of the stream */
+		oh->doh_ra.ras_window = min(oh->doh_ra.ras_window * 2, RA_WINDOW_MAX);
+		DFUSE_IE_STAT_ADD(ie, DS_READAHEAD_HIT);
+	}
 
-	cd->ia     = ie->ie_active;
-	cd->bucket = bucket;
-	submit     = true;
+	D_SPIN_UNLOCK(&ia->lock);
 
-found:
+	d_list_for_each_entry_safe(cd, cdn, &free_list, list)
+		chunk_free(cd);
 
-	if (++cd->entered < 8) {
-		/* Put on front of list for efficient searching */
-		d_list_add(&cd->list, &ie->ie_active->chunks);
+	/* Submit the new buckets, making sure that they see any data still in the write-back
+	 * cache.
+	 */
+	if (!d_list_empty(&fetch_list)) {
+		DFUSE_IE_WFLUSH(ie);
+		d_list_for_each_entry_safe(cd, cdn, &fetch_list, fetch) {
+			d_list_del(&cd->fetch);
+			chunk_fetch(cd);
+		}
 	}
 
-	D_SPIN_UNLOCK(&ie->ie_active->lock);
-
-	if (submit) {
-		DFUSE_TRA_DEBUG(oh, "submit for bucket %ld[%d]", bucket, slot);
-		rcb = chunk_fetch(req, oh, cd, slot);
-	} else {
-		struct dfuse_event *ev = NULL;
+	if (hit) {
+		bool free_cd;
 
-		/* Now check if this read request is complete or not yet, if it isn't then just
-		 * save req in the right slot however if it is then reply here.  After the call to
-		 * DFUSE_REPLY_* then no reference is held on either the open file or the inode so
-		 * at that point they could be closed.
-		 */
-		rcb = true;
+		chunk_reply(hit, oh, req, position, len);
 
-		D_SPIN_LOCK(&ie->ie_active->lock);
-		if (cd->complete) {
-			ev = cd->ev;
-		} else {
-			cd->reqs[slot] = req;
-			cd->ohs[slot]  = oh;
-		}
-		D_SPIN_UNLOCK(&ie->ie_active->lock);
-
-		if (ev) {
-			if (cd->rc != 0) {
-				/* Don't pass fuse an error here, rather return false and the read
-				 * will be tried over the network.
-				 */
-				rcb = false;
-			} else {
-				DFUSE_TRA_DEBUG(oh, "%#zx-%#zx read", position,
-						position + K128 - 1);
-				DFUSE_REPLY_BUFQ(oh, req, ev->de_iov.iov_buf + (slot * K128), K128);
-			}
-			if (atomic_fetch_add_relaxed(&cd->exited, 1) == 7) {
-				d_slab_release(cd->eqt->de_read_slab, cd->ev);
-				D_FREE(cd);
-			}
-		}
+		D_SPIN_LOCK(&ia->lock);
+		free_cd = chunk_decref(hit);
+		D_SPIN_UNLOCK(&ia->lock);
+		if (free_cd)
+			chunk_free(hit);
 	}
 
 	return rcb;
-
-err:
-	D_SPIN_UNLOCK(&ie->ie_active->lock);
-	return false;
 }
 
 void
@@ -49,7 +49,8 @@ dfuse_cache_evict_dir(struct dfuse_info *dfuse_info, struct dfuse_inode_entry *i
 }
 
 static int
-filler_cb(dfs_t *dfs, dfs_obj_t *dir, const char name[], void *arg)
+filler_cb(dfs_t *dfs, dfs_obj_t *dir, const char name[], mode_t mode, daos_obj_id_t oid,
+	  void *arg)
 {
 	struct iterate_data        *idata = arg;
 	struct dfuse_readdir_entry *dre;
@@ -62,6 +63,8 @@ filler_cb(dfs_t *dfs, dfs_obj_t *dir, const char name[], void *arg)
 	strncpy(dre->dre_name, name, NAME_MAX);
 	dre->dre_offset      = idata->id_base_offset + idata->id_index;
 	dre->dre_next_offset = dre->dre_offset + 1;
+	dre->dre_mode        = mode;
+	dre->dre_oid         = oid;
 	idata->id_index++;
 
 	return 0;
@@ -82,11 +85,11 @@ fetch_dir_entries(struct dfuse_obj_hdl *oh, off_t offset, int to_fetch, bool *eo
 
 	D_ASSERT(oh->doh_rd);
 
-	rc = dfs_iterate(oh->doh_dfs, oh->doh_ie->ie_obj, &hdl->drh_anchor, &count,
-			 (NAME_MAX + 1) * count, filler_cb, &idata);
+	rc = dfs_iterate_plus(oh->doh_dfs, oh->doh_ie->ie_obj, &hdl->drh_anchor, &count,
+			      (NAME_MAX + 1) * count, filler_cb, &idata);
 
 	if (rc) {
-		DFUSE_TRA_ERROR(oh, "dfs_iterate() returned: %d (%s)", rc, strerror(rc));
+		DFUSE_TRA_ERROR(oh, "dfs_iterate_plus() returned: %d (%s)", rc, strerror(rc));
 		return rc;
 	}
 
@@ -654,7 +657,7 @@ restart:
 			struct dfuse_readdir_entry *dre   = &hdl->drh_dre[i];
 			struct stat                 stbuf = {0};
 			daos_obj_id_t               oid;
-			dfs_obj_t                  *obj;
+			dfs_obj_t                  *obj = NULL;
 			size_t                      written;
 			char                        out[DUNS_MAX_XATTR_LEN];
 			char                       *outp     = &out[0];
@@ -679,14 +682,17 @@ restart:
 					dre->dre_offset, dre->dre_next_offset,
 					DP_DE(dre->dre_name));
 
-			if (plus)
+			if (plus) {
 				rc = dfs_lookupx(oh->doh_dfs, oh->doh_ie->ie_obj, dre->dre_name,
 						 O_RDWR | O_NOFOLLOW, &obj, &stbuf.st_mode, &stbuf,
 						 1, &duns_xattr_name, (void **)&outp, &attr_len);
-			else
-				rc = dfs_lookup_rel(oh->doh_dfs, oh->doh_ie->ie_obj, dre->dre_name,
-						    O_RDONLY | O_NOFOLLOW, &obj, &stbuf.st_mode,
-						    NULL);
+			} else if (dre->dre_mode != 0) {
+				/* The mode and oid came with the name, no need to open the entry */
+				stbuf.st_mode = dre->dre_mode;
+				rc            = 0;
+			} else {
+				rc = ENOENT;
+			}
 			if (rc == ENOENT) {
 				DFUSE_TRA_DEBUG(oh, "File does not exist");
 				D_FREE(drc);
@@ -698,7 +704,10 @@ restart:
 				D_GOTO(reply, rc);
 			}
 
-			dfs_obj2id(obj, &oid);
+			if (obj)
+				dfs_obj2id(obj, &oid);
+			else
+				oid = dre->dre_oid;
 
 			dfuse_compute_inode(oh->doh_ie->ie_dfs, &oid, &stbuf.st_ino);
 
@@ -742,8 +751,6 @@ restart:
 						d_hash_rec_decref(&dfuse_info->dpi_iet, rlink);
 				}
 			} else {
-				dfs_release(obj);
-
 				written = FAD(req, &reply_buff[buff_offset], size - buff_offset,
 					      dre->dre_name, &stbuf, dre->dre_next_offset);
 
@@ -22,6 +22,339 @@ dfuse_cb_write_complete(struct dfuse_event *ev)
 	d_slab_release(ev->de_eqt->de_write_slab, ev);
 }
 
+/* Update the inode for a write which is about to be made */
+static void
+write_update_ie(struct dfuse_inode_entry *ie, off_t position, size_t len)
+{
+	/* Check for potentially using readahead on this file, ie_truncated
+	 * will only be set if caching is enabled so only check for the one
+	 * flag rather than two here
+	 */
+	if (ie->ie_truncated) {
+		if (ie->ie_start_off == 0 && ie->ie_end_off == 0) {
+			ie->ie_start_off = position;
+			ie->ie_end_off   = position + len;
+		} else {
+			if (ie->ie_start_off > position)
+				ie->ie_start_off = position;
+			if (ie->ie_end_off < position + len)
+				ie->ie_end_off = position + len;
+		}
+	}
+
+	if (len + position > ie->ie_stat.st_size)
+		ie->ie_stat.st_size = len + position;
+
+	read_chunk_invalidate(ie, position, len);
+}
+
+/* Write coalescing
+ *
+ * Every write from the kernel, which is at most 1MiB and often much less, would otherwise be a
+ * dfs_write() call of its own so applications making small appends, such as writing log files,
+ * generate an RPC per write.  When enabled for a container with the dfuse-write-coalesce attribute
+ * small writes which follow each other are instead copied into a per-inode buffer which is written
+ * out as a single dfs_write() call when:
+ * - it is full, buffers end on a chunk boundary of the file so each call updates a single dkey,
+ * - the next write does not follow it or does not fit,
+ * - on flush, fsync or close, or anything else which calls DFUSE_IE_WFLUSH(),
+ * - it has been pending for DFUSE_WC_TIMEOUT seconds, checked every second by the inval thread so
+ *   a buffer can be held for up to twice that.
+ *
+ * Writes which can't be coalesced are made directly, after the pending buffer.  As writes are
+ * replied to before being made they can be in flight at the same time, so a write which overlaps
+ * one which may still be in flight waits for it first.
+ *
+ * This requires the write-back cache as the writes are replied to before they're made, errors from
+ * coalesced writes are saved on the inode and reported to the next flush or fsync call.  The memory
+ * used by buffers is limited to DFUSE_WCOALESCE_MAX, beyond that writes are made directly.
+ */
+
+#define DFUSE_WC_TIMEOUT 1
+
+static uint64_t
+wc_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+	return now.tv_sec;
+}
+
+static void
+dfuse_wc_complete(struct dfuse_event *ev)
+{
+	struct dfuse_inode_entry *ie         = ev->de_ie;
+	struct dfuse_info        *dfuse_info = ev->de_di;
+	int                       rc         = ev->de_ev.ev_error;
+	int                       expected   = 0;
+
+	if (rc != 0) {
+		DHS_ERROR(ie, rc, "Coalesced write of %#zx-%#zx failed", ev->de_req_position,
+			  ev->de_req_position + ev->de_iov.iov_len - 1);
+		atomic_compare_exchange_strong(&ie->ie_wc_err, &expected, rc);
+	}
+
+	D_RWLOCK_UNLOCK(&ie->ie_wlock);
+	daos_event_fini(&ev->de_ev);
+	d_slab_release(ev->de_eqt->de_write_slab, ev);
+	atomic_fetch_sub_relaxed(&dfuse_info->di_wc_used, DFUSE_MAX_READ);
+
+	/* Drop the ref on active taken by wc_alloc() */
+	active_ie_decref(dfuse_info, ie);
+}
+
+/* Add a write which is about to be made to the in-flight range, called with ie_wc_lock held. */
+static void
+wc_inflight_add(struct dfuse_inode_entry *ie, off_t position, size_t len)
+{
+	if (ie->ie_wc_end <= ie->ie_wc_start) {
+		ie->ie_wc_start = position;
+		ie->ie_wc_end   = position + len;
+		return;
+	}
+	ie->ie_wc_start = min(ie->ie_wc_start, position);
+	ie->ie_wc_end   = max(ie->ie_wc_end, (off_t)(position + len));
+}
+
+/* Wait for in-flight writes if a new write overlaps them, called with ie_wc_lock held.  Writes
+ * complete without taking ie_wc_lock so they can be waited for here.
+ */
+static void
+wc_inflight_wait(struct dfuse_inode_entry *ie, off_t position, size_t len)
+{
+	if (position >= ie->ie_wc_end || position + len <= ie->ie_wc_start)
+		return;
+
+	D_RWLOCK_WRLOCK(&ie->ie_wlock);
+	D_RWLOCK_UNLOCK(&ie->ie_wlock);
+	ie->ie_wc_start = 0;
+	ie->ie_wc_end   = 0;
+}
+
+/* Take the pending buffer of an inode, and write it out.  Called with ie_wc_lock held. */
+static void
+wc_submit(struct dfuse_inode_entry *ie)
+{
+	struct dfuse_event *ev = ie->ie_wc_ev;
+	struct dfuse_info  *dfuse_info;
+	int                 rc;
+
+	if (ev == NULL)
+		return;
+
+	wc_inflight_add(ie, ev->de_req_position, ev->de_iov.iov_len);
+
+	dfuse_info   = ev->de_di;
+	ie->ie_wc_ev = NULL;
+	D_SPIN_LOCK(&dfuse_info->di_lock);
+	d_list_del_init(&ie->ie_wc_entry);
+	D_SPIN_UNLOCK(&dfuse_info->di_lock);
+
+	DFUSE_TRA_DEBUG(ie, "%#zx-%#zx coalesced", ev->de_req_position,
+			ev->de_req_position + ev->de_iov.iov_len - 1);
+
+	/* Held until the write completes so that DFUSE_IE_WFLUSH() waits for it */
+	D_RWLOCK_RDLOCK(&ie->ie_wlock);
+
+	if (ev->de_iov.iov_len == 0) {
+		dfuse_wc_complete(ev);
+		return;
+	}
+
+	rc = dfs_write(ie->ie_dfs->dfs_ns, ie->ie_obj, &ev->de_sgl, ev->de_req_position,
+		       &ev->de_ev);
+	if (rc != 0) {
+		ev->de_ev.ev_error = rc;
+		dfuse_wc_complete(ev);
+		return;
+	}
+
+	/* Send a message to the async thread to wake it up and poll for events */
+	sem_post(&ev->de_eqt->de_sem);
+}
+
+/* Start a new buffer at position, called with ie_wc_lock held.  It holds up to len bytes. */
+static struct dfuse_event *
+wc_alloc(struct dfuse_info *dfuse_info, struct dfuse_inode_entry *ie, off_t position, size_t len)
+{
+	struct dfuse_event *ev;
+	struct dfuse_eq    *eqt;
+	uint64_t            eqt_idx;
+	bool                wake;
+
+	if (atomic_fetch_add_relaxed(&dfuse_info->di_wc_used, DFUSE_MAX_READ) + DFUSE_MAX_READ >
+	    DFUSE_WCOALESCE_MAX) {
+		atomic_fetch_sub_relaxed(&dfuse_info->di_wc_used, DFUSE_MAX_READ);
+		return NULL;
+	}
+
+	eqt_idx = atomic_fetch_add_relaxed(&dfuse_info->di_eqt_idx, 1);
+	eqt     = &dfuse_info->di_eqt[eqt_idx % dfuse_info->di_eq_count];
+
+	ev = d_slab_acquire(eqt->de_write_slab);
+	if (ev == NULL) {
+		atomic_fetch_sub_relaxed(&dfuse_info->di_wc_used, DFUSE_MAX_READ);
+		return NULL;
+	}
+	d_slab_restock(eqt->de_write_slab);
+
+	ev->de_ie           = ie;
+	ev->de_di           = dfuse_info;
+	ev->de_req          = 0;
+	ev->de_req_position = position;
+	ev->de_req_len      = len;
+	ev->de_iov.iov_len  = 0;
+	ev->de_sgl.sg_nr    = 1;
+	ev->de_complete_cb  = dfuse_wc_complete;
+
+	/* Take a ref on active for the buffer, it's dropped in dfuse_wc_complete() */
+	atomic_fetch_add_relaxed(&ie->ie_open_count, 1);
+
+	ie->ie_wc_ev   = ev;
+	ie->ie_wc_time = wc_now();
+	D_SPIN_LOCK(&dfuse_info->di_lock);
+	wake = d_list_empty(&dfuse_info->di_wc_list);
+	d_list_add_tail(&ie->ie_wc_entry, &dfuse_info->di_wc_list);
+	D_SPIN_UNLOCK(&dfuse_info->di_lock);
+
+	/* Have the timeout checked even if the inval thread is sleeping for a long time */
+	if (wake)
+		ival_thread_wake();
+
+	return ev;
+}
+
+/* Try and add a write to the coalescing buffer of the inode.
+ *
+ * Returns true if the write was handled, in which case it has been replied to.  Otherwise the
+ * write has to be made directly, and the read lock of ie_wlock is held for it.
+ */
+static bool
+wc_write(fuse_req_t req, struct dfuse_obj_hdl *oh, struct fuse_bufvec *bufv, off_t position,
+	 size_t len)
+{
+	struct dfuse_info        *dfuse_info = fuse_req_userdata(req);
+	struct dfuse_inode_entry *ie         = oh->doh_ie;
+	struct fuse_bufvec        ibuf       = FUSE_BUFVEC_INIT(len);
+	struct dfuse_event       *ev;
+	size_t                    chunk_size;
+	size_t                    size;
+	ssize_t                   rc;
+
+	D_MUTEX_LOCK(&ie->ie_wc_lock);
+
+	/* Only small writes benefit, others are made directly once the pending buffer is written
+	 * out, so that they land after it.
+	 */
+	if (len == 0 || len >= DFUSE_MAX_READ)
+		goto out;
+
+	ev = ie->ie_wc_ev;
+	if (ev && (position != ev->de_req_position + ev->de_iov.iov_len ||
+		   ev->de_iov.iov_len + len > ev->de_req_len)) {
+		wc_submit(ie);
+		ev = NULL;
+	}
+
+	wc_inflight_wait(ie, position, len);
+
+	if (ev == NULL) {
+		/* A buffer ends on a chunk boundary so is written to a single dkey */
+		chunk_size = ie->ie_stat.st_blksize ? ie->ie_stat.st_blksize : DFUSE_MAX_READ;
+		size       = min(DFUSE_MAX_READ, chunk_size - (position % chunk_size));
+		if (len > size)
+			goto out;
+
+		ev = wc_alloc(dfuse_info, ie, position, size);
+		if (ev == NULL)
+			goto out;
+	}
+
+	ibuf.buf[0].mem = ev->de_iov.iov_buf + ev->de_iov.iov_len;
+
+	rc = fuse_buf_copy(&ibuf, bufv, 0);
+	if (rc != len) {
+		D_MUTEX_UNLOCK(&ie->ie_wc_lock);
+		DFUSE_REPLY_ERR_RAW(oh, req, EIO);
+		return true;
+	}
+	ev->de_iov.iov_len += len;
+	write_update_ie(ie, position, len);
+
+	DFUSE_TRA_DEBUG(oh, "%#zx-%#zx added to %#zx-%#zx", position, position + len - 1,
+			ev->de_req_position, ev->de_req_position + ev->de_req_len - 1);
+
+	if (ev->de_iov.iov_len == ev->de_req_len)
+		wc_submit(ie);
+
+	D_MUTEX_UNLOCK(&ie->ie_wc_lock);
+
+	DFUSE_IE_STAT_ADD(ie, DS_WRITE_COALESCED);
+	DFUSE_REPLY_WRITE(oh, req, len);
+	return true;
+
+out:
+	/* Write this one directly, after any pending writes.  The read lock is taken before
+	 * ie_wc_lock is dropped so that an overlapping write waiting in wc_inflight_wait() can't
+	 * be made before this one.
+	 */
+	wc_submit(ie);
+	wc_inflight_wait(ie, position, len);
+	wc_inflight_add(ie, position, len);
+	D_RWLOCK_RDLOCK(&ie->ie_wlock);
+	D_MUTEX_UNLOCK(&ie->ie_wc_lock);
+	return false;
+}
+
+void
+dfuse_wc_flush(struct dfuse_inode_entry *ie)
+{
+	D_MUTEX_LOCK(&ie->ie_wc_lock);
+	wc_submit(ie);
+	D_MUTEX_UNLOCK(&ie->ie_wc_lock);
+}
+
+int
+dfuse_wc_error(struct dfuse_inode_entry *ie)
+{
+	return atomic_exchange(&ie->ie_wc_err, 0);
+}
+
+bool
+dfuse_wc_expire(struct dfuse_info *dfuse_info)
+{
+	struct dfuse_inode_entry *ie;
+	uint64_t                  now = wc_now();
+	bool                      pending;
+
+	do {
+		D_SPIN_LOCK(&dfuse_info->di_lock);
+		/* The list is in the order the buffers were started */
+		ie = NULL;
+		if (!d_list_empty(&dfuse_info->di_wc_list))
+			ie = d_list_entry(dfuse_info->di_wc_list.next, struct dfuse_inode_entry,
+					  ie_wc_entry);
+		if (ie != NULL && now - ie->ie_wc_time >= DFUSE_WC_TIMEOUT) {
+			/* The buffer holds a ref on active, take another one as the buffer can be
+			 * written out by another thread once the lock is dropped.
+			 */
+			atomic_fetch_add_relaxed(&ie->ie_open_count, 1);
+		} else {
+			ie = NULL;
+		}
+		pending = !d_list_empty(&dfuse_info->di_wc_list);
+		D_SPIN_UNLOCK(&dfuse_info->di_lock);
+
+		if (ie) {
+			dfuse_wc_flush(ie);
+			active_ie_decref(dfuse_info, ie);
+		}
+	} while (ie);
+
+	return pending;
+}
+
 void
 dfuse_cb_write(fuse_req_t req, fuse_ino_t ino, struct fuse_bufvec *bufv, off_t position,
 	       struct fuse_file_info *fi)
@@ -40,15 +373,6 @@ dfuse_cb_write(fuse_req_t req, fuse_ino_t ino, struct fuse_bufvec *bufv, off_t p
 
 	oh->doh_linear_read = false;
 
-	eqt_idx = atomic_fetch_add_relaxed(&dfuse_info->di_eqt_idx, 1);
-
-	eqt = &dfuse_info->di_eqt[eqt_idx % dfuse_info->di_eq_count];
-
-	if (oh->doh_ie->ie_dfs->dfc_wb_cache) {
-		D_RWLOCK_RDLOCK(&oh->doh_ie->ie_wlock);
-		wb_cache = true;
-	}
-
 	DFUSE_TRA_DEBUG(oh, "%#zx-%#zx requested flags %#x", position, position + len - 1,
 			bufv->buf[0].flags);
 
@@ -59,6 +383,20 @@ dfuse_cb_write(fuse_req_t req, fuse_ino_t ino, struct fuse_bufvec *bufv, off_t p
 		}
 	}
 
+	eqt_idx = atomic_fetch_add_relaxed(&dfuse_info->di_eqt_idx, 1);
+
+	eqt = &dfuse_info->di_eqt[eqt_idx % dfuse_info->di_eq_count];
+
+	if (oh->doh_ie->ie_dfs->dfc_wcoalesce) {
+		if (wc_write(req, oh, bufv, position, len))
+			return;
+		/* Coalescing requires the write-back cache, wc_write() took the read lock */
+		wb_cache = true;
+	} else if (oh->doh_ie->ie_dfs->dfc_wb_cache) {
+		D_RWLOCK_RDLOCK(&oh->doh_ie->ie_wlock);
+		wb_cache = true;
+	}
+
 	ev = d_slab_acquire(eqt->de_write_slab);
 	if (ev == NULL)
 		D_GOTO(err, rc = ENOMEM);
@@ -82,24 +420,7 @@ dfuse_cb_write(fuse_req_t req, fuse_ino_t ino, struct fuse_bufvec *bufv, off_t p
 	ev->de_len         = len;
 	ev->de_complete_cb = dfuse_cb_write_complete;
 
-	/* Check for potentially using readahead on this file, ie_truncated
-	 * will only be set if caching is enabled so only check for the one
-	 * flag rather than two here
-	 */
-	if (oh->doh_ie->ie_truncated) {
-		if (oh->doh_ie->ie_start_off == 0 && oh->doh_ie->ie_end_off == 0) {
-			oh->doh_ie->ie_start_off = position;
-			oh->doh_ie->ie_end_off   = position + len;
-		} else {
-			if (oh->doh_ie->ie_start_off > position)
-				oh->doh_ie->ie_start_off = position;
-			if (oh->doh_ie->ie_end_off < position + len)
-				oh->doh_ie->ie_end_off = position + len;
-		}
-	}
-
-	if (len + position > oh->doh_ie->ie_stat.st_size)
-		oh->doh_ie->ie_stat.st_size = len + position;
+	write_update_ie(oh->doh_ie, position, len);
 
 	rc = dfs_write(oh->doh_dfs, oh->doh_obj, &ev->de_sgl, position, &ev->de_ev);
 	if (rc != 0)
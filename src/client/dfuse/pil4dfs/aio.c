@@ -7,10 +7,14 @@
 #define D_LOGFAC DD_FAC(il)
 
 #include <libaio.h>
+#include <aio.h>
 #include <time.h>
 #include <unistd.h>
 #include <pthread.h>
+#include <sched.h>
+#include <signal.h>
 #include <dlfcn.h>
+#include <fcntl.h>
 #include <sys/syscall.h>
 
 #include <daos.h>
@@ -28,15 +32,23 @@ extern struct file_obj  *d_file_list[MAX_OPENED_FILE];
 extern int
 d_get_fd_redirected(int fd);
 
-typedef struct d_aio_req_args {
-	d_iov_t	    iov;
-	d_sg_list_t sgl;
-}d_aio_req_args_t;
+extern int
+d_get_eqh(daos_handle_t *eqh);
 
 struct d_aio_ev {
 	daos_event_t      ev;
 	struct iocb      *piocb;
 	struct d_aio_ctx *ctx;
+	d_sg_list_t       sgl;
+	/* used by IO_CMD_PREAD and IO_CMD_PWRITE */
+	d_iov_t           iov;
+	/* used by IO_CMD_PREADV and IO_CMD_PWRITEV */
+	d_iov_t          *iovs;
+	off_t             offset;
+	/* the number of bytes requested */
+	size_t            nbytes;
+	daos_size_t       read_size;
+	bool              is_read;
 };
 
 struct d_aio_ctx {
@@ -167,21 +179,62 @@ err:
 	return daos_der2errno(rc);
 }
 
+/* set up the sgl of an aio event from its iocb */
 static int
-aio_req_cb(void *args, daos_event_t *ev, int ret)
+aio_ev_set_sgl(struct d_aio_ev *aio_ev)
 {
-	D_FREE(args);
+	struct iocb *piocb = aio_ev->piocb;
+	int          i;
+
+	switch (piocb->aio_lio_opcode) {
+	case IO_CMD_PREAD:
+	case IO_CMD_PWRITE:
+		d_iov_set(&aio_ev->iov, piocb->u.c.buf, piocb->u.c.nbytes);
+		aio_ev->sgl.sg_nr   = 1;
+		aio_ev->sgl.sg_iovs = &aio_ev->iov;
+		aio_ev->offset      = piocb->u.c.offset;
+		aio_ev->nbytes      = piocb->u.c.nbytes;
+		break;
+	case IO_CMD_PREADV:
+	case IO_CMD_PWRITEV:
+		if (piocb->u.v.nr <= 0)
+			return EINVAL;
+		D_ALLOC_ARRAY(aio_ev->iovs, piocb->u.v.nr);
+		if (aio_ev->iovs == NULL)
+			return ENOMEM;
+		for (i = 0; i < piocb->u.v.nr; i++) {
+			d_iov_set(&aio_ev->iovs[i], piocb->u.v.vec[i].iov_base,
+				  piocb->u.v.vec[i].iov_len);
+			aio_ev->nbytes += piocb->u.v.vec[i].iov_len;
+		}
+		aio_ev->sgl.sg_nr   = piocb->u.v.nr;
+		aio_ev->sgl.sg_iovs = aio_ev->iovs;
+		aio_ev->offset      = piocb->u.v.offset;
+		break;
+	default:
+		return EINVAL;
+	}
+	aio_ev->is_read =
+	    (piocb->aio_lio_opcode == IO_CMD_PREAD || piocb->aio_lio_opcode == IO_CMD_PREADV);
+
 	return 0;
 }
 
+static void
+aio_ev_free(struct d_aio_ev *aio_ev)
+{
+	if (aio_ev == NULL)
+		return;
+	D_FREE(aio_ev->iovs);
+	D_FREE(aio_ev);
+}
+
 int
 io_submit(io_context_t ctx, long nr, struct iocb *ios[])
 {
 	d_aio_ctx_t      *aio_ctx_obj = (d_aio_ctx_t *)ctx;
 	io_context_t      ctx_real    = aio_ctx_obj->ctx;
-	daos_size_t       read_size   = 0;
 	struct d_aio_ev  *ctx_ev      = NULL;
-	d_aio_req_args_t *req_args;
 	int               i, n_op_dfs, fd, io_depth;
 	int               rc, rc2;
 	short             op;
@@ -210,9 +263,10 @@ io_submit(io_context_t ctx, long nr, struct iocb *ios[])
 			n_op_dfs++;
 
 		op = ios[i]->aio_lio_opcode;
-		/* only support IO_CMD_PREAD and IO_CMD_PWRITE */
-		if (op != IO_CMD_PREAD && op != IO_CMD_PWRITE) {
-			DS_ERROR(EINVAL, "io_submit only supports PREAD and PWRITE for now");
+		/* only support IO_CMD_PREAD(V) and IO_CMD_PWRITE(V) */
+		if (op != IO_CMD_PREAD && op != IO_CMD_PWRITE && op != IO_CMD_PREADV &&
+		    op != IO_CMD_PWRITEV) {
+			DS_ERROR(EINVAL, "io_submit only supports PREAD(V) and PWRITE(V) for now");
 			D_GOTO(err, rc = EINVAL);
 		}
 	}
@@ -233,58 +287,38 @@ io_submit(io_context_t ctx, long nr, struct iocb *ios[])
 			D_GOTO(err, rc);
 	}
 
+	/* all the requests are in flight at once, they are completed by io_getevents() */
 	for (i = 0; i < nr; i++) {
-		op = ios[i]->aio_lio_opcode;
 		fd = fd_directed[i] - FD_FILE_BASE;
 
 		D_ALLOC_PTR(ctx_ev);
 		if (ctx_ev == NULL)
 			D_GOTO(err_loop, rc = ENOMEM);
+		ctx_ev->piocb = ios[i];
+		/* EQs are shared by contexts. Need to save ctx when polling EQs. */
+		ctx_ev->ctx = aio_ctx_obj;
+		rc = aio_ev_set_sgl(ctx_ev);
+		if (rc)
+			D_GOTO(err_loop, rc);
 
 		rc = daos_event_init(&ctx_ev->ev, aio_ctx_obj->eq, NULL);
 		if (rc) {
 			DL_ERROR(rc, "daos_event_init() failed");
 			D_GOTO(err_loop, rc = daos_der2errno(rc));
 		}
-		ctx_ev->piocb = ios[i];
-		/* EQs are shared by contexts. Need to save ctx when polling EQs. */
-		ctx_ev->ctx = aio_ctx_obj;
-		D_ALLOC_PTR(req_args);
-		if (req_args == NULL)
-			D_GOTO(err_loop, rc = ENOMEM);
-		d_iov_set(&req_args->iov, (void *)ios[i]->u.c.buf, ios[i]->u.c.nbytes);
-		req_args->sgl.sg_nr     = 1;
-		req_args->sgl.sg_iovs   = &req_args->iov;
-
-		if (op == IO_CMD_PREAD) {
-			rc = daos_event_register_comp_cb(&ctx_ev->ev, aio_req_cb, req_args);
-			if (rc) {
-				DL_ERROR(rc, "daos_event_register_comp_cb() failed");
-				D_GOTO(err_loop, rc);
-			}
+
+		if (ctx_ev->is_read)
 			rc = dfs_read(d_file_list[fd]->dfs_mt->dfs, d_file_list[fd]->file,
-				      &req_args->sgl, ios[i]->u.c.offset, &read_size, &ctx_ev->ev);
-			if (rc) {
-				rc2 = daos_event_fini(&ctx_ev->ev);
-				if (rc2)
-					DL_ERROR(rc2, "daos_event_fini() failed");
-				D_GOTO(err_loop, rc);
-			}
-		}
-		if (op == IO_CMD_PWRITE) {
-			rc = daos_event_register_comp_cb(&ctx_ev->ev, aio_req_cb, req_args);
-			if (rc) {
-				DL_ERROR(rc, "daos_event_register_comp_cb() failed");
-				D_GOTO(err_loop, rc);
-			}
+				      &ctx_ev->sgl, ctx_ev->offset, &ctx_ev->read_size,
+				      &ctx_ev->ev);
+		else
 			rc = dfs_write(d_file_list[fd]->dfs_mt->dfs, d_file_list[fd]->file,
-				       &req_args->sgl, ios[i]->u.c.offset, &ctx_ev->ev);
-			if (rc) {
-				rc2 = daos_event_fini(&ctx_ev->ev);
-				if (rc2)
-					DL_ERROR(rc2, "daos_event_fini() failed");
-				D_GOTO(err_loop, rc);
-			}
+				       &ctx_ev->sgl, ctx_ev->offset, &ctx_ev->ev);
+		if (rc) {
+			rc2 = daos_event_fini(&ctx_ev->ev);
+			if (rc2)
+				DL_ERROR(rc2, "daos_event_fini() failed");
+			D_GOTO(err_loop, rc);
 		}
 		aio_ctx_obj->n_op_queued++;
 	}
@@ -301,7 +335,7 @@ err:
 	return (-rc);
 
 err_loop:
-	D_FREE(ctx_ev);
+	aio_ev_free(ctx_ev);
 	D_FREE(fd_directed);
 
 	return i ? i : (-rc);
@@ -330,39 +364,46 @@ io_cancel(io_context_t ctx, struct iocb *iocb, struct io_event *evt)
 
 #define AIO_EQ_DEPTH MAX_EQ
 
-/* poll the event queue of current aio context */
+/* poll the event queue of current aio context, waiting up to timeout us for a completion */
 static void
-aio_poll_eq(struct d_aio_ctx *ctx, long min_nr, long nr, struct io_event *events, int *num_ev)
+aio_poll_eq(struct d_aio_ctx *ctx, int64_t timeout, long nr, struct io_event *events, int *num_ev)
 {
 	int                j;
 	int                rc, rc2;
 	struct daos_event *eps[AIO_EQ_DEPTH + 1] = {0};
 	struct d_aio_ev   *p_aio_ev;
+	struct io_event   *event;
 
 	if (ctx->n_op_queued == 0)
 		return;
 
-	rc = daos_eq_poll(ctx->eq, 0, DAOS_EQ_NOWAIT, min(AIO_EQ_DEPTH, nr - (*num_ev)), eps);
+	rc = daos_eq_poll(ctx->eq, 1, timeout, min(AIO_EQ_DEPTH, nr - (*num_ev)), eps);
 	if (rc < 0)
 		DL_ERROR(rc, "daos_eq_poll() failed");
 
 	for (j = 0; j < rc; j++) {
+		ctx->n_op_queued--;
+		ctx->n_op_done++;
+		p_aio_ev = container_of(eps[j], struct d_aio_ev, ev);
+		/* append to event list, errors are reported as negative errno like the kernel */
+		event       = &events[*num_ev];
+		event->data = p_aio_ev->piocb->data;
+		event->obj  = p_aio_ev->piocb;
+		event->res2 = 0;
 		if (eps[j]->ev_error) {
-			DS_ERROR(eps[j]->ev_error, "daos_eq_poll() error");
+			DS_ERROR(eps[j]->ev_error, "aio request failed");
+			event->res = -eps[j]->ev_error;
+		} else if (p_aio_ev->is_read) {
+			event->res = p_aio_ev->read_size;
 		} else {
-			ctx->n_op_queued--;
-			ctx->n_op_done++;
-			p_aio_ev = container_of(eps[j], struct d_aio_ev, ev);
-			/* append to event list */
-			events[*num_ev].obj = p_aio_ev->piocb;
-			events[*num_ev].res = p_aio_ev->piocb->u.c.nbytes;
-
-			rc2 = daos_event_fini(&p_aio_ev->ev);
-			if (rc2)
-				DL_ERROR(rc2, "daos_event_fini() failed");
-			(*num_ev)++;
-			D_FREE(p_aio_ev);
+			event->res = p_aio_ev->nbytes;
 		}
+
+		rc2 = daos_event_fini(&p_aio_ev->ev);
+		if (rc2)
+			DL_ERROR(rc2, "daos_event_fini() failed");
+		(*num_ev)++;
+		aio_ev_free(p_aio_ev);
 	}
 
 	return;
@@ -382,6 +423,7 @@ io_getevents(io_context_t ctx, long min_nr, long nr, struct io_event *events,
 	d_aio_ctx_t    *aio_ctx_obj = (d_aio_ctx_t *)ctx;
 	io_context_t    ctx_real    = aio_ctx_obj->ctx;
 	int             op_done     = 0;
+	int64_t         wait;
 	struct timespec times_0;
 	struct timespec times_1;
 	struct timespec dt;
@@ -401,28 +443,713 @@ io_getevents(io_context_t ctx, long min_nr, long nr, struct io_event *events,
 		return (-EINVAL);
 	}
 	if (timeout)
-		clock_gettime(CLOCK_REALTIME, &times_0);
+		clock_gettime(CLOCK_MONOTONIC, &times_0);
 
 	if (min_nr > AIO_EQ_DEPTH)
 		min_nr = AIO_EQ_DEPTH;
 
+	/* block in the event queue until min_nr requests completed or the timeout expired */
 	while (1) {
-		aio_poll_eq(aio_ctx_obj, min_nr, nr, events, &op_done);
-		if (op_done >= min_nr)
+		wait = (min_nr > 0) ? DAOS_EQ_WAIT : DAOS_EQ_NOWAIT;
+		if (timeout && min_nr > 0) {
+			clock_gettime(CLOCK_MONOTONIC, &times_1);
+			dt.tv_sec  = timeout->tv_sec - (times_1.tv_sec - times_0.tv_sec);
+			dt.tv_nsec = timeout->tv_nsec - (times_1.tv_nsec - times_0.tv_nsec);
+			wait       = max(dt.tv_sec * 1000000 + dt.tv_nsec / 1000, DAOS_EQ_NOWAIT);
+		}
+		aio_poll_eq(aio_ctx_obj, wait, nr, events, &op_done);
+		if (op_done >= min_nr || wait == DAOS_EQ_NOWAIT || aio_ctx_obj->n_op_queued == 0)
 			return op_done;
-		if (timeout) {
-			clock_gettime(CLOCK_REALTIME, &times_1);
-			dt.tv_sec  = times_1.tv_sec - times_0.tv_sec;
-			dt.tv_nsec = times_1.tv_nsec - times_0.tv_nsec;
-			if (dt.tv_nsec < 0) {
-				dt.tv_sec--;
-				dt.tv_nsec += 1000000000L;
+	}
+	return op_done;
+}
+
+/*
+ * POSIX AIO
+ *
+ * glibc implements POSIX AIO with helper threads calling pread()/pwrite() on the file descriptor,
+ * which is a fake one for files on DFS. Requests on DFS files are instead issued directly to DAOS
+ * with an event of the event queue shared by the calling thread (d_get_eqh()), so the requests of
+ * a thread are all in flight at once. The requests are tracked on a list, in submission order,
+ * until aio_return() is called. Their completion is checked with daos_event_test(), so their events
+ * are never polled out of the shared event queue by other requests. Waiting for a request blocks
+ * in daos_event_test() with the remaining timeout. An fsync request has no event, it completes once
+ * the requests queued before it on the same file completed.
+ */
+
+/* the longest wait on one request, when any of several requests may complete first */
+#define POSIX_AIO_WAIT_SLICE_US 1000
+
+struct d_posix_aio_req {
+	/* entry in posix_aio_list */
+	d_list_t      link;
+	struct aiocb *cb;
+	/* submission order, and fd of the file on DFS */
+	uint64_t      seq;
+	int           fd;
+	daos_event_t  ev;
+	d_iov_t       iov;
+	d_sg_list_t   sgl;
+	daos_size_t   read_size;
+	bool          is_read;
+	bool          is_fsync;
+	/* a thread is blocked in daos_event_test() on the event, without posix_aio_lock */
+	bool          waiting;
+	/* the request completed, error and ret are set */
+	bool          done;
+	int           error;
+	ssize_t       ret;
+};
+
+struct d_posix_aio_notify {
+	void (*fn)(union sigval);
+	union sigval value;
+};
+
+static D_LIST_HEAD(posix_aio_list);
+static pthread_mutex_t posix_aio_lock = PTHREAD_MUTEX_INITIALIZER;
+static uint64_t        posix_aio_seq;
+
+static int (*next_aio_read)(struct aiocb *cb);
+static int (*next_aio_write)(struct aiocb *cb);
+static int (*next_aio_fsync)(int op, struct aiocb *cb);
+static int (*next_aio_error)(const struct aiocb *cb);
+static ssize_t (*next_aio_return)(struct aiocb *cb);
+static int (*next_aio_cancel)(int fd, struct aiocb *cb);
+static int (*next_aio_suspend)(const struct aiocb *const list[], int nent,
+			       const struct timespec *timeout);
+static int (*next_lio_listio)(int mode, struct aiocb *const list[], int nent,
+			      struct sigevent *sig);
+
+#define POSIX_AIO_NEXT(name)                                                                       \
+	do {                                                                                       \
+		if (next_##name == NULL) {                                                         \
+			next_##name = dlsym(RTLD_NEXT, #name);                                     \
+			D_ASSERT(next_##name != NULL);                                             \
+		}                                                                                  \
+	} while (0)
+
+/* return the fd of the file on DFS, or -1 if the file is not on DFS */
+static int
+posix_aio_dfs_fd(int fd)
+{
+	int fd_directed;
+
+	if (!d_hook_enabled)
+		return -1;
+
+	fd_directed = d_get_fd_redirected(fd);
+	if (fd_directed < FD_FILE_BASE || fd_directed >= FD_DIR_BASE)
+		return -1;
+
+	return fd_directed - FD_FILE_BASE;
+}
+
+/* find the request of an aiocb, called with posix_aio_lock held */
+static struct d_posix_aio_req *
+posix_aio_find(const struct aiocb *cb)
+{
+	struct d_posix_aio_req *req;
+
+	d_list_for_each_entry(req, &posix_aio_list, link) {
+		if (req->cb == cb)
+			return req;
+	}
+
+	return NULL;
+}
+
+static void
+posix_aio_complete(struct d_posix_aio_req *req, int rc)
+{
+	req->done  = true;
+	req->error = rc;
+	if (rc)
+		req->ret = -1;
+	else if (req->is_fsync)
+		req->ret = 0;
+	else if (req->is_read)
+		req->ret = req->read_size;
+	else
+		req->ret = req->cb->aio_nbytes;
+}
+
+/* complete a request after testing its event, called with posix_aio_lock held */
+static void
+posix_aio_ev_tested(struct d_posix_aio_req *req, int rc, bool flag)
+{
+	if (rc) {
+		DL_ERROR(rc, "daos_event_test() failed");
+		rc = daos_der2errno(rc);
+	} else if (flag) {
+		rc = req->ev.ev_error;
+	} else {
+		return;
+	}
+	posix_aio_complete(req, rc);
+
+	rc = daos_event_fini(&req->ev);
+	if (rc)
+		DL_ERROR(rc, "daos_event_fini() failed");
+}
+
+static void
+posix_aio_test(struct d_posix_aio_req *req);
+
+/*
+ * Return the first request still in flight that was queued on the file of an fsync request
+ * before it, or NULL if there is none. Called with posix_aio_lock held.
+ */
+static struct d_posix_aio_req *
+posix_aio_fsync_dep(struct d_posix_aio_req *fsync)
+{
+	struct d_posix_aio_req *req;
+
+	d_list_for_each_entry(req, &posix_aio_list, link) {
+		if (req->seq >= fsync->seq)
+			break;
+		if (req->fd != fsync->fd || req->is_fsync)
+			continue;
+		posix_aio_test(req);
+		if (!req->done)
+			return req;
+	}
+
+	return NULL;
+}
+
+/* check for the completion of a request, called with posix_aio_lock held */
+static void
+posix_aio_test(struct d_posix_aio_req *req)
+{
+	bool flag = false;
+	int  rc;
+
+	if (req->done)
+		return;
+
+	if (req->is_fsync) {
+		if (posix_aio_fsync_dep(req) == NULL)
+			posix_aio_complete(req, 0);
+		return;
+	}
+
+	/* the thread blocked on the event completes the request */
+	if (req->waiting)
+		return;
+
+	rc = daos_event_test(&req->ev, DAOS_EQ_NOWAIT, &flag);
+	posix_aio_ev_tested(req, rc, flag);
+}
+
+/*
+ * Wait up to timeout us, or DAOS_EQ_WAIT, for a request still in flight to complete. Called with
+ * posix_aio_lock held, which is released while blocked in daos_event_test().
+ */
+static void
+posix_aio_wait(struct d_posix_aio_req *req, int64_t timeout)
+{
+	bool flag = false;
+	int  rc;
+
+	if (req->is_fsync) {
+		req = posix_aio_fsync_dep(req);
+		if (req == NULL)
+			return;
+	}
+
+	if (req->waiting) {
+		/* another thread is blocked on the event and completes the request */
+		D_MUTEX_UNLOCK(&posix_aio_lock);
+		sched_yield();
+		D_MUTEX_LOCK(&posix_aio_lock);
+		return;
+	}
+
+	req->waiting = true;
+	D_MUTEX_UNLOCK(&posix_aio_lock);
+	rc = daos_event_test(&req->ev, timeout, &flag);
+	D_MUTEX_LOCK(&posix_aio_lock);
+	req->waiting = false;
+	posix_aio_ev_tested(req, rc, flag);
+}
+
+/* wait for a request to complete and return its error status */
+static int
+posix_aio_wait_one(const struct aiocb *cb)
+{
+	struct d_posix_aio_req *req;
+	int                     rc;
+
+	D_MUTEX_LOCK(&posix_aio_lock);
+	req = posix_aio_find(cb);
+	if (req == NULL) {
+		D_MUTEX_UNLOCK(&posix_aio_lock);
+		while ((rc = next_aio_error(cb)) == EINPROGRESS)
+			next_aio_suspend(&cb, 1, NULL);
+		return rc;
+	}
+	posix_aio_test(req);
+	while (!req->done) {
+		posix_aio_wait(req, DAOS_EQ_WAIT);
+		posix_aio_test(req);
+	}
+	rc = req->error;
+	D_MUTEX_UNLOCK(&posix_aio_lock);
+
+	return rc;
+}
+
+static void *
+posix_aio_notify_thread(void *arg)
+{
+	struct d_posix_aio_notify *notify = arg;
+
+	notify->fn(notify->value);
+	D_FREE(notify);
+
+	return NULL;
+}
+
+/* deliver the notification of a request completed synchronously */
+static void
+posix_aio_notify(struct sigevent *sev)
+{
+	struct d_posix_aio_notify *notify;
+	pthread_attr_t             attr;
+	pthread_attr_t            *pattr = sev->sigev_notify_attributes;
+	pthread_t                  tid;
+	int                        rc;
+
+	switch (sev->sigev_notify) {
+	case SIGEV_SIGNAL:
+		if (sigqueue(getpid(), sev->sigev_signo, sev->sigev_value))
+			DS_ERROR(errno, "sigqueue() failed");
+		break;
+	case SIGEV_THREAD:
+		D_ALLOC_PTR(notify);
+		if (notify == NULL)
+			break;
+		notify->fn    = sev->sigev_notify_function;
+		notify->value = sev->sigev_value;
+		if (pattr == NULL) {
+			pthread_attr_init(&attr);
+			pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+			pattr = &attr;
+		}
+		rc = pthread_create(&tid, pattr, posix_aio_notify_thread, notify);
+		if (rc) {
+			DS_ERROR(rc, "pthread_create() failed");
+			D_FREE(notify);
+		}
+		if (pattr == &attr)
+			pthread_attr_destroy(&attr);
+		break;
+	default:
+		break;
+	}
+}
+
+/*
+ * Queue an fsync request. DAOS writes are durable once they completed, so the request completes
+ * once all the requests queued before it on the same file completed.
+ */
+static int
+posix_aio_submit_fsync(struct d_posix_aio_req *req, bool sync)
+{
+	struct sigevent *sev = &req->cb->aio_sigevent;
+
+	D_MUTEX_LOCK(&posix_aio_lock);
+	req->seq = ++posix_aio_seq;
+	d_list_add_tail(&req->link, &posix_aio_list);
+	posix_aio_test(req);
+	while (sync && !req->done) {
+		posix_aio_wait(req, DAOS_EQ_WAIT);
+		posix_aio_test(req);
+	}
+	D_MUTEX_UNLOCK(&posix_aio_lock);
+
+	if (sync && sev->sigev_notify != SIGEV_NONE)
+		posix_aio_notify(sev);
+
+	return 0;
+}
+
+/*
+ * Queue a request on a DFS file. Errors from DAOS are reported by aio_error(), as the kernel
+ * does, so only the failure to allocate the request is returned.
+ */
+static int
+posix_aio_submit(struct aiocb *cb, int fd, int op)
+{
+	struct d_posix_aio_req *req;
+	struct file_obj        *file = d_file_list[fd];
+	daos_event_t           *ev   = NULL;
+	daos_handle_t           eqh;
+	bool                    sync;
+	bool                    notify = false;
+	int                     rc;
+
+	D_ALLOC_PTR(req);
+	if (req == NULL)
+		return EAGAIN;
+	req->cb       = cb;
+	req->fd       = fd;
+	req->is_read  = (op == LIO_READ);
+	req->is_fsync = (op == LIO_NOP);
+	d_iov_set(&req->iov, (void *)cb->aio_buf, cb->aio_nbytes);
+	req->sgl.sg_nr   = 1;
+	req->sgl.sg_iovs = &req->iov;
+
+	/* Without an event queue, or with a notification to deliver, the request is completed
+	 * before returning.
+	 */
+	sync = (cb->aio_sigevent.sigev_notify != SIGEV_NONE || d_get_eqh(&eqh) != 0);
+	if (op == LIO_NOP)
+		return posix_aio_submit_fsync(req, sync);
+
+	if (!sync) {
+		rc = daos_event_init(&req->ev, eqh, NULL);
+		if (rc) {
+			DL_ERROR(rc, "daos_event_init() failed");
+			D_FREE(req);
+			return daos_der2errno(rc);
+		}
+		ev = &req->ev;
+	}
+
+	if (op == LIO_READ)
+		rc = dfs_read(file->dfs_mt->dfs, file->file, &req->sgl, cb->aio_offset,
+			      &req->read_size, ev);
+	else
+		rc = dfs_write(file->dfs_mt->dfs, file->file, &req->sgl, cb->aio_offset, ev);
+
+	if (ev == NULL || rc) {
+		if (ev) {
+			int rc2 = daos_event_fini(ev);
+
+			if (rc2)
+				DL_ERROR(rc2, "daos_event_fini() failed");
+		}
+		posix_aio_complete(req, rc);
+		notify = (cb->aio_sigevent.sigev_notify != SIGEV_NONE);
+	}
+
+	D_MUTEX_LOCK(&posix_aio_lock);
+	req->seq = ++posix_aio_seq;
+	d_list_add_tail(&req->link, &posix_aio_list);
+	D_MUTEX_UNLOCK(&posix_aio_lock);
+
+	/* the request is tracked first, so the notified code can call aio_error() on it */
+	if (notify)
+		posix_aio_notify(&cb->aio_sigevent);
+
+	return 0;
+}
+
+int
+aio_read(struct aiocb *cb)
+{
+	int fd, rc;
+
+	POSIX_AIO_NEXT(aio_read);
+	fd = posix_aio_dfs_fd(cb->aio_fildes);
+	if (fd < 0)
+		return next_aio_read(cb);
+
+	rc = posix_aio_submit(cb, fd, LIO_READ);
+	if (rc) {
+		errno = rc;
+		return -1;
+	}
+	return 0;
+}
+
+int
+aio_read64(struct aiocb64 *cb) __attribute__((alias("aio_read")));
+
+int
+aio_write(struct aiocb *cb)
+{
+	int fd, rc;
+
+	POSIX_AIO_NEXT(aio_write);
+	fd = posix_aio_dfs_fd(cb->aio_fildes);
+	if (fd < 0)
+		return next_aio_write(cb);
+
+	rc = posix_aio_submit(cb, fd, LIO_WRITE);
+	if (rc) {
+		errno = rc;
+		return -1;
+	}
+	return 0;
+}
+
+int
+aio_write64(struct aiocb64 *cb) __attribute__((alias("aio_write")));
+
+int
+aio_fsync(int op, struct aiocb *cb)
+{
+	int fd, rc;
+
+	POSIX_AIO_NEXT(aio_fsync);
+	fd = posix_aio_dfs_fd(cb->aio_fildes);
+	if (fd < 0)
+		return next_aio_fsync(op, cb);
+
+	if (op != O_SYNC && op != O_DSYNC) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	rc = posix_aio_submit(cb, fd, LIO_NOP);
+	if (rc) {
+		errno = rc;
+		return -1;
+	}
+	return 0;
+}
+
+int
+aio_fsync64(int op, struct aiocb64 *cb) __attribute__((alias("aio_fsync")));
+
+int
+aio_error(const struct aiocb *cb)
+{
+	struct d_posix_aio_req *req;
+	int                     rc;
+
+	POSIX_AIO_NEXT(aio_error);
+
+	D_MUTEX_LOCK(&posix_aio_lock);
+	req = posix_aio_find(cb);
+	if (req == NULL) {
+		D_MUTEX_UNLOCK(&posix_aio_lock);
+		return next_aio_error(cb);
+	}
+	posix_aio_test(req);
+	rc = req->done ? req->error : EINPROGRESS;
+	D_MUTEX_UNLOCK(&posix_aio_lock);
+
+	return rc;
+}
+
+int
+aio_error64(const struct aiocb64 *cb) __attribute__((alias("aio_error")));
+
+ssize_t
+aio_return(struct aiocb *cb)
+{
+	struct d_posix_aio_req *req;
+	ssize_t                 ret;
+
+	POSIX_AIO_NEXT(aio_return);
+
+	D_MUTEX_LOCK(&posix_aio_lock);
+	req = posix_aio_find(cb);
+	if (req == NULL) {
+		D_MUTEX_UNLOCK(&posix_aio_lock);
+		return next_aio_return(cb);
+	}
+	posix_aio_test(req);
+	if (!req->done) {
+		D_MUTEX_UNLOCK(&posix_aio_lock);
+		errno = EINVAL;
+		return -1;
+	}
+	d_list_del(&req->link);
+	D_MUTEX_UNLOCK(&posix_aio_lock);
+
+	ret = req->ret;
+	if (ret < 0)
+		errno = req->error;
+	D_FREE(req);
+
+	return ret;
+}
+
+ssize_t
+aio_return64(struct aiocb64 *cb) __attribute__((alias("aio_return")));
+
+int
+aio_cancel(int fd, struct aiocb *cb)
+{
+	struct d_posix_aio_req *req;
+	int                     rc = AIO_ALLDONE;
+
+	POSIX_AIO_NEXT(aio_cancel);
+	if (posix_aio_dfs_fd(fd) < 0)
+		return next_aio_cancel(fd, cb);
+
+	/* DAOS requests can not be aborted, the ones in flight are reported as not canceled */
+	D_MUTEX_LOCK(&posix_aio_lock);
+	d_list_for_each_entry(req, &posix_aio_list, link) {
+		if (cb ? req->cb != cb : req->cb->aio_fildes != fd)
+			continue;
+		posix_aio_test(req);
+		if (!req->done)
+			rc = AIO_NOTCANCELED;
+	}
+	D_MUTEX_UNLOCK(&posix_aio_lock);
+
+	return rc;
+}
+
+int
+aio_cancel64(int fd, struct aiocb64 *cb) __attribute__((alias("aio_cancel")));
+
+/* return true if any of the requests is on a DFS file */
+static bool
+posix_aio_list_on_dfs(const struct aiocb *const list[], int nent)
+{
+	bool found = false;
+	int  i;
+
+	D_MUTEX_LOCK(&posix_aio_lock);
+	for (i = 0; i < nent && !found; i++)
+		found = (list[i] != NULL && posix_aio_find(list[i]) != NULL);
+	D_MUTEX_UNLOCK(&posix_aio_lock);
+
+	return found;
+}
+
+int
+aio_suspend(const struct aiocb *const list[], int nent, const struct timespec *timeout)
+{
+	struct d_posix_aio_req *req;
+	struct d_posix_aio_req *pending;
+	struct timespec         times_0;
+	struct timespec         times_1;
+	int64_t                 wait;
+	int                     n_pending;
+	int                     i;
+
+	POSIX_AIO_NEXT(aio_suspend);
+	POSIX_AIO_NEXT(aio_error);
+	if (!d_hook_enabled || !posix_aio_list_on_dfs(list, nent))
+		return next_aio_suspend(list, nent, timeout);
+
+	if (timeout)
+		clock_gettime(CLOCK_MONOTONIC, &times_0);
+
+	D_MUTEX_LOCK(&posix_aio_lock);
+	while (1) {
+		pending   = NULL;
+		n_pending = 0;
+		for (i = 0; i < nent; i++) {
+			if (list[i] == NULL)
+				continue;
+			req = posix_aio_find(list[i]);
+			if (req == NULL) {
+				/* a request on another file */
+				if (next_aio_error(list[i]) != EINPROGRESS)
+					goto out;
+				n_pending++;
+				continue;
 			}
-			if ((dt.tv_sec > timeout->tv_sec) ||
-			    ((dt.tv_sec == timeout->tv_sec) && ((dt.tv_nsec > timeout->tv_nsec)))) {
-				return op_done;
+			posix_aio_test(req);
+			if (req->done)
+				goto out;
+			if (pending == NULL)
+				pending = req;
+			n_pending++;
+		}
+		if (pending == NULL) {
+			D_MUTEX_UNLOCK(&posix_aio_lock);
+			return next_aio_suspend(list, nent, timeout);
+		}
+
+		wait = DAOS_EQ_WAIT;
+		if (timeout) {
+			clock_gettime(CLOCK_MONOTONIC, &times_1);
+			wait = (timeout->tv_sec - times_1.tv_sec + times_0.tv_sec) * 1000000 +
+			       (timeout->tv_nsec - times_1.tv_nsec + times_0.tv_nsec) / 1000;
+			if (wait <= 0) {
+				D_MUTEX_UNLOCK(&posix_aio_lock);
+				errno = EAGAIN;
+				return -1;
 			}
 		}
+		/* block on the first request, the others are checked again after a while */
+		if (n_pending > 1 && (wait == DAOS_EQ_WAIT || wait > POSIX_AIO_WAIT_SLICE_US))
+			wait = POSIX_AIO_WAIT_SLICE_US;
+		posix_aio_wait(pending, wait);
 	}
-	return op_done;
+
+out:
+	D_MUTEX_UNLOCK(&posix_aio_lock);
+	return 0;
 }
+
+int
+aio_suspend64(const struct aiocb64 *const list[], int nent, const struct timespec *timeout)
+    __attribute__((alias("aio_suspend")));
+
+int
+lio_listio(int mode, struct aiocb *const list[], int nent, struct sigevent *sig)
+{
+	bool failed = false;
+	bool on_dfs = false;
+	int  i, fd, op, rc;
+
+	POSIX_AIO_NEXT(lio_listio);
+	POSIX_AIO_NEXT(aio_read);
+	POSIX_AIO_NEXT(aio_write);
+	POSIX_AIO_NEXT(aio_error);
+	POSIX_AIO_NEXT(aio_suspend);
+	for (i = 0; i < nent && !on_dfs; i++)
+		on_dfs = (list[i] != NULL && posix_aio_dfs_fd(list[i]->aio_fildes) >= 0);
+	if (!on_dfs)
+		return next_lio_listio(mode, list, nent, sig);
+
+	if (mode != LIO_WAIT && mode != LIO_NOWAIT) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	for (i = 0; i < nent; i++) {
+		if (list[i] == NULL)
+			continue;
+		op = list[i]->aio_lio_opcode;
+		if (op == LIO_NOP)
+			continue;
+		if (op != LIO_READ && op != LIO_WRITE) {
+			failed = true;
+			continue;
+		}
+		fd = posix_aio_dfs_fd(list[i]->aio_fildes);
+		if (fd >= 0)
+			rc = posix_aio_submit(list[i], fd, op);
+		else if (op == LIO_READ)
+			rc = next_aio_read(list[i]) ? errno : 0;
+		else
+			rc = next_aio_write(list[i]) ? errno : 0;
+		if (rc)
+			failed = true;
+	}
+
+	/* the notification of the whole list is delivered once all the requests completed */
+	if (mode == LIO_WAIT || (sig != NULL && sig->sigev_notify != SIGEV_NONE)) {
+		for (i = 0; i < nent; i++) {
+			if (list[i] == NULL || list[i]->aio_lio_opcode == LIO_NOP)
+				continue;
+			rc = posix_aio_wait_one(list[i]);
+			if (rc)
+				failed = true;
+		}
+		if (mode == LIO_NOWAIT)
+			posix_aio_notify(sig);
+	}
+
+	if (failed) {
+		errno = EIO;
+		return -1;
+	}
+	return 0;
+}
+
+int
+lio_listio64(int mode, struct aiocb64 *const list[], int nent, struct sigevent *sig)
+    __attribute__((alias("lio_listio")));
@@ -29,6 +29,11 @@
 #define DCACHE_KEY_PREF_SIZE 35
 #define DCACHE_KEY_MAX       (DCACHE_KEY_PREF_SIZE - 1 + PATH_MAX)
 
+/** Maximal number of directories waiting to be prefetched */
+#define DCACHE_PREFETCH_QUEUE_MAX 64
+/** Number of entries enumerated per call when prefetching a directory */
+#define DCACHE_PREFETCH_BATCH     64
+
 #ifdef DAOS_BUILD_RELEASE
 
 #define DF_DK          "dk[%zi]"
@@ -72,6 +77,30 @@ struct dfs_dcache {
 	struct timespec     dd_expire_gc;
 	/** True iff one thread is running the garbage collection */
 	atomic_flag         dd_running_gc;
+	/** Maximal number of child directories prefetched per directory, 0 if disabled */
+	uint32_t            dd_prefetch_max;
+	/** Mutex protecting access to the prefetch queue */
+	pthread_mutex_t     dd_prefetch_mutex;
+	/** Condition signaled when a directory is queued or the prefetcher should stop */
+	pthread_cond_t      dd_prefetch_cond;
+	/** Entry head of the directories waiting to be prefetched */
+	d_list_t            dd_prefetch_head;
+	/** Size of the prefetch queue */
+	uint32_t            dd_prefetch_count;
+	/** Thread prefetching the queued directories */
+	pthread_t           dd_prefetch_thread;
+	/** Process which started the prefetch thread, 0 if it was not started */
+	pid_t               dd_prefetch_pid;
+	/** True iff the prefetch thread should exit */
+	atomic_bool         dd_prefetch_stop;
+	/** Number of directories enumerated by the prefetcher */
+	_Atomic uint64_t    dd_prefetch_dirs;
+	/** Number of dir-cache records added by the prefetcher */
+	_Atomic uint64_t    dd_prefetch_recs;
+	/** Number of lookups which hit a dir-cache record added by the prefetcher */
+	_Atomic uint64_t    dd_prefetch_hits;
+	/** Number of directories not prefetched because the queue was full */
+	_Atomic uint64_t    dd_prefetch_drops;
 	/** Destroy a dfs dir-cache */
 	destroy_fn_t        destroy_fn;
 	/** Return the dir-cahe record of a given location and insert it if needed */
@@ -102,6 +131,12 @@ struct dcache_rec {
 	bool             dr_deleted_gc;
 	/** Expiration date of the record */
 	struct timespec  dr_expire_gc;
+	/** True iff the child directories of this record were queued for prefetching */
+	atomic_flag      dr_prefetch;
+	/** Entry in the prefetch queue */
+	d_list_t         dr_entry_prefetch;
+	/** True iff this record was added by the prefetcher and was not looked up yet */
+	atomic_bool      dr_prefetched;
 	/** Key prefix used by its child directory */
 	char             dr_key_child_prefix[DCACHE_KEY_PREF_SIZE];
 	/** Length of the hash key used to compute the hash index */
@@ -404,6 +439,8 @@ static void
 drec_del_at_act(dfs_dcache_t *dcache, dcache_rec_t *rec);
 static int
 drec_del_act(dfs_dcache_t *dcache, char *path, dcache_rec_t *parent);
+static void
+prefetch_stop(dfs_dcache_t *dcache);
 
 static inline int
 dcache_add_root(dfs_dcache_t *dcache, dfs_obj_t *obj)
@@ -418,6 +455,8 @@ dcache_add_root(dfs_dcache_t *dcache, dfs_obj_t *obj)
 	rec->dr_obj = obj;
 	atomic_init(&rec->dr_ref, 0);
 	atomic_flag_clear(&rec->dr_deleted);
+	atomic_flag_clear(&rec->dr_prefetch);
+	atomic_init(&rec->dr_prefetched, false);
 	memcpy(&rec->dr_key_child_prefix[0], &dcache->dd_key_root_prefix[0], DCACHE_KEY_PREF_SIZE);
 	memcpy(&rec->dr_key[0], &dcache->dd_key_root_prefix[0], DCACHE_KEY_PREF_SIZE);
 	rec->dr_key_len = DCACHE_KEY_PREF_SIZE - 1;
@@ -434,7 +473,7 @@ out:
 
 static int
 dcache_create_act(dfs_t *dfs, uint32_t bits, uint32_t rec_timeout, uint32_t gc_period,
-		  uint32_t gc_reclaim_max, dfs_dcache_t **dcache)
+		  uint32_t gc_reclaim_max, uint32_t prefetch_max, dfs_dcache_t **dcache)
 {
 	dfs_dcache_t *dcache_tmp;
 	dfs_obj_t    *obj;
@@ -451,6 +490,7 @@ dcache_create_act(dfs_t *dfs, uint32_t bits, uint32_t rec_timeout, uint32_t gc_p
 	dcache_tmp->dd_period_gc      = gc_period;
 	dcache_tmp->dd_reclaim_max_gc = gc_reclaim_max;
 	dcache_tmp->dd_count_gc       = 0;
+	dcache_tmp->dd_prefetch_max   = prefetch_max;
 	dcache_tmp->destroy_fn        = dcache_destroy_act;
 	dcache_tmp->find_insert_fn    = dcache_find_insert_act;
 	dcache_tmp->drec_incref_fn    = drec_incref_act;
@@ -473,6 +513,15 @@ dcache_create_act(dfs_t *dfs, uint32_t bits, uint32_t rec_timeout, uint32_t gc_p
 	atomic_flag_clear(&dcache_tmp->dd_running_gc);
 	D_INIT_LIST_HEAD(&dcache_tmp->dd_head_gc);
 
+	rc = D_MUTEX_INIT(&dcache_tmp->dd_prefetch_mutex, NULL);
+	if (rc != 0)
+		D_GOTO(error_prefetch_mutex, daos_errno2der(rc));
+	rc = D_COND_INIT(&dcache_tmp->dd_prefetch_cond, NULL);
+	if (rc != 0)
+		D_GOTO(error_prefetch_cond, daos_errno2der(rc));
+	D_INIT_LIST_HEAD(&dcache_tmp->dd_prefetch_head);
+	atomic_init(&dcache_tmp->dd_prefetch_stop, false);
+
 	rc = d_hash_table_create_inplace(D_HASH_FT_MUTEX | D_HASH_FT_LRU, bits, NULL,
 					 &dcache_hash_ops, &dcache_tmp->dd_dir_hash);
 	if (rc != 0)
@@ -493,6 +542,10 @@ dcache_create_act(dfs_t *dfs, uint32_t bits, uint32_t rec_timeout, uint32_t gc_p
 error_add_root:
 	d_hash_table_destroy_inplace(&dcache_tmp->dd_dir_hash, true);
 error_htable:
+	D_COND_DESTROY(&dcache_tmp->dd_prefetch_cond);
+error_prefetch_cond:
+	D_MUTEX_DESTROY(&dcache_tmp->dd_prefetch_mutex);
+error_prefetch_mutex:
 	D_MUTEX_DESTROY(&dcache_tmp->dd_mutex_gc);
 error_mutex:
 	dfs_release(obj);
@@ -508,6 +561,8 @@ dcache_destroy_act(dfs_dcache_t *dcache)
 	d_list_t *rlink;
 	int       rc;
 
+	prefetch_stop(dcache);
+
 	while ((rlink = d_hash_rec_first(&dcache->dd_dir_hash)) != NULL) {
 		dcache_rec_t *rec;
 		bool          deleted;
@@ -534,6 +589,18 @@ dcache_destroy_act(dfs_dcache_t *dcache)
 		D_GOTO(out, rc);
 	}
 
+	rc = D_COND_DESTROY(&dcache->dd_prefetch_cond);
+	if (rc != 0) {
+		DL_ERROR(rc, "D_COND_DESTROY() failed");
+		D_GOTO(out, rc);
+	}
+
+	rc = D_MUTEX_DESTROY(&dcache->dd_prefetch_mutex);
+	if (rc != 0) {
+		DL_ERROR(rc, "D_MUTEX_DESTROY() failed");
+		D_GOTO(out, rc);
+	}
+
 	D_FREE(dcache);
 
 out:
@@ -557,7 +624,7 @@ dcache_get(dfs_dcache_t *dcache, const char *key, size_t key_len)
 
 static inline int
 dcache_add(dfs_dcache_t *dcache, dcache_rec_t *parent, const char *name, const char *key,
-	   size_t key_len, dcache_rec_t **rec)
+	   size_t key_len, bool prefetched, dcache_rec_t **rec)
 {
 	dcache_rec_t *rec_tmp = NULL;
 	dfs_obj_t    *obj     = NULL;
@@ -572,6 +639,8 @@ dcache_add(dfs_dcache_t *dcache, dcache_rec_t *parent, const char *name, const c
 
 	atomic_init(&rec_tmp->dr_ref, 1);
 	atomic_flag_clear(&rec_tmp->dr_deleted);
+	atomic_flag_clear(&rec_tmp->dr_prefetch);
+	atomic_init(&rec_tmp->dr_prefetched, prefetched);
 
 	rc = dfs_lookup_rel(dcache->dd_dfs, parent->dr_obj, name, O_RDWR, &obj, &mode, NULL);
 	if (rc != 0)
@@ -599,6 +668,8 @@ dcache_add(dfs_dcache_t *dcache, dcache_rec_t *parent, const char *name, const c
 		D_DEBUG(DB_TRACE, "add record " DF_DK " with ref counter %u",
 			DP_DK(rec_tmp->dr_key), rec_tmp->dr_ref);
 		gc_add_rec(dcache, rec_tmp);
+		if (prefetched)
+			atomic_fetch_add(&dcache->dd_prefetch_recs, 1);
 	} else {
 		dcache_rec_free(&dcache->dd_dir_hash, &rec_tmp->dr_entry);
 		rec_tmp = dlist2drec(rlink);
@@ -614,6 +685,198 @@ out:
 	return rc;
 }
 
+/** Argument of the callback adding the child directories of a prefetched directory */
+struct prefetch_arg {
+	/** The dir-cache being filled */
+	dfs_dcache_t *pa_dcache;
+	/** Record of the directory being enumerated */
+	dcache_rec_t *pa_parent;
+	/** Number of child directories found so far */
+	uint32_t      pa_count;
+	/** Buffer holding the hash key of a child directory */
+	char         *pa_key;
+};
+
+static int
+prefetch_filler(dfs_t *dfs, dfs_obj_t *obj, const char name[], mode_t mode, daos_obj_id_t oid,
+		void *arg)
+{
+	const size_t         key_prefix_len = DCACHE_KEY_PREF_SIZE - 1;
+	struct prefetch_arg *pa             = arg;
+	dfs_dcache_t        *dcache         = pa->pa_dcache;
+	dcache_rec_t        *rec;
+	size_t               key_len;
+	int                  rc;
+
+	/* NOTE Only directories are cached: the mode returned with the entry avoids looking up
+	 * the other ones */
+	if (!S_ISDIR(mode) || pa->pa_count >= dcache->dd_prefetch_max)
+		return 0;
+	++pa->pa_count;
+
+	key_len = key_prefix_len + strnlen(name, DFS_MAX_NAME);
+	memcpy(pa->pa_key + key_prefix_len, name, key_len - key_prefix_len);
+	pa->pa_key[key_len] = '\0';
+
+	rec = dcache_get(dcache, pa->pa_key, key_len);
+	if (rec == NULL) {
+		rc = dcache_add(dcache, pa->pa_parent, name, pa->pa_key, key_len, true, &rec);
+		if (rc != -DER_SUCCESS) {
+			/* NOTE Eventually happen if the entry was removed since its enumeration */
+			D_DEBUG(DB_TRACE, "prefetch of record " DF_DK " failed: " DF_RC "\n",
+				DP_DK(pa->pa_key), DP_RC(rc));
+			return 0;
+		}
+	}
+	drec_decref_act(dcache, rec);
+
+	return 0;
+}
+
+static void
+prefetch_dir(dfs_dcache_t *dcache, dcache_rec_t *rec)
+{
+	struct prefetch_arg pa = {.pa_dcache = dcache, .pa_parent = rec};
+	daos_anchor_t       anchor = {0};
+	uint32_t            nr;
+	int                 rc;
+
+	D_ALLOC(pa.pa_key, DCACHE_KEY_PREF_SIZE + DFS_MAX_NAME);
+	if (pa.pa_key == NULL)
+		return;
+	memcpy(pa.pa_key, rec->dr_key_child_prefix, DCACHE_KEY_PREF_SIZE - 1);
+
+	atomic_fetch_add(&dcache->dd_prefetch_dirs, 1);
+	while (!daos_anchor_is_eof(&anchor) && pa.pa_count < dcache->dd_prefetch_max &&
+	       !atomic_load_relaxed(&dcache->dd_prefetch_stop)) {
+		nr = DCACHE_PREFETCH_BATCH;
+		rc = dfs_iterate_plus(dcache->dd_dfs, rec->dr_obj, &anchor, &nr,
+				      (DFS_MAX_NAME + 1) * nr, prefetch_filler, &pa);
+		if (rc != 0) {
+			DS_WARN(rc, "dfs_iterate_plus() failed");
+			break;
+		}
+	}
+	D_DEBUG(DB_TRACE, "prefetched %u child directories of record " DF_DK "\n", pa.pa_count,
+		DP_DK(rec->dr_key));
+
+	D_FREE(pa.pa_key);
+}
+
+static void *
+prefetch_thread(void *arg)
+{
+	dfs_dcache_t *dcache = arg;
+	dcache_rec_t *rec;
+	int           rc;
+
+	rc = D_MUTEX_LOCK(&dcache->dd_prefetch_mutex);
+	D_ASSERT(rc == 0);
+	for (;;) {
+		while (d_list_empty(&dcache->dd_prefetch_head) &&
+		       !atomic_load_relaxed(&dcache->dd_prefetch_stop))
+			pthread_cond_wait(&dcache->dd_prefetch_cond, &dcache->dd_prefetch_mutex);
+		if (atomic_load_relaxed(&dcache->dd_prefetch_stop))
+			break;
+
+		rec = d_list_pop_entry(&dcache->dd_prefetch_head, dcache_rec_t, dr_entry_prefetch);
+		D_ASSERT(dcache->dd_prefetch_count > 0);
+		--dcache->dd_prefetch_count;
+		rc = D_MUTEX_UNLOCK(&dcache->dd_prefetch_mutex);
+		D_ASSERT(rc == 0);
+
+		prefetch_dir(dcache, rec);
+		drec_decref_act(dcache, rec);
+
+		rc = D_MUTEX_LOCK(&dcache->dd_prefetch_mutex);
+		D_ASSERT(rc == 0);
+	}
+	rc = D_MUTEX_UNLOCK(&dcache->dd_prefetch_mutex);
+	D_ASSERT(rc == 0);
+
+	return NULL;
+}
+
+/** Queue a directory to have its child directories added to the dir-cache in the background */
+static void
+prefetch_queue(dfs_dcache_t *dcache, dcache_rec_t *rec)
+{
+	int rc;
+
+	if (dcache->dd_prefetch_max == 0 || atomic_flag_test_and_set(&rec->dr_prefetch))
+		return;
+
+	rc = D_MUTEX_LOCK(&dcache->dd_prefetch_mutex);
+	D_ASSERT(rc == 0);
+
+	if (dcache->dd_prefetch_pid != getpid()) {
+		/* NOTE The prefetch thread does not survive to a fork() */
+		if (dcache->dd_prefetch_pid != 0)
+			D_GOTO(unlock, rc);
+
+		rc = pthread_create(&dcache->dd_prefetch_thread, NULL, prefetch_thread, dcache);
+		if (rc != 0) {
+			DS_WARN(rc, "pthread_create() failed: dir-cache prefetch disabled");
+			dcache->dd_prefetch_max = 0;
+			D_GOTO(unlock, rc);
+		}
+		dcache->dd_prefetch_pid = getpid();
+	}
+
+	if (dcache->dd_prefetch_count >= DCACHE_PREFETCH_QUEUE_MAX) {
+		atomic_fetch_add(&dcache->dd_prefetch_drops, 1);
+		atomic_flag_clear(&rec->dr_prefetch);
+		D_GOTO(unlock, rc);
+	}
+
+	drec_incref_act(dcache, rec);
+	d_list_add_tail(&rec->dr_entry_prefetch, &dcache->dd_prefetch_head);
+	++dcache->dd_prefetch_count;
+	pthread_cond_signal(&dcache->dd_prefetch_cond);
+	D_DEBUG(DB_TRACE, "queue record " DF_DK " for prefetch: count=%u\n", DP_DK(rec->dr_key),
+		dcache->dd_prefetch_count);
+
+unlock:
+	rc = D_MUTEX_UNLOCK(&dcache->dd_prefetch_mutex);
+	D_ASSERT(rc == 0);
+}
+
+static void
+prefetch_stop(dfs_dcache_t *dcache)
+{
+	dcache_rec_t *rec;
+	int           rc;
+
+	rc = D_MUTEX_LOCK(&dcache->dd_prefetch_mutex);
+	D_ASSERT(rc == 0);
+	atomic_store_relaxed(&dcache->dd_prefetch_stop, true);
+	pthread_cond_signal(&dcache->dd_prefetch_cond);
+	rc = D_MUTEX_UNLOCK(&dcache->dd_prefetch_mutex);
+	D_ASSERT(rc == 0);
+
+	if (dcache->dd_prefetch_pid == getpid()) {
+		rc = pthread_join(dcache->dd_prefetch_thread, NULL);
+		if (rc != 0)
+			DS_ERROR(rc, "pthread_join() failed");
+	}
+
+	while ((rec = d_list_pop_entry(&dcache->dd_prefetch_head, dcache_rec_t,
+				       dr_entry_prefetch)) != NULL) {
+		--dcache->dd_prefetch_count;
+		drec_decref_act(dcache, rec);
+	}
+	D_ASSERT(dcache->dd_prefetch_count == 0);
+
+	if (dcache->dd_prefetch_max > 0)
+		D_DEBUG(DB_ANY,
+			"dir-cache prefetch: dirs=%" PRIu64 ", records=%" PRIu64 ", hits=%" PRIu64
+			", drops=%" PRIu64 "\n",
+			atomic_load_relaxed(&dcache->dd_prefetch_dirs),
+			atomic_load_relaxed(&dcache->dd_prefetch_recs),
+			atomic_load_relaxed(&dcache->dd_prefetch_hits),
+			atomic_load_relaxed(&dcache->dd_prefetch_drops));
+}
+
 static int
 dcache_find_insert_act(dfs_dcache_t *dcache, char *path, size_t path_len, dcache_rec_t **rec)
 {
@@ -649,6 +912,9 @@ dcache_find_insert_act(dfs_dcache_t *dcache, char *path, size_t path_len, dcache
 		rec_tmp = dcache_get(dcache, key, key_len);
 		D_DEBUG(DB_TRACE, "dcache %s: path=" DF_PATH ", key=" DF_DK "\n",
 			(rec_tmp == NULL) ? "miss" : "hit", DP_PATH(path), DP_DK(key));
+		if (rec_tmp != NULL && atomic_load_relaxed(&rec_tmp->dr_prefetched) &&
+		    atomic_exchange(&rec_tmp->dr_prefetched, false))
+			atomic_fetch_add(&dcache->dd_prefetch_hits, 1);
 		if (rec_tmp == NULL) {
 			char tmp;
 
@@ -657,12 +923,15 @@ dcache_find_insert_act(dfs_dcache_t *dcache, char *path, size_t path_len, dcache
 
 			tmp            = name[name_len];
 			name[name_len] = '\0';
-			rc             = dcache_add(dcache, parent, name, key, key_len, &rec_tmp);
+			rc = dcache_add(dcache, parent, name, key, key_len, false, &rec_tmp);
 			name[name_len] = tmp;
 			if (rc != -DER_SUCCESS) {
 				drec_decref(dcache, parent);
 				D_GOTO(out, rc);
 			}
+
+			/* NOTE The siblings of a missed directory are likely to be looked up next */
+			prefetch_queue(dcache, parent);
 		}
 		D_ASSERT(rec_tmp != NULL);
 
@@ -862,7 +1131,7 @@ drec_del_at_dact(dfs_dcache_t *dcache, dcache_rec_t *rec)
 
 int
 dcache_create(dfs_t *dfs, uint32_t bits, uint32_t rec_timeout, uint32_t gc_period,
-	      uint32_t gc_reclaim_max, dfs_dcache_t **dcache)
+	      uint32_t gc_reclaim_max, uint32_t prefetch_max, dfs_dcache_t **dcache)
 {
 	D_ASSERT(dcache != NULL);
 	D_ASSERT(dfs != NULL);
@@ -870,7 +1139,8 @@ dcache_create(dfs_t *dfs, uint32_t bits, uint32_t rec_timeout, uint32_t gc_perio
 	if (rec_timeout == 0)
 		return dcache_create_dact(dfs, dcache);
 
-	return dcache_create_act(dfs, bits, rec_timeout, gc_period, gc_reclaim_max, dcache);
+	return dcache_create_act(dfs, bits, rec_timeout, gc_period, gc_reclaim_max, prefetch_max,
+				 dcache);
 }
 int
 dcache_destroy(dfs_dcache_t *dcache)
@@ -93,6 +93,8 @@ static int                    fd_dummy = -1;
 #define DCACHE_GC_RECLAIM_MAX 1000
 /* Default dir cache garbage collector time-out in seconds */
 #define DCACHE_GC_PERIOD      120
+/* Default maximal number of child dirs prefetched per dir, prefetching is disabled by default */
+#define DCACHE_PREFETCH_MAX   0
 
 /* the number of low fd reserved */
 static uint16_t               low_fd_count;
@@ -117,6 +119,7 @@ static uint32_t               dcache_size_bits;
 static uint32_t               dcache_rec_timeout;
 static uint32_t               dcache_gc_reclaim_max;
 static uint32_t               dcache_gc_period;
+static uint32_t               dcache_prefetch_max;
 
 static _Atomic uint64_t        num_read;
 static _Atomic uint64_t        num_write;
@@ -264,8 +267,8 @@ static void
 finalize_dfs(void);
 static void
 update_cwd(void);
-static int
-get_eqh(daos_handle_t *eqh);
+int
+d_get_eqh(daos_handle_t *eqh);
 static void
 destroy_all_eqs(void);
 
@@ -907,7 +910,8 @@ retrieve_handles_from_fuse(int idx)
 	}
 
 	rc = dcache_create(dfs_list[idx].dfs, dcache_size_bits, dcache_rec_timeout,
-			   dcache_gc_period, dcache_gc_reclaim_max, &dfs_list[idx].dcache);
+			   dcache_gc_period, dcache_gc_reclaim_max, dcache_prefetch_max,
+			   &dfs_list[idx].dcache);
 	if (rc != 0) {
 		errno_saved = daos_der2errno(rc);
 		D_DEBUG(DB_ANY,
@@ -2480,7 +2484,7 @@ pread_over_dfs(int fd, void *buf, size_t size, off_t offset)
 	d_iov_set(&iov, buf, size);
 	sgl.sg_iovs = &iov;
 
-	rc = get_eqh(&eqh);
+	rc = d_get_eqh(&eqh);
 	if (rc == 0) {
 		bool flag = false;
 
@@ -2632,7 +2636,7 @@ pwrite_over_dfs(int fd, const void *buf, size_t size, off_t offset)
 	d_iov_set(&iov, (void *)buf, size);
 	sgl.sg_iovs = &iov;
 
-	rc = get_eqh(&eqh);
+	rc = d_get_eqh(&eqh);
 	if (rc == 0) {
 		bool flag = false;
 
@@ -2782,7 +2786,7 @@ readv_over_dfs(int fd, const struct iovec *iov, int iovcnt)
 		return size_sum;
 	}
 
-	rc = get_eqh(&eqh);
+	rc = d_get_eqh(&eqh);
 	if (rc == 0) {
 		bool flag = false;
 
@@ -2866,7 +2870,7 @@ writev_over_dfs(int fd, const struct iovec *iov, int iovcnt)
 		return size_sum;
 	}
 
-	rc = get_eqh(&eqh);
+	rc = d_get_eqh(&eqh);
 	if (rc == 0) {
 		bool flag = false;
 
@@ -7107,6 +7111,11 @@ init_myhook(void)
 		dcache_gc_reclaim_max = DCACHE_GC_RECLAIM_MAX;
 	}
 
+	dcache_prefetch_max = DCACHE_PREFETCH_MAX;
+	rc = d_getenv_uint32_t("D_IL_DCACHE_PREFETCH_MAX", &dcache_prefetch_max);
+	if (rc != -DER_SUCCESS && rc != -DER_NONEXIST)
+		DL_WARN(rc, "'D_IL_DCACHE_PREFETCH_MAX' env variable could not be used");
+
 	register_a_hook("libc", "open64", (void *)new_open_libc, (long int *)(&libc_open));
 	register_a_hook("libpthread", "open64", (void *)new_open_pthread,
 			(long int *)(&pthread_open));
@@ -7348,7 +7357,8 @@ init_dfs(int idx)
 	}
 
 	rc = dcache_create(dfs_list[idx].dfs, dcache_size_bits, dcache_rec_timeout,
-			   dcache_gc_period, dcache_gc_reclaim_max, &dfs_list[idx].dcache);
+			   dcache_gc_period, dcache_gc_reclaim_max, dcache_prefetch_max,
+			   &dfs_list[idx].dcache);
 	if (rc != 0) {
 		DL_ERROR(rc, "failed to create DFS directory cache");
 		D_GOTO(out_err_ht, rc = daos_der2errno(rc));
@@ -7444,8 +7454,8 @@ _exit(int rc)
 	(*next__exit)(rc);
 }
 
-static int
-get_eqh(daos_handle_t *eqh)
+int
+d_get_eqh(daos_handle_t *eqh)
 {
 	int rc;
 
@@ -451,6 +451,205 @@ err_task:
 	return rc;
 }
 
+/** State shared by the sub-tasks of one dc_kv_put_multi() call. */
+struct kv_batch {
+	/** TX that the puts of the batch are attached to. */
+	daos_handle_t		 kb_th;
+	/** Per-key return codes, may be NULL. */
+	int			*kb_rcs;
+	/** Number of keys in the batch. */
+	uint32_t		 kb_nr;
+	/** kb_th is an internal TX opened (and to be closed) for this batch. */
+	bool			 kb_own_th;
+};
+
+static int
+kv_batch_put_cb(tse_task_t *task, void *data)
+{
+	int	*rc = *((int **)data);
+
+	*rc = task->dt_result;
+	return 0;
+}
+
+static int
+kv_batch_comp_cb(tse_task_t *task, void *data)
+{
+	struct kv_batch	*kb = *((struct kv_batch **)data);
+	uint32_t	 i;
+	int		 rc;
+
+	if (!kb->kb_own_th)
+		goto out;
+
+	/** The internal TX is all or nothing, a failed commit fails every key. */
+	if (task->dt_result != 0 && kb->kb_rcs != NULL) {
+		for (i = 0; i < kb->kb_nr; i++) {
+			if (kb->kb_rcs[i] == 0)
+				kb->kb_rcs[i] = task->dt_result;
+		}
+	}
+
+	rc = dc_tx_local_close(kb->kb_th);
+	if (rc != 0)
+		D_ERROR("Failed to close batch TX: "DF_RC"\n", DP_RC(rc));
+out:
+	D_FREE(kb);
+	return 0;
+}
+
+static int
+kv_batch_commit(tse_task_t *task)
+{
+	struct kv_batch		*kb = tse_task_get_priv(task);
+	daos_tx_commit_t	*commit_args;
+	tse_task_t		*commit_task;
+	int			 rc = task->dt_result;
+
+	/** One of the puts failed, the TX is dropped when closing it. */
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	rc = daos_task_create(DAOS_OPC_TX_COMMIT, tse_task2sched(task), 0, NULL, &commit_task);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	commit_args = daos_task_get_args(commit_task);
+	commit_args->th		= kb->kb_th;
+	commit_args->flags	= 0;
+
+	rc = tse_task_register_deps(task, 1, &commit_task);
+	if (rc != 0) {
+		tse_task_complete(commit_task, rc);
+		D_GOTO(out, rc);
+	}
+
+	return tse_task_schedule(commit_task, true);
+out:
+	tse_task_complete(task, rc);
+	return rc;
+}
+
+int
+dc_kv_put_multi(tse_task_t *task)
+{
+	daos_kv_put_multi_t	*args = daos_task_get_args(task);
+	tse_sched_t		*sched = tse_task2sched(task);
+	struct dc_kv		*kv = NULL;
+	struct kv_batch		*kb = NULL;
+	tse_task_t		*cmt_task = NULL;
+	tse_task_t		*put_task;
+	daos_kv_put_t		*put_args;
+	d_list_t		 task_list;
+	bool			 kb_cb_registered = false;
+	uint32_t		 i;
+	int			 rc;
+
+	D_INIT_LIST_HEAD(&task_list);
+
+	if (args->nr == 0 || args->keys == NULL || args->buf_sizes == NULL || args->bufs == NULL)
+		D_GOTO(err_task, rc = -DER_INVAL);
+
+	for (i = 0; i < args->nr; i++) {
+		if (args->keys[i] == NULL)
+			D_GOTO(err_task, rc = -DER_INVAL);
+	}
+
+	kv = kv_hdl2ptr(args->oh);
+	if (kv == NULL)
+		D_GOTO(err_task, rc = -DER_NO_HDL);
+
+	D_ALLOC_PTR(kb);
+	if (kb == NULL)
+		D_GOTO(err_task, rc = -DER_NOMEM);
+
+	kb->kb_th	= args->th;
+	kb->kb_rcs	= args->rcs;
+	kb->kb_nr	= args->nr;
+
+	/*
+	 * Without a user TX, attach all the puts to an internal one so that they are sent to the
+	 * leader as a single compound RPC and executed under a single DTX, instead of one update
+	 * RPC (and one DTX) per key.
+	 */
+	if (daos_handle_is_inval(args->th) && args->nr > 1) {
+		rc = dc_tx_open_direct(kv->coh, 0, &kb->kb_th);
+		if (rc != 0) {
+			D_ERROR("Failed to open batch TX: "DF_RC"\n", DP_RC(rc));
+			D_GOTO(err_task, rc);
+		}
+		kb->kb_own_th = true;
+	}
+
+	rc = tse_task_register_comp_cb(task, kv_batch_comp_cb, &kb, sizeof(kb));
+	if (rc != 0)
+		D_GOTO(err_task, rc);
+	kb_cb_registered = true;
+
+	if (kb->kb_own_th) {
+		rc = tse_task_create(kv_batch_commit, sched, kb, &cmt_task);
+		if (rc != 0)
+			D_GOTO(err_task, rc);
+
+		rc = tse_task_register_deps(task, 1, &cmt_task);
+		if (rc != 0) {
+			tse_task_complete(cmt_task, rc);
+			D_GOTO(err_task, rc);
+		}
+	}
+
+	for (i = 0; i < args->nr; i++) {
+		rc = daos_task_create(DAOS_OPC_KV_PUT, sched, 0, NULL, &put_task);
+		if (rc != 0)
+			D_GOTO(err_list, rc);
+
+		put_args = daos_task_get_args(put_task);
+		put_args->oh		= args->oh;
+		put_args->th		= kb->kb_th;
+		put_args->flags		= args->flags;
+		put_args->key		= args->keys[i];
+		put_args->buf_size	= args->buf_sizes[i];
+		put_args->buf		= args->bufs[i];
+		tse_task_list_add(put_task, &task_list);
+
+		if (args->rcs != NULL) {
+			int	*put_rc = &args->rcs[i];
+
+			*put_rc = 0;
+			rc = tse_task_register_comp_cb(put_task, kv_batch_put_cb, &put_rc,
+						       sizeof(put_rc));
+			if (rc != 0)
+				D_GOTO(err_list, rc);
+		}
+
+		rc = tse_task_register_deps(cmt_task != NULL ? cmt_task : task, 1, &put_task);
+		if (rc != 0)
+			D_GOTO(err_list, rc);
+	}
+
+	if (cmt_task != NULL)
+		tse_task_list_add(cmt_task, &task_list);
+
+	tse_task_list_sched(&task_list, true);
+	kv_decref(kv);
+	return 0;
+
+err_list:
+	tse_task_list_abort(&task_list, rc);
+	if (cmt_task != NULL)
+		tse_task_complete(cmt_task, rc);
+err_task:
+	tse_task_complete(task, rc);
+	if (!kb_cb_registered && kb != NULL) {
+		if (kb->kb_own_th)
+			dc_tx_local_close(kb->kb_th);
+		D_FREE(kb);
+	}
+	if (kv)
+		kv_decref(kv);
+	return rc;
+}
+
 int
 dc_kv_get(tse_task_t *task)
 {
@@ -2087,6 +2087,8 @@ struct umem_page_info {
 	uint64_t pi_last_checkpoint;
 	/** Highest transaction ID of writes to the page */
 	uint64_t pi_last_inflight;
+	/** Lowest transaction ID of writes to the page since it became dirty */
+	uint64_t pi_first_dirty;
 	/** link to global LRU lists, or global free page list, or global pinned list */
 	d_list_t pi_lru_link;
 	/** link to global dirty page list, or wait commit list, or temporary list for flushing */
@@ -2598,6 +2600,9 @@ touch_page(struct umem_store *store, struct umem_page_info *pinfo, uint64_t wr_t
 	}
 
 	D_ASSERT(pinfo->pi_loaded == 1);
+	/* All prior writes have been copied for flush, this is the first write since then */
+	if (!is_page_dirty(pinfo))
+		pinfo->pi_first_dirty = wr_tx;
 	pinfo->pi_last_inflight = wr_tx;
 
 	/* Don't change the pi_dirty_link while the page is being flushed */
@@ -2971,15 +2976,116 @@ cache_flush_pages(struct umem_cache *cache, d_list_t *dirty_list,
 	return rc;
 }
 
-int
-umem_cache_checkpoint(struct umem_store *store, umem_cache_wait_cb_t wait_cb, void *arg,
-		      uint64_t *out_id, struct umem_cache_chkpt_stats *stats)
+static int
+pinfo_pgid_cmp(const void *a, const void *b)
+{
+	const struct umem_page_info *pa = *(struct umem_page_info * const *)a;
+	const struct umem_page_info *pb = *(struct umem_page_info * const *)b;
+
+	return (pa->pi_pg_id > pb->pi_pg_id) - (pa->pi_pg_id < pb->pi_pg_id);
+}
+
+/* Reorder the dirty pages in MD-blob offset order, so that the flush I/Os are sequential */
+static void
+cache_sort_dirty(d_list_t *dirty_list, unsigned int nr)
+{
+	struct umem_page_info	**pgs;
+	struct umem_page_info	 *pinfo;
+	unsigned int		  i = 0;
+
+	if (nr < 2)
+		return;
+
+	/* Sorting is only an optimization, just skip it on ENOMEM */
+	D_ALLOC_ARRAY_NZ(pgs, nr);
+	if (pgs == NULL)
+		return;
+
+	d_list_for_each_entry(pinfo, dirty_list, pi_dirty_link)
+		pgs[i++] = pinfo;
+	D_ASSERT(i == nr);
+
+	qsort(pgs, nr, sizeof(*pgs), pinfo_pgid_cmp);
+
+	D_INIT_LIST_HEAD(dirty_list);
+	for (i = 0; i < nr; i++)
+		d_list_add_tail(&pgs[i]->pi_dirty_link, dirty_list);
+
+	D_FREE(pgs);
+}
+
+/* Max times the checkpoint ID of an incremental checkpoint can be extended */
+#define CACHE_SELECT_EXT_MAX	8
+
+/*
+ * Select the dirty pages must be flushed to persist all the transactions up to @upto_id.
+ *
+ * A page with first dirty ID <= @upto_id could carry changes from later transactions, to
+ * keep the invariant that checkpointed pages never carry changes newer than checkpoint ID,
+ * the checkpoint ID is extended to the highest write ID of the selected pages, and more
+ * pages are selected accordingly until no more page is pulled in.
+ *
+ * Each extension rescans the dirty list, and with hot pages the selection converges to all
+ * the dirty pages anyway, so after CACHE_SELECT_EXT_MAX extensions it gives up and selects
+ * all of them, just like a full checkpoint (@chkpt_id is then left to the flush).
+ */
+static unsigned int
+cache_select_dirty(struct umem_cache *cache, uint64_t upto_id, d_list_t *dirty_list,
+		   uint64_t *chkpt_id)
+{
+	struct umem_store	*store = cache->ca_store;
+	struct umem_page_info	*pinfo, *tmp;
+	uint64_t		 max_id = upto_id;
+	unsigned int		 nr = 0;
+	unsigned int		 ext = 0;
+	bool			 extended;
+
+	do {
+		extended = false;
+		d_list_for_each_entry(pinfo, &cache->ca_pgs_dirty, pi_dirty_link) {
+			if (store->stor_ops->so_wal_id_cmp(store, pinfo->pi_first_dirty,
+							   max_id) > 0)
+				continue;
+			if (store->stor_ops->so_wal_id_cmp(store, pinfo->pi_last_inflight,
+							   max_id) > 0) {
+				max_id = pinfo->pi_last_inflight;
+				extended = true;
+			}
+		}
+	} while (extended && ++ext < CACHE_SELECT_EXT_MAX);
+
+	if (extended) {
+		D_DEBUG(DB_TRACE, "Checkpoint up to "DF_X64" extended %u times, select all\n",
+			upto_id, ext);
+		d_list_for_each_entry(pinfo, &cache->ca_pgs_dirty, pi_dirty_link)
+			nr++;
+		d_list_splice_init(&cache->ca_pgs_dirty, dirty_list);
+		return nr;
+	}
+
+	d_list_for_each_entry_safe(pinfo, tmp, &cache->ca_pgs_dirty, pi_dirty_link) {
+		if (store->stor_ops->so_wal_id_cmp(store, pinfo->pi_first_dirty, max_id) > 0)
+			continue;
+		d_list_move_tail(&pinfo->pi_dirty_link, dirty_list);
+		nr++;
+	}
+
+	if (nr > 0)
+		*chkpt_id = max_id;
+
+	return nr;
+}
+
+static int
+cache_checkpoint(struct umem_store *store, umem_cache_wait_cb_t wait_cb, void *arg,
+		 uint64_t *upto_id, uint64_t *out_id, struct umem_cache_chkpt_stats *stats)
 {
 	struct umem_cache		*cache;
 	struct umem_page_info		*pinfo;
 	struct umem_checkpoint_data	*chkpt_data_all;
 	d_list_t			 dirty_list;
 	uint64_t			 chkpt_id = *out_id;
+	unsigned int			 nr = 0;
 	int				 rc = 0;
 
 	D_ASSERT(store != NULL);
@@ -2991,12 +3097,23 @@ umem_cache_checkpoint(struct umem_store *store, umem_cache_wait_cb_t wait_cb, vo
 	if (d_list_empty(&cache->ca_pgs_dirty))
 		goto wait;
 
+	D_INIT_LIST_HEAD(&dirty_list);
+	if (upto_id != NULL) {
+		nr = cache_select_dirty(cache, *upto_id, &dirty_list, &chkpt_id);
+		if (nr == 0)
+			goto wait;
+	} else {
+		d_list_splice_init(&cache->ca_pgs_dirty, &dirty_list);
+		d_list_for_each_entry(pinfo, &dirty_list, pi_dirty_link)
+			nr++;
+	}
+	cache_sort_dirty(&dirty_list, nr);
+
 	D_ALLOC_ARRAY(chkpt_data_all, MAX_INFLIGHT_SETS);
-	if (chkpt_data_all == NULL)
+	if (chkpt_data_all == NULL) {
+		d_list_splice(&dirty_list, &cache->ca_pgs_dirty);
 		return -DER_NOMEM;
-
-	D_INIT_LIST_HEAD(&dirty_list);
-	d_list_splice_init(&cache->ca_pgs_dirty, &dirty_list);
+	}
 
 	rc = cache_flush_pages(cache, &dirty_list, chkpt_data_all, MAX_INFLIGHT_SETS, wait_cb, arg,
 			       &chkpt_id, stats);
@@ -3007,10 +3124,15 @@ umem_cache_checkpoint(struct umem_store *store, umem_cache_wait_cb_t wait_cb, vo
 		d_list_move(&dirty_list, &cache->ca_pgs_dirty);
 	}
 wait:
-	/* Wait for the evicting pages (if any) with lower checkpoint id */
+	/*
+	 * Wait for the evicting pages (if any) with lower checkpoint id. For partial checkpoint,
+	 * an evicting page could carry changes older than checkpoint id even if its checkpoint
+	 * id is higher, so wait for all the evicting pages.
+	 */
 	d_list_for_each_entry(pinfo, &cache->ca_pgs_flushing, pi_flush_link) {
 		D_ASSERT(pinfo->pi_io == 1);
-		if (store->stor_ops->so_wal_id_cmp(store, chkpt_id, pinfo->pi_last_checkpoint) < 0)
+		if (upto_id == NULL &&
+		    store->stor_ops->so_wal_id_cmp(store, chkpt_id, pinfo->pi_last_checkpoint) < 0)
 			continue;
 		page_wait_io(cache, pinfo);
 		goto wait;
@@ -3021,6 +3143,20 @@ wait:
 	return rc;
 }
 
+int
+umem_cache_checkpoint(struct umem_store *store, umem_cache_wait_cb_t wait_cb, void *arg,
+		      uint64_t *out_id, struct umem_cache_chkpt_stats *stats)
+{
+	return cache_checkpoint(store, wait_cb, arg, NULL, out_id, stats);
+}
+
+int
+umem_cache_checkpoint_upto(struct umem_store *store, umem_cache_wait_cb_t wait_cb, void *arg,
+			   uint64_t upto_id, uint64_t *out_id, struct umem_cache_chkpt_stats *stats)
+{
+	return cache_checkpoint(store, wait_cb, arg, &upto_id, out_id, stats);
+}
+
 static inline void
 inc_cache_stats(struct umem_cache *cache, unsigned int op)
 {
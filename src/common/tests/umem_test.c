@@ -563,6 +563,74 @@ test_many_writes(void **state)
 	umem_cache_free(&arg->ta_store);
 }
 
+static void
+test_checkpoint_upto(void **state)
+{
+	struct test_arg   *arg = *state;
+	struct umem_cache *cache;
+	uint64_t           id = 0;
+	int                rc;
+
+	arg->ta_store.stor_size = 8 * UMEM_CACHE_PAGE_SZ;
+	arg->ta_store.stor_ops  = &stor_ops;
+
+	/** In case prior test failed */
+	umem_cache_free(&arg->ta_store);
+
+	rc = umem_cache_alloc(&arg->ta_store, UMEM_CACHE_PAGE_SZ, 8, 0, 0, 0,
+			      (void *)(UMEM_CACHE_PAGE_SZ), NULL, NULL, NULL);
+	assert_rc_equal(rc, 0);
+
+	cache = arg->ta_store.cache;
+	assert_non_null(cache);
+
+	/** One tx per page, checkpoint them one by one */
+	reset_arg(arg);
+	touch_mem(arg, 1, 0, 10);
+	touch_mem(arg, 2, UMEM_CACHE_PAGE_SZ + 10, 10);
+	touch_mem(arg, 3, 2 * UMEM_CACHE_PAGE_SZ + 10, 10);
+	touch_mem(arg, 4, 3 * UMEM_CACHE_PAGE_SZ + 10, 10);
+
+	/** Only the first two pages are flushed, a flush of the others would assert */
+	rc = umem_cache_checkpoint_upto(&arg->ta_store, wait_cb, NULL, 2, &id, NULL);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(id, 2);
+	assert_false(d_list_empty(&arg->ta_flush_list));
+
+	rc = umem_cache_checkpoint_upto(&arg->ta_store, wait_cb, NULL, 3, &id, NULL);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(id, 3);
+
+	/** Nothing to flush, checkpoint id is unchanged */
+	rc = umem_cache_checkpoint_upto(&arg->ta_store, wait_cb, NULL, 3, &id, NULL);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(id, 3);
+
+	rc = umem_cache_checkpoint_upto(&arg->ta_store, wait_cb, NULL, 4, &id, NULL);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(id, 4);
+	check_lists_empty(arg);
+
+	/** The first page carries a later tx, the checkpoint id is extended to cover it */
+	reset_arg(arg);
+	touch_mem(arg, 5, 20, 10);
+	touch_mem(arg, 6, UMEM_CACHE_PAGE_SZ + 20, 10);
+	touch_mem(arg, 7, 40, 10);
+	touch_mem(arg, 8, 2 * UMEM_CACHE_PAGE_SZ + 20, 10);
+
+	rc = umem_cache_checkpoint_upto(&arg->ta_store, wait_cb, NULL, 5, &id, NULL);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(id, 7);
+	assert_false(d_list_empty(&arg->ta_flush_list));
+
+	rc = umem_cache_checkpoint(&arg->ta_store, wait_cb, NULL, &id, NULL);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(id, 8);
+	check_lists_empty(arg);
+
+	umem_cache_free(&arg->ta_store);
+}
+
 static int
 waitqueue_create(void **wq)
 {
@@ -762,6 +830,7 @@ main(int argc, char **argv)
 	    {"UMEM007: Test page cache many writes", test_many_writes, NULL, NULL},
 	    {"UMEM008: Test phase2 APIs", test_p2_basic, NULL, NULL},
 	    {"UMEM009: Test phase2 eviction", test_p2_evict, NULL, NULL},
+	    {"UMEM010: Test incremental checkpoint", test_checkpoint_upto, NULL, NULL},
 	    {NULL, NULL, NULL, NULL}};
 
 	d_register_alt_assert(mock_assert);
@@ -24,6 +24,7 @@ uint32_t dtx_agg_thd_cnt_lo;
 uint32_t dtx_agg_thd_age_up;
 uint32_t dtx_agg_thd_age_lo;
 uint32_t dtx_batched_ult_max;
+uint32_t dtx_pool_coalesce;
 
 struct dtx_batched_pool_args {
 	/* Link to dss_module_info::dmi_dtx_batched_pool_list. */
@@ -34,7 +35,11 @@ struct dtx_batched_pool_args {
 	/* The container that needs to do DTX aggregation. */
 	struct dtx_batched_cont_args	*dbpa_victim;
 	struct dtx_stat			 dbpa_stat;
+	/* The pool level batched commit ULT, see dtx_pool_coalesce. */
+	struct sched_request		*dbpa_commit_req;
+	int				 dbpa_refs;
 	uint32_t			 dbpa_aggregating;
+	uint32_t			 dbpa_commit_done:1;
 };
 
 struct dtx_batched_cont_args {
@@ -51,7 +56,7 @@ struct dtx_batched_cont_args {
 	int                              dbca_refs;
 	uint32_t                         dbca_cleanup_thd;
 	uint32_t dbca_deregister : 1, dbca_cleanup_done : 1, dbca_commit_done : 1,
-	    dbca_agg_done : 1, dbca_flush_pending : 1;
+	    dbca_agg_done : 1, dbca_flush_pending : 1, dbca_coalescing : 1;
 };
 
 struct dtx_partial_cmt_item {
@@ -134,6 +139,18 @@ dtx_free_dbca(struct dtx_batched_cont_args *dbca)
 	}
 
 	if (d_list_empty(&dbpa->dbpa_cont_list)) {
+		if (dbpa->dbpa_commit_req != NULL)
+			sched_req_abort(dbpa->dbpa_commit_req);
+
+		/* The pool level batched commit ULT may hold reference on the dbpa. */
+		while (dbpa->dbpa_refs > 0) {
+			D_DEBUG(DB_TRACE, "Sleep 10 mseconds for reference release\n");
+			dss_sleep(10);
+		}
+
+		if (dbpa->dbpa_commit_req != NULL)
+			sched_req_put(dbpa->dbpa_commit_req);
+
 		d_list_del(&dbpa->dbpa_sys_link);
 		D_FREE(dbpa);
 	}
@@ -596,6 +613,15 @@ dtx_need_batched_commit(struct dtx_batched_cont_args *dbca)
 	return dtx_cont_opened(dbca->dbca_cont) || dbca->dbca_flush_pending;
 }
 
+static inline void
+dtx_cmt_lag_set(struct dtx_tls *tls, uint64_t oldest)
+{
+	uint64_t	now = d_hlc_get();
+
+	if (oldest != 0 && now > oldest)
+		d_tm_set_gauge(tls->dt_cmt_lag, d_hlc2msec(now - oldest));
+}
+
 static void
 dtx_batched_commit_one(void *arg)
 {
@@ -614,6 +640,7 @@ dtx_batched_commit_one(void *arg)
 		struct dtx_coll_entry	 *dce = NULL;
 		struct dtx_stat		  stat = { 0 };
 		int			  cnt;
+		uint64_t		  oldest = dtx_cos_oldest(cont);
 		int			  rc;
 
 		cnt = dtx_fetch_committable(cont, DTX_THRESHOLD_COUNT, NULL,
@@ -644,6 +671,7 @@ dtx_batched_commit_one(void *arg)
 		} else {
 			rc = dtx_commit(cont, dtes, NULL, cnt, true);
 		}
+		dtx_cmt_lag_set(tls, oldest);
 		dtx_free_committable(dtes, NULL, dce, cnt);
 		if (rc != 0) {
 			D_WARN("Fail to batched commit %d entries for "DF_UUID": "DF_RC"\n",
@@ -672,11 +700,204 @@ out:
 	dtx_put_dbca(dbca);
 }
 
+/* Whether some container in the pool has small but old committable batch or not. */
+static bool
+dtx_pool_need_commit(struct dtx_batched_pool_args *dbpa)
+{
+	struct dtx_batched_cont_args	*dbca;
+
+	d_list_for_each_entry(dbca, &dbpa->dbpa_cont_list, dbca_pool_link) {
+		struct dtx_stat		stat = { 0 };
+
+		if (!dtx_cont_opened(dbca->dbca_cont) || dbca->dbca_commit_req != NULL)
+			continue;
+
+		dtx_stat(dbca->dbca_cont, &stat);
+		if (stat.dtx_committable_count <= DTX_THRESHOLD_COUNT &&
+		    stat.dtx_committable_coll_count == 0 && stat.dtx_oldest_committable_time != 0 &&
+		    d_hlc_age2sec(stat.dtx_oldest_committable_time) >= DTX_COMMIT_THRESHOLD_AGE)
+			return true;
+	}
+
+	return false;
+}
+
+/*
+ * Pool level batched commit: collect the committable DTXs from multiple containers of the
+ * pool, then commit them together via dtx_pool_commit(). The containers that are being
+ * handled by their own batched commit ULT are skipped.
+ */
+static void
+dtx_batched_commit_pool(void *arg)
+{
+	struct dss_module_info		*dmi = dss_get_module_info();
+	struct dtx_tls			*tls = dtx_tls_get();
+	struct dtx_batched_pool_args	*dbpa = arg;
+	struct dtx_batched_cont_args	*dbcas[DTX_POOL_COALESCE_MAX];
+	struct ds_cont_child		*conts[DTX_POOL_COALESCE_MAX];
+	struct dtx_entry		**dtes[DTX_POOL_COALESCE_MAX];
+	int				 counts[DTX_POOL_COALESCE_MAX];
+
+	if (dbpa->dbpa_commit_req == NULL)
+		goto out;
+
+	tls->dt_batched_ult_cnt++;
+
+	while (!dss_ult_exiting(dbpa->dbpa_commit_req)) {
+		struct dtx_batched_cont_args	*dbca;
+		struct dtx_stat			 stat = { 0 };
+		uint64_t			 oldest = 0;
+		uint64_t			 epoch;
+		int				 total = 0;
+		int				 nr = 0;
+		int				 rc;
+		int				 i;
+
+again:
+		/*
+		 * Nothing yields during the scan, so the list cannot be changed by others. The
+		 * only exception is the collective DTX commit, after that the scan restarts.
+		 */
+		d_list_for_each_entry(dbca, &dbpa->dbpa_cont_list, dbca_pool_link) {
+			struct dtx_coll_entry	*dce = NULL;
+			int			 cnt;
+
+			if (nr >= dtx_pool_coalesce || total >= DTX_THRESHOLD_COUNT)
+				break;
+
+			if (!dtx_cont_opened(dbca->dbca_cont) || dbca->dbca_commit_req != NULL ||
+			    dbca->dbca_coalescing || dbca->dbca_cont->sc_dtx_committable_count == 0)
+				continue;
+
+			epoch = dtx_cos_oldest(dbca->dbca_cont);
+			cnt = dtx_fetch_committable(dbca->dbca_cont, DTX_THRESHOLD_COUNT, NULL,
+						    DAOS_EPOCH_MAX, false, &dtes[nr], NULL, &dce);
+			if (cnt <= 0) {
+				if (cnt < 0)
+					D_WARN("Fail to fetch committable for "DF_UUID": "DF_RC"\n",
+					       DP_UUID(dbca->dbca_cont->sc_uuid), DP_RC(cnt));
+				continue;
+			}
+
+			if (unlikely(dce != NULL)) {
+				/* Commit collective DTX by itself, then rescan the pool. */
+				dtx_get_dbca(dbca);
+				rc = dtx_coll_commit(dbca->dbca_cont, dce, NULL, true);
+				dtx_free_committable(NULL, NULL, dce, 1);
+				dtx_put_dbca(dbca);
+				if (rc != 0) {
+					D_WARN("Fail to commit collective DTX for "DF_UUID": "
+					       DF_RC"\n", DP_UUID(dbca->dbca_cont->sc_uuid),
+					       DP_RC(rc));
+					break;
+				}
+				goto again;
+			}
+
+			dtx_get_dbca(dbca);
+			dbca->dbca_coalescing = 1;
+			dbcas[nr] = dbca;
+			conts[nr] = dbca->dbca_cont;
+			counts[nr] = cnt;
+			if (epoch != 0 && (oldest == 0 || epoch < oldest))
+				oldest = epoch;
+			total += cnt;
+			nr++;
+		}
+
+		if (nr == 0)
+			break;
+
+		if (nr == 1)
+			rc = dtx_commit(conts[0], dtes[0], NULL, counts[0], true);
+		else
+			rc = dtx_pool_commit(dbpa->dbpa_pool, conts, dtes, counts, nr);
+
+		d_tm_set_gauge(tls->dt_pool_cmt_batch, total);
+		d_tm_set_gauge(tls->dt_pool_cmt_conts, nr);
+		dtx_cmt_lag_set(tls, oldest);
+
+		if (rc == 0)
+			dtx_stat(conts[0], &stat);
+
+		for (i = 0; i < nr; i++) {
+			dtx_free_committable(dtes[i], NULL, NULL, counts[i]);
+			dbcas[i]->dbca_coalescing = 0;
+			dtx_put_dbca(dbcas[i]);
+		}
+
+		if (rc != 0) {
+			D_WARN("Fail to batched commit %d entries for %d containers of "DF_UUID": "
+			       DF_RC"\n", total, nr, DP_UUID(dbpa->dbpa_pool->spc_uuid), DP_RC(rc));
+			break;
+		}
+
+		if (stat.dtx_pool_cmt_count >= dtx_agg_thd_cnt_up && dbpa->dbpa_aggregating == 0)
+			sched_req_wakeup(dmi->dmi_dtx_agg_req);
+
+		if (!dtx_pool_need_commit(dbpa))
+			break;
+	}
+
+	dbpa->dbpa_commit_done = 1;
+	tls->dt_batched_ult_cnt--;
+
+out:
+	D_ASSERT(dbpa->dbpa_refs > 0);
+	dbpa->dbpa_refs--;
+}
+
+/*
+ * Merge the small batches from the containers of the same pool via the pool level batched
+ * commit ULT. Return true if the committable DTXs of the given container will be handled
+ * by such ULT.
+ */
+static bool
+dtx_batched_commit_coalesce(struct dtx_batched_cont_args *dbca, struct dtx_stat *stat)
+{
+	struct dtx_batched_pool_args	*dbpa = dbca->dbca_pool;
+	struct dtx_batched_cont_args	*tmp;
+	struct sched_req_attr		 attr;
+
+	if (dtx_pool_coalesce < 2 || stat->dtx_committable_count > DTX_THRESHOLD_COUNT ||
+	    stat->dtx_committable_coll_count > 0)
+		return false;
+
+	/* In processing, the container will be handled by its next cycle. */
+	if (dbpa->dbpa_commit_req != NULL)
+		return true;
+
+	/* It is worth only if some other container in the pool has committable DTXs. */
+	d_list_for_each_entry(tmp, &dbpa->dbpa_cont_list, dbca_pool_link) {
+		if (tmp != dbca && dtx_cont_opened(tmp->dbca_cont) &&
+		    tmp->dbca_commit_req == NULL && tmp->dbca_cont->sc_dtx_committable_count > 0)
+			break;
+	}
+
+	if (&tmp->dbca_pool_link == &dbpa->dbpa_cont_list)
+		return false;
+
+	D_ASSERT(!dbpa->dbpa_commit_done);
+	dbpa->dbpa_refs++;
+
+	sched_req_attr_init(&attr, SCHED_REQ_GC, &dbpa->dbpa_pool->spc_uuid);
+	dbpa->dbpa_commit_req = sched_create_ult(&attr, dtx_batched_commit_pool, dbpa, 0);
+	if (dbpa->dbpa_commit_req == NULL) {
+		D_WARN("Fail to start DTX pool ULT for "DF_UUID"\n",
+		       DP_UUID(dbpa->dbpa_pool->spc_uuid));
+		dbpa->dbpa_refs--;
+		return false;
+	}
+
+	return true;
+}
+
 void
 dtx_batched_commit(void *arg)
 {
 	struct dss_module_info		*dmi = dss_get_module_info();
 	struct dtx_tls			*tls = dtx_tls_get();
+	struct dtx_batched_pool_args	*dbpa;
 	struct dtx_batched_cont_args	*dbca;
 	struct sched_req_attr		 attr;
 	uuid_t				 anonym_uuid;
@@ -723,7 +944,15 @@ dtx_batched_commit(void *arg)
 			dbca->dbca_commit_done = 0;
 		}
 
+		dbpa = dbca->dbca_pool;
+		if (dbpa->dbpa_commit_req != NULL && dbpa->dbpa_commit_done) {
+			sched_req_put(dbpa->dbpa_commit_req);
+			dbpa->dbpa_commit_req = NULL;
+			dbpa->dbpa_commit_done = 0;
+		}
+
 		if (dtx_need_batched_commit(dbca) && dbca->dbca_commit_req == NULL &&
+		    !dbca->dbca_coalescing &&
 		    (dtx_batched_ult_max != 0 && tls->dt_batched_ult_cnt < dtx_batched_ult_max) &&
 		    ((stat.dtx_committable_count > DTX_THRESHOLD_COUNT) ||
 		     (stat.dtx_committable_coll_count > 0) ||
@@ -732,6 +961,9 @@ dtx_batched_commit(void *arg)
 			  DTX_COMMIT_THRESHOLD_AGE))) {
 			D_ASSERT(!dbca->dbca_commit_done);
 			sleep_time = 0;
+			if (dtx_batched_commit_coalesce(dbca, &stat))
+				goto cleanup;
+
 			dtx_get_dbca(dbca);
 
 			D_ASSERT(dbca->dbca_cont);
@@ -745,6 +977,7 @@ dtx_batched_commit(void *arg)
 			}
 		}
 
+cleanup:
 		if (dbca->dbca_cleanup_req != NULL && dbca->dbca_cleanup_done) {
 			sched_req_put(dbca->dbca_cleanup_req);
 			dbca->dbca_cleanup_req = NULL;
@@ -22,8 +22,11 @@
  *
  * These are for daos_rpc::dr_opc and DAOS_RPC_OPCODE(opc, ...) rather than
  * crt_req_create(..., opc, ...). See src/include/daos/rpc.h.
+ *
+ * Version 5 adds DTX_POOL_COMMIT. Engines with different DTX protocol versions cannot
+ * exchange any DTX RPC, so all the engines of a system must be upgraded together.
  */
-#define DAOS_DTX_VERSION	4
+#define DAOS_DTX_VERSION	5
 
 /** VOS reserves highest two minor epoch values for internal use so we must
  *  limit the number of dtx sub modifications to avoid conflict.
@@ -47,7 +50,9 @@
 	X(DTX_COLL_ABORT,	0,	&CQF_dtx_coll,	dtx_coll_handler,	\
 	  &dtx_coll_abort_co_ops, "dtx_coll_abort")				\
 	X(DTX_COLL_CHECK,	0,	&CQF_dtx_coll,	dtx_coll_handler,	\
-	  &dtx_coll_check_co_ops, "dtx_coll_check")
+	  &dtx_coll_check_co_ops, "dtx_coll_check")				\
+	X(DTX_POOL_COMMIT,	0,	&CQF_dtx_pool,	dtx_pool_handler,	\
+	  NULL,			"dtx_pool_commit")
 
 #define X(a, b, c, d, e, f) a,
 enum dtx_operation {
@@ -76,6 +81,24 @@ enum dtx_operation {
 
 CRT_RPC_DECLARE(dtx, DAOS_ISEQ_DTX, DAOS_OSEQ_DTX);
 
+/*
+ * DTX pool commit RPC input fields
+ * It commits the DTXs that belong to multiple containers of the same pool. dpi_co_idx is
+ * per DTX, the index of related container in dpi_co_uuids, non-decreasing.
+ */
+/* clang-format off */
+#define DAOS_ISEQ_DTX_POOL						\
+	((uuid_t)		(dpi_po_uuid)		CRT_VAR)	\
+	((uint32_t)		(dpi_version)		CRT_VAR)	\
+	((uint32_t)		(dpi_padding)		CRT_VAR)	\
+	((uuid_t)		(dpi_co_uuids)		CRT_ARRAY)	\
+	((uint32_t)		(dpi_co_idx)		CRT_ARRAY)	\
+	((struct dtx_id)	(dpi_dtx_array)		CRT_ARRAY)
+/* clang-format on */
+
+/* The same output as DTX_COMMIT, do_misc is the count of real committed DTX entries. */
+CRT_RPC_DECLARE(dtx_pool, DAOS_ISEQ_DTX_POOL, DAOS_OSEQ_DTX);
+
 /*
  * DTX collective RPC input fields
  * dci_hints is sparse array, one per engine, sorted against the rank ID.
@@ -176,6 +199,18 @@ extern uint32_t dtx_agg_thd_age_lo;
  */
 extern uint32_t dtx_batched_ult_max;
 
+/*
+ * The max count of containers whose committable DTXs can be merged into one DTX_POOL_COMMIT
+ * RPC (per target) by the pool level batched commit ULT. It is controlled via the environment
+ * "DAOS_DTX_POOL_COALESCE".
+ *
+ * Zero or one:		disable the pool level coalescing, each container commits its own DTXs.
+ * Others:		the max count of containers merged per RPC.
+ */
+extern uint32_t dtx_pool_coalesce;
+
+#define DTX_POOL_COALESCE_MAX	64
+
 /*
  * If the size of dtx_memberships exceeds DTX_INLINE_MBS_SIZE, then load it (DTX mbs)
  * dynamically when use it to avoid holding a lot of DRAM resource for long time that
@@ -231,6 +266,9 @@ struct dtx_tls {
 	struct d_tm_node_t	*dt_dtx_leader_total;
 	struct d_tm_node_t	*dt_async_cmt_lat;
 	struct d_tm_node_t      *dt_chore_retry;
+	struct d_tm_node_t	*dt_cmt_lag;
+	struct d_tm_node_t	*dt_pool_cmt_batch;
+	struct d_tm_node_t	*dt_pool_cmt_conts;
 	uint64_t		 dt_agg_gen;
 	uint32_t		 dt_batched_ult_cnt;
 };
@@ -287,6 +325,8 @@ void dtx_cos_batched_del(struct ds_cont_child *cont, struct dtx_id xid[], bool r
 /* dtx_rpc.c */
 int dtx_check(struct ds_cont_child *cont, struct dtx_entry *dte,
 	      daos_epoch_t epoch);
+int dtx_pool_commit(struct ds_pool_child *pool, struct ds_cont_child **conts,
+		    struct dtx_entry ***dtes, int *counts, int cont_nr);
 int dtx_coll_check(struct ds_cont_child *cont, struct dtx_coll_entry *dce, daos_epoch_t epoch);
 int dtx_refresh_internal(struct ds_cont_child *cont, int *check_count, d_list_t *check_list,
 			 d_list_t *cmt_list, d_list_t *abt_list, d_list_t *act_list, bool for_io);
@@ -22,6 +22,7 @@
 
 CRT_RPC_DEFINE(dtx, DAOS_ISEQ_DTX, DAOS_OSEQ_DTX);
 CRT_RPC_DEFINE(dtx_coll, DAOS_ISEQ_COLL_DTX, DAOS_OSEQ_COLL_DTX);
+CRT_RPC_DEFINE(dtx_pool, DAOS_ISEQ_DTX_POOL, DAOS_OSEQ_DTX);
 
 #define X(a, b, c, d, e, f)	\
 {				\
@@ -56,6 +57,9 @@ struct dtx_req_args {
 	uuid_t				 dra_po_uuid;
 	/* container UUID */
 	uuid_t				 dra_co_uuid;
+	/* containers UUIDs array and its size, for DTX_POOL_COMMIT. */
+	uuid_t				*dra_co_uuids;
+	uint32_t			 dra_co_nr;
 	uint32_t                         dra_version;
 	/* The count of sub requests. */
 	int				 dra_length;
@@ -89,6 +93,7 @@ struct dtx_req_rec {
 	uint32_t			 drr_inline_flags;
 	struct dtx_id			*drr_dti; /* The DTX array */
 	uint32_t			*drr_flags;
+	uint32_t			*drr_co_idx; /* The containers indexes, for DTX_POOL_COMMIT */
 	union {
 		struct dtx_share_peer	**drr_cb_args; /* Used by dtx_req_cb. */
 		struct dtx_share_peer	*drr_single_cb_arg;
@@ -113,6 +118,8 @@ struct dtx_cf_rec_bundle {
 	 * the dtx_req_rec::drr_dti array size when allocating it.
 	 */
 	int				 dcrb_count;
+	/* The index of the container that current DTX belongs to, -1 for single container. */
+	int				 dcrb_co_idx;
 };
 
 /* Make sure that the "dcrb_key" is consisted of "dcrb_rank" + "dcrb_tag". */
@@ -137,6 +144,7 @@ dtx_drr_cleanup(struct dtx_req_rec *drr)
 		}
 		D_FREE(drr->drr_dti);
 		D_FREE(drr->drr_flags);
+		D_FREE(drr->drr_co_idx);
 	} else if (drr->drr_single_cb_arg != NULL) {
 		dtx_dsp_free(drr->drr_single_cb_arg);
 	}
@@ -161,7 +169,7 @@ dtx_req_cb(const struct crt_cb_info *cb_info)
 		goto out;
 
 	dout = crt_reply_get(req);
-	if (dra->dra_opc == DTX_COMMIT) {
+	if (dra->dra_opc == DTX_COMMIT || dra->dra_opc == DTX_POOL_COMMIT) {
 		dra->dra_committed += dout->do_misc;
 		D_GOTO(out, rc = dout->do_status);
 	}
@@ -232,7 +240,8 @@ out:
 	DL_CDEBUG(rc < 0 && rc != -DER_NONEXIST, DLOG_ERR, DB_TRACE, rc,
 		  "DTX req for opc %x (req %p future %p) got reply from %d/%d: "
 		  "epoch :"DF_X64, dra->dra_opc, req, dra->dra_future,
-		  drr->drr_rank, drr->drr_tag, din != NULL ? din->di_epoch : 0);
+		  drr->drr_rank, drr->drr_tag,
+		  din != NULL && dra->dra_opc != DTX_POOL_COMMIT ? din->di_epoch : 0);
 
 	drr->drr_comp = 1;
 	drr->drr_result = rc;
@@ -258,7 +267,20 @@ dtx_req_send(struct dtx_req_rec *drr, daos_epoch_t epoch)
 	opc = DAOS_RPC_OPCODE(dra->dra_opc, DAOS_DTX_MODULE, DAOS_DTX_VERSION);
 
 	rc = crt_req_create(dss_get_module_info()->dmi_ctx, &tgt_ep, opc, &req);
-	if (rc == 0) {
+	if (rc == 0 && dra->dra_opc == DTX_POOL_COMMIT) {
+		struct dtx_pool_in	*dpi = crt_req_get(req);
+
+		uuid_copy(dpi->dpi_po_uuid, dra->dra_po_uuid);
+		dpi->dpi_version             = dra->dra_version;
+		dpi->dpi_co_uuids.ca_count   = dra->dra_co_nr;
+		dpi->dpi_co_uuids.ca_arrays  = dra->dra_co_uuids;
+		dpi->dpi_co_idx.ca_count     = drr->drr_count;
+		dpi->dpi_co_idx.ca_arrays    = drr->drr_co_idx;
+		dpi->dpi_dtx_array.ca_count  = drr->drr_count;
+		dpi->dpi_dtx_array.ca_arrays = drr->drr_dti;
+
+		rc = crt_req_send(req, dtx_req_cb, drr);
+	} else if (rc == 0) {
 		din = crt_req_get(req);
 		uuid_copy(din->di_po_uuid, dra->dra_po_uuid);
 		uuid_copy(din->di_co_uuid, dra->dra_co_uuid);
@@ -459,6 +481,16 @@ dtx_cf_rec_alloc(struct btr_instance *tins, d_iov_t *key_iov,
 		return -DER_NOMEM;
 	}
 
+	if (dcrb->dcrb_co_idx >= 0) {
+		D_ALLOC_ARRAY(drr->drr_co_idx, dcrb->dcrb_count);
+		if (drr->drr_co_idx == NULL) {
+			D_FREE(drr->drr_dti);
+			D_FREE(drr);
+			return -DER_NOMEM;
+		}
+		drr->drr_co_idx[0] = dcrb->dcrb_co_idx;
+	}
+
 	drr->drr_rank = dcrb->dcrb_rank;
 	drr->drr_tag = dcrb->dcrb_tag;
 	drr->drr_count = 1;
@@ -508,6 +540,8 @@ dtx_cf_rec_update(struct btr_instance *tins, struct btr_record *rec,
 			    dcrb->dcrb_dti)) {
 		D_ASSERT(drr->drr_count < dcrb->dcrb_count);
 
+		if (drr->drr_co_idx != NULL)
+			drr->drr_co_idx[drr->drr_count] = dcrb->dcrb_co_idx;
 		drr->drr_dti[drr->drr_count++] = *dcrb->dcrb_dti;
 	}
 
@@ -525,7 +559,7 @@ btr_ops_t dbtree_dtx_cf_ops = {
 
 static int
 dtx_classify_one(struct ds_pool *pool, daos_handle_t tree, d_list_t *head, int *length,
-		 struct dtx_entry *dte, int count, d_rank_t my_rank, uint32_t my_tgtid,
+		 struct dtx_entry *dte, int count, int co_idx, d_rank_t my_rank, uint32_t my_tgtid,
 		 uint32_t opc)
 {
 	struct dtx_memberships		*mbs = dte->dte_mbs;
@@ -539,6 +573,7 @@ dtx_classify_one(struct ds_pool *pool, daos_handle_t tree, d_list_t *head, int *
 
 	if (daos_handle_is_valid(tree)) {
 		dcrb.dcrb_count = count;
+		dcrb.dcrb_co_idx = co_idx;
 		dcrb.dcrb_dti = &dte->dte_xid;
 		dcrb.dcrb_head = head;
 		dcrb.dcrb_length = length;
@@ -638,6 +673,93 @@ dtx_rpc_helper(struct dss_chore *chore, bool is_reentrance)
 	return DSS_CHORE_DONE;
 }
 
+/* Send the classified DTX RPCs in dca->dca_head and wait for their replies. */
+static int
+dtx_rpc_steps(struct dtx_common_args *dca, int length, int opc)
+{
+	int	rc = 0;
+
+	dca->dca_chore.cho_func     = dtx_rpc_helper;
+	dca->dca_chore.cho_priority = 1;
+	dca->dca_drr = d_list_entry(dca->dca_head.next, struct dtx_req_rec, drr_link);
+
+	/*
+	 * Do not send out the batched RPCs all together, instead, we do that step by step to
+	 * avoid holding too much system resources for relative long time. It is also helpful
+	 * to reduce the whole network peak load and the pressure on related peers.
+	 */
+	while (length > 0) {
+		if (length > DTX_PRI_RPC_STEP_LENGTH && opc != DTX_CHECK)
+			dca->dca_steps = DTX_PRI_RPC_STEP_LENGTH;
+		else
+			dca->dca_steps = length;
+
+		/* Use helper ULT to handle DTX RPC if there are enough helper XS. */
+		if (dss_has_enough_helper()) {
+			rc = ABT_eventual_create(0, &dca->dca_chore_eventual);
+			if (rc != ABT_SUCCESS) {
+				D_ERROR("failed to create eventual: %d\n", rc);
+				return dss_abterr2der(rc);
+			}
+
+			dca->dca_chore.cho_credits = dca->dca_steps;
+			dca->dca_chore.cho_hint    = NULL;
+			rc                         = dss_chore_register(&dca->dca_chore);
+			if (rc != 0) {
+				ABT_eventual_free(&dca->dca_chore_eventual);
+				return rc;
+			}
+
+			rc = ABT_eventual_wait(dca->dca_chore_eventual, NULL);
+			D_ASSERTF(rc == ABT_SUCCESS, "ABT_eventual_wait: %d\n", rc);
+
+			rc = ABT_eventual_free(&dca->dca_chore_eventual);
+			D_ASSERTF(rc == ABT_SUCCESS, "ABT_eventual_free: %d\n", rc);
+		} else {
+			dss_chore_diy(&dca->dca_chore);
+		}
+
+		rc = dtx_req_wait(&dca->dca_dra);
+		dss_chore_deregister(&dca->dca_chore);
+		if (rc == 0 || rc == -DER_NONEXIST)
+			goto next;
+
+		switch (opc) {
+		case DTX_COMMIT:
+		case DTX_POOL_COMMIT:
+		case DTX_ABORT:
+			/*
+			 * Continue to send out more RPCs as long as there is no local failure,
+			 * then other healthy participants can commit/abort related DTX entries
+			 * without being affected by the bad one(s).
+			 */
+			if (dca->dca_dra.dra_local_fail)
+				return rc;
+			break;
+		case DTX_CHECK:
+			if (rc == DTX_ST_COMMITTED || rc == DTX_ST_COMMITTABLE)
+				return rc;
+			/*
+			 * Go ahead even if someone failed, there may be 'COMMITTED'
+			 * in subsequent check, that will overwrite former failure.
+			 */
+			break;
+		case DTX_REFRESH:
+			D_ASSERTF(length < DTX_PRI_RPC_STEP_LENGTH,
+				  "Too long list for DTX refresh: %u vs %u\n", length,
+				  DTX_PRI_RPC_STEP_LENGTH);
+			break;
+		default:
+			D_ASSERTF(0, "Invalid DTX opc %u\n", opc);
+		}
+
+next:
+		length -= dca->dca_steps;
+	}
+
+	return rc;
+}
+
 static int
 dtx_rpc(struct ds_cont_child *cont,d_list_t *dti_list,  struct dtx_entry **dtes, uint32_t count,
 	int opc, daos_epoch_t epoch, d_list_t *cmt_list, d_list_t *abt_list, d_list_t *act_list,
@@ -700,7 +822,7 @@ dtx_rpc(struct ds_cont_child *cont,d_list_t *dti_list,  struct dtx_entry **dtes,
 		ABT_rwlock_rdlock(pool->sp_lock);
 		for (i = 0; i < dca->dca_count; i++) {
 			rc = dtx_classify_one(pool, dca->dca_tree_hdl, &dca->dca_head, &length,
-					      dca->dca_dtes[i], dca->dca_count,
+					      dca->dca_dtes[i], dca->dca_count, -1,
 					      dca->dca_rank, dca->dca_tgtid, dca->dca_dra.dra_opc);
 			if (rc != 0) {
 				ABT_rwlock_unlock(pool->sp_lock);
@@ -724,83 +846,7 @@ dtx_rpc(struct ds_cont_child *cont,d_list_t *dti_list,  struct dtx_entry **dtes,
 		length = dca->dca_count;
 	}
 
-	dca->dca_chore.cho_func     = dtx_rpc_helper;
-	dca->dca_chore.cho_priority = 1;
-	dca->dca_drr = d_list_entry(dca->dca_head.next, struct dtx_req_rec, drr_link);
-
-	/*
-	 * Do not send out the batched RPCs all together, instead, we do that step by step to
-	 * avoid holding too much system resources for relative long time. It is also helpful
-	 * to reduce the whole network peak load and the pressure on related peers.
-	 */
-	while (length > 0) {
-		if (length > DTX_PRI_RPC_STEP_LENGTH && opc != DTX_CHECK)
-			dca->dca_steps = DTX_PRI_RPC_STEP_LENGTH;
-		else
-			dca->dca_steps = length;
-
-		/* Use helper ULT to handle DTX RPC if there are enough helper XS. */
-		if (dss_has_enough_helper()) {
-			rc = ABT_eventual_create(0, &dca->dca_chore_eventual);
-			if (rc != ABT_SUCCESS) {
-				D_ERROR("failed to create eventual: %d\n", rc);
-				rc = dss_abterr2der(rc);
-				goto out;
-			}
-
-			dca->dca_chore.cho_credits = dca->dca_steps;
-			dca->dca_chore.cho_hint    = NULL;
-			rc                         = dss_chore_register(&dca->dca_chore);
-			if (rc != 0) {
-				ABT_eventual_free(&dca->dca_chore_eventual);
-				goto out;
-			}
-
-			rc = ABT_eventual_wait(dca->dca_chore_eventual, NULL);
-			D_ASSERTF(rc == ABT_SUCCESS, "ABT_eventual_wait: %d\n", rc);
-
-			rc = ABT_eventual_free(&dca->dca_chore_eventual);
-			D_ASSERTF(rc == ABT_SUCCESS, "ABT_eventual_free: %d\n", rc);
-		} else {
-			dss_chore_diy(&dca->dca_chore);
-		}
-
-		rc = dtx_req_wait(&dca->dca_dra);
-		dss_chore_deregister(&dca->dca_chore);
-		if (rc == 0 || rc == -DER_NONEXIST)
-			goto next;
-
-		switch (opc) {
-		case DTX_COMMIT:
-		case DTX_ABORT:
-			/*
-			 * Continue to send out more RPCs as long as there is no local failure,
-			 * then other healthy participants can commit/abort related DTX entries
-			 * without being affected by the bad one(s).
-			 */
-			if (dca->dca_dra.dra_local_fail)
-				goto out;
-			break;
-		case DTX_CHECK:
-			if (rc == DTX_ST_COMMITTED || rc == DTX_ST_COMMITTABLE)
-				goto out;
-			/*
-			 * Go ahead even if someone failed, there may be 'COMMITTED'
-			 * in subsequent check, that will overwrite former failure.
-			 */
-			break;
-		case DTX_REFRESH:
-			D_ASSERTF(length < DTX_PRI_RPC_STEP_LENGTH,
-				  "Too long list for DTX refresh: %u vs %u\n", length,
-				  DTX_PRI_RPC_STEP_LENGTH);
-			break;
-		default:
-			D_ASSERTF(0, "Invalid DTX opc %u\n", opc);
-		}
-
-next:
-		length -= dca->dca_steps;
-	}
+	rc = dtx_rpc_steps(dca, length, opc);
 
 out:
 	if (daos_handle_is_valid(dca->dca_tree_hdl))
@@ -928,6 +974,145 @@ out:
 }
 
 
+/**
+ * Commit the given DTXs that belong to multiple containers of the same pool globally.
+ *
+ * It is similar as dtx_commit(), but the DTXs of all the given containers are classified
+ * together, then the shards that reside on the same server (rank + tag) are sent via single
+ * DTX_POOL_COMMIT RPC regardless of which container they belong to, and the local ones are
+ * committed via single local transaction. It is used by the pool level batched commit to
+ * merge the small batches from the containers that share the targets.
+ */
+int
+dtx_pool_commit(struct ds_pool_child *pool_child, struct ds_cont_child **conts,
+		struct dtx_entry ***dtes, int *counts, int cont_nr)
+{
+	struct ds_pool		*pool = pool_child->spc_pool;
+	struct dtx_common_args	 dca;
+	struct dtx_req_args	*dra = &dca.dca_dra;
+	struct dtx_req_rec	*drr;
+	struct umem_attr	 uma = { 0 };
+	struct dtx_id		*dtis[DTX_POOL_COALESCE_MAX];
+	daos_handle_t		 cohs[DTX_POOL_COALESCE_MAX];
+	bool			*rm_cos[DTX_POOL_COALESCE_MAX];
+	bool			*rm_buf = NULL;
+	uuid_t			*co_uuids = NULL;
+	int			 length = 0;
+	int			 total = 0;
+	int			 rc = 0;
+	int			 rc1 = 0;
+	int			 i;
+	int			 j;
+	int			 k;
+
+	D_ASSERT(cont_nr > 0 && cont_nr <= DTX_POOL_COALESCE_MAX);
+
+	for (k = 0; k < cont_nr; k++)
+		total += counts[k];
+
+	memset(&dca, 0, sizeof(dca));
+	dca.dca_chore_eventual = ABT_EVENTUAL_NULL;
+	D_INIT_LIST_HEAD(&dca.dca_head);
+	dca.dca_tree_hdl = DAOS_HDL_INVAL;
+	dca.dca_count = total;
+	crt_group_rank(NULL, &dca.dca_rank);
+	dca.dca_tgtid = dss_get_module_info()->dmi_tgt_id;
+
+	dra->dra_future  = ABT_FUTURE_NULL;
+	dra->dra_version = pool->sp_map_version;
+	dra->dra_opc     = DTX_POOL_COMMIT;
+	uuid_copy(dra->dra_po_uuid, pool->sp_uuid);
+
+	D_ALLOC_ARRAY(dca.dca_dtis, total);
+	if (dca.dca_dtis == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	D_ALLOC_ARRAY(co_uuids, cont_nr);
+	if (co_uuids == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	dra->dra_co_uuids = co_uuids;
+	dra->dra_co_nr    = cont_nr;
+
+	uma.uma_id = UMEM_CLASS_VMEM;
+	rc = dbtree_create_inplace(DBTREE_CLASS_DTX_CF, 0, DTX_CF_BTREE_ORDER, &uma,
+				   &dca.dca_tree_root, &dca.dca_tree_hdl);
+	if (rc != 0)
+		goto out;
+
+	ABT_rwlock_rdlock(pool->sp_lock);
+	for (k = 0, j = 0; k < cont_nr; k++) {
+		uuid_copy(co_uuids[k], conts[k]->sc_uuid);
+		cohs[k] = conts[k]->sc_hdl;
+		dtis[k] = &dca.dca_dtis[j];
+
+		for (i = 0; i < counts[k]; i++, j++) {
+			rc = dtx_classify_one(pool, dca.dca_tree_hdl, &dca.dca_head, &length,
+					      dtes[k][i], total, k, dca.dca_rank, dca.dca_tgtid,
+					      DTX_POOL_COMMIT);
+			if (rc != 0) {
+				ABT_rwlock_unlock(pool->sp_lock);
+				goto out;
+			}
+
+			daos_dti_copy(&dca.dca_dtis[j], &dtes[k][i]->dte_xid);
+		}
+	}
+	ABT_rwlock_unlock(pool->sp_lock);
+
+	/* Let remote participants to commit firstly, see dtx_commit() for the reason. */
+	if (length > 0)
+		rc = dtx_rpc_steps(&dca, length, DTX_POOL_COMMIT);
+	if (rc > 0 || rc == -DER_NONEXIST || rc == -DER_EXCLUDED || rc == -DER_OOG)
+		rc = 0;
+
+	if (rc == 0 || dra->dra_committed > 0) {
+		if (rc == 0) {
+			D_ALLOC_ARRAY(rm_buf, total);
+			if (rm_buf == NULL)
+				D_GOTO(out, rc1 = -DER_NOMEM);
+		}
+
+		for (k = 0, j = 0; k < cont_nr; j += counts[k], k++)
+			rm_cos[k] = rm_buf != NULL ? &rm_buf[j] : NULL;
+
+		rc1 = vos_dtx_commit_multi(cohs, dtis, counts, cont_nr, rc != 0, rm_cos);
+		if (rc1 > 0) {
+			dra->dra_committed += rc1;
+			rc1 = 0;
+		} else if (rc1 == -DER_NONEXIST) {
+			rc1 = 0;
+		}
+
+		/* For partial commit case, move them to the tail of the committable lists. */
+		if (rc1 == 0) {
+			for (k = 0; k < cont_nr; k++)
+				dtx_cos_batched_del(conts[k], dtis[k], rm_cos[k], counts[k]);
+		}
+	}
+
+out:
+	if (daos_handle_is_valid(dca.dca_tree_hdl))
+		dbtree_destroy(dca.dca_tree_hdl, NULL);
+
+	while ((drr = d_list_pop_entry(&dca.dca_head, struct dtx_req_rec, drr_link)) != NULL)
+		dtx_drr_cleanup(drr);
+
+	D_FREE(rm_buf);
+	D_FREE(co_uuids);
+	D_FREE(dca.dca_dtis);
+
+	if (rc != 0 || rc1 != 0)
+		D_ERROR("Failed to commit DTX entries for %d containers of "DF_UUID", count %d, "
+			"%s committed: %d %d\n", cont_nr, DP_UUID(pool->sp_uuid), total,
+			dra->dra_committed > 0 ? "partial" : "nothing", rc, rc1);
+	else
+		D_DEBUG(DB_TRACE, "Commit DTXs for %d containers of "DF_UUID", count %d\n",
+			cont_nr, DP_UUID(pool->sp_uuid), total);
+
+	return rc != 0 ? rc : rc1;
+}
+
 int
 dtx_abort(struct ds_cont_child *cont, struct dtx_entry *dte, daos_epoch_t epoch)
 {
@@ -61,6 +61,25 @@ dtx_tls_init(int tags, int xs_id, int tgt_id)
 	if (rc != DER_SUCCESS)
 		D_WARN("Failed to create DTX chore retry metric: " DF_RC "\n", DP_RC(rc));
 
+	rc = d_tm_add_metric(&tls->dt_cmt_lag, D_TM_STATS_GAUGE,
+			     "age of the oldest committable DTX when batched commit it", "ms",
+			     "io/dtx/cmt_lag/tgt_%u", tgt_id);
+	if (rc != DER_SUCCESS)
+		D_WARN("Failed to create DTX commit lag metric: " DF_RC "\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&tls->dt_pool_cmt_batch, D_TM_STATS_GAUGE,
+			     "DTX entries per pool level batched commit", "entry",
+			     "io/dtx/pool_cmt_batch/tgt_%u", tgt_id);
+	if (rc != DER_SUCCESS)
+		D_WARN("Failed to create DTX pool commit batch metric: " DF_RC "\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&tls->dt_pool_cmt_conts, D_TM_STATS_GAUGE,
+			     "containers merged per pool level batched commit", "container",
+			     "io/dtx/pool_cmt_conts/tgt_%u", tgt_id);
+	if (rc != DER_SUCCESS)
+		D_WARN("Failed to create DTX pool commit containers metric: " DF_RC "\n",
+		       DP_RC(rc));
+
 	return tls;
 }
 
@@ -358,6 +377,100 @@ out:
 		ds_cont_child_put(cont);
 }
 
+static void
+dtx_pool_handler(crt_rpc_t *rpc)
+{
+	struct dtx_pool_metrics	*dpm = NULL;
+	struct dtx_pool_in	*dpi = crt_req_get(rpc);
+	struct dtx_out		*dout = crt_reply_get(rpc);
+	struct ds_cont_child	*conts[DTX_POOL_COALESCE_MAX] = { 0 };
+	struct dtx_id		*dtis[DTX_POOL_COALESCE_MAX];
+	daos_handle_t		 cohs[DTX_POOL_COALESCE_MAX];
+	int			 counts[DTX_POOL_COALESCE_MAX];
+	uuid_t			*co_uuids = dpi->dpi_co_uuids.ca_arrays;
+	uint32_t		*co_idx = dpi->dpi_co_idx.ca_arrays;
+	uint32_t		 dtx_cnt = dpi->dpi_dtx_array.ca_count;
+	uint32_t		 co_nr = dpi->dpi_co_uuids.ca_count;
+	uint32_t		 committed = 0;
+	uint64_t		 opc_cnt = 0;
+	uint64_t		 pool_cnt = 0;
+	uint64_t		 ent_cnt = 0;
+	int			 nr = 0;
+	int			 rc = 0;
+	int			 rc1;
+	int			 i;
+	int			 j;
+
+	if (co_nr == 0 || co_nr > DTX_POOL_COALESCE_MAX || dpi->dpi_co_idx.ca_count != dtx_cnt)
+		D_GOTO(out, rc = -DER_PROTO);
+
+	if (DAOS_FAIL_CHECK(DAOS_DTX_MISS_COMMIT))
+		goto out;
+
+	/* The DTXs are sorted against the containers, split them into per container runs. */
+	for (i = 0; i < dtx_cnt; i = j) {
+		if (co_idx[i] >= co_nr || (i > 0 && co_idx[i] <= co_idx[i - 1]))
+			D_GOTO(out, rc = -DER_PROTO);
+
+		for (j = i + 1; j < dtx_cnt && co_idx[j] == co_idx[i]; j++)
+			;
+
+		rc1 = ds_cont_child_lookup(dpi->dpi_po_uuid, co_uuids[co_idx[i]], &conts[nr]);
+		if (rc1 != 0) {
+			/* Go ahead, the others can still be committed. */
+			D_ERROR("Failed to locate pool="DF_UUID" cont idx %u for DTX pool commit: "
+				DF_RC"\n", DP_UUID(dpi->dpi_po_uuid), co_idx[i], DP_RC(rc1));
+			if (rc == 0)
+				rc = rc1;
+			continue;
+		}
+
+		cohs[nr] = conts[nr]->sc_hdl;
+		dtis[nr] = (struct dtx_id *)dpi->dpi_dtx_array.ca_arrays + i;
+		counts[nr] = j - i;
+		nr++;
+	}
+
+	if (nr == 0)
+		goto out;
+
+	dpm = conts[0]->sc_pool->spc_metrics[DAOS_DTX_MODULE];
+
+	rc1 = vos_dtx_commit_multi(cohs, dtis, counts, nr, false, NULL);
+	if (rc1 > 0)
+		committed += rc1;
+	else if (rc == 0 && rc1 < 0)
+		rc = rc1;
+
+	d_tm_inc_counter(dpm->dpm_batched_total, dtx_cnt);
+	rc1 = d_tm_get_counter(NULL, &ent_cnt, dpm->dpm_batched_total);
+	D_ASSERT(rc1 == DER_SUCCESS);
+
+	rc1 = d_tm_get_counter(NULL, &opc_cnt, dpm->dpm_total[DTX_COMMIT]);
+	D_ASSERT(rc1 == DER_SUCCESS);
+
+	rc1 = d_tm_get_counter(NULL, &pool_cnt, dpm->dpm_total[DTX_POOL_COMMIT]);
+	D_ASSERT(rc1 == DER_SUCCESS);
+
+	d_tm_set_gauge(dpm->dpm_batched_degree, ent_cnt / (opc_cnt + pool_cnt + 1));
+
+out:
+	D_DEBUG(DB_TRACE, "Handle DTX pool commit for "DF_UUID", %u containers, count %u: "
+		"rc = "DF_RC"\n", DP_UUID(dpi->dpi_po_uuid), co_nr, dtx_cnt, DP_RC(rc));
+
+	dout->do_status = rc;
+	dout->do_misc   = committed;
+	rc              = crt_reply_send_input_free(rpc);
+	if (rc != 0)
+		D_ERROR("send reply failed for DTX pool commit: rc = "DF_RC"\n", DP_RC(rc));
+
+	if (likely(dpm != NULL))
+		d_tm_inc_counter(dpm->dpm_total[DTX_POOL_COMMIT], 1);
+
+	for (i = 0; i < nr; i++)
+		ds_cont_child_put(conts[i]);
+}
+
 static void
 dtx_coll_handler(crt_rpc_t *rpc)
 {
@@ -539,6 +652,15 @@ dtx_init(void)
 	d_getenv_uint32_t("DAOS_DTX_BATCHED_ULT_MAX", &dtx_batched_ult_max);
 	D_INFO("Set the max count of DTX batched commit ULTs as %d\n", dtx_batched_ult_max);
 
+	dtx_pool_coalesce = 0;
+	d_getenv_uint32_t("DAOS_DTX_POOL_COALESCE", &dtx_pool_coalesce);
+	if (dtx_pool_coalesce > DTX_POOL_COALESCE_MAX) {
+		D_WARN("Invalid DTX pool coalesce count %u, the max is %u, use the max one\n",
+		       dtx_pool_coalesce, DTX_POOL_COALESCE_MAX);
+		dtx_pool_coalesce = DTX_POOL_COALESCE_MAX;
+	}
+	D_INFO("Set the max count of containers per DTX pool commit as %u\n", dtx_pool_coalesce);
+
 	rc = dbtree_class_register(DBTREE_CLASS_DTX_CF,
 				   BTR_FEAT_UINT_KEY | BTR_FEAT_DYNAMIC_ROOT,
 				   &dbtree_dtx_cf_ops);
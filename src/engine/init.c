@@ -679,8 +679,10 @@ metrics_region_size(int num_tgts)
 {
 	const uint64_t	est_std_metrics = 1024; /* high estimate to allow for pool links */
 	const uint64_t	est_tgt_metrics = 128; /* high estimate */
+	const uint64_t	est_tgt_hdr     = 96;  /* log-linear latency histograms */
 
-	return (est_std_metrics + est_tgt_metrics * num_tgts) * D_TM_METRIC_SIZE;
+	return (est_std_metrics + est_tgt_metrics * num_tgts) * D_TM_METRIC_SIZE +
+	       est_tgt_hdr * num_tgts * D_TM_HDR_SIZE(D_TM_HDR_SUB_BITS);
 }
 
 static int
@@ -147,12 +147,15 @@ struct sched_pool_info {
 	int			spi_gc_sleeping;
 	int			spi_ref;
 	uint32_t		spi_req_cnt;
+	/* SCHED_POLICY_* used for the IO requests of this pool */
+	int			spi_policy;
 	struct stats_window	spi_stats_window;
 };
 
 struct sched_request {
 	/*
-	 * IO request links to 'sched_info->si_fifo_list', other types of
+	 * IO request links to 'sched_info->si_fifo_list' (or is in
+	 * 'sched_info->si_edf_heap' for SCHED_POLICY_EDF pools), other types of
 	 * request link to each 'sched_req_info->sri_req_list' respectively.
 	 * When request is not used, it's in 'sched_info->si_idle_list'.
 	 */
@@ -167,11 +170,15 @@ struct sched_request {
 	uint64_t		 sr_wakeup_time;
 	/* When the request is enqueued, in msecs */
 	uint64_t		 sr_enqueue_ts;
+	/* When the request should be kicked off by SCHED_POLICY_EDF, in msecs */
+	uint64_t		 sr_deadline;
 	unsigned int		 sr_abort:1,
 				 /* sr_ult is sched_request-owned */
 				 sr_owned:1,
 				 /* request is in heap */
-				 sr_in_heap:1;
+				 sr_in_heap:1,
+				 /* request is in EDF heap */
+				 sr_in_edf:1;
 };
 
 bool		sched_prio_disabled;
@@ -193,11 +200,24 @@ enum {
 	 * Container ID, JobID, UID, etc.)
 	 */
 	SCHED_POLICY_ID_PRIO,
+	/*
+	 * IO requests are processed in earliest-deadline-first order, the
+	 * deadline is derived from the RPC timeout and is tighter for latency
+	 * sensitive requests (SCHED_REQ_FL_LATENCY). System requests of the pool
+	 * are kicked off after the IO requests in each cycle.
+	 */
+	SCHED_POLICY_EDF,
 	SCHED_POLICY_MAX
 };
 
 static int	sched_policy;
 
+/* Pools using SCHED_POLICY_EDF, see sched_policy_init() */
+#define SCHED_EDF_POOLS_MAX	32
+static uuid_t	sched_edf_pools[SCHED_EDF_POOLS_MAX];
+/* Number of pools in sched_edf_pools, -1 for all pools */
+static int	sched_edf_pool_nr;
+
 struct pressure_ratio {
 	unsigned int	pr_free;	/* free space ratio */
 	unsigned int	pr_gc_ratio;	/* CPU percentage for GC & Aggregation */
@@ -444,6 +464,7 @@ sched_info_fini(struct dss_xstream *dx)
 	D_ASSERT(info->si_total_req_cnt == 0);
 	D_ASSERT(d_list_empty(&info->si_sleep_list));
 	D_ASSERT(d_list_empty(&info->si_fifo_list));
+	D_ASSERT(d_binheap_is_empty(&info->si_edf_heap));
 
 	prune_purge_list(dx);
 
@@ -452,10 +473,11 @@ sched_info_fini(struct dss_xstream *dx)
 		info->si_pool_hash = NULL;
 	}
 	d_binheap_destroy_inplace(&info->si_heap);
+	d_binheap_destroy_inplace(&info->si_edf_heap);
 
 	d_list_for_each_entry_safe(req, tmp, &info->si_idle_list,
 				   sr_link) {
-		D_ASSERT(req->sr_in_heap == 0);
+		D_ASSERT(req->sr_in_heap == 0 && req->sr_in_edf == 0);
 		d_list_del_init(&req->sr_link);
 		D_FREE(req);
 	}
@@ -528,6 +550,24 @@ sched_metrics_init(struct dss_xstream *dx)
 			     "req", "sched/total_reject/xs_%u", dx->dx_xs_id);
 	if (rc)
 		D_WARN("Failed to create total_reject telemetry: "DF_RC"\n", DP_RC(rc));
+
+	/* IO requests are only queued on the VOS xstreams, see should_enqueue_req() */
+	if (!dx->dx_main_xs)
+		return;
+
+	rc = d_tm_add_metric(&stats->ss_fetch_delay, D_TM_STATS_GAUGE, "Fetch queueing delay",
+			     "ms", "sched/fetch_delay/xs_%u", dx->dx_xs_id);
+	if (rc == 0)
+		rc = d_tm_init_hdr_histogram(stats->ss_fetch_delay, D_TM_HDR_SUB_BITS);
+	if (rc)
+		D_WARN("Failed to create fetch_delay telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->ss_update_delay, D_TM_STATS_GAUGE, "Update queueing delay",
+			     "ms", "sched/update_delay/xs_%u", dx->dx_xs_id);
+	if (rc == 0)
+		rc = d_tm_init_hdr_histogram(stats->ss_update_delay, D_TM_HDR_SUB_BITS);
+	if (rc)
+		D_WARN("Failed to create update_delay telemetry: "DF_RC"\n", DP_RC(rc));
 }
 
 static int
@@ -576,6 +616,53 @@ static struct d_binheap_ops rpc_heap_ops = {
 	.hop_compare	= rpc_heap_node_cmp,
 };
 
+static int
+edf_heap_node_enter(struct d_binheap *h, struct d_binheap_node *e)
+{
+	struct sched_request *sr;
+
+	D_ASSERT(h != NULL);
+	D_ASSERT(e != NULL);
+
+	sr = container_of(e, struct sched_request, sr_node);
+	sr->sr_in_edf = 1;
+
+	return 0;
+}
+
+static int
+edf_heap_node_exit(struct d_binheap *h, struct d_binheap_node *e)
+{
+	struct sched_request *sr;
+
+	D_ASSERT(h != NULL);
+	D_ASSERT(e != NULL);
+
+	sr = container_of(e, struct sched_request, sr_node);
+	sr->sr_in_edf = 0;
+
+	return 0;
+}
+
+static bool
+edf_heap_node_cmp(struct d_binheap_node *a, struct d_binheap_node *b)
+{
+	struct sched_request *nodea, *nodeb;
+
+	nodea = container_of(a, struct sched_request, sr_node);
+	nodeb = container_of(b, struct sched_request, sr_node);
+
+	/* Min heap, the earliest deadline is heap root */
+	return sched_edf_before(nodea->sr_deadline, nodea->sr_attr.sra_enqueue_id,
+				nodeb->sr_deadline, nodeb->sr_attr.sra_enqueue_id);
+}
+
+static struct d_binheap_ops edf_heap_ops = {
+	.hop_enter	= edf_heap_node_enter,
+	.hop_exit	= edf_heap_node_exit,
+	.hop_compare	= edf_heap_node_cmp,
+};
+
 static int
 sched_info_init(struct dss_xstream *dx)
 {
@@ -613,6 +700,12 @@ sched_info_init(struct dss_xstream *dx)
 		goto out;
 	}
 
+	rc = d_binheap_create_inplace(DBH_FT_NOLOCK, 0, NULL, &edf_heap_ops, &info->si_edf_heap);
+	if (rc != 0) {
+		D_ERROR("Failed to create EDF binheap. "DF_RC"\n", DP_RC(rc));
+		goto out;
+	}
+
 	rc = prealloc_requests(info, count);
 
 out:
@@ -622,6 +715,22 @@ out:
 	return rc;
 }
 
+static int
+sched_pool2policy(uuid_t pool_uuid)
+{
+	int i;
+
+	if (sched_edf_pool_nr < 0)
+		return SCHED_POLICY_EDF;
+
+	for (i = 0; i < sched_edf_pool_nr; i++) {
+		if (uuid_compare(sched_edf_pools[i], pool_uuid) == 0)
+			return SCHED_POLICY_EDF;
+	}
+
+	return sched_policy;
+}
+
 static struct sched_pool_info *
 cur_pool_info(struct sched_info *info, uuid_t pool_uuid)
 {
@@ -646,6 +755,7 @@ cur_pool_info(struct sched_info *info, uuid_t pool_uuid)
 
 	D_INIT_LIST_HEAD(&spi->spi_hash_link);
 	uuid_copy(spi->spi_pool_id, pool_uuid);
+	spi->spi_policy = sched_pool2policy(pool_uuid);
 
 	for (type = SCHED_REQ_UPDATE; type < SCHED_REQ_MAX; type++) {
 		list = pool2req_list(spi, type);
@@ -760,8 +870,15 @@ req_kickoff(struct dss_xstream *dx, struct sched_request *req)
 	info->si_req_cnt[req->sr_attr.sra_type]--;
 	sw_cycle_update(&spi->spi_stats_window, req->sr_attr.sra_type);
 
+	if (req->sr_attr.sra_type == SCHED_REQ_FETCH)
+		d_tm_set_gauge(info->si_stats.ss_fetch_delay, info->si_cur_ts - req->sr_enqueue_ts);
+	else if (req->sr_attr.sra_type == SCHED_REQ_UPDATE)
+		d_tm_set_gauge(info->si_stats.ss_update_delay, info->si_cur_ts - req->sr_enqueue_ts);
+
 	if (req->sr_in_heap)
 		d_binheap_remove(&info->si_heap, &req->sr_node);
+	else if (req->sr_in_edf)
+		d_binheap_remove(&info->si_edf_heap, &req->sr_node);
 	else
 		d_list_del_init(&req->sr_link);
 
@@ -1135,6 +1252,14 @@ is_system_req(int req_type)
 	return true;
 }
 
+static inline void
+process_sys_reqs(struct dss_xstream *dx, struct sched_pool_info *spi)
+{
+	process_req_list(dx, pool2req_list(spi, SCHED_REQ_GC), true);
+	process_req_list(dx, pool2req_list(spi, SCHED_REQ_SCRUB), true);
+	process_req_list(dx, pool2req_list(spi, SCHED_REQ_MIGRATE), true);
+}
+
 static int
 process_pool_cb(d_list_t *rlink, void *arg)
 {
@@ -1187,9 +1312,22 @@ process_pool_cb(d_list_t *rlink, void *arg)
 		info->si_kicked_req_cnt[i] = 0;
 	}
 
-	process_req_list(dx, pool2req_list(spi, SCHED_REQ_GC), true);
-	process_req_list(dx, pool2req_list(spi, SCHED_REQ_SCRUB), true);
-	process_req_list(dx, pool2req_list(spi, SCHED_REQ_MIGRATE), true);
+	/* Let the IO requests go first, see process_pool_sys_cb() */
+	if (spi->spi_policy != SCHED_POLICY_EDF)
+		process_sys_reqs(dx, spi);
+
+	return 0;
+}
+
+static int
+process_pool_sys_cb(d_list_t *rlink, void *arg)
+{
+	struct dss_xstream	*dx = (struct dss_xstream *)arg;
+	struct sched_pool_info	*spi;
+
+	spi = sched_rlink2spi(rlink);
+	if (spi->spi_policy == SCHED_POLICY_EDF && spi->spi_req_cnt != 0)
+		process_sys_reqs(dx, spi);
 
 	return 0;
 }
@@ -1271,6 +1409,50 @@ policy_fifo_process(struct dss_xstream *dx)
 	}
 }
 
+static int
+policy_edf_enqueue(struct dss_xstream *dx, struct sched_request *req,
+		   void *prio_data)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	struct sched_req_attr	*attr = &req->sr_attr;
+
+	D_ASSERT(attr->sra_type < SCHED_REQ_TYPE_MAX);
+	req->sr_deadline = sched_edf_deadline(info->si_cur_ts, attr);
+
+	return d_binheap_insert(&info->si_edf_heap, &req->sr_node);
+}
+
+static void
+policy_edf_process(struct dss_xstream *dx)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	struct sched_request	*req, *tmp;
+	struct d_binheap_node	*node;
+	d_list_t                 tmp_list;
+	int			 rc;
+
+	D_INIT_LIST_HEAD(&tmp_list);
+	/*
+	 * Requests throttled by their pool limits are put aside, so that the
+	 * following ones with later deadlines can still use the kick quota of
+	 * other pools or request types in this cycle.
+	 */
+	while (!d_binheap_is_empty(&info->si_edf_heap)) {
+		node = d_binheap_root(&info->si_edf_heap);
+		req = container_of(node, struct sched_request, sr_node);
+		rc = process_req(dx, req);
+		if (rc > 0) {
+			d_binheap_remove(&info->si_edf_heap, &req->sr_node);
+			d_list_add_tail(&req->sr_link, &tmp_list);
+		}
+	}
+
+	d_list_for_each_entry_safe(req, tmp, &tmp_list, sr_link) {
+		d_list_del_init(&req->sr_link);
+		d_binheap_insert(&info->si_edf_heap, &req->sr_node);
+	}
+}
+
 struct sched_policy_ops {
 	int (*enqueue_io)(struct dss_xstream *dx, struct sched_request *req,
 			   void *prio_data);
@@ -1289,6 +1471,10 @@ static struct sched_policy_ops	policy_ops[SCHED_POLICY_MAX] = {
 	{	/* SCHED_POLICY_ID_PRIO */
 		.enqueue_io = NULL,
 		.process_io = NULL,
+	},
+	{	/* SCHED_POLICY_EDF */
+		.enqueue_io = policy_edf_enqueue,
+		.process_io = policy_edf_process,
 	}
 };
 
@@ -1303,8 +1489,17 @@ process_all(struct dss_xstream *dx)
 	if (rc)
 		D_ERROR("Traverse pool hash error. "DF_RC"\n", DP_RC(rc));
 
+	if (sched_edf_pool_nr != 0)
+		policy_ops[SCHED_POLICY_EDF].process_io(dx);
+
 	D_ASSERT(policy_ops[sched_policy].process_io != NULL);
 	policy_ops[sched_policy].process_io(dx);
+
+	if (sched_edf_pool_nr != 0) {
+		rc = d_hash_table_traverse(info->si_pool_hash, process_pool_sys_cb, dx);
+		if (rc)
+			D_ERROR("Traverse pool hash error. "DF_RC"\n", DP_RC(rc));
+	}
 }
 
 static inline bool
@@ -1336,12 +1531,12 @@ req_enqueue(struct dss_xstream *dx, struct sched_request *req)
 	D_ASSERT(attr->sra_type < SCHED_REQ_MAX);
 	sri = &spi->spi_req_array[attr->sra_type];
 
-	D_ASSERT(req->sr_in_heap == 0);
+	D_ASSERT(req->sr_in_heap == 0 && req->sr_in_edf == 0);
 	D_ASSERT(d_list_empty(&req->sr_link));
 	if (attr->sra_type == SCHED_REQ_UPDATE ||
 	    attr->sra_type == SCHED_REQ_FETCH) {
-		D_ASSERT(policy_ops[sched_policy].enqueue_io != NULL);
-		rc = policy_ops[sched_policy].enqueue_io(dx, req, NULL);
+		D_ASSERT(policy_ops[spi->spi_policy].enqueue_io != NULL);
+		rc = policy_ops[spi->spi_policy].enqueue_io(dx, req, NULL);
 	} else {
 		d_list_add_tail(&req->sr_link, &sri->sri_req_list);
 	}
@@ -2358,6 +2553,48 @@ dss_sched_fini(struct dss_xstream *dx)
 	sched_info_fini(dx);
 }
 
+/**
+ * Select the pools whose IO requests are scheduled by SCHED_POLICY_EDF. The
+ * DAOS_SCHED_EDF_POOLS environment variable is either "all" or a comma
+ * separated list of pool UUIDs.
+ */
+void
+sched_policy_init(void)
+{
+	char	*env;
+	char	*tok;
+	char	*saveptr = NULL;
+
+	sched_edf_pool_nr = 0;
+	d_agetenv_str(&env, "DAOS_SCHED_EDF_POOLS");
+	if (env == NULL)
+		return;
+
+	if (strcasecmp(env, "all") == 0) {
+		sched_edf_pool_nr = -1;
+		D_INFO("EDF IO scheduling is enabled for all pools\n");
+		goto out;
+	}
+
+	for (tok = strtok_r(env, ",", &saveptr); tok != NULL;
+	     tok = strtok_r(NULL, ",", &saveptr)) {
+		if (sched_edf_pool_nr == SCHED_EDF_POOLS_MAX) {
+			D_WARN("Too many pools in DAOS_SCHED_EDF_POOLS, only %d are used\n",
+			       SCHED_EDF_POOLS_MAX);
+			break;
+		}
+		if (uuid_parse(tok, sched_edf_pools[sched_edf_pool_nr]) != 0) {
+			D_WARN("Invalid pool UUID '%s' in DAOS_SCHED_EDF_POOLS\n", tok);
+			continue;
+		}
+		D_INFO("EDF IO scheduling is enabled for pool "DF_UUID"\n",
+		       DP_UUID(sched_edf_pools[sched_edf_pool_nr]));
+		sched_edf_pool_nr++;
+	}
+out:
+	d_freeenv_str(&env);
+}
+
 int
 dss_sched_init(struct dss_xstream *dx)
 {
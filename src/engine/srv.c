@@ -1098,6 +1098,7 @@ dss_xstreams_init(void)
 
 	d_getenv_uint("DAOS_SCHED_UNIT_RUNTIME_MAX", &sched_unit_runtime_max);
 	d_getenv_bool("DAOS_SCHED_WATCHDOG_ALL", &sched_watchdog_all);
+	sched_policy_init();
 
 	dss_chore_credits = DSS_CHORE_CREDITS_DEF;
 	d_getenv_uint("DAOS_IO_CHORE_CREDITS", &dss_chore_credits);
@@ -1108,6 +1109,13 @@ dss_xstreams_init(void)
 	}
 	D_INFO("Set DAOS IO chore credits as %u\n", dss_chore_credits);
 
+	d_getenv_bool("DAOS_IO_CHORE_STEAL", &dss_chore_steal);
+	if (dss_chore_steal && (!dss_helper_pool || dss_tgt_offload_xs_nr < 2)) {
+		D_WARN("DAOS_IO_CHORE_STEAL requires a pool of at least 2 helper xstreams\n");
+		dss_chore_steal = false;
+	}
+	D_INFO("DAOS IO chore stealing is %s\n", dss_chore_steal ? "enabled" : "disabled");
+
 	/* start the execution streams */
 	D_DEBUG(DB_TRACE,
 		"%d cores total detected starting %d main xstreams\n",
@@ -34,6 +34,8 @@ struct sched_stats {
 	struct d_tm_node_t	*ss_cycle_duration;	/* Cycle duration (ms) */
 	struct d_tm_node_t	*ss_cycle_size;		/* Total ULTs in a cycle */
 	struct d_tm_node_t	*ss_total_reject;	/* Total Rejected requests */
+	struct d_tm_node_t	*ss_fetch_delay;	/* Fetch queueing delay (ms) */
+	struct d_tm_node_t	*ss_update_delay;	/* Update queueing delay (ms) */
 	uint64_t		 ss_busy_ts;		/* Last busy timestamp (ms) */
 	uint64_t		 ss_watchdog_ts;	/* Last watchdog print ts (ms) */
 	void			*ss_last_unit;		/* Last executed unit */
@@ -52,6 +54,7 @@ struct sched_info {
 	d_list_t		 si_purge_list;	/* Stale sched_pool_info */
 	struct d_hash_table	*si_pool_hash;	/* All sched_pool_info */
 	struct d_binheap	 si_heap;	/* All retried RPC */
+	struct d_binheap	 si_edf_heap;	/* IO requests of EDF pools */
 	/* Total inuse request count */
 	uint32_t		 si_total_req_cnt;
 	/* Request count for each type of inuse request */
@@ -71,12 +74,19 @@ struct mem_stats {
 
 /* See dss_chore. */
 struct dss_chore_queue {
-	d_list_t   chq_list;
-	int32_t    chq_credits;
-	bool       chq_stop;
-	ABT_mutex  chq_mutex;
-	ABT_cond   chq_cond;
-	ABT_thread chq_ult;
+	d_list_t            chq_list;
+	int32_t             chq_credits;
+	/* Number of chores waiting in chq_list */
+	uint32_t            chq_depth;
+	bool                chq_stop;
+	/* The queue ULT is waiting for chores, see chore_steal_kick */
+	bool                chq_idle;
+	ABT_mutex           chq_mutex;
+	ABT_cond            chq_cond;
+	ABT_thread          chq_ult;
+	struct d_tm_node_t *chq_depth_gauge;	/* chq_depth */
+	struct d_tm_node_t *chq_steal_chores;	/* chores stolen from peers */
+	struct d_tm_node_t *chq_steal_ults;	/* offload ULTs redirected here */
 };
 
 /** Per-xstream configuration data */
@@ -165,9 +175,13 @@ extern unsigned int          dss_offload_per_numa_nr;
 extern unsigned int          dss_tgt_per_numa_nr;
 /** The maximum number of credits for each IO chore queue. That is per helper XS. */
 extern uint32_t              dss_chore_credits;
+/** Idle helper XS steal chores and offload ULTs from busy peers on the same NUMA node */
+extern bool                  dss_chore_steal;
 
 #define DSS_CHORE_CREDITS_MIN 1024
 #define DSS_CHORE_CREDITS_DEF 4096
+/** Minimum number of waiting chores before a chore queue is worth stealing from */
+#define DSS_CHORE_STEAL_MIN   2
 
 /** Shadow dss_get_module_info */
 struct dss_module_info *get_module_info(void);
@@ -246,7 +260,37 @@ extern unsigned int sched_relax_mode;
 extern unsigned int sched_unit_runtime_max;
 extern bool sched_watchdog_all;
 
+/*
+ * SCHED_POLICY_EDF deadline budgets as a fraction (right shift) of the RPC
+ * timeout: a small fetch is due long before a bulk update received at the same time.
+ */
+#define SCHED_EDF_LAT_SHIFT	4
+#define SCHED_EDF_BULK_SHIFT	1
+
+/** Deadline (msecs) of an IO request enqueued at \a now by SCHED_POLICY_EDF */
+static inline uint64_t
+sched_edf_deadline(uint64_t now, const struct sched_req_attr *attr)
+{
+	/* The client has already waited for one RPC timeout on a retried RPC */
+	if (attr->sra_flags & SCHED_REQ_FL_RESENT)
+		return now;
+	if (attr->sra_flags & SCHED_REQ_FL_LATENCY)
+		return now + (attr->sra_timeout >> SCHED_EDF_LAT_SHIFT);
+	return now + (attr->sra_timeout >> SCHED_EDF_BULK_SHIFT);
+}
+
+/** Does request \a a go before \b b in SCHED_POLICY_EDF, FIFO for the same deadline */
+static inline bool
+sched_edf_before(uint64_t deadline_a, uint64_t enqueue_id_a, uint64_t deadline_b,
+		 uint64_t enqueue_id_b)
+{
+	if (deadline_a != deadline_b)
+		return deadline_a < deadline_b;
+	return enqueue_id_a < enqueue_id_b;
+}
+
 void dss_sched_fini(struct dss_xstream *dx);
+void sched_policy_init(void);
 int dss_sched_init(struct dss_xstream *dx);
 int sched_req_enqueue(struct dss_xstream *dx, struct sched_req_attr *attr,
 		      void (*func)(void *), void *arg);
@@ -0,0 +1,427 @@
+/**
+ * (C) Copyright 2025 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+
+/*
+ * Unit tests for the engine scheduling helpers: chore queues of the helper
+ * xstreams (ult.c) and the SCHED_POLICY_EDF ordering (sched.c).
+ */
+#define D_LOGFAC DD_FAC(tests)
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <abt.h>
+#include <daos/common.h>
+#include <daos/tests_lib.h>
+#include "../srv_internal.h"
+
+/*
+ * The engine layout used by the tests: xstream 0 is the system xstream,
+ * xstream 1 is the main xstream of the only target and xstreams 2 and 3 are
+ * helpers. IOFW chores of target 0 are always queued on xstream 2.
+ */
+#define UT_XS_NR		4
+#define UT_XS_QUEUE		2
+#define UT_XS_THIEF		3
+#define UT_CHORE_NR		64
+#define UT_CHORE_CREDITS	4096
+#define UT_WAIT_SEC		10
+
+/*
+ * Mocks
+ */
+bool                  dss_forward_neighbor;
+bool                  dss_helper_pool = true;
+int                   dss_numa_nr     = 1;
+unsigned int          dss_offload_per_numa_nr;
+unsigned int          dss_sys_xs_nr         = 1;
+unsigned int          dss_tgt_nr            = 1;
+unsigned int          dss_tgt_offload_xs_nr = 2;
+unsigned int          dss_tgt_per_numa_nr   = 1;
+struct dss_module_key daos_srv_modkey       = {
+    .dmk_index = 0,
+};
+
+static struct dss_xstream                      ut_xs[UT_XS_NR];
+static __thread struct dss_module_info         ut_dmi;
+static __thread void                          *ut_tls_values[1];
+static __thread struct dss_thread_local_storage ut_tls;
+
+struct dss_module_key *
+daos_get_module_key(int index)
+{
+	assert_int_equal(index, 0);
+	return &daos_srv_modkey;
+}
+
+struct dss_thread_local_storage *
+dss_tls_get(void)
+{
+	ut_tls_values[0]  = &ut_dmi;
+	ut_tls.dtls_values = ut_tls_values;
+	return &ut_tls;
+}
+
+struct dss_xstream *
+dss_get_xstream(int stream_id)
+{
+	if (stream_id < 0 || stream_id >= UT_XS_NR)
+		return NULL;
+	return &ut_xs[stream_id];
+}
+
+int
+dss_xstream_cnt(void)
+{
+	return UT_XS_NR;
+}
+
+void
+sched_cond_wait_for_business(ABT_cond cond, ABT_mutex mutex)
+{
+	ABT_cond_wait(cond, mutex);
+}
+
+/*
+ * Helpers
+ */
+struct ut_chore {
+	struct dss_chore uc_chore;
+	/* xstream the chore ran on, -1 if it did not run yet */
+	int              uc_xs_id;
+};
+
+static struct ut_chore ut_chores[UT_CHORE_NR];
+static _Atomic int     ut_ran[UT_XS_NR];
+
+static enum dss_chore_status
+ut_chore_func(struct dss_chore *chore, bool is_reentrance)
+{
+	struct ut_chore *uc = container_of(chore, struct ut_chore, uc_chore);
+
+	uc->uc_xs_id = dss_get_module_info()->dmi_xs_id;
+	dss_chore_deregister(chore);
+	atomic_fetch_add_relaxed(&ut_ran[uc->uc_xs_id], 1);
+	return DSS_CHORE_DONE;
+}
+
+static void
+ut_set_xs_id(void *arg)
+{
+	dss_get_module_info()->dmi_xs_id = (int)(intptr_t)arg;
+}
+
+static int
+ut_ran_total(void)
+{
+	int nr = 0;
+	int i;
+
+	for (i = 0; i < UT_XS_NR; i++)
+		nr += atomic_load_relaxed(&ut_ran[i]);
+	return nr;
+}
+
+static uint32_t
+ut_queue_depth(int xs_id)
+{
+	struct dss_chore_queue *queue = &ut_xs[xs_id].dx_chore_queue;
+	uint32_t                depth;
+
+	ABT_mutex_lock(queue->chq_mutex);
+	depth = queue->chq_depth;
+	ABT_mutex_unlock(queue->chq_mutex);
+	return depth;
+}
+
+static int32_t
+ut_queue_credits(int xs_id)
+{
+	struct dss_chore_queue *queue = &ut_xs[xs_id].dx_chore_queue;
+	int32_t                 credits;
+
+	ABT_mutex_lock(queue->chq_mutex);
+	credits = queue->chq_credits;
+	ABT_mutex_unlock(queue->chq_mutex);
+	return credits;
+}
+
+/* Wait until the stolen chores are done and the thief has nothing left to take. */
+static bool
+ut_steal_settled(void)
+{
+	uint32_t depth = ut_queue_depth(UT_XS_QUEUE);
+
+	return depth < DSS_CHORE_STEAL_MIN &&
+	       atomic_load_relaxed(&ut_ran[UT_XS_THIEF]) + depth == UT_CHORE_NR;
+}
+
+static bool
+ut_all_done(void)
+{
+	return ut_ran_total() == UT_CHORE_NR;
+}
+
+static void
+ut_wait(bool (*cond)(void))
+{
+	uint64_t deadline = daos_gettime_coarse() + UT_WAIT_SEC;
+
+	while (!cond()) {
+		assert_true(daos_gettime_coarse() < deadline);
+		ABT_thread_yield();
+		usleep(1000);
+	}
+}
+
+static void
+ut_register_chores(void)
+{
+	int i;
+	int rc;
+
+	for (i = 0; i < UT_CHORE_NR; i++) {
+		ut_chores[i].uc_xs_id             = -1;
+		ut_chores[i].uc_chore.cho_func     = ut_chore_func;
+		ut_chores[i].uc_chore.cho_priority = 0;
+		ut_chores[i].uc_chore.cho_credits  = 1;
+		rc = dss_chore_register(&ut_chores[i].uc_chore);
+		assert_rc_equal(rc, 0);
+	}
+}
+
+static int
+sched_test_setup(void **state)
+{
+	ABT_thread ult;
+	ABT_pool  *pool;
+	int        i;
+	int        rc;
+
+	dss_chore_credits = UT_CHORE_CREDITS;
+	memset(ut_ran, 0, sizeof(ut_ran));
+	memset(ut_xs, 0, sizeof(ut_xs));
+
+	for (i = 0; i < UT_XS_NR; i++)
+		ut_xs[i].dx_xs_id = i;
+	ut_xs[1].dx_main_xs = true;
+	ut_xs[1].dx_tgt_id  = 0;
+
+	for (i = UT_XS_QUEUE; i <= UT_XS_THIEF; i++) {
+		ut_xs[i].dx_iofw   = true;
+		ut_xs[i].dx_tgt_id = -1;
+
+		pool = &ut_xs[i].dx_pools[DSS_POOL_GENERIC];
+		rc = ABT_pool_create_basic(ABT_POOL_FIFO, ABT_POOL_ACCESS_MPSC, ABT_TRUE, pool);
+		assert_int_equal(rc, ABT_SUCCESS);
+		rc = ABT_xstream_create_basic(ABT_SCHED_BASIC, 1, pool, ABT_SCHED_CONFIG_NULL,
+					      &ut_xs[i].dx_xstream);
+		assert_int_equal(rc, ABT_SUCCESS);
+
+		rc = ABT_thread_create(*pool, ut_set_xs_id, (void *)(intptr_t)i,
+				       ABT_THREAD_ATTR_NULL, &ult);
+		assert_int_equal(rc, ABT_SUCCESS);
+		ABT_thread_free(&ult);
+
+		rc = dss_chore_queue_init(&ut_xs[i]);
+		assert_rc_equal(rc, 0);
+	}
+
+	return 0;
+}
+
+static int
+sched_test_teardown(void **state)
+{
+	int i;
+
+	for (i = UT_XS_QUEUE; i <= UT_XS_THIEF; i++) {
+		dss_chore_queue_stop(&ut_xs[i]);
+		dss_chore_queue_fini(&ut_xs[i]);
+		ABT_xstream_join(ut_xs[i].dx_xstream);
+		ABT_xstream_free(&ut_xs[i].dx_xstream);
+	}
+
+	return 0;
+}
+
+/*
+ * Tests
+ */
+static void
+test_chore_no_steal(void **state)
+{
+	int rc;
+
+	dss_chore_steal = false;
+
+	rc = dss_chore_queue_start(&ut_xs[UT_XS_QUEUE]);
+	assert_rc_equal(rc, 0);
+	rc = dss_chore_queue_start(&ut_xs[UT_XS_THIEF]);
+	assert_rc_equal(rc, 0);
+
+	ut_register_chores();
+	ut_wait(ut_all_done);
+
+	assert_int_equal(atomic_load_relaxed(&ut_ran[UT_XS_QUEUE]), UT_CHORE_NR);
+	assert_int_equal(atomic_load_relaxed(&ut_ran[UT_XS_THIEF]), 0);
+	assert_int_equal(ut_queue_credits(UT_XS_QUEUE), UT_CHORE_CREDITS);
+}
+
+static void
+test_chore_steal(void **state)
+{
+	int i;
+	int rc;
+
+	dss_chore_steal = true;
+
+	/* The owner of the queue is "busy": its queue ULT is not running yet. */
+	rc = dss_chore_queue_start(&ut_xs[UT_XS_THIEF]);
+	assert_rc_equal(rc, 0);
+
+	ut_register_chores();
+
+	/* The idle helper is kicked by the registrations and keeps taking half the backlog. */
+	ut_wait(ut_steal_settled);
+	assert_true(atomic_load_relaxed(&ut_ran[UT_XS_THIEF]) >= UT_CHORE_NR / 2);
+	assert_int_equal(atomic_load_relaxed(&ut_ran[UT_XS_QUEUE]), 0);
+
+	/* Stolen chores returned their credits to the queue that was charged. */
+	assert_int_equal(ut_queue_credits(UT_XS_QUEUE),
+			 UT_CHORE_CREDITS - (int32_t)ut_queue_depth(UT_XS_QUEUE));
+	assert_int_equal(ut_queue_credits(UT_XS_THIEF), UT_CHORE_CREDITS);
+
+	/* The owner runs whatever was left to it. */
+	rc = dss_chore_queue_start(&ut_xs[UT_XS_QUEUE]);
+	assert_rc_equal(rc, 0);
+	ut_wait(ut_all_done);
+
+	for (i = 0; i < UT_CHORE_NR; i++)
+		assert_true(ut_chores[i].uc_xs_id == UT_XS_QUEUE ||
+			    ut_chores[i].uc_xs_id == UT_XS_THIEF);
+	assert_int_equal(ut_queue_depth(UT_XS_QUEUE), 0);
+	assert_int_equal(ut_queue_credits(UT_XS_QUEUE), UT_CHORE_CREDITS);
+}
+
+struct ut_edf_req {
+	struct d_binheap_node uer_node;
+	struct sched_req_attr uer_attr;
+	uint64_t              uer_deadline;
+};
+
+static bool
+ut_edf_cmp(struct d_binheap_node *a, struct d_binheap_node *b)
+{
+	struct ut_edf_req *ra = container_of(a, struct ut_edf_req, uer_node);
+	struct ut_edf_req *rb = container_of(b, struct ut_edf_req, uer_node);
+
+	return sched_edf_before(ra->uer_deadline, ra->uer_attr.sra_enqueue_id, rb->uer_deadline,
+				rb->uer_attr.sra_enqueue_id);
+}
+
+static struct d_binheap_ops ut_edf_ops = {
+    .hop_compare = ut_edf_cmp,
+};
+
+static void
+test_edf_deadline(void **state)
+{
+	struct sched_req_attr attr = {0};
+
+	attr.sra_timeout = 60000;
+
+	attr.sra_flags = 0;
+	assert_int_equal(sched_edf_deadline(1000, &attr), 1000 + 60000 / 2);
+	attr.sra_flags = SCHED_REQ_FL_LATENCY;
+	assert_int_equal(sched_edf_deadline(1000, &attr), 1000 + 60000 / 16);
+	attr.sra_flags = SCHED_REQ_FL_RESENT;
+	assert_int_equal(sched_edf_deadline(1000, &attr), 1000);
+	attr.sra_flags = SCHED_REQ_FL_RESENT | SCHED_REQ_FL_LATENCY;
+	assert_int_equal(sched_edf_deadline(1000, &attr), 1000);
+}
+
+static void
+test_edf_order(void **state)
+{
+	/* Enqueue time (msecs) and flags of each request, in enqueue order */
+	struct {
+		uint64_t now;
+		uint32_t flags;
+	} reqs[] = {
+	    {0, 0},                         /* bulk update, due at 30000 */
+	    {10, SCHED_REQ_FL_LATENCY},     /* small fetch, due at 3760 */
+	    {20, 0},                        /* bulk fetch, due at 30020 */
+	    {26250, SCHED_REQ_FL_LATENCY},  /* due at 30000, after the first one */
+	    {27000, SCHED_REQ_FL_LATENCY},  /* a late fetch does not pass an old update */
+	    {27500, SCHED_REQ_FL_RESENT},   /* resent, due now */
+	};
+	int                    expected[] = {1, 5, 0, 3, 2, 4};
+	struct ut_edf_req      edf_reqs[ARRAY_SIZE(reqs)];
+	struct d_binheap       heap;
+	struct d_binheap_node *node;
+	struct ut_edf_req     *req;
+	int                    i;
+	int                    rc;
+
+	rc = d_binheap_create_inplace(DBH_FT_NOLOCK, 0, NULL, &ut_edf_ops, &heap);
+	assert_rc_equal(rc, 0);
+
+	for (i = 0; i < ARRAY_SIZE(reqs); i++) {
+		req                          = &edf_reqs[i];
+		req->uer_attr.sra_type       = SCHED_REQ_FETCH;
+		req->uer_attr.sra_flags      = reqs[i].flags;
+		req->uer_attr.sra_timeout    = 60000;
+		req->uer_attr.sra_enqueue_id = i;
+		req->uer_deadline            = sched_edf_deadline(reqs[i].now, &req->uer_attr);
+		rc                           = d_binheap_insert(&heap, &req->uer_node);
+		assert_rc_equal(rc, 0);
+	}
+
+	for (i = 0; i < ARRAY_SIZE(expected); i++) {
+		node = d_binheap_root(&heap);
+		assert_non_null(node);
+		req = container_of(node, struct ut_edf_req, uer_node);
+		assert_int_equal(req - edf_reqs, expected[i]);
+		d_binheap_remove(&heap, node);
+	}
+	assert_true(d_binheap_is_empty(&heap));
+
+	d_binheap_destroy_inplace(&heap);
+}
+
+#define SCHED_UTEST(x) cmocka_unit_test_setup_teardown(x, sched_test_setup, sched_test_teardown)
+
+int
+main(void)
+{
+	const struct CMUnitTest tests[] = {
+	    SCHED_UTEST(test_chore_no_steal),
+	    SCHED_UTEST(test_chore_steal),
+	    cmocka_unit_test(test_edf_deadline),
+	    cmocka_unit_test(test_edf_order),
+	};
+	int rc;
+
+	rc = daos_debug_init(DAOS_LOG_DEFAULT);
+	if (rc != 0)
+		return rc;
+
+	rc = ABT_init(0, NULL);
+	if (rc != ABT_SUCCESS) {
+		daos_debug_fini();
+		return -1;
+	}
+
+	rc = cmocka_run_group_tests_name("engine_sched", tests, NULL, NULL);
+
+	ABT_finalize();
+	daos_debug_fini();
+	return rc;
+}
+
+#undef SCHED_UTEST
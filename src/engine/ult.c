@@ -10,6 +10,8 @@
 #include <abt.h>
 #include <daos/common.h>
 #include <daos_errno.h>
+#include <gurt/telemetry_common.h>
+#include <gurt/telemetry_producer.h>
 #include "srv_internal.h"
 
 /* ============== Thread collective functions ============================ */
@@ -17,6 +19,9 @@
 /** The maximum number of credits for each IO chore queue. That is per helper XS. */
 uint32_t dss_chore_credits;
 
+/** Idle helper XS steal chores and offload ULTs from busy peers on the same NUMA node. */
+bool dss_chore_steal;
+
 struct aggregator_arg_type {
 	struct dss_stream_arg_type	at_args;
 	void				(*at_reduce)(void *a_args,
@@ -490,6 +495,69 @@ sched_ult2xs(int xs_type, int tgt_id)
 	return xs_id;
 }
 
+/*
+ * Get the range [*start, *start + *nr) of the helper xstreams on the same NUMA
+ * node as helper xstream \a xs_id. Only valid with dss_helper_pool, see
+ * sched_ult2xs_multisocket for the layout.
+ */
+static void
+helper_xs_range(int xs_id, int *start, int *nr)
+{
+	int base = dss_sys_xs_nr + dss_tgt_nr;
+
+	D_ASSERT(xs_id >= base && xs_id < DSS_XS_NR_TOTAL);
+	if (dss_numa_nr > 1 && dss_offload_per_numa_nr > 0) {
+		*start = base + (xs_id - base) / dss_offload_per_numa_nr * dss_offload_per_numa_nr;
+		*nr    = min(dss_offload_per_numa_nr, DSS_XS_NR_TOTAL - *start);
+	} else {
+		*start = base;
+		*nr    = dss_tgt_offload_xs_nr;
+	}
+}
+
+static inline bool
+xs_is_helper(struct dss_xstream *dx)
+{
+	return dx != NULL && dx->dx_iofw && !dx->dx_main_xs;
+}
+
+/*
+ * A ULT can't leave the ABT pool of the xstream it was created on, so instead
+ * of stealing offload ULTs after the fact, balance them when they are created:
+ * take the less loaded of \a xs_id and a random helper peer on the same NUMA node.
+ */
+static int
+sched_ult2xs_steal(int xs_id)
+{
+	struct dss_xstream *dx;
+	struct dss_xstream *peer;
+	size_t              size;
+	size_t              peer_size;
+	int                 start;
+	int                 nr;
+	int                 peer_id;
+
+	dx = dss_get_xstream(xs_id);
+	if (!xs_is_helper(dx))
+		return xs_id;
+
+	helper_xs_range(xs_id, &start, &nr);
+	if (nr < 2)
+		return xs_id;
+	peer_id = start + rand() % nr;
+	peer    = dss_get_xstream(peer_id);
+	if (peer_id == xs_id || !xs_is_helper(peer))
+		return xs_id;
+
+	if (ABT_pool_get_size(dx->dx_pools[DSS_POOL_GENERIC], &size) != ABT_SUCCESS ||
+	    ABT_pool_get_size(peer->dx_pools[DSS_POOL_GENERIC], &peer_size) != ABT_SUCCESS ||
+	    peer_size >= size)
+		return xs_id;
+
+	d_tm_inc_counter(peer->dx_chore_queue.chq_steal_ults, 1);
+	return peer_id;
+}
+
 static int
 ult_create_internal(void (*func)(void *), void *arg, int xs_type, int tgt_idx,
 		    size_t stack_size, ABT_thread *ult, unsigned int flags)
@@ -502,6 +570,9 @@ ult_create_internal(void (*func)(void *), void *arg, int xs_type, int tgt_idx,
 	stream_id = sched_ult2xs(xs_type, tgt_idx);
 	if (stream_id == -DER_INVAL)
 		return stream_id;
+	if (dss_chore_steal && stream_id != DSS_XS_SELF &&
+	    (xs_type == DSS_XS_IOFW || xs_type == DSS_XS_OFFLOAD))
+		stream_id = sched_ult2xs_steal(stream_id);
 
 	dx = dss_get_xstream(stream_id);
 	if (dx == NULL)
@@ -716,6 +787,105 @@ dss_chore_ult(void *arg)
 	dss_chore_diy_internal(chore);
 }
 
+/* Caller holds queue->chq_mutex. */
+static inline void
+chore_queue_depth_set(struct dss_chore_queue *queue, uint32_t depth)
+{
+	queue->chq_depth = depth;
+	d_tm_set_gauge(queue->chq_depth_gauge, depth);
+}
+
+/*
+ * \a queue of helper xstream \a xs_id has a backlog; wake up an idle helper
+ * on the same NUMA node, which will then steal some chores via chore_steal.
+ */
+static void
+chore_steal_kick(int xs_id)
+{
+	static __thread uint32_t next;
+	struct dss_xstream      *dx;
+	struct dss_chore_queue  *peer;
+	bool                     woken = false;
+	int                      start;
+	int                      nr;
+	int                      i;
+
+	helper_xs_range(xs_id, &start, &nr);
+	for (i = 0; i < nr && !woken; i++) {
+		int peer_id = start + (next + i) % nr;
+
+		dx = dss_get_xstream(peer_id);
+		if (peer_id == xs_id || !xs_is_helper(dx))
+			continue;
+		peer = &dx->dx_chore_queue;
+		/* Unlocked peek to avoid taking the mutex of every busy peer. */
+		if (!peer->chq_idle)
+			continue;
+
+		ABT_mutex_lock(peer->chq_mutex);
+		if (peer->chq_idle && !peer->chq_stop) {
+			ABT_cond_broadcast(peer->chq_cond);
+			woken = true;
+			next  = peer_id - start + 1;
+		}
+		ABT_mutex_unlock(peer->chq_mutex);
+	}
+}
+
+/*
+ * Move up to half of the waiting chores of a busy peer of helper xstream
+ * \a xs_id to \a list. The chores keep their cho_hint, so that
+ * dss_chore_deregister returns the credits to the queue they were charged to.
+ * The caller must not hold any chore queue mutex.
+ *
+ * \return	number of chores stolen
+ */
+static int
+chore_steal(int xs_id, struct dss_chore_queue *queue, d_list_t *list)
+{
+	static __thread uint32_t victim;
+	struct dss_xstream      *dx;
+	struct dss_chore_queue  *peer;
+	struct dss_chore        *chore;
+	uint32_t                 n = 0;
+	int                      start;
+	int                      nr;
+	int                      i;
+
+	helper_xs_range(xs_id, &start, &nr);
+	for (i = 0; i < nr && n == 0; i++) {
+		int peer_id = start + (victim + i) % nr;
+
+		dx = dss_get_xstream(peer_id);
+		if (peer_id == xs_id || !xs_is_helper(dx))
+			continue;
+		peer = &dx->dx_chore_queue;
+		if (peer->chq_depth < DSS_CHORE_STEAL_MIN)
+			continue;
+		/* Never wait for a busy peer; try the next one instead. */
+		if (ABT_mutex_trylock(peer->chq_mutex) != ABT_SUCCESS)
+			continue;
+
+		if (!peer->chq_stop && peer->chq_depth >= DSS_CHORE_STEAL_MIN) {
+			/* Take the oldest ones, as the owner is busy with an earlier batch. */
+			for (n = 0; n < peer->chq_depth / 2; n++) {
+				chore = d_list_entry(peer->chq_list.next, struct dss_chore, cho_link);
+				D_ASSERT(chore->cho_status == DSS_CHORE_NEW);
+				d_list_move_tail(&chore->cho_link, list);
+			}
+			chore_queue_depth_set(peer, peer->chq_depth - n);
+			victim = peer_id - start + 1;
+		}
+		ABT_mutex_unlock(peer->chq_mutex);
+	}
+
+	if (n > 0) {
+		d_tm_inc_counter(queue->chq_steal_chores, n);
+		D_DEBUG(DB_TRACE, "xs %d stole %u chores\n", xs_id, n);
+	}
+	return n;
+}
+
 /**
  * Add \a chore for \a func to the chore queue of some other xstream.
  *
@@ -730,6 +900,7 @@ dss_chore_register(struct dss_chore *chore)
 	int                     xs_id;
 	struct dss_xstream     *dx;
 	struct dss_chore_queue *queue;
+	uint32_t                depth;
 
 	D_ASSERT(chore->cho_credits > 0);
 
@@ -774,11 +945,16 @@ dss_chore_register(struct dss_chore *chore)
 	queue->chq_credits -= chore->cho_credits;
 	chore->cho_hint = queue;
 	d_list_add_tail(&chore->cho_link, &queue->chq_list);
+	chore_queue_depth_set(queue, queue->chq_depth + 1);
+	depth = queue->chq_depth;
 	ABT_cond_broadcast(queue->chq_cond);
 	ABT_mutex_unlock(queue->chq_mutex);
 
 	D_DEBUG(DB_TRACE, "register chore %p on queue %p: tgt=%d -> xs=%d dx.tgt=%d, credits %u\n",
 		chore, queue, info->dmi_tgt_id, xs_id, dx->dx_tgt_id, chore->cho_credits);
+
+	if (dss_chore_steal && depth >= DSS_CHORE_STEAL_MIN)
+		chore_steal_kick(xs_id);
 	return 0;
 }
 
@@ -819,6 +995,7 @@ dss_chore_queue_ult(void *arg)
 {
 	struct dss_chore_queue *queue = arg;
 	d_list_t                list  = D_LIST_HEAD_INIT(list);
+	int                     xs_id = dss_get_module_info()->dmi_xs_id;
 
 	D_ASSERT(queue != NULL);
 	D_DEBUG(DB_TRACE, "begin\n");
@@ -827,7 +1004,8 @@ dss_chore_queue_ult(void *arg)
 		d_list_t          list_tmp = D_LIST_HEAD_INIT(list_tmp);
 		struct dss_chore *chore;
 		struct dss_chore *chore_tmp;
-		bool              stop = false;
+		bool              stop        = false;
+		bool              steal_tried = false;
 
 		/*
 		 * The scheduling order shall be
@@ -841,6 +1019,7 @@ dss_chore_queue_ult(void *arg)
 		for (;;) {
 			if (!d_list_empty(&queue->chq_list)) {
 				d_list_splice_init(&queue->chq_list, &list);
+				chore_queue_depth_set(queue, 0);
 				break;
 			}
 			if (!d_list_empty(&list))
@@ -849,7 +1028,18 @@ dss_chore_queue_ult(void *arg)
 				stop = true;
 				break;
 			}
+			if (dss_chore_steal && !steal_tried) {
+				/* Never hold two chore queue mutexes at the same time. */
+				ABT_mutex_unlock(queue->chq_mutex);
+				chore_steal(xs_id, queue, &list);
+				ABT_mutex_lock(queue->chq_mutex);
+				steal_tried = true;
+				continue;
+			}
+			queue->chq_idle = true;
 			sched_cond_wait_for_business(queue->chq_cond, queue->chq_mutex);
+			queue->chq_idle = false;
+			steal_tried     = false;
 		}
 		ABT_mutex_unlock(queue->chq_mutex);
 
@@ -889,9 +1079,36 @@ dss_chore_queue_init(struct dss_xstream *dx)
 	int                     rc;
 
 	D_INIT_LIST_HEAD(&queue->chq_list);
-	queue->chq_stop = false;
+	queue->chq_stop    = false;
+	queue->chq_idle    = false;
+	queue->chq_depth   = 0;
 	queue->chq_credits = dss_chore_credits;
 
+	if (xs_is_helper(dx)) {
+		rc = d_tm_add_metric(&queue->chq_depth_gauge, D_TM_GAUGE,
+				     "Chores waiting in the queue", "chore",
+				     "sched/chore_queue/xs_%u", dx->dx_xs_id);
+		if (rc)
+			D_WARN("Failed to create chore_queue telemetry: "DF_RC"\n", DP_RC(rc));
+
+		if (dss_chore_steal) {
+			rc = d_tm_add_metric(&queue->chq_steal_chores, D_TM_COUNTER,
+					     "Chores stolen from busy peers", "chore",
+					     "sched/steal_chores/xs_%u", dx->dx_xs_id);
+			if (rc)
+				D_WARN("Failed to create steal_chores telemetry: "DF_RC"\n",
+				       DP_RC(rc));
+
+			/* Incremented by the creating xstreams */
+			rc = d_tm_add_metric(&queue->chq_steal_ults, D_TM_COUNTER | D_TM_SHARDED,
+					     "Offload ULTs taken over from busy peers", "ULT",
+					     "sched/steal_ults/xs_%u", dx->dx_xs_id);
+			if (rc)
+				D_WARN("Failed to create steal_ults telemetry: "DF_RC"\n",
+				       DP_RC(rc));
+		}
+	}
+
 	rc = ABT_mutex_create(&queue->chq_mutex);
 	if (rc != ABT_SUCCESS) {
 		D_ERROR("failed to create chore queue mutex: %d\n", rc);
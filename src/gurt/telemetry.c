@@ -87,6 +87,11 @@ static struct d_tm_mem {
 	int			 id; /** Instance ID */
 } tm_mem;
 
+/** Next slot handed to a writer thread that was not given one by d_tm_set_shard() */
+static _Atomic uint32_t tm_shard_next;
+/** Slot this thread writes into for sharded counters, -1 until first use */
+static __thread int     tm_shard = -1;
+
 /* Internal helper functions */
 static int
 allocate_memory_segment(int srv_idx, size_t mem_size, bool shared, struct d_tm_mem_hdr **mem_hdr);
@@ -1356,6 +1361,32 @@ d_tm_print_gauge(uint64_t val, struct d_tm_stats_t *stats, char *name,
 		d_tm_print_stats(stream, stats, format);
 }
 
+/**
+ * Prints the tail percentiles of the log-linear histogram \a hdr to the
+ * \a stream provided.  Nothing is printed in CSV format, so that the CSV
+ * columns stay the same whether or not a metric has such a histogram.
+ *
+ * \param[in]	hdr		Histogram snapshot
+ * \param[in]	format		Output format.
+ *				Choose D_TM_STANDARD for standard output.
+ *				Choose D_TM_CSV for comma separated values.
+ * \param[in]	stream		Output stream (stdout, stderr)
+ */
+void
+d_tm_print_hdr(struct d_tm_hdr_t *hdr, int format, FILE *stream)
+{
+	if (hdr == NULL || stream == NULL || format == D_TM_CSV)
+		return;
+
+	if (d_tm_hdr_count(hdr) == 0)
+		return;
+
+	fprintf(stream, " [p50: %lu, p90: %lu, p99: %lu, p99.9: %lu, p99.99: %lu]",
+		d_tm_hdr_percentile(hdr, 50), d_tm_hdr_percentile(hdr, 90),
+		d_tm_hdr_percentile(hdr, 99), d_tm_hdr_percentile(hdr, 99.9),
+		d_tm_hdr_percentile(hdr, 99.99));
+}
+
 /**
  * Client function to print the metadata strings \a desc and \a units
  * to the \a stream provided
@@ -1390,6 +1421,22 @@ d_tm_print_metadata(char *desc, char *units, int format, FILE *stream)
 static int
 d_tm_get_meminfo(struct d_tm_context *ctx, struct d_tm_meminfo_t *meminfo,
 		 struct d_tm_node_t *node);
+
+static void
+print_node_hdr(struct d_tm_context *ctx, struct d_tm_node_t *node, int format, FILE *stream)
+{
+	struct d_tm_hdr_t	*hdr = NULL;
+
+	if (format == D_TM_CSV)
+		return;
+
+	if (d_tm_get_hdr_histogram(ctx, &hdr, node) != DER_SUCCESS)
+		return;
+
+	d_tm_print_hdr(hdr, format, stream);
+	D_FREE(hdr);
+}
+
 /**
  * Prints a single \a node.
  * Used as a convenience function to demonstrate usage for the client
@@ -1525,6 +1572,7 @@ d_tm_print_node(struct d_tm_context *ctx, struct d_tm_node_t *node, int level,
 				    opt_fields, stream);
 		if (stats.sample_size > 0)
 			stats_printed = true;
+		print_node_hdr(ctx, node, format, stream);
 		break;
 	case D_TM_GAUGE:
 	case D_TM_STATS_GAUGE:
@@ -1537,6 +1585,7 @@ d_tm_print_node(struct d_tm_context *ctx, struct d_tm_node_t *node, int level,
 				 stream);
 		if (stats.sample_size > 0)
 			stats_printed = true;
+		print_node_hdr(ctx, node, format, stream);
 		break;
 	default:
 		fprintf(stream, "Item: %s has unknown type: 0x%x\n", name,
@@ -1633,6 +1682,8 @@ _reset_node(struct d_tm_context *ctx, struct d_tm_node_t *node)
 	struct d_tm_metric_t	*metric_data = NULL;
 	struct d_tm_stats_t	*dtm_stats = NULL;
 	struct d_tm_histogram_t *dtm_histogram = NULL;
+	struct d_tm_shard_t     *dtm_shards    = NULL;
+	struct d_tm_hdr_t       *dtm_hdr       = NULL;
 	struct d_tm_mem_hdr     *mem_hdr       = NULL;
 	int			 rc;
 
@@ -1649,8 +1700,22 @@ _reset_node(struct d_tm_context *ctx, struct d_tm_node_t *node)
 
 	dtm_stats     = conv_ptr(mem_hdr, metric_data->dtm_stats);
 	dtm_histogram = conv_ptr(mem_hdr, metric_data->dtm_histogram);
+	dtm_shards    = conv_ptr(mem_hdr, metric_data->dtm_shards);
+	dtm_hdr       = conv_ptr(mem_hdr, metric_data->dtm_hdr);
 	d_tm_node_lock(node);
 	memset(&metric_data->dtm_data, 0, sizeof(metric_data->dtm_data));
+	if (dtm_shards != NULL) {
+		int i;
+
+		for (i = 0; i < D_TM_SHARD_NR; i++)
+			atomic_store_relaxed(&dtm_shards[i].dts_value, 0);
+	}
+	if (dtm_hdr != NULL) {
+		int i;
+
+		for (i = 0; i < dtm_hdr->dth_nr; i++)
+			__atomic_store_n(&dtm_hdr->dth_counts[i], 0, __ATOMIC_RELAXED);
+	}
 	if (dtm_stats != NULL)
 		memset(dtm_stats, 0, sizeof(*dtm_stats));
 
@@ -1941,7 +2006,100 @@ d_tm_compute_histogram(struct d_tm_node_t *node, uint64_t value)
 		D_ERROR("Unable to find bucket for value %lu\n", value);
 		return;
 	}
-	d_tm_inc_counter(bucket, 1);
+
+	/**
+	 * The caller already holds the parent node lock (if any), and buckets
+	 * are only ever incremented from here, so a relaxed atomic add is
+	 * enough; no need to take the bucket lock as well.
+	 */
+	__atomic_fetch_add(&bucket->dtn_metric->dtm_data.value, 1, __ATOMIC_RELAXED);
+}
+
+/** Index of the log-linear bucket that \a value falls into */
+static inline int
+hdr_index(int sub_bits, uint64_t value)
+{
+	int	exp;
+
+	if (value < (1ULL << sub_bits))
+		return value;
+
+	exp = 63 - __builtin_clzll(value);
+	if (exp >= D_TM_HDR_MAX_BITS)
+		return D_TM_HDR_NR(sub_bits) - 1;
+
+	return ((exp - sub_bits + 1) << sub_bits) +
+	       (int)((value >> (exp - sub_bits)) - (1ULL << sub_bits));
+}
+
+/** Largest value that maps to log-linear bucket \a idx */
+static inline uint64_t
+hdr_upper(int sub_bits, int idx)
+{
+	int		group = idx >> sub_bits;
+	uint64_t	sub   = idx & ((1 << sub_bits) - 1);
+
+	if (group == 0)
+		return sub;
+
+	return (((1ULL << sub_bits) + sub + 1) << (group - 1)) - 1;
+}
+
+/**
+ * Records \a value in the log-linear histogram of this metric, if it has one.
+ * This is lock-free and may be called outside of the node lock.
+ *
+ * \param[in]	node		Pointer to a duration or gauge node
+ * \param[in]	value		The value to record
+ */
+void
+d_tm_compute_hdr(struct d_tm_node_t *node, uint64_t value)
+{
+	struct d_tm_hdr_t	*hdr;
+
+	if (!node || !node->dtn_metric || !node->dtn_metric->dtm_hdr)
+		return;
+
+	hdr = node->dtn_metric->dtm_hdr;
+	__atomic_fetch_add(&hdr->dth_counts[hdr_index(hdr->dth_sub_bits, value)], 1,
+			   __ATOMIC_RELAXED);
+}
+
+/**
+ * Select the slot that the calling thread writes into for sharded counters.
+ * Threads that never call it are assigned a slot round-robin on their first
+ * sharded update.
+ *
+ * \param[in]	shard	Slot index, taken modulo D_TM_SHARD_NR
+ */
+void
+d_tm_set_shard(int shard)
+{
+	if (shard < 0)
+		return;
+
+	tm_shard = shard % D_TM_SHARD_NR;
+}
+
+static inline int
+get_shard(void)
+{
+	if (unlikely(tm_shard < 0))
+		tm_shard = atomic_fetch_add_relaxed(&tm_shard_next, 1) % D_TM_SHARD_NR;
+
+	return tm_shard;
+}
+
+static uint64_t
+fold_shards(struct d_tm_shard_t *shards)
+{
+	uint64_t	val = 0;
+	int		i;
+
+	for (i = 0; i < D_TM_SHARD_NR; i++)
+		val += atomic_load_relaxed(&shards[i].dts_value);
+
+	return val;
 }
 
 /**
@@ -1962,6 +2120,17 @@ d_tm_set_counter(struct d_tm_node_t *metric, uint64_t value)
 		return;
 	}
 
+	if (metric->dtn_metric->dtm_shards != NULL) {
+		struct d_tm_shard_t	*shards = metric->dtn_metric->dtm_shards;
+		int			 i;
+
+		/** not atomic with respect to concurrent increments */
+		for (i = 1; i < D_TM_SHARD_NR; i++)
+			atomic_store_relaxed(&shards[i].dts_value, 0);
+		atomic_store_relaxed(&shards[0].dts_value, value);
+		return;
+	}
+
 	d_tm_node_lock(metric);
 	metric->dtn_metric->dtm_data.value = value;
 	d_tm_node_unlock(metric);
@@ -1985,6 +2154,12 @@ d_tm_inc_counter(struct d_tm_node_t *metric, uint64_t value)
 		return;
 	}
 
+	if (metric->dtn_metric->dtm_shards != NULL) {
+		atomic_fetch_add_relaxed(&metric->dtn_metric->dtm_shards[get_shard()].dts_value,
+					 value);
+		return;
+	}
+
 	d_tm_node_lock(metric);
 	metric->dtn_metric->dtm_data.value += value;
 	d_tm_node_unlock(metric);
@@ -2134,6 +2309,7 @@ d_tm_mark_duration_end(struct d_tm_node_t *metric)
 	d_tm_compute_stats(metric, us);
 	d_tm_compute_histogram(metric, us);
 	d_tm_node_unlock(metric);
+	d_tm_compute_hdr(metric, us);
 }
 
 static bool
@@ -2182,6 +2358,7 @@ d_tm_set_gauge(struct d_tm_node_t *metric, uint64_t value)
 		d_tm_compute_histogram(metric, value);
 	}
 	d_tm_node_unlock(metric);
+	d_tm_compute_hdr(metric, value);
 }
 
 /**
@@ -2193,6 +2370,8 @@ d_tm_set_gauge(struct d_tm_node_t *metric, uint64_t value)
 void
 d_tm_inc_gauge(struct d_tm_node_t *metric, uint64_t value)
 {
+	uint64_t	cur;
+
 	if (metric == NULL)
 		return;
 
@@ -2205,11 +2384,13 @@ d_tm_inc_gauge(struct d_tm_node_t *metric, uint64_t value)
 
 	d_tm_node_lock(metric);
 	metric->dtn_metric->dtm_data.value += value;
+	cur = metric->dtn_metric->dtm_data.value;
 	if (has_stats(metric)) {
-		d_tm_compute_stats(metric, metric->dtn_metric->dtm_data.value);
+		d_tm_compute_stats(metric, cur);
 		d_tm_compute_histogram(metric, value);
 	}
 	d_tm_node_unlock(metric);
+	d_tm_compute_hdr(metric, cur);
 }
 
 /**
@@ -2221,6 +2402,8 @@ d_tm_inc_gauge(struct d_tm_node_t *metric, uint64_t value)
 void
 d_tm_dec_gauge(struct d_tm_node_t *metric, uint64_t value)
 {
+	uint64_t	cur;
+
 	if (metric == NULL)
 		return;
 
@@ -2233,11 +2416,13 @@ d_tm_dec_gauge(struct d_tm_node_t *metric, uint64_t value)
 
 	d_tm_node_lock(metric);
 	metric->dtn_metric->dtm_data.value -= value;
+	cur = metric->dtn_metric->dtm_data.value;
 	if (has_stats(metric)) {
-		d_tm_compute_stats(metric, metric->dtn_metric->dtm_data.value);
+		d_tm_compute_stats(metric, cur);
 		d_tm_compute_histogram(metric, value);
 	}
 	d_tm_node_unlock(metric);
+	d_tm_compute_hdr(metric, cur);
 }
 
 /**
@@ -2368,9 +2553,18 @@ add_metric(struct d_tm_context *ctx, struct d_tm_node_t **node, int metric_type,
 	char			*token;
 	char			*rest;
 	char			*unit_string;
+	bool			 sharded;
 	int			buff_len;
 	int			rc = 0;
 
+	sharded = metric_type & D_TM_SHARDED;
+	metric_type &= ~D_TM_SHARDED;
+	if (sharded && metric_type != D_TM_COUNTER) {
+		D_ERROR("D_TM_SHARDED is only supported for counters\n");
+		rc = -DER_INVAL;
+		goto out;
+	}
+
 	rest = path;
 	parent_node = d_tm_get_root(ctx);
 	token = strtok_r(rest, "/", &rest);
@@ -2405,8 +2599,21 @@ add_metric(struct d_tm_context *ctx, struct d_tm_node_t **node, int metric_type,
 		}
 	}
 
-	metric            = conv_ptr(mem_hdr, temp->dtn_metric);
-	metric->dtm_stats = NULL;
+	metric             = conv_ptr(mem_hdr, temp->dtn_metric);
+	metric->dtm_stats  = NULL;
+	metric->dtm_shards = NULL;
+	if (sharded) {
+		void *shards;
+
+		/** over-allocate so that the slots can start on a cache line */
+		shards = tm_alloc(mem_hdr, D_TM_SHARD_NR * sizeof(struct d_tm_shard_t) +
+					       D_TM_SHARD_ALIGN);
+		if (shards == NULL) {
+			rc = -DER_NO_SHMEM;
+			goto out;
+		}
+		metric->dtm_shards = (void *)D_ALIGNUP((uintptr_t)shards, D_TM_SHARD_ALIGN);
+	}
 	if (has_stats(temp)) {
 		metric->dtm_stats = tm_alloc(mem_hdr, sizeof(struct d_tm_stats_t));
 		if (metric->dtm_stats == NULL) {
@@ -2521,7 +2728,10 @@ out:
  * critical time.
  *
  * \param[out]	node		Points to the new metric if supplied
- * \param[in]	metric_type	One of the corresponding d_tm_metric_types
+ * \param[in]	metric_type	One of the corresponding d_tm_metric_types.
+ *				D_TM_COUNTER may be combined with
+ *				D_TM_SHARDED for counters that are updated
+ *				concurrently by many threads.
  * \param[in]	desc		A description of the metric containing
  *				D_TM_MAX_DESC_LEN - 1 characters maximum
  * \param[in]	units		A string defining the units of the metric
@@ -3361,6 +3571,71 @@ failure:
 	return rc;
 }
 
+/**
+ * Attaches a log-linear (HDR-style) histogram to the given node.  Every value
+ * recorded into the node from then on is also counted in the histogram,
+ * without taking the node lock, so that readers can compute tail percentiles
+ * with a relative error bounded by 2^-\a sub_bits.  The histogram takes
+ * D_TM_HDR_SIZE(\a sub_bits) bytes of shared memory.
+ *
+ * \param[in]	node		Pointer to a node with a metric of type duration
+ *				or stats gauge.
+ * \param[in]	sub_bits	log2 of the number of sub-buckets per power of
+ *				two.  Must be between 1 and 7.
+ *
+ * \return			DER_SUCCESS		Success
+ *				-DER_INVAL		node or sub_bits is invalid
+ *				-DER_OP_NOT_PERMITTED	Node was not a gauge
+ *							or duration with stats.
+ *				-DER_NO_SHMEM		Out of shared memory
+ */
+int
+d_tm_init_hdr_histogram(struct d_tm_node_t *node, int sub_bits)
+{
+	struct d_tm_metric_t	*metric;
+	struct d_tm_hdr_t	*hdr;
+	struct d_tm_mem_hdr     *mem_hdr;
+	int			 rc;
+
+	if (node == NULL)
+		return -DER_INVAL;
+
+	if (sub_bits < 1 || sub_bits > 7)
+		return -DER_INVAL;
+
+	if (!has_stats(node))
+		return -DER_OP_NOT_PERMITTED;
+
+	mem_hdr = get_mem_region_for_key(tm_mem.ctx, node->dtn_shmem_key);
+	if (mem_hdr == NULL)
+		return -DER_NO_SHMEM;
+
+	rc = d_tm_lock_shmem();
+	if (rc != 0) {
+		D_ERROR("Failed to get mutex: " DF_RC "\n", DP_RC(rc));
+		return rc;
+	}
+
+	metric = node->dtn_metric;
+	if (metric->dtm_hdr != NULL) {
+		/** metric was looked up rather than created */
+		d_tm_unlock_shmem();
+		return DER_SUCCESS;
+	}
+
+	hdr = tm_alloc(mem_hdr, D_TM_HDR_SIZE(sub_bits));
+	if (hdr == NULL) {
+		d_tm_unlock_shmem();
+		return -DER_NO_SHMEM;
+	}
+	hdr->dth_sub_bits = sub_bits;
+	hdr->dth_nr       = D_TM_HDR_NR(sub_bits);
+	metric->dtm_hdr   = hdr;
+	d_tm_unlock_shmem();
+
+	return DER_SUCCESS;
+}
+
 /**
  * Retrieves the histogram creation data for the given node, which includes
  * the number of buckets, initial width and multiplier used to create the
@@ -3488,6 +3763,158 @@ d_tm_get_bucket_range(struct d_tm_context *ctx, struct d_tm_bucket_t *bucket,
 	return DER_SUCCESS;
 }
 
+/**
+ * Takes a snapshot of the log-linear histogram of the given node.
+ *
+ * \param[in]	ctx		Client context
+ * \param[out]	hdr		Snapshot of the histogram, to be released by
+ *				the caller with D_FREE().
+ * \param[in]	node		Pointer to the metric node with a
+ *				log-linear histogram.
+ *
+ * \return	DER_SUCCESS		Success
+ *		-DER_INVAL		Invalid input
+ *		-DER_METRIC_NOT_FOUND	The metric node has no log-linear
+ *					histogram.
+ *		-DER_OP_NOT_PERMITTED	Node was not a gauge or duration
+ *					with stats.
+ *		-DER_NOMEM		Out of memory
+ */
+int
+d_tm_get_hdr_histogram(struct d_tm_context *ctx, struct d_tm_hdr_t **hdr,
+		       struct d_tm_node_t *node)
+{
+	struct d_tm_metric_t	*metric_data = NULL;
+	struct d_tm_hdr_t	*dtm_hdr     = NULL;
+	struct d_tm_hdr_t	*snap;
+	struct d_tm_mem_hdr     *mem_hdr     = NULL;
+	int			 rc;
+	int			 i;
+
+	if (ctx == NULL || hdr == NULL || node == NULL)
+		return -DER_INVAL;
+
+	rc = validate_node_ptr(ctx, node, &mem_hdr);
+	if (rc != 0)
+		return rc;
+
+	if (unlikely(!node_is_readable(node)))
+		return -DER_AGAIN;
+
+	if (!has_stats(node))
+		return -DER_OP_NOT_PERMITTED;
+
+	metric_data = conv_ptr(mem_hdr, node->dtn_metric);
+	if (metric_data == NULL)
+		return -DER_METRIC_NOT_FOUND;
+
+	dtm_hdr = conv_ptr(mem_hdr, metric_data->dtm_hdr);
+	if (dtm_hdr == NULL)
+		return -DER_METRIC_NOT_FOUND;
+
+	if (dtm_hdr->dth_sub_bits < 1 || dtm_hdr->dth_sub_bits > 7 ||
+	    dtm_hdr->dth_nr != D_TM_HDR_NR(dtm_hdr->dth_sub_bits))
+		return -DER_METRIC_NOT_FOUND;
+
+	D_ALLOC(snap, D_TM_HDR_SIZE(dtm_hdr->dth_sub_bits));
+	if (snap == NULL)
+		return -DER_NOMEM;
+
+	snap->dth_sub_bits = dtm_hdr->dth_sub_bits;
+	snap->dth_nr       = dtm_hdr->dth_nr;
+	for (i = 0; i < snap->dth_nr; i++)
+		snap->dth_counts[i] = __atomic_load_n(&dtm_hdr->dth_counts[i], __ATOMIC_RELAXED);
+
+	*hdr = snap;
+	return DER_SUCCESS;
+}
+
+/**
+ * Adds the counts of \a src into \a dst, e.g. to combine the histograms of
+ * several targets or engines.
+ *
+ * \param[in,out]	dst	Histogram snapshot to merge into
+ * \param[in]		src	Histogram snapshot to merge from
+ *
+ * \return		DER_SUCCESS	Success
+ *			-DER_INVAL	Histograms have a different precision
+ */
+int
+d_tm_hdr_merge(struct d_tm_hdr_t *dst, struct d_tm_hdr_t *src)
+{
+	int	i;
+
+	if (dst == NULL || src == NULL)
+		return -DER_INVAL;
+
+	if (dst->dth_sub_bits != src->dth_sub_bits || dst->dth_nr != src->dth_nr)
+		return -DER_INVAL;
+
+	for (i = 0; i < dst->dth_nr; i++)
+		dst->dth_counts[i] += src->dth_counts[i];
+
+	return DER_SUCCESS;
+}
+
+/**
+ * \param[in]	hdr	Histogram snapshot
+ *
+ * \return		Number of values recorded in \a hdr
+ */
+uint64_t
+d_tm_hdr_count(struct d_tm_hdr_t *hdr)
+{
+	uint64_t	total = 0;
+	int		i;
+
+	if (hdr == NULL)
+		return 0;
+
+	for (i = 0; i < hdr->dth_nr; i++)
+		total += hdr->dth_counts[i];
+
+	return total;
+}
+
+/**
+ * Computes the value below which \a pct percent of the recorded values fall.
+ * The result is the upper bound of the matching bucket, so it never
+ * under-reports and is within the relative error of the histogram.
+ *
+ * \param[in]	hdr	Histogram snapshot
+ * \param[in]	pct	Percentile, between 0 and 100
+ *
+ * \return		The percentile value, or 0 if \a hdr is empty
+ */
+uint64_t
+d_tm_hdr_percentile(struct d_tm_hdr_t *hdr, double pct)
+{
+	uint64_t	total;
+	uint64_t	target;
+	uint64_t	seen = 0;
+	int		i;
+
+	total = d_tm_hdr_count(hdr);
+	if (total == 0)
+		return 0;
+
+	if (pct > 100.0)
+		pct = 100.0;
+	target = (uint64_t)ceil(pct * total / 100.0);
+	if (target == 0)
+		target = 1;
+
+	for (i = 0; i < hdr->dth_nr; i++) {
+		seen += hdr->dth_counts[i];
+		if (seen >= target)
+			break;
+	}
+	if (i == hdr->dth_nr)
+		i--;
+
+	return hdr_upper(hdr->dth_sub_bits, i);
+}
+
 /**
  * Read the specified counter.
  *
@@ -3531,8 +3958,20 @@ d_tm_get_counter(struct d_tm_context *ctx, uint64_t *val,
 			return -DER_METRIC_NOT_FOUND;
 	}
 
+	if (metric_data->dtm_shards != NULL) {
+		struct d_tm_shard_t *shards = metric_data->dtm_shards;
+
+		if (ctx != NULL) {
+			shards = conv_ptr(mem_hdr, shards);
+			if (shards == NULL)
+				return -DER_METRIC_NOT_FOUND;
+		}
+		*val = fold_shards(shards);
+		return DER_SUCCESS;
+	}
+
 	d_tm_node_lock(node);
-	*val = metric_data->dtm_data.value;
+	*val = __atomic_load_n(&metric_data->dtm_data.value, __ATOMIC_RELAXED);
 	d_tm_node_unlock(node);
 	return DER_SUCCESS;
 }
@@ -95,6 +95,67 @@ test_add_to_counter(void **state)
 	assert_int_equal(val, count + 1);
 }
 
+#define SHARD_THREADS	8
+#define SHARD_INCS	10000
+
+static void *
+sharded_inc_thread(void *arg)
+{
+	struct d_tm_node_t	*ctr = arg;
+	int			 i;
+
+	for (i = 0; i < SHARD_INCS; i++)
+		d_tm_inc_counter(ctr, 1);
+
+	return NULL;
+}
+
+static void
+test_sharded_counter(void **state)
+{
+	struct d_tm_node_t	*ctr;
+	struct d_tm_node_t	*gauge;
+	pthread_t		 threads[SHARD_THREADS];
+	char			*path = "gurt/tests/telem/sharded counter";
+	uint64_t		 val;
+	int			 rc;
+	int			 i;
+
+	/* only counters can be sharded */
+	rc = d_tm_add_metric(&gauge, D_TM_GAUGE | D_TM_SHARDED, NULL, NULL,
+			     "gurt/tests/telem/sharded gauge");
+	assert_rc_equal(rc, -DER_INVAL);
+
+	rc = d_tm_add_metric(&ctr, D_TM_COUNTER | D_TM_SHARDED, NULL, NULL, path);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(ctr->dtn_type, D_TM_COUNTER);
+
+	for (i = 0; i < SHARD_THREADS; i++) {
+		rc = pthread_create(&threads[i], NULL, sharded_inc_thread, ctr);
+		assert_int_equal(rc, 0);
+	}
+	for (i = 0; i < SHARD_THREADS; i++)
+		pthread_join(threads[i], NULL);
+
+	/* this thread picks an explicit slot */
+	d_tm_set_shard(3);
+	d_tm_inc_counter(ctr, 5);
+
+	rc = d_tm_get_counter(cli_ctx, &val, srv_to_cli_node(ctr));
+	assert_rc_equal(rc, DER_SUCCESS);
+	assert_int_equal(val, SHARD_THREADS * SHARD_INCS + 5);
+
+	/* server-side fast read folds the same slots */
+	rc = d_tm_get_counter(NULL, &val, ctr);
+	assert_rc_equal(rc, DER_SUCCESS);
+	assert_int_equal(val, SHARD_THREADS * SHARD_INCS + 5);
+
+	d_tm_set_counter(ctr, 42);
+	rc = d_tm_get_counter(cli_ctx, &val, srv_to_cli_node(ctr));
+	assert_rc_equal(rc, DER_SUCCESS);
+	assert_int_equal(val, 42);
+}
+
 static void
 test_gauge(void **state)
 {
@@ -678,6 +739,64 @@ test_gauge_with_histogram_multiplier_2(void **state)
 	check_histogram_metadata(path);
 }
 
+static void
+test_hdr_histogram(void **state)
+{
+	struct d_tm_node_t	*gauge;
+	struct d_tm_node_t	*ctr;
+	struct d_tm_hdr_t	*hdr;
+	struct d_tm_hdr_t	*hdr2;
+	char			*path = "gurt/tests/telem/hdr-gauge";
+	uint64_t		 val;
+	uint64_t		 i;
+	int			 rc;
+
+	rc = d_tm_add_metric(&ctr, D_TM_COUNTER, NULL, NULL, "gurt/tests/telem/hdr-counter");
+	assert_rc_equal(rc, 0);
+	rc = d_tm_init_hdr_histogram(ctr, D_TM_HDR_SUB_BITS);
+	assert_rc_equal(rc, -DER_OP_NOT_PERMITTED);
+
+	rc = d_tm_add_metric(&gauge, D_TM_STATS_GAUGE, NULL, "us", path);
+	assert_rc_equal(rc, 0);
+	rc = d_tm_init_hdr_histogram(gauge, 0);
+	assert_rc_equal(rc, -DER_INVAL);
+	rc = d_tm_init_hdr_histogram(gauge, D_TM_HDR_SUB_BITS);
+	assert_rc_equal(rc, 0);
+
+	for (i = 1; i <= 10000; i++)
+		d_tm_set_gauge(gauge, i);
+
+	rc = d_tm_get_hdr_histogram(cli_ctx, &hdr, srv_to_cli_node(gauge));
+	assert_rc_equal(rc, DER_SUCCESS);
+	assert_int_equal(hdr->dth_nr, D_TM_HDR_NR(D_TM_HDR_SUB_BITS));
+	assert_int_equal(d_tm_hdr_count(hdr), 10000);
+
+	/* never under-reported, and within the relative error of the histogram */
+	val = d_tm_hdr_percentile(hdr, 50);
+	assert_true(val >= 5000 && val <= 5000 + 5000 / (1 << D_TM_HDR_SUB_BITS));
+	val = d_tm_hdr_percentile(hdr, 99);
+	assert_true(val >= 9900 && val <= 9900 + 9900 / (1 << D_TM_HDR_SUB_BITS));
+	assert_int_equal(d_tm_hdr_percentile(hdr, 0), 1);
+
+	/* an outlier shows up in the far tail once merged */
+	d_tm_set_gauge(gauge, 1000000);
+	rc = d_tm_get_hdr_histogram(cli_ctx, &hdr2, srv_to_cli_node(gauge));
+	assert_rc_equal(rc, DER_SUCCESS);
+	rc = d_tm_hdr_merge(hdr, hdr2);
+	assert_rc_equal(rc, DER_SUCCESS);
+	assert_int_equal(d_tm_hdr_count(hdr), 20001);
+	assert_true(d_tm_hdr_percentile(hdr, 100) >= 1000000);
+
+	hdr2->dth_sub_bits++;
+	rc = d_tm_hdr_merge(hdr, hdr2);
+	assert_rc_equal(rc, -DER_INVAL);
+	D_FREE(hdr);
+	D_FREE(hdr2);
+
+	rc = d_tm_get_hdr_histogram(cli_ctx, &hdr, srv_to_cli_node(ctr));
+	assert_rc_equal(rc, -DER_OP_NOT_PERMITTED);
+}
+
 static void
 test_units(void **state)
 {
@@ -1243,9 +1362,9 @@ test_verify_object_count(void **state)
 {
 	struct d_tm_node_t	*node;
 	int			num;
-	int			exp_num_ctr = 20;
+	int			exp_num_ctr = 22;
 	int			exp_num_gauge = 3;
-	int			exp_num_gauge_stats = 3;
+	int			exp_num_gauge_stats = 4;
 	int			exp_num_dur = 2;
 	int			exp_num_timestamp = 2;
 	int			exp_num_snap = 2;
@@ -1411,6 +1530,7 @@ main(int argc, char **argv)
 	    cmocka_unit_test(test_timer_snapshot),
 	    cmocka_unit_test(test_increment_counter),
 	    cmocka_unit_test(test_add_to_counter),
+	    cmocka_unit_test(test_sharded_counter),
 	    cmocka_unit_test(test_gauge),
 	    cmocka_unit_test(test_record_timestamp),
 	    cmocka_unit_test(test_interval_timer),
@@ -1419,6 +1539,7 @@ main(int argc, char **argv)
 	    cmocka_unit_test(test_gauge_with_histogram_multiplier_1),
 	    cmocka_unit_test(test_gauge_with_histogram_multiplier_2),
 	    cmocka_unit_test(benchmark_histogram_fast_vs_slow),
+	    cmocka_unit_test(test_hdr_histogram),
 	    cmocka_unit_test(test_units),
 	    cmocka_unit_test(test_ephemeral_simple),
 	    cmocka_unit_test(test_ephemeral_nested),
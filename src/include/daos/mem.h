@@ -519,6 +519,27 @@ int
 umem_cache_checkpoint(struct umem_store *store, umem_cache_wait_cb_t wait_cb, void *arg,
 		      uint64_t *chkpt_id, struct umem_cache_chkpt_stats *chkpt_stats);
 
+/**
+ * Incremental version of umem_cache_checkpoint(), it only flushes the dirty pages required
+ * to persist all the transactions up to @upto_id, the pages are flushed in MD-blob offset
+ * order. The checkpointed id could be higher than @upto_id, since the selected pages could
+ * carry changes from later transactions.
+ *
+ * \param[in]		store		The umem store
+ * \param[in]		wait_cb		Callback for to wait for wal commit completion
+ * \param[in]		arg		argument for wait_cb
+ * \param[in]		upto_id		Transactions up to this ID are to be checkpointed
+ * \param[in,out]	chkpt_id	Input is last checkpointed id, output is checkpointed id,
+ *					it's unchanged if no page needs to be flushed
+ * \param[out]		chkpt_stats	check point stats
+ *
+ * \return 0 on success
+ */
+int
+umem_cache_checkpoint_upto(struct umem_store *store, umem_cache_wait_cb_t wait_cb, void *arg,
+			   uint64_t upto_id, uint64_t *chkpt_id,
+			   struct umem_cache_chkpt_stats *chkpt_stats);
+
 #endif /*DAOS_PMEM_BUILD*/
 
 /* umem persistent object functions */
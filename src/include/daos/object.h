@@ -608,6 +608,7 @@ int dc_tx_restart(tse_task_t *task);
 int dc_tx_local_open(daos_handle_t coh, daos_epoch_t epoch,
 		     uint32_t flags, daos_handle_t *th);
 int dc_tx_local_close(daos_handle_t th);
+int dc_tx_open_direct(daos_handle_t coh, uint64_t flags, daos_handle_t *th);
 int dc_tx_hdl2epoch(daos_handle_t th, daos_epoch_t *epoch);
 
 /** Decode shard number from enumeration anchor */
@@ -666,8 +667,13 @@ enum {
 	OBJ_ITER_DKEY_EPOCH,
 	OBJ_ITER_AKEY_EPOCH,
 	OBJ_ITER_OBJ_PUNCH_EPOCH,
+	/* value of the requested akey under the previous dkey, see ORF_ENUM_INLINE_AKEY */
+	OBJ_ITER_INLINE_VAL,
 };
 
+/** Max size of the akey value returned inline with each enumerated dkey */
+#define OBJ_ENUM_INLINE_VAL_MAX	512
+
 #define RECX_INLINE	(1U << 0)
 
 struct obj_enum_rec {
@@ -95,6 +95,8 @@ struct pl_map {
 	struct pool_map		*pl_poolmap;
 	/** placement map operations */
 	struct pl_map_ops       *pl_ops;
+	/** cache of the recently computed object layouts, NULL if disabled */
+	struct pl_layout_cache	*pl_layout_cache;
 };
 
 /** attributes of the placement map */
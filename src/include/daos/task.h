@@ -101,6 +101,7 @@ struct daos_task_args {
 		daos_kv_destroy_t	kv_destroy;
 		daos_kv_get_t		kv_get;
 		daos_kv_put_t		kv_put;
+		daos_kv_put_multi_t	kv_put_multi;
 		daos_kv_remove_t	kv_remove;
 		daos_kv_list_t		kv_list;
 
@@ -235,6 +236,17 @@ dc_obj_list_dkey_task_create(daos_handle_t oh, daos_handle_t th, uint32_t *nr,
 			     daos_key_desc_t *kds, d_sg_list_t *sgl,
 			     daos_anchor_t *anchor, daos_event_t *ev,
 			     tse_sched_t *tse, tse_task_t **task);
+/**
+ * List dkeys as dc_obj_list_dkey_task_create(), each dkey kds may be followed by a
+ * OBJ_ITER_INLINE_VAL kds carrying the value of \a akey under that dkey (zero length if the
+ * akey does not exist). A dkey without it must be fetched by the caller. Each dkey may consume
+ * two kds, so at most half of \a nr dkeys are returned.
+ */
+int
+dc_obj_list_dkey_inline_task_create(daos_handle_t oh, daos_handle_t th, daos_key_t *akey,
+				    daos_iod_type_t type, uint32_t *nr, daos_key_desc_t *kds,
+				    d_sg_list_t *sgl, daos_anchor_t *anchor, daos_event_t *ev,
+				    tse_sched_t *tse, tse_task_t **task);
 int
 dc_obj_list_akey_task_create(daos_handle_t oh, daos_handle_t th,
 			     daos_key_t *dkey, uint32_t *nr,
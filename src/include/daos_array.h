@@ -52,6 +52,27 @@ typedef struct {
 	daos_size_t		arr_nr_read;
 } daos_array_iod_t;
 
+/**
+ * Strided IO descriptor in a DAOS array object: \a arr_count blocks of \a arr_len records each,
+ * the first starting at \a arr_idx and each following one \a arr_stride records after the
+ * previous. This describes the same access as a list of arr_count ranges in a daos_array_iod_t
+ * without having to build (and walk) that list.
+ */
+typedef struct {
+	/** Index of the first record of the first block */
+	daos_off_t		arr_idx;
+	/** Number of records in each block */
+	daos_size_t		arr_len;
+	/** Distance in records between the start of two consecutive blocks (>= arr_len) */
+	daos_size_t		arr_stride;
+	/** Number of blocks */
+	daos_size_t		arr_count;
+	/** (on read only) same as daos_array_iod_t::arr_nr_short_read */
+	daos_size_t		arr_nr_short_read;
+	/** (on read only) same as daos_array_iod_t::arr_nr_read */
+	daos_size_t		arr_nr_read;
+} daos_array_siod_t;
+
 /** DAOS array stat (size, modification time) information */
 typedef struct {
 	/** Array size (in records) */
@@ -315,6 +336,60 @@ int
 daos_array_write(daos_handle_t oh, daos_handle_t th, daos_array_iod_t *iod,
 		 d_sg_list_t *sgl, daos_event_t *ev);
 
+/**
+ * Read a strided pattern of blocks from an array object. Same as daos_array_read() with the ranges
+ * given by a strided descriptor instead of a list.
+ *
+ * \param[in]	oh	Array object open handle.
+ * \param[in]	th	Transaction handle.
+ * \param[in,out]
+ *		siod	[in]: Strided IO descriptor of the blocks to read from the array.
+ *			The same limit as for daos_array_read() applies to arr_count if arr_len
+ *			is under DAOS_ARRAY_RG_LEN_THD.
+ *			[out]: number of records read / possibly short read.
+ * \param[in]	sgl	A scatter/gather list (sgl) to the store array data. The total size must
+ *			match arr_len * arr_count records.
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		These values will be returned by \a ev::ev_error in
+ *			non-blocking mode:
+ *			0		Success
+ *			-DER_NO_HDL	Invalid object open handle
+ *			-DER_INVAL	Invalid parameter
+ *			-DER_UNREACH	Network is unreachable
+ *			-DER_REC2BIG	Record is too large and can't be
+ *					fit into output buffer
+ */
+int
+daos_array_read_strided(daos_handle_t oh, daos_handle_t th, daos_array_siod_t *siod,
+			d_sg_list_t *sgl, daos_event_t *ev);
+
+/**
+ * Write a strided pattern of blocks to an array object. Same as daos_array_write() with the ranges
+ * given by a strided descriptor instead of a list.
+ *
+ * \param[in]	oh	Array object open handle.
+ * \param[in]	th	Transaction handle.
+ * \param[in]	siod	Strided IO descriptor of the blocks to write to the array.
+ *			The same limit as for daos_array_write() applies to arr_count if arr_len
+ *			is under DAOS_ARRAY_RG_LEN_THD.
+ * \param[in]	sgl	A scatter/gather list (sgl) to the store array data. The total size must
+ *			match arr_len * arr_count records.
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		These values will be returned by \a ev::ev_error in
+ *			non-blocking mode:
+ *			0		Success
+ *			-DER_NO_HDL	Invalid object open handle
+ *			-DER_INVAL	Invalid parameter
+ *			-DER_UNREACH	Network is unreachable
+ */
+int
+daos_array_write_strided(daos_handle_t oh, daos_handle_t th, daos_array_siod_t *siod,
+			 d_sg_list_t *sgl, daos_event_t *ev);
+
 /**
  * Query the number of records in the array object.
  *
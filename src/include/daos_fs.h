@@ -641,6 +641,30 @@ int
 dfs_readx(dfs_t *dfs, dfs_obj_t *obj, dfs_iod_t *iod, d_sg_list_t *sgl,
 	  daos_size_t *read_size, daos_event_t *ev);
 
+/**
+ * Strided read interface to a DFS file.
+ * Same as dfs_readx with the file layout given as arr_count blocks of arr_len bytes,
+ * arr_stride bytes apart, starting at offset arr_idx, instead of a list of ranges. This is the
+ * common access pattern of a column or a sub-array of a file (e.g. MPI-IO vector datatypes), and
+ * avoids building and walking a range per block.
+ *
+ * \param[in]	dfs	Pointer to the mounted file system.
+ * \param[in]	obj	Opened file object.
+ * \param[in]	siod	Strided IO descriptor (in bytes).
+ *			The same limit as dfs_readx applies to arr_count if arr_len is under
+ *			DAOS_ARRAY_RG_LEN_THD.
+ * \param[in]	sgl	Scatter/Gather list for data buffer.
+ * \param[out]	read_size
+ *			How much data is actually read.
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		0 on success, errno code on failure.
+ */
+int
+dfs_read_strided(dfs_t *dfs, dfs_obj_t *obj, daos_array_siod_t *siod, d_sg_list_t *sgl,
+		 daos_size_t *read_size, daos_event_t *ev);
+
 /**
  * Write data to the file object.
  *
@@ -675,6 +699,25 @@ int
 dfs_writex(dfs_t *dfs, dfs_obj_t *obj, dfs_iod_t *iod, d_sg_list_t *sgl,
 	   daos_event_t *ev);
 
+/**
+ * Strided write interface to a DFS file.
+ * Same as dfs_writex with the file layout given by a strided descriptor (see dfs_read_strided).
+ *
+ * \param[in]	dfs	Pointer to the mounted file system.
+ * \param[in]	obj	Opened file object.
+ * \param[in]	siod	Strided IO descriptor (in bytes).
+ *			The same limit as dfs_writex applies to arr_count if arr_len is under
+ *			DAOS_ARRAY_RG_LEN_THD.
+ * \param[in]	sgl	Scatter/Gather list for data buffer.
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		0 on success, errno code on failure.
+ */
+int
+dfs_write_strided(dfs_t *dfs, dfs_obj_t *obj, daos_array_siod_t *siod, d_sg_list_t *sgl,
+		  daos_event_t *ev);
+
 /**
  * Query size of file data.
  *
@@ -777,6 +820,37 @@ int
 dfs_iterate(dfs_t *dfs, dfs_obj_t *obj, daos_anchor_t *anchor,
 	    uint32_t *nr, size_t size, dfs_filler_cb_t op, void *arg);
 
+/**
+ * User callback defined for dfs_iterate_plus. \a mode is 0 if the entry was removed while being
+ * enumerated.
+ */
+typedef int (*dfs_filler_plus_cb_t)(dfs_t *dfs, dfs_obj_t *obj, const char name[], mode_t mode,
+				    daos_obj_id_t oid, void *arg);
+
+/**
+ * Same as dfs_iterate, but the callback is also given the mode and object ID of every entry. They
+ * are returned by the servers along with the entry names when possible, so a lookup of every entry
+ * is not needed by the caller.
+ *
+ * \param[in]	dfs	Pointer to the mounted file system.
+ * \param[in]	obj	Opened directory object.
+ * \param[in,out]
+ *		anchor	Hash anchor for the next call, it should be set to
+ *			zeroes for the first call, it should not be changed
+ *			by caller between calls.
+ * \param[in,out]
+ *		nr	[in]: MAX number of entries to enumerate.
+ *			[out]: Actual number of entries enumerated.
+ * \param[in]	size	Max buffer size to be used internally for the entry names.
+ * \param[in]	op	Callback to be issued on every entry.
+ * \param[in]	arg	Pointer to user data to be passed to \a op.
+ *
+ * \return		0 on success, errno code on failure.
+ */
+int
+dfs_iterate_plus(dfs_t *dfs, dfs_obj_t *obj, daos_anchor_t *anchor, uint32_t *nr, size_t size,
+		 dfs_filler_plus_cb_t op, void *arg);
+
 /**
  * Set the readdir/iterate anchor to start from a specific entry name in a directory object. When
  * using the anchor in a readdir call, the iteration will start from the position of that entry.
@@ -114,6 +114,46 @@ int
 daos_kv_put(daos_handle_t oh, daos_handle_t th, uint64_t flags, const char *key,
 	    daos_size_t size, const void *buf, daos_event_t *ev);
 
+/**
+ * Insert or update a batch of KV pairs. Each pair is stored the same way as
+ * daos_kv_put() would do it.
+ *
+ * If \a th is DAOS_TX_NONE and more than one pair is given, the pairs are
+ * attached to an internal transaction that is committed with a single
+ * compound RPC to the leader, i.e. one RPC and one DTX for the whole batch
+ * instead of one RPC per key. The batch is then atomic: either all pairs
+ * are stored or none is. If \a th is a valid transaction handle, the pairs
+ * are attached to it and committed with the caller's transaction.
+ *
+ * \param[in]	oh	Object open handle.
+ * \param[in]	th	Transaction handle.
+ * \param[in]	flags	Update flags, applied to all pairs.
+ * \param[in]	nr	Number of KV pairs.
+ * \param[in]	keys	Array of \a nr keys.
+ * \param[in]	sizes	Array of \a nr value sizes.
+ * \param[in]	bufs	Array of \a nr pointers to the atomic values.
+ * \param[out]	rcs	Optional array of \a nr per-key return codes. When
+ *			the internal transaction fails to commit, the commit
+ *			error is reported for every key.
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		These values will be returned by \a ev::ev_error in
+ *			non-blocking mode:
+ *			0		Success
+ *			-DER_NO_HDL	Invalid object open handle
+ *			-DER_INVAL	Invalid parameter
+ *			-DER_NO_PERM	Permission denied
+ *			-DER_UNREACH	Network is unreachable
+ *			-DER_EP_RO	Epoch is read-only
+ *			-DER_TX_RESTART	The internal transaction needs to be
+ *					restarted, the batch can be resubmitted
+ */
+int
+daos_kv_put_multi(daos_handle_t oh, daos_handle_t th, uint64_t flags, uint32_t nr,
+		  const char **keys, daos_size_t *sizes, const void **bufs, int *rcs,
+		  daos_event_t *ev);
+
 /**
  * Fetch value of a key.
  *
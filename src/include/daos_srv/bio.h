@@ -1074,6 +1074,8 @@ struct bio_wal_stats {
 	uint32_t	ws_size;	/* WAL size for single tx in bytes */
 	uint32_t	ws_qd;		/* WAL tx QD */
 	uint32_t	ws_waiters;	/* Waiters for WAL reclaiming */
+	uint32_t	ws_batch;	/* Transactions in the commit group, 0 for non-leader */
+	uint32_t	ws_batch_delay;	/* Commit group queuing delay in us */
 };
 
 /*
@@ -1119,6 +1121,7 @@ struct bio_wal_rp_stats {
 	uint64_t	wrs_sz;		/* bytes replayed */
 	uint64_t	wrs_entries;	/* replayed entries count */
 	uint64_t	wrs_tx_cnt;	/* total transactions */
+	uint64_t	wrs_tput;	/* replay throughput in bytes/s */
 };
 
 /*
@@ -1173,6 +1176,12 @@ struct bio_wal_info {
  */
 void bio_wal_query(struct bio_meta_context *mc, struct bio_wal_info *info);
 
+/*
+ * Get the transaction ID which checkpoint needs to reach for reclaiming @nr_blks WAL
+ * blocks, the returned ID is capped by the last committed ID.
+ */
+uint64_t bio_wal_ckp_target(struct bio_meta_context *mc, uint32_t nr_blks);
+
 /*
  * Check if the meta blob is empty, paired with bio_meta_clear_empty() for avoid
  * loading a newly created meta blob.
@@ -162,6 +162,8 @@ enum {
 	SCHED_REQ_FL_PERIODIC	= (1 << 1),
 	SCHED_REQ_FL_NO_REJECT	= (1 << 2),
 	SCHED_REQ_FL_RESENT	= (1 << 3),
+	/* Latency sensitive request, e.g. small fetch, see DAOS_SCHED_EDF_POOLS */
+	SCHED_REQ_FL_LATENCY	= (1 << 4),
 };
 
 struct sched_req_attr {
@@ -228,6 +228,25 @@ struct evt_node {
 	};
 };
 
+enum evt_summary_flags {
+	/** Every record in the subtree is a hole */
+	EVT_NS_HOLES		= (1 << 0),
+};
+
+/**
+ * Per-node subtree summary, stored right after the entries (or children) of
+ * a node when the tree is created with EVT_FEAT_NODE_SUMMARY.  It is kept
+ * conservative: the max epoch is never lower, and EVT_NS_HOLES is never set
+ * while the subtree may hold data.
+ */
+struct evt_node_summary {
+	/** Highest major epoch of all records in the subtree */
+	daos_epoch_t			ns_max_epc;
+	/** See evt_summary_flags */
+	uint16_t			ns_flags;
+	uint16_t			ns_padding[3];
+};
+
 struct evt_root {
 	/** UUID of pmem pool */
 	uint64_t			tr_pool_uuid;
@@ -288,11 +307,13 @@ enum evt_feats {
 	EVT_FEAT_SORT_DIST_EVEN = (1 << 2),
 	/** Dynamic root tree size */
 	EVT_FEAT_DYNAMIC_ROOT = (1 << 3),
+	/** Nodes carry a struct evt_node_summary for subtree pruning */
+	EVT_FEAT_NODE_SUMMARY = (1 << 4),
 	EVT_FEATS_END,
 	/** Calculated mask for all supported feats */
 	EVT_FEATS_SUPPORTED = ((EVT_FEATS_END - 1) << 1) - 1,
 	/** Policy mask */
-	EVT_POLICY_MASK = EVT_FEATS_SUPPORTED ^ EVT_FEAT_DYNAMIC_ROOT,
+	EVT_POLICY_MASK = EVT_FEATS_SUPPORTED ^ (EVT_FEAT_DYNAMIC_ROOT | EVT_FEAT_NODE_SUMMARY),
 };
 
 /** These are "internal" flags meant to match the btree ones */
@@ -640,6 +661,20 @@ int evt_remove_all(daos_handle_t toh, const struct evt_extent *ext,
 int evt_find(daos_handle_t toh, const struct evt_filter *filter,
 	     struct evt_entry_array *ent_array);
 
+/**
+ * Same as evt_find, but for callers that only consume visible data and treat
+ * holes and gaps alike (e.g. fetch).  On trees with EVT_FEAT_NODE_SUMMARY,
+ * subtrees that are entirely punched, or only hold holes that hide no data,
+ * are skipped, so visible holes may be missing from \a ent_array.
+ *
+ * \param toh		[IN]		The tree open handle
+ * \param filter	[IN]		Describes the range to search
+ * \param ent_array	[IN,OUT]	Pass in initialized list, filled in by
+ *					the function
+ */
+int evt_find_data(daos_handle_t toh, const struct evt_filter *filter,
+		  struct evt_entry_array *ent_array);
+
 /**
  * Debug function, it outputs status of tree nodes at level \a debug_level,
  * or all levels if \a debug_level is negative.
@@ -815,6 +850,31 @@ evt_feats_get(struct evt_root *root)
  */
 int  evt_feats_set(struct evt_root *root, struct umem_instance *umm, uint64_t feats);
 
+/** Batched leaf overlap kernels, see evt_leaf_overlap_check() */
+enum evt_overlap_kernel {
+	EVT_OVERLAP_SCALAR,
+	EVT_OVERLAP_AVX2,
+	EVT_OVERLAP_AVX512,
+	EVT_OVERLAP_MAX,
+};
+
+/**
+ * Run overlap kernel \a kernel on the first \a nr entries of a leaf, bit @i of \a mask
+ * (EVT_ORDER_MAX bits) is set if the extent of entry @i overlaps with [\a lo, \a hi].
+ * It's for the unit test which checks the vector kernels against the scalar one.
+ *
+ * \param kernel[in]	Kernel to run
+ * \param ne[in]	Leaf entries
+ * \param nr[in]	Number of entries, up to EVT_ORDER_MAX
+ * \param lo[in]	Low offset of the range
+ * \param hi[in]	High offset of the range
+ * \param mask[out]	Overlap bitmap
+ *
+ * \return 0 on success, -DER_NOSYS if the kernel isn't supported by this CPU
+ */
+int evt_leaf_overlap_check(enum evt_overlap_kernel kernel, const struct evt_node_entry *ne,
+			   int nr, uint64_t lo, uint64_t hi, uint64_t *mask);
+
 /** Validate the provided evt.
  *
  * Note: It is designed for catastrophic recovery. Not to perform at run-time.
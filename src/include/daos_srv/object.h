@@ -46,6 +46,9 @@ struct ds_obj_enum_arg {
 		};
 	};
 	daos_size_t		inline_thres;	/* type == S||R || chk_key2big*/
+	daos_key_t		inline_akey;	/* type == DKEY, value packed with each dkey */
+	uint32_t		inline_type;	/* daos_iod_type_t of inline_akey */
+	struct dtx_handle      *dth;		/* DTX of the enumeration, for inline_akey */
 	int			rnum;		/* records num (type == S||R) */
 	daos_size_t		rsize;		/* record size (type == S||R) */
 	daos_unit_oid_t		oid;		/* for unpack */
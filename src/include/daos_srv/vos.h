@@ -178,6 +178,25 @@ vos_dtx_load_mbs(daos_handle_t coh, struct dtx_id *dti, daos_unit_oid_t *oid,
 int
 vos_dtx_commit(daos_handle_t coh, struct dtx_id dtis[], int count, bool keep_act, bool rm_cos[]);
 
+/**
+ * Commit the specified DTXs that belong to multiple containers of the same pool via single
+ * local transaction. Fall back to one transaction per container if the pool is evictable.
+ *
+ * \param cohs	[IN]	The array of container open handles.
+ * \param dtis	[IN]	The array of DTX identifier arrays, one per container.
+ * \param counts [IN]	The array of DTX counts, one per container.
+ * \param nr	[IN]	The count of containers.
+ * \param keep_act [IN]	Keep DTX entry or not.
+ * \param rm_cos [OUT]	The array of arrays for whether remove entry from CoS cache,
+ *			one per container. Can be NULL.
+ *
+ * \return		Negative value if error.
+ * \return		Others are for the count of committed DTXs.
+ */
+int
+vos_dtx_commit_multi(daos_handle_t cohs[], struct dtx_id *dtis[], int counts[], int nr,
+		     bool keep_act, bool *rm_cos[]);
+
 /**
  * Abort the specified DTXs.
  *
@@ -1416,6 +1435,8 @@ enum vos_pool_opc {
 	VOS_PO_CTL_SET_DATA_THRESH,
 	/** Set space reserve ratio for rebuild */
 	VOS_PO_CTL_SET_SPACE_RB,
+	/** Set max number of cached objects of the pool per target, 0 means no limit */
+	VOS_PO_CTL_SET_OBJ_CACHE,
 };
 
 /**
@@ -1514,6 +1535,16 @@ vos_pool_needs_checkpoint(daos_handle_t poh);
 int
 vos_pool_checkpoint(daos_handle_t poh);
 
+/** Incremental checkpoint, only flush the dirty pages required to reclaim the specified
+ *  number of WAL blocks.
+ *
+ * \param[in] poh		Open vos pool handle
+ * \param[in] nr_blks		Number of WAL blocks to be reclaimed
+ * \param[out] nr_pages		Number of pages flushed
+ */
+int
+vos_pool_checkpoint_incr(daos_handle_t poh, uint32_t nr_blks, uint32_t *nr_pages);
+
 /**
  * The following declarations are for checksum scrubbing functions. The function
  * types provide an interface for injecting dependencies into the
@@ -921,6 +921,8 @@ typedef struct {
 	daos_array_iod_t	*iod;
 	/** memory descriptors. */
 	d_sg_list_t		*sgl;
+	/** Strided IO descriptor, used instead of \a iod if not NULL. */
+	daos_array_siod_t	*siod;
 } daos_array_io_t;
 
 /** Array get size args */
@@ -1019,6 +1021,26 @@ typedef struct {
 	const void		*buf;
 } daos_kv_put_t;
 
+/** KV multi-key put args */
+typedef struct {
+	/** KV open handle. */
+	daos_handle_t		oh;
+	/** Transaction open handle. */
+	daos_handle_t		th;
+	/** Operation flags. */
+	uint64_t		flags;
+	/** Number of key-value pairs. */
+	uint32_t		nr;
+	/** Array of \a nr keys. */
+	const char		**keys;
+	/** Array of \a nr value sizes. */
+	daos_size_t		*buf_sizes;
+	/** Array of \a nr value buffers. */
+	const void		**bufs;
+	/** Optional array of \a nr per-key return codes. */
+	int			*rcs;
+} daos_kv_put_multi_t;
+
 /** KV remove args */
 typedef struct {
 	/** KV open handle. */
@@ -20,6 +20,11 @@
 #define D_TM_SHARED_MEMORY_KEY		0x10242048
 #define D_TM_SHARED_MEMORY_SIZE		(1024 * 1024)
 
+/** Number of per-writer slots allocated for a D_TM_SHARDED counter */
+#define D_TM_SHARD_NR			16
+/** Each slot sits on its own cache line to avoid false sharing */
+#define D_TM_SHARD_ALIGN		64
+
 /**
  * The following definitions are suggested strings for units that may be used
  * when explicitly calling d_tm_add_metric() to initialize a metric before use.
@@ -143,6 +148,13 @@ enum {
 	D_TM_CLOCK_THREAD_CPUTIME	= 0x200,
 	D_TM_LINK			= 0x400,
 	D_TM_MEMINFO			= 0x800,
+	/**
+	 * Creation-time modifier for D_TM_COUNTER only: writers add into
+	 * per-thread slots without locking, readers fold the slots together.
+	 * It is not stored in dtn_type, so a sharded counter still reports
+	 * as a plain D_TM_COUNTER.
+	 */
+	D_TM_SHARDED			= 0x1000,
 	D_TM_ALL_NODES			= (D_TM_DIRECTORY | \
 					   D_TM_COUNTER | \
 					   D_TM_TIMESTAMP | \
@@ -213,6 +225,25 @@ struct d_tm_histogram_t {
 	int                      dth_value_multiplier;
 };
 
+/**
+ * Log-linear (HDR-style) histogram.  Every power of two is split into
+ * 2^dth_sub_bits equal sub-buckets, so any recorded value below
+ * 2^D_TM_HDR_MAX_BITS is known to within a relative error of
+ * 2^-dth_sub_bits.  Larger values are counted in the last bucket.
+ */
+#define D_TM_HDR_MAX_BITS		32
+/** Default precision: 8 sub-buckets per power of two, i.e. 12.5% error */
+#define D_TM_HDR_SUB_BITS		3
+#define D_TM_HDR_NR(sub_bits)		((D_TM_HDR_MAX_BITS - (sub_bits) + 1) << (sub_bits))
+#define D_TM_HDR_SIZE(sub_bits)		(sizeof(struct d_tm_hdr_t) + \
+					 D_TM_HDR_NR(sub_bits) * sizeof(uint64_t))
+
+struct d_tm_hdr_t {
+	int			dth_sub_bits; /** log2 of sub-buckets per power of two */
+	int			dth_nr; /** number of entries in dth_counts */
+	uint64_t		dth_counts[]; /** updated with relaxed atomics */
+};
+
 struct d_tm_meminfo_t {
 	uint64_t arena;
 	uint64_t ordblks;
@@ -220,14 +251,21 @@ struct d_tm_meminfo_t {
 	uint64_t fordblks;
 };
 
+/** One writer slot of a sharded counter */
+struct d_tm_shard_t {
+	_Atomic uint64_t	dts_value;
+} __attribute__((aligned(D_TM_SHARD_ALIGN)));
+
 struct d_tm_metric_t {
 	union data {
 		uint64_t	value;
 		struct		timespec tms[2];
 		struct d_tm_meminfo_t meminfo;
 	}			dtm_data;
+	struct d_tm_shard_t	*dtm_shards; /** D_TM_SHARD_NR slots, or NULL */
 	struct d_tm_stats_t	*dtm_stats;
 	struct d_tm_histogram_t	*dtm_histogram;
+	struct d_tm_hdr_t	*dtm_hdr; /** log-linear histogram, or NULL */
 	char			*dtm_desc;
 	char			*dtm_units;
 };
@@ -274,6 +312,7 @@ void d_tm_compute_stats(struct d_tm_node_t *node, uint64_t value);
 double d_tm_compute_standard_dev(double sum_of_squares, uint64_t sample_size,
 				 double mean);
 void d_tm_compute_histogram(struct d_tm_node_t *node, uint64_t value);
+void d_tm_compute_hdr(struct d_tm_node_t *node, uint64_t value);
 void d_tm_print_stats(FILE *stream, struct d_tm_stats_t *stats, int format);
 
 #endif /* __TELEMETRY_COMMON_H__ */
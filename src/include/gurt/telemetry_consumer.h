@@ -28,6 +28,15 @@ int d_tm_get_num_buckets(struct d_tm_context *ctx,
 int d_tm_get_bucket_range(struct d_tm_context *ctx,
 			  struct d_tm_bucket_t *bucket, int bucket_id,
 			  struct d_tm_node_t *node);
+int
+     d_tm_get_hdr_histogram(struct d_tm_context *ctx, struct d_tm_hdr_t **hdr,
+			    struct d_tm_node_t *node);
+int
+     d_tm_hdr_merge(struct d_tm_hdr_t *dst, struct d_tm_hdr_t *src);
+uint64_t
+     d_tm_hdr_count(struct d_tm_hdr_t *hdr);
+uint64_t
+     d_tm_hdr_percentile(struct d_tm_hdr_t *hdr, double pct);
 
 /* Developer facing client API to discover topology and manage results */
 struct d_tm_context *d_tm_open(int id);
@@ -77,6 +86,8 @@ void d_tm_print_duration(struct timespec *tms, struct d_tm_stats_t *stats,
 void d_tm_print_gauge(uint64_t val, struct d_tm_stats_t *stats, char *name,
 		      int format, char *units, int opt_fields, FILE *stream);
 void d_tm_print_metadata(char *desc, char *units, int format, FILE *stream);
+void
+     d_tm_print_hdr(struct d_tm_hdr_t *hdr, int format, FILE *stream);
 int d_tm_clock_id(int clk_id);
 char *d_tm_clock_string(int clk_id);
 
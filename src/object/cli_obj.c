@@ -6905,6 +6905,11 @@ obj_list_common(tse_task_t *task, int opc, daos_obj_list_t *args)
 	uint8_t			*p_bitmaps = bitmaps;
 	int			rc;
 
+	/* Room for at least one dkey and its inline value. */
+	if (opc == DAOS_OBJ_DKEY_RPC_ENUMERATE && args->akey != NULL &&
+	    (args->nr == NULL || *args->nr < 2))
+		D_GOTO(out_task, rc = -DER_INVAL);
+
 	rc = obj_req_valid(task, args, opc, &epoch, &map_ver, &obj);
 	if (rc)
 		goto out_task;
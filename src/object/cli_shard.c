@@ -2002,6 +2002,13 @@ dc_obj_shard_list(struct dc_obj_shard *obj_shard, enum obj_rpc_opc opc,
 
 	oei->oei_nr		= args->la_nr;
 	oei->oei_rec_type	= obj_args->type;
+	/* The shard of an EC object only holds part of the value, let caller fetch it. */
+	if (opc == DAOS_OBJ_DKEY_RPC_ENUMERATE && obj_args->akey != NULL &&
+	    !args->la_auxi.obj_auxi->is_ec_obj) {
+		/* Each dkey may be followed by its inline value, see ORF_ENUM_INLINE_AKEY. */
+		oei->oei_nr /= 2;
+		oei->oei_flags |= ORF_ENUM_INLINE_AKEY;
+	}
 	if (dc_obj_proto_version >= 10) {
 		oei_v10 = (struct obj_key_enum_v10_in *)oei;
 		oei_v10->oei_comm_in.req_in_enqueue_id = args->la_auxi.enqueue_id;
@@ -191,6 +191,8 @@ enum obj_rpc_flags {
 	ORF_EMPTY_SGL		= (1 << 24),
 	/* The CPD RPC only contains read-only transaction. */
 	ORF_CPD_RDONLY		= (1 << 25),
+	/* dkey enumeration packs the value of oei_akey after each dkey. */
+	ORF_ENUM_INLINE_AKEY	= (1 << 26),
 };
 /* clang-format on */
 
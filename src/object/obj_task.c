@@ -283,6 +283,26 @@ dc_obj_list_dkey_task_create(daos_handle_t oh, daos_handle_t th, uint32_t *nr,
 	return 0;
 }
 
+int
+dc_obj_list_dkey_inline_task_create(daos_handle_t oh, daos_handle_t th, daos_key_t *akey,
+				    daos_iod_type_t type, uint32_t *nr, daos_key_desc_t *kds,
+				    d_sg_list_t *sgl, daos_anchor_t *anchor, daos_event_t *ev,
+				    tse_sched_t *tse, tse_task_t **task)
+{
+	daos_obj_list_dkey_t	*args;
+	int			 rc;
+
+	rc = dc_obj_list_dkey_task_create(oh, th, nr, kds, sgl, anchor, ev, tse, task);
+	if (rc)
+		return rc;
+
+	args = dc_task_get_args(*task);
+	args->akey		= akey;
+	args->type		= type;
+
+	return 0;
+}
+
 int
 dc_obj_list_akey_task_create(daos_handle_t oh, daos_handle_t th,
 			     daos_key_t *dkey, uint32_t *nr,
@@ -2706,6 +2706,26 @@ dc_tx_local_open(daos_handle_t coh, daos_epoch_t epoch, uint32_t flags,
 	return rc;
 }
 
+/*
+ * Open a modifiable TX without going through the task API, for client-side
+ * helpers that batch several updates (such as daos_kv_put_multi) into one TX
+ * so that they are committed together via a single CPD RPC.
+ */
+int
+dc_tx_open_direct(daos_handle_t coh, uint64_t flags, daos_handle_t *th)
+{
+	struct dc_tx	*tx = NULL;
+	int		 rc;
+
+	D_ASSERT(!(flags & DAOS_TF_RDONLY));
+
+	rc = dc_tx_alloc(coh, 0, flags, &tx);
+	if (rc == 0)
+		*th = dc_tx_ptr2hdl(tx);
+
+	return rc;
+}
+
 int
 dc_tx_local_close(daos_handle_t th)
 {
@@ -158,6 +158,7 @@ obj_metrics_alloc_internal(const char *path, int tgt_id, bool server)
 	struct obj_pool_metrics *metrics;
 	char                     tgt_path[32];
 	uint32_t                 opc;
+	int                      ctr_type;
 	int                      rc;
 
 	D_ASSERT(tgt_id >= 0);
@@ -203,15 +204,21 @@ obj_metrics_alloc_internal(const char *path, int tgt_id, bool server)
 	if (rc)
 		D_WARN("Failed to create retry cnt sensor: " DF_RC "\n", DP_RC(rc));
 
+	/**
+	 * Client-side byte counters are bumped by every application thread doing I/O
+	 * on the pool, so shard them instead of serializing on the node lock.
+	 */
+	ctr_type = server ? D_TM_COUNTER : (D_TM_COUNTER | D_TM_SHARDED);
+
 	/** Total bytes read */
-	rc = d_tm_add_metric(&metrics->opm_fetch_bytes, D_TM_COUNTER,
+	rc = d_tm_add_metric(&metrics->opm_fetch_bytes, ctr_type,
 			     "total number of bytes fetched/read", "bytes", "%s/xferred/fetch%s",
 			     path, tgt_path);
 	if (rc)
 		D_WARN("Failed to create bytes fetch counter: " DF_RC "\n", DP_RC(rc));
 
 	/** Total bytes written */
-	rc = d_tm_add_metric(&metrics->opm_update_bytes, D_TM_COUNTER,
+	rc = d_tm_add_metric(&metrics->opm_update_bytes, ctr_type,
 			     "total number of bytes updated/written", "bytes",
 			     "%s/xferred/update%s", path, tgt_path);
 	if (rc)
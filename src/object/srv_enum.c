@@ -197,15 +197,111 @@ fill_key_csum(vos_iter_entry_t *key_ent, struct ds_obj_enum_arg *arg)
 	return 0;
 }
 
+struct inline_val {
+	char		iv_buf[OBJ_ENUM_INLINE_VAL_MAX];
+	daos_size_t	iv_len;
+};
+
+static int
+inline_val_cb(daos_handle_t ih, vos_iter_entry_t *ent, vos_iter_type_t type,
+	      vos_iter_param_t *param, void *cb_arg, unsigned int *acts)
+{
+	struct inline_val	*val = cb_arg;
+	daos_size_t		 off = 0;
+	daos_size_t		 len;
+	d_iov_t			 iov;
+	int			 rc;
+
+	/* punched single value, the value does not exist */
+	if (bio_addr_is_hole(&ent->ie_biov.bi_addr))
+		return 1;
+
+	/* Same as fill_rec(), copying from NVMe may yield, which key enumeration can't handle. */
+	if (bio_iov2media(&ent->ie_biov) == DAOS_MEDIA_NVME ||
+	    BIO_ADDR_IS_GANG(&ent->ie_biov.bi_addr))
+		return -DER_NOTSUPPORTED;
+
+	if (type == VOS_ITER_SINGLE) {
+		/* only part of the value on this shard */
+		if (ent->ie_gsize != ent->ie_rsize)
+			return -DER_NOTSUPPORTED;
+		len = ent->ie_rsize;
+	} else {
+		if (ent->ie_recx.rx_idx >= OBJ_ENUM_INLINE_VAL_MAX ||
+		    ent->ie_recx.rx_nr > OBJ_ENUM_INLINE_VAL_MAX)
+			return -DER_REC2BIG;
+		off = ent->ie_recx.rx_idx * ent->ie_rsize;
+		len = ent->ie_recx.rx_nr * ent->ie_rsize;
+	}
+	if (off + len > OBJ_ENUM_INLINE_VAL_MAX)
+		return -DER_REC2BIG;
+
+	d_iov_set(&iov, &val->iv_buf[off], len);
+	rc = vos_iter_copy(ih, ent, &iov);
+	if (rc != 0)
+		return rc;
+
+	val->iv_len = max(val->iv_len, off + len);
+	/* the newest single value is the only visible one */
+	return type == VOS_ITER_SINGLE ? 1 : 0;
+}
+
+/**
+ * Read the value of arg::inline_akey under the dkey \a key_ent, visible at the epoch of the
+ * dkey enumeration. Return 1 if the value can't be packed inline and the client has to fetch it,
+ * or -DER_TX_RESTART if the read conflicts with the DTX of the enumeration.
+ */
+static int
+fetch_inline_val(vos_iter_param_t *key_param, vos_iter_entry_t *key_ent,
+		 struct ds_obj_enum_arg *arg, struct inline_val *val)
+{
+	vos_iter_param_t	param = { 0 };
+	struct vos_iter_anchors	anchors = { 0 };
+	vos_iter_type_t		type;
+	int			rc;
+
+	/* No checksum is packed for the value, let the client fetch and verify it. */
+	if (daos_csummer_initialized(arg->csummer))
+		return 1;
+
+	param.ip_hdl	= key_param->ip_hdl;
+	param.ip_oid	= key_param->ip_oid;
+	param.ip_dkey	= key_ent->ie_key;
+	param.ip_akey	= arg->inline_akey;
+	param.ip_epr	= key_param->ip_epr;
+	if (arg->inline_type == DAOS_IOD_ARRAY) {
+		type = VOS_ITER_RECX;
+		param.ip_epc_expr = VOS_IT_EPC_RE;
+		param.ip_flags = VOS_IT_RECX_VISIBLE | VOS_IT_RECX_SKIP_HOLES;
+	} else {
+		type = VOS_ITER_SINGLE;
+		param.ip_epc_expr = VOS_IT_EPC_RR;
+	}
+
+	memset(val->iv_buf, 0, sizeof(val->iv_buf));
+	val->iv_len = 0;
+	/* Under the DTX of the enumeration, so the read of the akey is recorded in its ts set. */
+	rc = vos_iterate(&param, type, false, &anchors, inline_val_cb, NULL, val, arg->dth);
+	if (rc == -DER_NONEXIST || rc >= 0)
+		return 0;
+	if (rc == -DER_TX_RESTART)
+		return rc;
+
+	D_DEBUG(DB_IO, "Skip inline value of " DF_KEY ": " DF_RC "\n", DP_KEY(&key_ent->ie_key),
+		DP_RC(rc));
+	return 1;
+}
+
 static int
 fill_key(daos_handle_t ih, vos_iter_entry_t *key_ent, struct ds_obj_enum_arg *arg,
-	 vos_iter_type_t vos_type)
+	 vos_iter_type_t vos_type, vos_iter_param_t *param)
 {
-	d_iov_t		*iov;
-	daos_size_t	 total_size;
-	int		 type;
-	int		 kds_cap;
-	int		 rc;
+	struct inline_val	*val = NULL;
+	d_iov_t			*iov;
+	daos_size_t		 total_size;
+	int			 type;
+	int			 kds_cap;
+	int			 rc;
 
 	D_ASSERT(vos_type == VOS_ITER_DKEY || vos_type == VOS_ITER_AKEY);
 
@@ -226,6 +322,22 @@ fill_key(daos_handle_t ih, vos_iter_entry_t *key_ent, struct ds_obj_enum_arg *ar
 	    key_ent->ie_obj_punch != 0 && !arg->obj_punched)
 		kds_cap--;                  /* extra kds for obj punch eph */
 
+	if (type == OBJ_ITER_DKEY && arg->inline_akey.iov_len != 0 && !arg->size_query) {
+		D_ALLOC_PTR(val);
+		if (val == NULL)
+			return -DER_NOMEM;
+
+		rc = fetch_inline_val(param, key_ent, arg, val);
+		if (rc < 0)
+			D_GOTO(out, rc);
+		if (rc == 0) {
+			total_size += val->iv_len;
+			kds_cap--;          /* extra kds for the value */
+		} else {
+			D_FREE(val);
+		}
+	}
+
 	if (arg->size_query) {
 		arg->kds_len++;
 		arg->kds[0].kd_key_len += total_size;
@@ -243,9 +355,9 @@ fill_key(daos_handle_t ih, vos_iter_entry_t *key_ent, struct ds_obj_enum_arg *ar
 		    (arg->chk_key2big && arg->kds_len <= 2)) {
 			if (arg->kds[0].kd_key_len < total_size)
 				arg->kds[0].kd_key_len = total_size;
-			return -DER_KEY2BIG;
+			D_GOTO(out, rc = -DER_KEY2BIG);
 		} else {
-			return 1;
+			D_GOTO(out, rc = 1);
 		}
 	}
 
@@ -272,11 +384,21 @@ fill_key(daos_handle_t ih, vos_iter_entry_t *key_ent, struct ds_obj_enum_arg *ar
 	arg->kds[arg->kds_len].kd_val_type = type;
 	rc = fill_key_csum(key_ent, arg);
 	if (rc != 0)
-		return rc;
+		goto out;
 	arg->kds_len++;
 
 	daos_iov_append(iov, key_ent->ie_key.iov_buf, key_ent->ie_key.iov_len);
 
+	if (val != NULL) {
+		arg->kds[arg->kds_len].kd_key_len = val->iv_len;
+		arg->kds[arg->kds_len].kd_val_type = OBJ_ITER_INLINE_VAL;
+		arg->kds_len++;
+
+		D_ASSERT(iov->iov_len + val->iv_len <= iov->iov_buf_len);
+		memcpy(iov->iov_buf + iov->iov_len, val->iv_buf, val->iv_len);
+		iov->iov_len += val->iv_len;
+	}
+
 	if (key_ent->ie_punch != 0 && arg->need_punch) {
 		int pi_size = sizeof(key_ent->ie_punch);
 
@@ -300,7 +422,9 @@ fill_key(daos_handle_t ih, vos_iter_entry_t *key_ent, struct ds_obj_enum_arg *ar
 		DF_U64" punched eph num "DF_U64"\n", DP_KEY(&key_ent->ie_key),
 		iov->iov_len, arg->kds_len - 1, key_ent->ie_epoch,
 		key_ent->ie_punch);
-	return 0;
+out:
+	D_FREE(val);
+	return rc;
 }
 
 static bool
@@ -741,7 +865,7 @@ enum_pack_cb(daos_handle_t ih, vos_iter_entry_t *entry, vos_iter_type_t type,
 		break;
 	case VOS_ITER_DKEY:
 	case VOS_ITER_AKEY:
-		rc = fill_key(ih, entry, cb_arg, type);
+		rc = fill_key(ih, entry, cb_arg, type, param);
 		break;
 	case VOS_ITER_SINGLE:
 	case VOS_ITER_RECX:
@@ -786,6 +910,7 @@ ds_obj_enum_pack(vos_iter_param_t *param, vos_iter_type_t type, bool recursive,
 	D_ASSERT(!arg->fill_recxs ||
 		 type == VOS_ITER_SINGLE || type == VOS_ITER_RECX);
 
+	arg->dth = dth;
 	rc = iter_cb(param, type, recursive, anchors, enum_pack_cb, NULL,
 		     arg, dth);
 
@@ -81,6 +81,26 @@ static struct daos_rpc_handler obj_handlers_v10[] = {
 
 #undef X
 
+/**
+ * Attach a log-linear histogram to each per-I/O size latency sensor so that
+ * tail latencies (p99 and above) can be read back from telemetry.
+ */
+static void
+obj_latency_hdr_init(struct d_tm_node_t **tm)
+{
+	int	i;
+	int	rc;
+
+	for (i = 0; i < NR_LATENCY_BUCKETS; i++) {
+		if (tm[i] == NULL)
+			continue;
+
+		rc = d_tm_init_hdr_histogram(tm[i], D_TM_HDR_SUB_BITS);
+		if (rc)
+			D_WARN("Failed to create latency histogram: " DF_RC "\n", DP_RC(rc));
+	}
+}
+
 static void *
 obj_tls_init(int tags, int xs_id, int tgt_id)
 {
@@ -154,6 +174,13 @@ obj_tls_init(int tags, int xs_id, int tgt_id)
 	obj_latency_tm_init(DAOS_OBJ_RPC_FETCH, tgt_id, tls->ot_fetch_bio_lat, "bio_fetch",
 			    "BIO fetch processing time", true);
 
+	/** Tail latency for the client-facing RPCs and the underlying BIO I/O */
+	obj_latency_hdr_init(tls->ot_update_lat);
+	obj_latency_hdr_init(tls->ot_fetch_lat);
+	obj_latency_hdr_init(tls->ot_tgt_update_lat);
+	obj_latency_hdr_init(tls->ot_update_bio_lat);
+	obj_latency_hdr_init(tls->ot_fetch_bio_lat);
+
 	return tls;
 }
 
@@ -211,6 +238,9 @@ obj_get_req_attr(crt_rpc_t *rpc, struct sched_req_attr *attr)
 		else
 			type = SCHED_REQ_FETCH;
 		sched_req_attr_init(attr, type, &orw->orw_pool_uuid);
+		/* Small fetch replies inline, without bulk transfer. */
+		if (type == SCHED_REQ_FETCH && orw->orw_bulks.ca_count == 0)
+			attr->sra_flags |= SCHED_REQ_FL_LATENCY;
 		break;
 	}
 	case DAOS_OBJ_RPC_MIGRATE: {
@@ -3217,6 +3217,14 @@ obj_local_enum(struct obj_io_context *ioc, crt_rpc_t *rpc,
 		enum_arg->fill_recxs = true;
 	} else if (opc == DAOS_OBJ_DKEY_RPC_ENUMERATE) {
 		type = VOS_ITER_DKEY;
+		if (oei->oei_flags & ORF_ENUM_INLINE_AKEY) {
+			if (oei->oei_akey.iov_len == 0 ||
+			    (oei->oei_rec_type != DAOS_IOD_SINGLE &&
+			     oei->oei_rec_type != DAOS_IOD_ARRAY))
+				D_GOTO(failed, rc = -DER_PROTO);
+			enum_arg->inline_akey = oei->oei_akey;
+			enum_arg->inline_type = oei->oei_rec_type;
+		}
 	} else if (opc == DAOS_OBJ_AKEY_RPC_ENUMERATE) {
 		type = VOS_ITER_AKEY;
 	} else {
@@ -3438,20 +3446,26 @@ ds_obj_enum_handler(crt_rpc_t *rpc)
 		enum_arg.recxs_cap = oei->oei_nr;
 		enum_arg.recxs_len = 0;
 	} else {
+		uint32_t	kds_nr = oei->oei_nr;
+
 		rc = daos_sgls_alloc(&oeo->oeo_sgl, &oei->oei_sgl, 1);
 		if (rc != 0)
 			D_GOTO(out, rc);
 		enum_arg.sgl = &oeo->oeo_sgl;
 		enum_arg.sgl_idx = 0;
 
+		/* oei_nr counts the dkeys, each one may be followed by its inline value. */
+		if (opc == DAOS_OBJ_DKEY_RPC_ENUMERATE && oei->oei_flags & ORF_ENUM_INLINE_AKEY)
+			kds_nr *= 2;
+
 		/* Prepare key descriptor buffer */
 		oeo->oeo_kds.ca_count = 0;
 		D_ALLOC(oeo->oeo_kds.ca_arrays,
-			oei->oei_nr * sizeof(daos_key_desc_t));
+			kds_nr * sizeof(daos_key_desc_t));
 		if (oeo->oeo_kds.ca_arrays == NULL)
 			D_GOTO(out, rc = -DER_NOMEM);
 		enum_arg.kds = oeo->oeo_kds.ca_arrays;
-		enum_arg.kds_cap = oei->oei_nr;
+		enum_arg.kds_cap = kds_nr;
 		enum_arg.kds_len = 0;
 	}
 
@@ -80,3 +80,47 @@ DEFINE_AGGR_FUNC_MAX(d)
 DEFINE_AGGR_FUNC_MIN(u)
 DEFINE_AGGR_FUNC_MIN(i)
 DEFINE_AGGR_FUNC_MIN(d)
+
+/**
+ * Batch (columnar) versions of SUM(), MAX(), and MIN(). They fold the \a nr values of a column
+ * into the aggregation value, skipping the records whose \a sel entry is zero. Records are folded
+ * in order, so the result is the same as the one of the per-record functions above.
+ */
+
+#define DEFINE_AGGR_BATCH_SUM(type, ctype)                                                         \
+	void aggr_batch_sum_##type(const void *col, const uint8_t *sel, uint32_t nr,             \
+				   double *aggr)                                                   \
+	{                                                                                          \
+		const _##ctype *v   = col;                                                         \
+		double          sum = *aggr;                                                       \
+		uint32_t        i;                                                                 \
+		for (i = 0; i < nr; i++)                                                           \
+			sum += sel[i] ? (double)v[i] : 0.0;                                        \
+		*aggr = sum;                                                                       \
+	}
+
+DEFINE_AGGR_BATCH_SUM(u, uint64_t)
+DEFINE_AGGR_BATCH_SUM(i, int64_t)
+DEFINE_AGGR_BATCH_SUM(d, double)
+
+#define DEFINE_AGGR_BATCH_CMP(name, cop, type, ctype)                                              \
+	void aggr_batch_##name##_##type(const void *col, const uint8_t *sel, uint32_t nr,        \
+					double *aggr)                                              \
+	{                                                                                          \
+		const _##ctype *v   = col;                                                         \
+		double          res = *aggr;                                                       \
+		double          val;                                                               \
+		uint32_t        i;                                                                 \
+		for (i = 0; i < nr; i++) {                                                         \
+			val = (double)v[i];                                                        \
+			res = (sel[i] && val cop res) ? val : res;                                 \
+		}                                                                                  \
+		*aggr = res;                                                                       \
+	}
+
+DEFINE_AGGR_BATCH_CMP(max, >, u, uint64_t)
+DEFINE_AGGR_BATCH_CMP(max, >, i, int64_t)
+DEFINE_AGGR_BATCH_CMP(max, >, d, double)
+DEFINE_AGGR_BATCH_CMP(min, <, u, uint64_t)
+DEFINE_AGGR_BATCH_CMP(min, <, i, int64_t)
+DEFINE_AGGR_BATCH_CMP(min, <, d, double)
@@ -0,0 +1,399 @@
+/**
+ * (C) Copyright 2025 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+
+#define D_LOGFAC DD_FAC(pipeline)
+
+#include <daos/common.h>
+#include "pipeline_internal.h"
+
+/**
+ * Batch (columnar) evaluation of compiled filters and aggregations.
+ *
+ * Instead of walking the filter tree once per record, the tree is walked once per batch of
+ * records. Every node produces a mask with one entry per record. Comparisons between numeric
+ * akeys, dkeys, and constants extract their operands into columns and run the SIMD friendly
+ * kernels from filter_funcs.c; AND, OR, and NOT combine the masks of their children. Any other
+ * node (string comparisons, LIKE, arithmetic, ...) falls back to its per-record function, but
+ * only for the records that can still change the result, so errors such as a division by zero
+ * are raised for the same records as in the per-record mode.
+ */
+
+enum batch_type {
+	BATCH_TYPE_U,
+	BATCH_TYPE_I,
+	BATCH_TYPE_D,
+	BATCH_TYPE_NONE,
+};
+
+struct batch_cmp_desc {
+	filter_func_t		*func;
+	filter_batch_cmp_t	*kernel;
+	enum batch_type		 type;
+};
+
+#define BATCH_CMP_DESC(op)                                                                         \
+	{filter_func_##op##_u, filter_batch_##op##_u, BATCH_TYPE_U},                               \
+	{filter_func_##op##_i, filter_batch_##op##_i, BATCH_TYPE_I},                               \
+	{filter_func_##op##_d, filter_batch_##op##_d, BATCH_TYPE_D}
+
+static struct batch_cmp_desc batch_cmps[] = {
+	BATCH_CMP_DESC(eq), BATCH_CMP_DESC(ne), BATCH_CMP_DESC(lt),
+	BATCH_CMP_DESC(le), BATCH_CMP_DESC(ge), BATCH_CMP_DESC(gt),
+};
+
+struct batch_aggr_desc {
+	filter_func_t		*func;
+	aggr_batch_func_t	*kernel;
+	enum batch_type		 type;
+};
+
+#define BATCH_AGGR_DESC(name)                                                                      \
+	{aggr_func_##name##_u, aggr_batch_##name##_u, BATCH_TYPE_U},                               \
+	{aggr_func_##name##_i, aggr_batch_##name##_i, BATCH_TYPE_I},                               \
+	{aggr_func_##name##_d, aggr_batch_##name##_d, BATCH_TYPE_D}
+
+static struct batch_aggr_desc batch_aggrs[] = {
+	BATCH_AGGR_DESC(sum), BATCH_AGGR_DESC(max), BATCH_AGGR_DESC(min),
+};
+
+struct batch_leaf_desc {
+	filter_func_t		*func;
+	enum batch_type		 type;
+};
+
+#define BATCH_LEAF_DESC(src)                                                                       \
+	{getdata_func_##src##_u1, BATCH_TYPE_U}, {getdata_func_##src##_u2, BATCH_TYPE_U},          \
+	{getdata_func_##src##_u4, BATCH_TYPE_U}, {getdata_func_##src##_u8, BATCH_TYPE_U},          \
+	{getdata_func_##src##_i1, BATCH_TYPE_I}, {getdata_func_##src##_i2, BATCH_TYPE_I},          \
+	{getdata_func_##src##_i4, BATCH_TYPE_I}, {getdata_func_##src##_i8, BATCH_TYPE_I},          \
+	{getdata_func_##src##_r4, BATCH_TYPE_D}, {getdata_func_##src##_r8, BATCH_TYPE_D}
+
+static struct batch_leaf_desc batch_leaves[] = {
+	BATCH_LEAF_DESC(dkey), BATCH_LEAF_DESC(akey), BATCH_LEAF_DESC(const),
+};
+
+static enum batch_type
+batch_leaf_type(struct filter_part_compiled_t *part)
+{
+	uint32_t i;
+
+	if (part->num_operands != 0)
+		return BATCH_TYPE_NONE;
+
+	for (i = 0; i < ARRAY_SIZE(batch_leaves); i++) {
+		if (batch_leaves[i].func == part->filter_func)
+			return batch_leaves[i].type;
+	}
+	return BATCH_TYPE_NONE;
+}
+
+static inline uint64_t *
+batch_col(struct pipeline_batch_t *batch, uint32_t idx)
+{
+	return &batch->cols[(size_t)idx * batch->max];
+}
+
+static inline uint8_t *
+batch_null(struct pipeline_batch_t *batch, uint32_t idx)
+{
+	return &batch->nulls[(size_t)idx * batch->max];
+}
+
+static inline uint8_t *
+batch_mask(struct pipeline_batch_t *batch, uint32_t idx)
+{
+	return &batch->masks[(size_t)idx * batch->max];
+}
+
+static inline uint8_t *
+batch_aux(struct pipeline_batch_t *batch, uint32_t idx)
+{
+	return &batch->aux[(size_t)idx * batch->max];
+}
+
+static inline void
+batch_set_record(struct filter_part_run_t *args, struct pipeline_batch_t *batch, uint32_t rec)
+{
+	args->dkey  = &batch->recs[rec].dkey;
+	args->iods  = batch->recs[rec].iods;
+	args->akeys = batch->recs[rec].akeys;
+}
+
+/** index of the last part of the subtree rooted at \a idx */
+static inline uint32_t
+batch_subtree_end(struct filter_part_compiled_t *parts, uint32_t idx)
+{
+	return parts[idx].num_operands == 0 ? idx : parts[idx].idx_end_subtree;
+}
+
+/** Extract the values of leaf \a idx for all the records of the batch into its column slot. */
+static void
+batch_extract(struct filter_part_run_t *args, struct pipeline_batch_t *batch, uint32_t idx,
+	      enum batch_type type)
+{
+	uint64_t *col_u = batch_col(batch, idx);
+	int64_t  *col_i = (int64_t *)col_u;
+	double   *col_d = (double *)col_u;
+	uint8_t  *null  = batch_null(batch, idx);
+	uint32_t  i;
+
+	for (i = 0; i < batch->nr; i++) {
+		batch_set_record(args, batch, i);
+		args->part_idx = idx;
+		args->data_out = NULL;
+		/** getdata functions never fail */
+		args->parts[idx].filter_func(args);
+		null[i] = (args->data_out == NULL);
+		switch (type) {
+		case BATCH_TYPE_U:
+			col_u[i] = args->value_u_out;
+			break;
+		case BATCH_TYPE_I:
+			col_i[i] = args->value_i_out;
+			break;
+		default:
+			col_d[i] = args->value_d_out;
+			break;
+		}
+	}
+}
+
+static struct batch_cmp_desc *
+batch_cmp_lookup(struct filter_part_compiled_t *parts, uint32_t idx)
+{
+	struct batch_cmp_desc *desc = NULL;
+	uint32_t               i;
+
+	for (i = 0; i < ARRAY_SIZE(batch_cmps); i++) {
+		if (batch_cmps[i].func == parts[idx].filter_func) {
+			desc = &batch_cmps[i];
+			break;
+		}
+	}
+	if (desc == NULL)
+		return NULL;
+
+	/** all the operands have to be numeric leaves of the comparison type */
+	for (i = 1; i <= parts[idx].num_operands; i++) {
+		if (batch_leaf_type(&parts[idx + i]) != desc->type)
+			return NULL;
+	}
+	return desc;
+}
+
+/**
+ * Columnar comparison: left operand against each right operand, true if any of them matches.
+ * Like in the per-record functions, a missing left value fails the comparison, and a missing
+ * right value stops looking at the following ones.
+ */
+static void
+batch_eval_cmp(struct filter_part_run_t *args, struct pipeline_batch_t *batch, uint32_t idx,
+	       struct batch_cmp_desc *desc)
+{
+	struct filter_part_compiled_t *parts = args->parts;
+	uint8_t                       *out   = batch_mask(batch, idx);
+	uint8_t                       *alive = batch_aux(batch, idx);
+	uint8_t                       *lnull;
+	uint8_t                       *rnull;
+	uint8_t                       *cmp;
+	uint32_t                       lidx  = idx + 1;
+	uint32_t                       ridx;
+	uint32_t                       i;
+
+	batch_extract(args, batch, lidx, desc->type);
+	lnull = batch_null(batch, lidx);
+	for (i = 0; i < batch->nr; i++) {
+		alive[i] = !lnull[i];
+		out[i]   = 0;
+	}
+
+	for (ridx = lidx + 1; ridx <= idx + parts[idx].num_operands; ridx++) {
+		batch_extract(args, batch, ridx, desc->type);
+		rnull = batch_null(batch, ridx);
+		cmp   = batch_mask(batch, ridx);
+		desc->kernel(batch_col(batch, lidx), batch_col(batch, ridx), cmp, batch->nr);
+		for (i = 0; i < batch->nr; i++) {
+			alive[i] &= !rnull[i];
+			out[i] |= alive[i] & cmp[i];
+		}
+	}
+}
+
+/** Per-record evaluation of the subtree rooted at \a idx, for the active records only. */
+static int
+batch_eval_fallback(struct filter_part_run_t *args, struct pipeline_batch_t *batch, uint32_t idx,
+		    const uint8_t *active)
+{
+	uint8_t  *out = batch_mask(batch, idx);
+	uint32_t  i;
+	int       rc;
+
+	for (i = 0; i < batch->nr; i++) {
+		out[i] = 0;
+		if (!active[i])
+			continue;
+
+		batch_set_record(args, batch, i);
+		args->part_idx = idx;
+		rc             = args->parts[idx].filter_func(args);
+		if (rc < 0)
+			return rc;
+		out[i] = (rc == 0 && args->log_out);
+	}
+	return 0;
+}
+
+/**
+ * Evaluate the subtree rooted at \a idx over the batch. The result is stored in the mask slot of
+ * \a idx. Entries of records not set in \a active are undefined.
+ */
+static int
+batch_eval(struct filter_part_run_t *args, struct pipeline_batch_t *batch, uint32_t idx,
+	   const uint8_t *active)
+{
+	struct filter_part_compiled_t *parts = args->parts;
+	struct batch_cmp_desc         *desc;
+	uint8_t                       *out   = batch_mask(batch, idx);
+	uint8_t                       *act   = batch_aux(batch, idx);
+	uint8_t                       *res;
+	uint32_t                       child = idx + 1;
+	uint32_t                       i;
+	uint32_t                       j;
+	int                            rc;
+
+	if (parts[idx].filter_func == filter_func_and) {
+		memcpy(out, active, batch->nr);
+		for (j = 0; j < parts[idx].num_operands; j++) {
+			rc = batch_eval(args, batch, child, out);
+			if (rc != 0)
+				return rc;
+			res = batch_mask(batch, child);
+			for (i = 0; i < batch->nr; i++)
+				out[i] &= res[i];
+			child = batch_subtree_end(parts, child) + 1;
+		}
+		return 0;
+	}
+
+	if (parts[idx].filter_func == filter_func_or) {
+		memset(out, 0, batch->nr);
+		for (j = 0; j < parts[idx].num_operands; j++) {
+			for (i = 0; i < batch->nr; i++)
+				act[i] = active[i] & !out[i];
+			rc = batch_eval(args, batch, child, act);
+			if (rc != 0)
+				return rc;
+			res = batch_mask(batch, child);
+			for (i = 0; i < batch->nr; i++)
+				out[i] |= act[i] & res[i];
+			child = batch_subtree_end(parts, child) + 1;
+		}
+		return 0;
+	}
+
+	if (parts[idx].filter_func == filter_func_not) {
+		rc = batch_eval(args, batch, child, active);
+		if (rc != 0)
+			return rc;
+		res = batch_mask(batch, child);
+		for (i = 0; i < batch->nr; i++)
+			out[i] = active[i] & !res[i];
+		return 0;
+	}
+
+	desc = batch_cmp_lookup(parts, idx);
+	if (desc != NULL) {
+		batch_eval_cmp(args, batch, idx, desc);
+		return 0;
+	}
+
+	return batch_eval_fallback(args, batch, idx, active);
+}
+
+/**
+ * Columnar counterpart of pipeline_filters(): on return, batch->sel[i] is set iff record i of
+ * the batch passes all the filters of the pipeline.
+ */
+int
+pipeline_filters_batch(struct pipeline_compiled_t *pipe, struct filter_part_run_t *args,
+		       struct pipeline_batch_t *batch)
+{
+	uint8_t  *res;
+	uint32_t  i;
+	uint32_t  j;
+	int       rc;
+
+	memset(batch->sel, 1, batch->nr);
+
+	for (i = 0; i < pipe->num_filters; i++) {
+		D_ASSERT(pipe->filters[i].num_parts <= batch->max_parts);
+		args->parts = pipe->filters[i].parts;
+
+		rc = batch_eval(args, batch, 0, batch->sel);
+		if (rc != 0)
+			return rc;
+
+		res = batch_mask(batch, 0);
+		for (j = 0; j < batch->nr; j++)
+			batch->sel[j] &= res[j];
+	}
+	return 0;
+}
+
+/**
+ * Columnar counterpart of pipeline_aggregations(), folding all the records selected in
+ * batch->sel into the aggregation values.
+ */
+int
+pipeline_aggregations_batch(struct pipeline_compiled_t *pipe, struct filter_part_run_t *args,
+			    struct pipeline_batch_t *batch, d_sg_list_t *sgl_agg)
+{
+	struct filter_part_compiled_t *parts;
+	struct batch_aggr_desc        *desc;
+	uint8_t                       *null;
+	uint8_t                       *sel;
+	uint32_t                       i;
+	uint32_t                       j;
+	int                            rc;
+
+	for (i = 0; i < pipe->num_aggr_filters; i++) {
+		D_ASSERT(pipe->aggr_filters[i].num_parts <= batch->max_parts);
+		parts          = pipe->aggr_filters[i].parts;
+		args->parts    = parts;
+		args->iov_aggr = &sgl_agg->sg_iovs[i];
+
+		desc = NULL;
+		for (j = 0; j < ARRAY_SIZE(batch_aggrs); j++) {
+			if (batch_aggrs[j].func == parts[0].filter_func) {
+				desc = &batch_aggrs[j];
+				break;
+			}
+		}
+
+		if (desc != NULL && batch_leaf_type(&parts[1]) == desc->type) {
+			batch_extract(args, batch, 1, desc->type);
+			null = batch_null(batch, 1);
+			sel  = batch_mask(batch, 1);
+			for (j = 0; j < batch->nr; j++)
+				sel[j] = batch->sel[j] & !null[j];
+			desc->kernel(batch_col(batch, 1), sel, batch->nr,
+				     (double *)args->iov_aggr->iov_buf);
+			continue;
+		}
+
+		/** per-record fallback, e.g. for aggregations over arithmetic expressions */
+		for (j = 0; j < batch->nr; j++) {
+			if (!batch->sel[j])
+				continue;
+			batch_set_record(args, batch, j);
+			args->part_idx = 0;
+			rc             = parts[0].filter_func(args);
+			if (rc < 0)
+				return rc;
+		}
+	}
+	return 0;
+}
@@ -547,3 +547,32 @@ exit:
 	args->log_out = res;
 	return 0;
 }
+
+/**
+ * Batch (columnar) comparison kernels. They compare \a nr left values against \a nr right values
+ * and set out[i] to 1 where the comparison holds. The loops are branch free, so the compiler turns
+ * them into SIMD code.
+ */
+
+#define DEFINE_FILTER_BATCH_CMP(op, cop, type, ctype)                                             \
+	void filter_batch_##op##_##type(const void *left, const void *right, uint8_t *out,         \
+					uint32_t nr)                                               \
+	{                                                                                          \
+		const _##ctype *l = left;                                                          \
+		const _##ctype *r = right;                                                         \
+		uint32_t        i;                                                                 \
+		for (i = 0; i < nr; i++)                                                           \
+			out[i] = l[i] cop r[i];                                                    \
+	}
+
+#define DEFINE_FILTER_BATCH_CMPS(type, ctype)                                                      \
+	DEFINE_FILTER_BATCH_CMP(eq, ==, type, ctype)                                               \
+	DEFINE_FILTER_BATCH_CMP(ne, !=, type, ctype)                                               \
+	DEFINE_FILTER_BATCH_CMP(lt, <, type, ctype)                                                \
+	DEFINE_FILTER_BATCH_CMP(le, <=, type, ctype)                                               \
+	DEFINE_FILTER_BATCH_CMP(ge, >=, type, ctype)                                               \
+	DEFINE_FILTER_BATCH_CMP(gt, >, type, ctype)
+
+DEFINE_FILTER_BATCH_CMPS(u, uint64_t)
+DEFINE_FILTER_BATCH_CMPS(i, int64_t)
+DEFINE_FILTER_BATCH_CMPS(d, double)
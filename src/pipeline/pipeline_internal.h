@@ -50,6 +50,36 @@ struct pipeline_compiled_t {
 	struct filter_compiled_t	*aggr_filters;
 };
 
+/** Default and maximum number of records evaluated together in batch (columnar) mode. */
+#define PIPELINE_BATCH_DEF	64
+#define PIPELINE_BATCH_MAX	1024
+
+/** One record fetched into a batch. */
+struct pipeline_record_t {
+	d_iov_t				dkey;
+	daos_iod_t			*iods;
+	d_sg_list_t			*akeys;
+};
+
+/**
+ * A batch of records, with scratch space for the columnar evaluation. Each compiled filter part
+ * owns one slot (of \a max entries) in \a cols, \a nulls, \a masks, and \a aux.
+ */
+struct pipeline_batch_t {
+	uint32_t			nr;
+	uint32_t			max;
+	struct pipeline_record_t	*recs;
+	uint32_t			max_parts;
+	uint64_t			*cols;
+	uint8_t				*nulls;
+	uint8_t				*masks;
+	uint8_t				*aux;
+	/** records of the batch passing all the filters */
+	uint8_t				*sel;
+};
+
+extern unsigned int pipeline_batch_nr;
+
 typedef struct {
 	uint32_t	nr;
 	daos_iod_t	*iods;
@@ -71,6 +101,12 @@ void pipeline_aggregations_fixavgs(daos_pipeline_t *pipeline, double total, d_sg
 
 int pipeline_compile(daos_pipeline_t *pipe, struct pipeline_compiled_t *comp_pipe);
 
+int pipeline_filters_batch(struct pipeline_compiled_t *pipe, struct filter_part_run_t *args,
+			   struct pipeline_batch_t *batch);
+
+int pipeline_aggregations_batch(struct pipeline_compiled_t *pipe, struct filter_part_run_t *args,
+				struct pipeline_batch_t *batch, d_sg_list_t *sgl_agg);
+
 void pipeline_compile_free(struct pipeline_compiled_t *comp_pipe);
 
 typedef uint8_t _uint8_t;
@@ -152,6 +188,33 @@ filter_func_t filter_func_not;
 filter_func_t filter_func_and;
 filter_func_t filter_func_or;
 
+typedef void filter_batch_cmp_t(const void *left, const void *right, uint8_t *out, uint32_t nr);
+typedef void aggr_batch_func_t(const void *col, const uint8_t *sel, uint32_t nr, double *aggr);
+
+#define DECLARE_FILTER_BATCH_CMPS(op)                                                              \
+	filter_batch_cmp_t filter_batch_##op##_u;                                                  \
+	filter_batch_cmp_t filter_batch_##op##_i;                                                  \
+	filter_batch_cmp_t filter_batch_##op##_d;
+
+DECLARE_FILTER_BATCH_CMPS(eq)
+DECLARE_FILTER_BATCH_CMPS(ne)
+DECLARE_FILTER_BATCH_CMPS(lt)
+DECLARE_FILTER_BATCH_CMPS(le)
+DECLARE_FILTER_BATCH_CMPS(ge)
+DECLARE_FILTER_BATCH_CMPS(gt)
+
+aggr_batch_func_t aggr_batch_sum_u;
+aggr_batch_func_t aggr_batch_sum_i;
+aggr_batch_func_t aggr_batch_sum_d;
+
+aggr_batch_func_t aggr_batch_max_u;
+aggr_batch_func_t aggr_batch_max_i;
+aggr_batch_func_t aggr_batch_max_d;
+
+aggr_batch_func_t aggr_batch_min_u;
+aggr_batch_func_t aggr_batch_min_i;
+aggr_batch_func_t aggr_batch_min_d;
+
 filter_func_t getdata_func_dkey_u1;
 filter_func_t getdata_func_dkey_u2;
 filter_func_t getdata_func_dkey_u4;
@@ -9,10 +9,19 @@
 #include <daos_srv/daos_engine.h>
 #include <daos/rpc.h>
 #include "pipeline_rpc.h"
+#include "pipeline_internal.h"
+
+/** Number of records filtered together in batch mode, 0 or 1 to filter one record at a time */
+unsigned int pipeline_batch_nr = PIPELINE_BATCH_DEF;
 
 static int
 pipeline_mod_init(void)
 {
+	d_getenv_uint("DAOS_PIPELINE_BATCH", &pipeline_batch_nr);
+	if (pipeline_batch_nr > PIPELINE_BATCH_MAX)
+		pipeline_batch_nr = PIPELINE_BATCH_MAX;
+	D_INFO("Pipeline batch size %u\n", pipeline_batch_nr);
+
 	return 0;
 }
 
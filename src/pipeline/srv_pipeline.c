@@ -259,6 +259,90 @@ free_iter_bufs(uint32_t nr, daos_iod_t *iods_iter, d_sg_list_t *sgl_recx_iter)
 		D_FREE(iods_iter);
 }
 
+static void
+free_batch(struct pipeline_batch_t *batch, uint32_t nr_iods)
+{
+	uint32_t i;
+
+	if (batch->recs != NULL) {
+		for (i = 0; i < batch->max; i++) {
+			free_iter_bufs(nr_iods, batch->recs[i].iods, batch->recs[i].akeys);
+			D_FREE(batch->recs[i].dkey.iov_buf);
+		}
+		D_FREE(batch->recs);
+	}
+	D_FREE(batch->cols);
+	D_FREE(batch->nulls);
+	D_FREE(batch->masks);
+	D_FREE(batch->aux);
+	D_FREE(batch->sel);
+}
+
+static uint32_t
+max_compiled_parts(struct pipeline_compiled_t *pipe)
+{
+	uint32_t nr = 1;
+	uint32_t i;
+
+	for (i = 0; i < pipe->num_filters; i++)
+		nr = max(nr, pipe->filters[i].num_parts);
+	for (i = 0; i < pipe->num_aggr_filters; i++)
+		nr = max(nr, pipe->aggr_filters[i].num_parts);
+	return nr;
+}
+
+static int
+alloc_batch(struct pipeline_compiled_t *pipe, daos_iod_t *iods, uint32_t nr_iods, uint32_t nr,
+	    struct pipeline_batch_t *batch)
+{
+	size_t   slots;
+	uint32_t i;
+	int      rc;
+
+	*batch           = (struct pipeline_batch_t){0};
+	batch->max       = nr;
+	batch->max_parts = max_compiled_parts(pipe);
+	slots            = (size_t)batch->max_parts * nr;
+
+	D_ALLOC_ARRAY(batch->recs, nr);
+	D_ALLOC_ARRAY(batch->cols, slots);
+	D_ALLOC_ARRAY(batch->nulls, slots);
+	D_ALLOC_ARRAY(batch->masks, slots);
+	D_ALLOC_ARRAY(batch->aux, slots);
+	D_ALLOC_ARRAY(batch->sel, nr);
+	if (batch->recs == NULL || batch->cols == NULL || batch->nulls == NULL ||
+	    batch->masks == NULL || batch->aux == NULL || batch->sel == NULL)
+		D_GOTO(error, rc = -DER_NOMEM);
+
+	for (i = 0; i < nr; i++) {
+		rc = alloc_iter_bufs(iods, nr_iods, &batch->recs[i].iods, &batch->recs[i].akeys);
+		if (rc != 0)
+			D_GOTO(error, rc);
+	}
+	return 0;
+error:
+	free_batch(batch, nr_iods);
+	return rc;
+}
+
+/** dkeys returned by the iterator are only valid until the ULT yields, keep a copy */
+static int
+batch_copy_dkey(struct pipeline_record_t *rec, d_iov_t *dkey)
+{
+	void *buf;
+
+	if (dkey->iov_len > rec->dkey.iov_buf_len) {
+		D_REALLOC(buf, rec->dkey.iov_buf, rec->dkey.iov_buf_len, dkey->iov_len);
+		if (buf == NULL)
+			return -DER_NOMEM;
+		rec->dkey.iov_buf     = buf;
+		rec->dkey.iov_buf_len = dkey->iov_len;
+	}
+	memcpy(rec->dkey.iov_buf, dkey->iov_buf, dkey->iov_len);
+	rec->dkey.iov_len = dkey->iov_len;
+	return 0;
+}
+
 static int
 pack_value(d_sg_list_t *sgl, uint32_t *iov_idx, d_iov_t *iov)
 {
@@ -342,6 +426,123 @@ pack_record(d_iov_t *d_key_iter, daos_iod_t *iods_iter, d_sg_list_t *sgl_recx_it
 	return 0;
 }
 
+/**
+ * Batch (columnar) mode of the main loop of ds_pipeline_run(): records are fetched in batches,
+ * and filters and aggregations are evaluated over the whole batch (see filter_batch.c). Since
+ * the batch may read past the last record that has to be returned, the anchor of every record is
+ * kept so that the scan can be resumed right after the last record actually consumed.
+ */
+static int
+pipeline_run_batch(daos_handle_t vos_coh, daos_unit_oid_t oid, daos_pipeline_t *pipeline,
+		   struct pipeline_compiled_t *pipeline_compiled, daos_epoch_range_t epr,
+		   daos_iod_t *iods, uint32_t nr_iods, uint32_t nr_kds, uint32_t batch_nr,
+		   struct vos_iter_anchors *anchors, uint32_t *nr_kds_pass,
+		   struct pack_ret_data_args *pack_args, d_sg_list_t *sgl_agg,
+		   daos_pipeline_stats_t *stats)
+{
+	struct pipeline_batch_t   batch         = {0};
+	struct filter_part_run_t  pipe_run_args = {0};
+	struct enum_credits       credits       = {0};
+	struct pipeline_record_t *rec;
+	daos_anchor_t            *rec_anchors   = NULL;
+	d_iov_t                   d_key_iter;
+	bool                      done          = false;
+	uint32_t                  i;
+	int                       rc;
+
+	if (nr_kds == 0 && pipeline->num_aggr_filters == 0)
+		return 0; /** nothing to return */
+
+	rc = alloc_batch(pipeline_compiled, iods, nr_iods, batch_nr, &batch);
+	if (rc != 0)
+		return rc;
+	D_ALLOC_ARRAY(rec_anchors, batch_nr);
+	if (rec_anchors == NULL)
+		D_GOTO(exit, rc = -DER_NOMEM);
+
+	pipe_run_args.nr_iods = nr_iods;
+	credits.max           = PIPELINE_ITERATION_MAX;
+
+	while (!done && !daos_anchor_is_eof(&anchors->ia_dkey)) {
+		if (pipeline->num_aggr_filters == 0 && *nr_kds_pass == nr_kds)
+			break; /** all records read */
+
+		/** -- fetching a batch of records */
+
+		batch.nr = 0;
+		while (batch.nr < batch.max && !daos_anchor_is_eof(&anchors->ia_dkey)) {
+			rec = &batch.recs[batch.nr];
+			rc  = pipeline_fetch_record(vos_coh, oid, anchors, epr, rec->iods, nr_iods,
+						    &d_key_iter, rec->akeys);
+			if (rc < 0)
+				D_GOTO(exit, rc); /** error */
+			if (rc == 1)
+				continue; /** nothing returned; no more records? */
+
+			rc = batch_copy_dkey(rec, &d_key_iter);
+			if (rc != 0)
+				D_GOTO(exit, rc);
+			rec_anchors[batch.nr] = anchors->ia_dkey;
+			batch.nr++;
+
+			credits.used++;
+			if (credits.used > credits.max) {
+				/** we have used all the credit. Yielding... */
+				credits.used = 0;
+				dss_sleep(0); /** 0 msec will not sleep, just yield */
+			}
+		}
+		if (batch.nr == 0)
+			break;
+
+		/** -- filtering the whole batch */
+
+		rc = pipeline_filters_batch(pipeline_compiled, &pipe_run_args, &batch);
+		if (rc < 0)
+			D_GOTO(exit, rc);
+
+		/** -- returning matching records, stopping as the per-record loop would */
+
+		for (i = 0; i < batch.nr; i++) {
+			stats->nr_dkeys += 1;
+			if (!batch.sel[i])
+				continue;
+
+			(*nr_kds_pass)++;
+			if (nr_kds == 0 ||
+			    (nr_kds > 0 && pipeline->num_aggr_filters > 0 && *nr_kds_pass > 1))
+				continue;
+
+			rec = &batch.recs[i];
+			rc  = pack_record(&rec->dkey, rec->iods, rec->akeys, *nr_kds_pass - 1,
+					  pack_args);
+			if (rc != 0)
+				D_GOTO(exit, rc);
+
+			if (pipeline->num_aggr_filters == 0 && *nr_kds_pass == nr_kds) {
+				/** all records read, resume after this one next time */
+				anchors->ia_dkey = rec_anchors[i];
+				done             = true;
+				break;
+			}
+		}
+
+		/** -- aggregations (never stop early, see above) */
+
+		if (pipeline->num_aggr_filters > 0) {
+			rc = pipeline_aggregations_batch(pipeline_compiled, &pipe_run_args, &batch,
+							 sgl_agg);
+			if (rc < 0)
+				D_GOTO(exit, rc);
+		}
+	}
+	rc = 0;
+exit:
+	D_FREE(rec_anchors);
+	free_batch(&batch, nr_iods);
+	return rc;
+}
+
 /** TODO: This code still assumes dkey==NULL. The code for dkey!=NULL has to be written */
 static int
 ds_pipeline_run(daos_handle_t vos_coh, daos_unit_oid_t oid, daos_pipeline_t pipeline,
@@ -361,6 +562,7 @@ ds_pipeline_run(daos_handle_t vos_coh, daos_unit_oid_t oid, daos_pipeline_t pipe
 	struct pipeline_compiled_t  pipeline_compiled  = {0};
 	struct filter_part_run_t    pipe_run_args      = {0};
 	struct pack_ret_data_args   pack_args          = {0};
+	uint32_t                    batch_nr           = pipeline_batch_nr;
 
 	*nr_kds_out  = 0;
 	*nr_iods_out = 0;
@@ -414,7 +616,19 @@ ds_pipeline_run(daos_handle_t vos_coh, daos_unit_oid_t oid, daos_pipeline_t pipe
 	anchors.ia_dkey = *anchor;
 	credits.max     = PIPELINE_ITERATION_MAX;
 
-	while (!daos_anchor_is_eof(&anchors.ia_dkey)) {
+	/** tests compare the results of both modes */
+	if (DAOS_FAIL_CHECK(DAOS_PIPELINE_NO_BATCH))
+		batch_nr = 1;
+
+	if (batch_nr > 1) {
+		rc = pipeline_run_batch(vos_coh, oid, &pipeline, &pipeline_compiled, epr, iods,
+					nr_iods, nr_kds, batch_nr, &anchors, &nr_kds_pass,
+					&pack_args, sgl_agg, stats);
+		if (rc != 0)
+			D_GOTO(exit, rc);
+	}
+
+	while (batch_nr <= 1 && !daos_anchor_is_eof(&anchors.ia_dkey)) {
 		if (pipeline.num_aggr_filters == 0 && nr_kds_pass == nr_kds)
 			break; /** all records read */
 
@@ -45,6 +45,218 @@ static struct pl_map_dict pl_maps[] = {
 	},
 };
 
+/**
+ * Object layout cache.
+ *
+ * Computing the layout of an object descends the fault domain tree for each shard, which is
+ * the main placement cost when the same objects are opened again and again (e.g. the parent
+ * directories of DFS). The placement map is immutable and is replaced by pl_map_update() for
+ * any new pool map version, so the layouts computed by a placement map can be memoized by it,
+ * keyed by everything else that the layout depends on. The cache is a LRU list of bounded
+ * size, each lookup returns a private copy of the layout.
+ */
+
+/** Default max count of cached layouts per placement map, see DAOS_PL_LAYOUT_CACHE */
+#define PL_LAYOUT_CACHE_DEF		4096
+/** Do not cache the layout of the widely striped objects, they are rarely re-opened */
+#define PL_LAYOUT_CACHE_SHARDS_MAX	256
+
+struct pl_layout_key {
+	daos_obj_id_t		lk_oid;
+	uint32_t		lk_map_ver;
+	uint32_t		lk_omd_ver;
+	uint32_t		lk_fdom_lvl;
+	uint32_t		lk_pda;
+	uint32_t		lk_pdom_lvl;
+	uint32_t		lk_layout_ver;
+	uint32_t		lk_mode;
+};
+
+struct pl_layout_ent {
+	/** link chain on the hash bucket */
+	d_list_t		le_hash_link;
+	/** link chain on the LRU list, the most recently used at head */
+	d_list_t		le_lru_link;
+	struct pl_layout_key	le_key;
+	struct pl_obj_layout	le_layout;
+	struct pl_obj_shard	le_shards[];
+};
+
+struct pl_layout_cache {
+	pthread_mutex_t		 lc_lock;
+	d_list_t		 lc_lru;
+	d_list_t		*lc_buckets;
+	uint32_t		 lc_mask;
+	uint32_t		 lc_nr;
+	uint32_t		 lc_max;
+};
+
+static int
+pl_layout_cache_create(uint32_t max, struct pl_layout_cache **cachep)
+{
+	struct pl_layout_cache	*cache;
+	uint32_t		 nr = 1;
+	uint32_t		 i;
+	int			 rc;
+
+	D_ALLOC_PTR(cache);
+	if (cache == NULL)
+		return -DER_NOMEM;
+
+	/* two entries per bucket on average when the cache is full */
+	while (nr < max / 2)
+		nr <<= 1;
+
+	D_ALLOC_ARRAY(cache->lc_buckets, nr);
+	if (cache->lc_buckets == NULL)
+		D_GOTO(free, rc = -DER_NOMEM);
+
+	rc = D_MUTEX_INIT(&cache->lc_lock, NULL);
+	if (rc != 0)
+		D_GOTO(free, rc);
+
+	for (i = 0; i < nr; i++)
+		D_INIT_LIST_HEAD(&cache->lc_buckets[i]);
+	D_INIT_LIST_HEAD(&cache->lc_lru);
+	cache->lc_mask = nr - 1;
+	cache->lc_max  = max;
+
+	*cachep = cache;
+	return 0;
+free:
+	D_FREE(cache->lc_buckets);
+	D_FREE(cache);
+	return rc;
+}
+
+static void
+pl_layout_cache_destroy(struct pl_layout_cache *cache)
+{
+	struct pl_layout_ent	*ent;
+
+	while ((ent = d_list_pop_entry(&cache->lc_lru, struct pl_layout_ent,
+				       le_lru_link)) != NULL) {
+		d_list_del(&ent->le_hash_link);
+		D_FREE(ent);
+	}
+
+	D_MUTEX_DESTROY(&cache->lc_lock);
+	D_FREE(cache->lc_buckets);
+	D_FREE(cache);
+}
+
+static inline d_list_t *
+pl_layout_cache_bucket(struct pl_layout_cache *cache, struct pl_layout_key *key)
+{
+	uint64_t	hash;
+
+	hash = d_hash_murmur64((unsigned char *)key, sizeof(*key), 0);
+	return &cache->lc_buckets[hash & cache->lc_mask];
+}
+
+static struct pl_layout_ent *
+pl_layout_cache_find(d_list_t *bucket, struct pl_layout_key *key)
+{
+	struct pl_layout_ent	*ent;
+
+	d_list_for_each_entry(ent, bucket, le_hash_link) {
+		if (memcmp(&ent->le_key, key, sizeof(*key)) == 0)
+			return ent;
+	}
+
+	return NULL;
+}
+
+/** Return a copy of the cached layout in \a layout_pp, or -DER_NONEXIST */
+static int
+pl_layout_cache_lookup(struct pl_layout_cache *cache, struct pl_layout_key *key,
+		       struct pl_obj_layout **layout_pp)
+{
+	d_list_t		*bucket = pl_layout_cache_bucket(cache, key);
+	struct pl_layout_ent	*ent;
+	struct pl_obj_layout	*layout;
+	int			 rc = 0;
+
+	D_MUTEX_LOCK(&cache->lc_lock);
+	ent = pl_layout_cache_find(bucket, key);
+	if (ent == NULL)
+		D_GOTO(out, rc = -DER_NONEXIST);
+
+	D_ALLOC_PTR(layout);
+	if (layout == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	*layout = ent->le_layout;
+	D_ALLOC_ARRAY(layout->ol_shards, layout->ol_nr);
+	if (layout->ol_shards == NULL) {
+		D_FREE(layout);
+		D_GOTO(out, rc = -DER_NOMEM);
+	}
+	memcpy(layout->ol_shards, ent->le_shards, sizeof(*layout->ol_shards) * layout->ol_nr);
+
+	d_list_move(&ent->le_lru_link, &cache->lc_lru);
+	*layout_pp = layout;
+out:
+	D_MUTEX_UNLOCK(&cache->lc_lock);
+	return rc;
+}
+
+static void
+pl_layout_cache_insert(struct pl_layout_cache *cache, struct pl_layout_key *key,
+		       struct pl_obj_layout *layout)
+{
+	d_list_t		*bucket = pl_layout_cache_bucket(cache, key);
+	struct pl_layout_ent	*ent;
+	struct pl_layout_ent	*victim = NULL;
+
+	if (layout->ol_nr > PL_LAYOUT_CACHE_SHARDS_MAX)
+		return;
+
+	D_ALLOC(ent, sizeof(*ent) + sizeof(ent->le_shards[0]) * layout->ol_nr);
+	if (ent == NULL)
+		return; /* it is just a cache */
+
+	ent->le_key = *key;
+	ent->le_layout = *layout;
+	ent->le_layout.ol_shards = ent->le_shards;
+	memcpy(ent->le_shards, layout->ol_shards, sizeof(ent->le_shards[0]) * layout->ol_nr);
+
+	D_MUTEX_LOCK(&cache->lc_lock);
+	if (pl_layout_cache_find(bucket, key) != NULL) {
+		/* inserted by another thread */
+		D_MUTEX_UNLOCK(&cache->lc_lock);
+		D_FREE(ent);
+		return;
+	}
+
+	d_list_add(&ent->le_hash_link, bucket);
+	d_list_add(&ent->le_lru_link, &cache->lc_lru);
+	if (++cache->lc_nr > cache->lc_max) {
+		victim = d_list_entry(cache->lc_lru.prev, struct pl_layout_ent, le_lru_link);
+		d_list_del(&victim->le_hash_link);
+		d_list_del(&victim->le_lru_link);
+		cache->lc_nr--;
+	}
+	D_MUTEX_UNLOCK(&cache->lc_lock);
+
+	D_FREE(victim);
+}
+
+static void
+pl_layout_key_init(struct pl_layout_key *key, struct pl_map *map, uint16_t layout_gl_version,
+		   struct daos_obj_md *md, unsigned int mode)
+{
+	/* zero the padding, the key is compared by memcmp */
+	memset(key, 0, sizeof(*key));
+	key->lk_oid        = md->omd_id;
+	key->lk_map_ver    = pl_map_version(map);
+	key->lk_omd_ver    = md->omd_ver;
+	key->lk_fdom_lvl   = md->omd_fdom_lvl;
+	key->lk_pda        = md->omd_pda;
+	key->lk_pdom_lvl   = md->omd_pdom_lvl;
+	key->lk_layout_ver = layout_gl_version;
+	key->lk_mode       = mode;
+}
 
 static int
 pl_map_create_inited(struct pool_map *pool_map, struct pl_map_init_attr *mia,
@@ -52,6 +264,7 @@ pl_map_create_inited(struct pool_map *pool_map, struct pl_map_init_attr *mia,
 {
 	struct pl_map_dict      *dict = pl_maps;
 	struct pl_map           *map;
+	uint32_t                 cache_max;
 	int                      rc;
 
 	for (dict = &pl_maps[0]; dict->pd_type != PL_TYPE_UNKNOWN; dict++) {
@@ -77,6 +290,19 @@ pl_map_create_inited(struct pool_map *pool_map, struct pl_map_init_attr *mia,
 		return rc;
 	}
 
+	/* Read it for each map, then it can be changed for the following pool map versions. */
+	cache_max = PL_LAYOUT_CACHE_DEF;
+	d_getenv_uint32_t("DAOS_PL_LAYOUT_CACHE", &cache_max);
+	map->pl_layout_cache = NULL;
+	if (cache_max > 0) {
+		rc = pl_layout_cache_create(cache_max, &map->pl_layout_cache);
+		if (rc != 0) {
+			D_SPIN_DESTROY(&map->pl_lock);
+			dict->pd_ops->o_destroy(map);
+			return rc;
+		}
+	}
+
 	map->pl_ref  = 1; /* for the caller */
 	map->pl_connects = 0;
 	map->pl_type = mia->ia_type;
@@ -97,6 +323,8 @@ pl_map_destroy(struct pl_map *map)
 	D_ASSERT(map->pl_ops != NULL);
 	D_ASSERT(map->pl_ops->o_destroy != NULL);
 
+	if (map->pl_layout_cache != NULL)
+		pl_layout_cache_destroy(map->pl_layout_cache);
 	D_SPIN_DESTROY(&map->pl_lock);
 	map->pl_ops->o_destroy(map);
 }
@@ -120,10 +348,28 @@ pl_obj_place(struct pl_map *map, uint16_t layout_gl_version, struct daos_obj_md
 	     unsigned int mode, struct daos_obj_shard_md *shard_md,
 	     struct pl_obj_layout **layout_pp)
 {
+	struct pl_layout_key	key;
+	int			rc;
+
 	D_ASSERT(map->pl_ops != NULL);
 	D_ASSERT(map->pl_ops->o_obj_place != NULL);
 	D_ASSERT(layout_gl_version < MAX_OBJ_LAYOUT_VERSION);
-	return map->pl_ops->o_obj_place(map, layout_gl_version, md, mode, shard_md, layout_pp);
+
+	/* Only the full layout is cached. */
+	if (map->pl_layout_cache == NULL || shard_md != NULL)
+		return map->pl_ops->o_obj_place(map, layout_gl_version, md, mode, shard_md,
+						layout_pp);
+
+	pl_layout_key_init(&key, map, layout_gl_version, md, mode);
+	rc = pl_layout_cache_lookup(map->pl_layout_cache, &key, layout_pp);
+	if (rc != -DER_NONEXIST)
+		return rc;
+
+	rc = map->pl_ops->o_obj_place(map, layout_gl_version, md, mode, NULL, layout_pp);
+	if (rc == 0)
+		pl_layout_cache_insert(map->pl_layout_cache, &key, *layout_pp);
+
+	return rc;
 }
 
 /**
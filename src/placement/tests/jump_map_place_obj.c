@@ -2304,6 +2304,79 @@ fail_multiple_ranks(void **state)
 	jtc_fini(&ctx);
 }
 
+static void
+assert_layout_equal(struct pl_obj_layout *a, struct pl_obj_layout *b)
+{
+	assert_int_equal(a->ol_ver, b->ol_ver);
+	assert_int_equal(a->ol_grp_size, b->ol_grp_size);
+	assert_int_equal(a->ol_grp_nr, b->ol_grp_nr);
+	assert_int_equal(a->ol_nr, b->ol_nr);
+	assert_memory_equal(a->ol_shards, b->ol_shards, sizeof(*a->ol_shards) * a->ol_nr);
+}
+
+#define LAYOUT_CACHE_SIZE	4
+#define LAYOUT_CACHE_OBJS	16
+
+/*
+ * The layouts returned by a placement map with the layout cache must be the ones computed
+ * without it, for the hot objects served from the cache as well as for the ones evicted from
+ * the LRU and computed again.
+ */
+static void
+layout_cache(void **state)
+{
+	struct pool_map		*po_map;
+	struct pl_map		*pl_map;
+	struct pl_map		*pl_map_cached;
+	struct pl_map_init_attr	 mia = {0};
+	struct pl_obj_layout	*layout;
+	struct pl_obj_layout	*cached;
+	daos_obj_id_t		 oids[LAYOUT_CACHE_OBJS];
+	char			 size[16];
+	int			 round;
+	int			 i;
+
+	/* the cache size is read when the placement map is created */
+	d_setenv("DAOS_PL_LAYOUT_CACHE", "0", 1);
+	gen_maps(1, 4, 1, 4, &po_map, &pl_map);
+	assert_null(pl_map->pl_layout_cache);
+
+	snprintf(size, sizeof(size), "%d", LAYOUT_CACHE_SIZE);
+	d_setenv("DAOS_PL_LAYOUT_CACHE", size, 1);
+	mia.ia_type        = PL_TYPE_JUMP_MAP;
+	mia.ia_ring.domain = PO_COMP_TP_RANK;
+	assert_success(pl_map_create(po_map, &mia, &pl_map_cached));
+	assert_non_null(pl_map_cached->pl_layout_cache);
+	d_unsetenv("DAOS_PL_LAYOUT_CACHE");
+
+	for (i = 0; i < LAYOUT_CACHE_OBJS; i++)
+		gen_oid(&oids[i], i + 1, 0, OC_RP_2G2);
+
+	for (round = 0; round < 3; round++) {
+		for (i = 0; i < LAYOUT_CACHE_OBJS; i++) {
+			/* oids[0] is hot and stays cached, the others go through the LRU */
+			assert_success(plt_obj_place(oids[0], 0, &layout, pl_map, false));
+			assert_success(plt_obj_place(oids[0], 0, &cached, pl_map_cached, false));
+			assert_layout_equal(layout, cached);
+			pl_obj_layout_free(layout);
+
+			/* the caller owns a private copy, changing it does not touch the cache */
+			memset(cached->ol_shards, 0xff, sizeof(*cached->ol_shards) * cached->ol_nr);
+			pl_obj_layout_free(cached);
+
+			assert_success(plt_obj_place(oids[i], 0, &layout, pl_map, false));
+			assert_success(plt_obj_place(oids[i], 0, &cached, pl_map_cached, false));
+			assert_layout_equal(layout, cached);
+			pl_obj_layout_free(layout);
+			pl_obj_layout_free(cached);
+		}
+	}
+
+	/* releases the cached layouts, checked by memcheck */
+	pl_map_decref(pl_map_cached);
+	free_pool_and_placement_map(po_map, pl_map);
+}
+
 /*
  * ------------------------------------------------
  * End Test Cases
@@ -2401,6 +2474,8 @@ static const struct CMUnitTest tests[] = {
 	  fail_shard_during_reintegration),
 	T("fail reintegrate ranks", fail_reintegrate_multiple_ranks),
 	T("fail multiple ranks", fail_multiple_ranks),
+	/* Layout cache */
+	T("layout cache returns the computed layouts", layout_cache),
 };
 
 int
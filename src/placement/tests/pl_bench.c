@@ -1,5 +1,6 @@
 /**
  * (C) Copyright 2016-2023 Intel Corporation.
+ * (C) Copyright 2025 Hewlett Packard Enterprise Development LP
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -35,6 +36,9 @@ extern void obj_class_fini(void);
 #define DEFAULT_ADDITION_NUM_TO_ADD 32
 #define DEFAULT_ADDITION_TEST_ENTRIES 100000
 
+#define DEFAULT_LAYOUT_CACHE_OBJECTS 1024
+#define DEFAULT_LAYOUT_CACHE_ITERATIONS 1000
+
 static void
 print_usage(const char *prog_name, const char *const ops[], uint32_t num_ops)
 {
@@ -265,6 +269,179 @@ benchmark_placement(int argc, char **argv, uint32_t num_domains,
 	D_FREE(layout_table);
 }
 
+static void
+benchmark_layout_cache_usage()
+{
+	D_PRINT("Layout cache benchmark usage: -- [optional arguments]\n"
+		"\n"
+		"Optional Arguments\n"
+		"  --num-objects <num>\n"
+		"      Short version: -n\n"
+		"      Number of objects placed repeatedly, i.e. the working set\n"
+		"      Default: %d\n"
+		"\n"
+		"  --iterations <num>\n"
+		"      Short version: -i\n"
+		"      Number of times each object is placed\n"
+		"      Default: %d\n"
+		"\n"
+		"  --cache-size <num>\n"
+		"      Short version: -c\n"
+		"      Max number of cached layouts, i.e. DAOS_PL_LAYOUT_CACHE\n"
+		"      Default: the working set size\n",
+		DEFAULT_LAYOUT_CACHE_OBJECTS, DEFAULT_LAYOUT_CACHE_ITERATIONS);
+}
+
+static bool
+layout_same(struct pl_obj_layout *a, struct pl_obj_layout *b)
+{
+	return a->ol_nr == b->ol_nr && a->ol_grp_size == b->ol_grp_size &&
+	       a->ol_grp_nr == b->ol_grp_nr && a->ol_ver == b->ol_ver &&
+	       memcmp(a->ol_shards, b->ol_shards, sizeof(*a->ol_shards) * a->ol_nr) == 0;
+}
+
+/*
+ * Place the same working set of objects again and again, as the client does for the hot objects
+ * (e.g. DFS directories), with the layout cache disabled then enabled.
+ */
+static void
+benchmark_layout_cache(int argc, char **argv, uint32_t num_domains,
+		       uint32_t nodes_per_domain, uint32_t vos_per_target)
+{
+	struct pool_map		 *pool_map;
+	struct pl_map		 *pl_map;
+	struct daos_obj_md	 *obj_table;
+	struct pl_obj_layout	**ref_table;
+	struct pl_obj_layout	 *layout;
+	struct benchmark_handle	 *bench_hdl;
+	char			  cache_env[16];
+	int			  num_objs = DEFAULT_LAYOUT_CACHE_OBJECTS;
+	int			  iterations = DEFAULT_LAYOUT_CACHE_ITERATIONS;
+	int			  cache_size = -1;
+	int			  pass;
+	int			  iter;
+	int			  i;
+	int			  rc;
+
+	while (1) {
+		static struct option long_options[] = {
+			{"num-objects", required_argument, 0, 'n'},
+			{"iterations", required_argument, 0, 'i'},
+			{"cache-size", required_argument, 0, 'c'},
+			{0, 0, 0, 0}
+		};
+		int c;
+		int ret;
+
+		c = getopt_long(argc, argv, "n:i:c:", long_options, NULL);
+		if (c == -1)
+			break;
+
+		switch (c) {
+		case 'n':
+			ret = sscanf(optarg, "%d", &num_objs);
+			if (ret != 1 || num_objs <= 0) {
+				D_PRINT("ERROR: Invalid num-objects\n");
+				benchmark_layout_cache_usage();
+				return;
+			}
+			break;
+		case 'i':
+			ret = sscanf(optarg, "%d", &iterations);
+			if (ret != 1 || iterations <= 0) {
+				D_PRINT("ERROR: Invalid iterations\n");
+				benchmark_layout_cache_usage();
+				return;
+			}
+			break;
+		case 'c':
+			ret = sscanf(optarg, "%d", &cache_size);
+			if (ret != 1 || cache_size <= 0) {
+				D_PRINT("ERROR: Invalid cache-size\n");
+				benchmark_layout_cache_usage();
+				return;
+			}
+			break;
+		case '?':
+		default:
+			D_PRINT("ERROR: Unrecognized argument '%s'\n", optarg);
+			benchmark_layout_cache_usage();
+			return;
+		}
+	}
+	if (cache_size < 0)
+		cache_size = num_objs;
+
+	D_ALLOC_ARRAY(obj_table, num_objs);
+	D_ASSERT(obj_table != NULL);
+	D_ALLOC_ARRAY(ref_table, num_objs);
+	D_ASSERT(ref_table != NULL);
+
+	for (i = 0; i < num_objs; i++) {
+		obj_table[i].omd_id.lo = rand();
+		obj_table[i].omd_id.hi = 5;
+		rc = daos_obj_set_oid_by_class(&obj_table[i].omd_id, 0, OC_RP_4G2, 0);
+		D_ASSERT(rc == 0);
+		obj_table[i].omd_ver = 1;
+	}
+
+	bench_hdl = benchmark_alloc();
+	D_ASSERT(bench_hdl != NULL);
+
+	D_PRINT("\nLayout cache benchmark results:\n");
+	D_PRINT("# Cache size, Objects, Iterations, Wallclock time (ns), thread time (ns), "
+		"Wallclock placements per second\n");
+
+	/* The cache size is read when the placement map is created, the 1st pass is uncached */
+	for (pass = 0; pass < 2; pass++) {
+		snprintf(cache_env, sizeof(cache_env), "%d", pass == 0 ? 0 : cache_size);
+		d_setenv("DAOS_PL_LAYOUT_CACHE", cache_env, 1);
+
+		gen_pool_and_placement_map(1, num_domains, nodes_per_domain, vos_per_target,
+					   PL_TYPE_JUMP_MAP, PO_COMP_TP_RANK, &pool_map, &pl_map);
+		D_ASSERT(pool_map != NULL);
+		D_ASSERT(pl_map != NULL);
+
+		benchmark_start(bench_hdl);
+		for (iter = 0; iter < iterations; iter++) {
+			for (i = 0; i < num_objs; i++) {
+				rc = pl_obj_place(pl_map, 0, &obj_table[i], 0, NULL, &layout);
+				D_ASSERT(rc == 0);
+				pl_obj_layout_free(layout);
+			}
+		}
+		benchmark_stop(bench_hdl);
+
+		/* The cached layouts must be the same as the computed ones */
+		for (i = 0; i < num_objs; i++) {
+			rc = pl_obj_place(pl_map, 0, &obj_table[i], 0, NULL, &layout);
+			D_ASSERT(rc == 0);
+			if (pass == 0) {
+				ref_table[i] = layout;
+				continue;
+			}
+			D_ASSERT(layout_same(ref_table[i], layout));
+			pl_obj_layout_free(layout);
+		}
+
+		D_PRINT("%s,%d,%d,%lld,%lld,%lld\n", cache_env, num_objs, iterations,
+			bench_hdl->wallclock_delta_ns, bench_hdl->thread_delta_ns,
+			NANOSECONDS_PER_SECOND * num_objs * iterations /
+			bench_hdl->wallclock_delta_ns);
+
+		free_pool_and_placement_map(pool_map, pl_map);
+	}
+	check_unique_layout(num_domains, nodes_per_domain, vos_per_target, ref_table,
+			    num_objs, 0);
+
+	d_unsetenv("DAOS_PL_LAYOUT_CACHE");
+	benchmark_free(bench_hdl);
+	for (i = 0; i < num_objs; i++)
+		pl_obj_layout_free(ref_table[i]);
+	D_FREE(ref_table);
+	D_FREE(obj_table);
+}
+
 void
 benchmark_add_data_movement_usage()
 {
@@ -592,10 +769,12 @@ main(int argc, char **argv)
 	test_op_t op_fn[] = {
 		benchmark_placement,
 		benchmark_add_data_movement,
+		benchmark_layout_cache,
 	};
 	const char *const op_names[] = {
 		"benchmark-placement",
 		"benchmark-add",
+		"benchmark-layout-cache",
 	};
 	D_ASSERT(ARRAY_SIZE(op_fn) == ARRAY_SIZE(op_names));
 
@@ -24,6 +24,7 @@
 bool		ec_agg_disabled;
 uint32_t        pw_rf = -1; /* pool wise redundancy factor */
 uint32_t        ps_cache_intvl = 2;  /* pool space cache expiration time, in seconds */
+uint32_t        ps_chkpt_incr_rate;  /* incremental checkpoint rate in pages/s, 0: disabled */
 #define PW_RF_DEFAULT (2)
 #define PW_RF_MIN     (0)
 #define PW_RF_MAX     (4)
@@ -86,6 +87,11 @@ init(void)
 	}
 	D_INFO("pool space cache expiration time set to %u seconds\n", ps_cache_intvl);
 
+	d_getenv_uint32_t("DAOS_MD_CHKPT_INCR_RATE", &ps_chkpt_incr_rate);
+	if (ps_chkpt_incr_rate != 0)
+		D_INFO("incremental checkpoint enabled, base rate %u pages/s\n",
+		       ps_chkpt_incr_rate);
+
 	ds_pool_rsvc_class_register();
 
 	bio_register_ract_ops(&nvme_reaction_ops);
@@ -19,6 +19,7 @@
 
 extern uint32_t pw_rf;
 extern uint32_t ps_cache_intvl;
+extern uint32_t ps_chkpt_incr_rate;
 
 /**
  * Global pool metrics
@@ -63,14 +63,17 @@ ds_pool_get_vos_df_version(uint32_t pool_global_version)
 	return 0;
 }
 
-/** Return the VOS DF version for the default pool global version. */
+/**
+ * Return the VOS DF version for new pools. VOS_POOL_DF_2_10 only adds server side layout
+ * (the evtree node summary), so it is used for new pools without a new pool global version,
+ * which would lock out older clients. Existing pools keep the DF that their global version
+ * maps to.
+ */
 uint32_t
 ds_pool_get_vos_df_version_default(void)
 {
-	uint32_t v = ds_pool_get_vos_df_version(DAOS_POOL_GLOBAL_VERSION);
-
-	D_ASSERT(v != 0);
-	return v;
+	D_ASSERT(ds_pool_get_vos_df_version(DAOS_POOL_GLOBAL_VERSION) == VOS_POOL_DF_2_8);
+	return VOS_POOL_DF_2_10;
 }
 
 #define DUP_OP_MIN_RDB_SIZE                       (1 << 30)
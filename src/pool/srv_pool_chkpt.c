@@ -117,6 +117,16 @@ update_cb(void *arg, uint64_t id, uint32_t used_blocks, uint32_t total_blocks)
 	}
 }
 
+static void
+update_thresh(struct ds_pool *pool, struct chkpt_ctx *ctx)
+{
+	if (pool->sp_checkpoint_thresh != ctx->cc_saved_thresh) {
+		/** Recalculate the checkpoint max */
+		ctx->cc_saved_thresh    = pool->sp_checkpoint_thresh;
+		ctx->cc_max_used_blocks = (ctx->cc_total_blocks * ctx->cc_saved_thresh) / 100;
+	}
+}
+
 /** Returns true if we should trigger a checkpoint.  Otherwise, it sleeps for some interval and
  *  returns false.
  */
@@ -132,12 +142,7 @@ need_checkpoint(struct ds_pool_child *child, struct chkpt_ctx *ctx, uint64_t *st
 		goto do_sleep;
 	}
 
-	if (pool->sp_checkpoint_thresh != ctx->cc_saved_thresh) {
-		/** Recalculate the checkpoint max */
-		ctx->cc_saved_thresh    = pool->sp_checkpoint_thresh;
-		ctx->cc_max_used_blocks = (ctx->cc_total_blocks * ctx->cc_saved_thresh) / 100;
-	}
-
+	update_thresh(pool, ctx);
 	if (ctx->cc_used_blocks > ctx->cc_max_used_blocks)
 		return true;
 
@@ -175,6 +180,63 @@ do_sleep:
 	return false;
 }
 
+/** Minimal & maximal sleep interval between incremental checkpoints in ms */
+#define CHKPT_INCR_INTVL_MIN	10
+#define CHKPT_INCR_INTVL_MAX	1000
+/** Fraction of the used WAL to be reclaimed by each incremental checkpoint */
+#define CHKPT_INCR_STEPS	8
+/** Maximal scale of the incremental checkpoint base rate */
+#define CHKPT_INCR_SCALE_MAX	16
+
+/** Returns true if the incremental checkpoint should be used instead of the full checkpoint */
+static bool
+need_incr_checkpoint(struct ds_pool_child *child, struct chkpt_ctx *ctx)
+{
+	struct ds_pool *pool = child->spc_pool;
+
+	if (ps_chkpt_incr_rate == 0 || pool->sp_checkpoint_mode == DAOS_CHECKPOINT_DISABLED)
+		return false;
+
+	/** Fallback to full checkpoint when the WAL usage is above threshold */
+	update_thresh(pool, ctx);
+	return ctx->cc_used_blocks <= ctx->cc_max_used_blocks;
+}
+
+/** Reclaim the WAL in small steps continuously, the flush rate is paced by a budget which
+ *  scales up as the WAL free space shrinks.
+ */
+static int
+incr_checkpoint(struct ds_pool_child *child, struct chkpt_ctx *ctx)
+{
+	uint32_t free_blks, nr_blks, nr_pages = 0, scale, rate;
+	uint64_t sleep_time = CHKPT_INCR_INTVL_MAX;
+	int      rc = 0;
+
+	if (ctx->cc_used_blocks == 0)
+		goto do_sleep;
+
+	free_blks = ctx->cc_total_blocks - ctx->cc_used_blocks;
+	scale     = min(ctx->cc_total_blocks / max(free_blks, 1), CHKPT_INCR_SCALE_MAX);
+	rate      = ps_chkpt_incr_rate * max(scale, 1);
+
+	nr_blks = max(ctx->cc_used_blocks / CHKPT_INCR_STEPS, 1);
+	rc      = vos_pool_checkpoint_incr(ctx->cc_vos_pool_hdl, nr_blks, &nr_pages);
+	if (rc != 0)
+		return rc;
+
+	sleep_time = (uint64_t)nr_pages * 1000 / rate;
+	sleep_time = min(max(sleep_time, CHKPT_INCR_INTVL_MIN), CHKPT_INCR_INTVL_MAX);
+do_sleep:
+	D_DEBUG(DB_IO,
+		"Incremental checkpoint flushed %u pages, sleep "DF_U64" ms. Used blocks %d/%d\n",
+		nr_pages, sleep_time, ctx->cc_used_blocks, ctx->cc_total_blocks);
+	ctx->cc_sleeping = 1;
+	sched_req_sleep(child->spc_chkpt_req, sleep_time);
+	ctx->cc_sleeping = 0;
+
+	return 0;
+}
+
 /** Setup checkpointing context and start checkpointing the pool */
 static void
 chkpt_ult(void *arg)
@@ -207,10 +269,14 @@ chkpt_ult(void *arg)
 	vos_pool_checkpoint_init(poh, update_cb, wait_cb, &ctx, &ctx.cc_store);
 
 	while (!dss_ult_exiting(child->spc_chkpt_req)) {
-		if (!need_checkpoint(child, &ctx, &start))
+		if (need_incr_checkpoint(child, &ctx)) {
+			rc = incr_checkpoint(child, &ctx);
+		} else if (need_checkpoint(child, &ctx, &start)) {
+			rc = vos_pool_checkpoint(poh);
+		} else {
 			continue;
+		}
 
-		rc = vos_pool_checkpoint(poh);
 		if (rc == -DER_SHUTDOWN) {
 			D_ERROR("tgt_id %d shutting down. Checkpointer should quit\n",
 				ctx.cc_dmi->dmi_tgt_id);
@@ -0,0 +1,222 @@
+/**
+ * (C) Copyright 2025 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * This file is part of CaRT testing: per-context RPC descriptor cache and
+ * adaptive network progress.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <time.h>
+
+#include <cmocka.h>
+
+#include <cart/api.h>
+#include "../cart/crt_internal.h"
+
+static struct crt_rpc_priv *
+rpc_create(crt_context_t crt_ctx, crt_opcode_t opc)
+{
+	crt_rpc_t *rpc = NULL;
+	int        rc;
+
+	rc = crt_req_create(crt_ctx, NULL, opc, &rpc);
+	assert_int_equal(rc, 0);
+	assert_non_null(rpc);
+
+	return container_of(rpc, struct crt_rpc_priv, crp_pub);
+}
+
+/* Number of cached RPCs of \a opc_info in \a ctx, -1 if no bucket holds them */
+static int
+rpc_cache_num(struct crt_context *ctx, struct crt_opc_info *opc_info)
+{
+	int i;
+
+	for (i = 0; i < CRT_RPC_CACHE_BKT_NR; i++) {
+		if (ctx->cc_rpc_cache.crc_bkts[i].crb_opc_info == opc_info)
+			return ctx->cc_rpc_cache.crc_bkts[i].crb_num;
+	}
+	return -1;
+}
+
+static void
+test_rpc_cache(void **state)
+{
+	struct crt_rpc_priv *rpcs[CRT_RPC_CACHE_MAX_NUM + 4];
+	struct crt_rpc_priv *rpc_priv;
+	struct crt_rpc_priv *other;
+	struct crt_opc_info *opc_info;
+	struct crt_opc_info *other_info;
+	struct crt_context  *ctx;
+	crt_context_t        crt_ctx;
+	size_t               size_in;
+	char                *input;
+	int                  i;
+	int                  rc;
+
+	rc = crt_init(NULL, CRT_FLAG_BIT_SERVER | CRT_FLAG_BIT_AUTO_SWIM_DISABLE);
+	assert_int_equal(rc, 0);
+
+	rc = crt_context_create(&crt_ctx);
+	assert_int_equal(rc, 0);
+	ctx = crt_ctx;
+
+	/* A freed RPC is kept in the cache and handed out again, zeroed */
+	rpc_priv = rpc_create(crt_ctx, CRT_OPC_URI_LOOKUP);
+	opc_info = rpc_priv->crp_opc_info;
+	size_in  = opc_info->coi_crf->crf_size_in;
+	assert_true(size_in > 0);
+	memset(rpc_priv->crp_pub.cr_input, 0xa5, size_in);
+	crt_req_decref(&rpc_priv->crp_pub);
+	assert_int_equal(rpc_cache_num(ctx, opc_info), 1);
+
+	other = rpc_create(crt_ctx, CRT_OPC_URI_LOOKUP);
+	assert_ptr_equal(other, rpc_priv);
+	assert_int_equal(rpc_cache_num(ctx, opc_info), 0);
+	input = other->crp_pub.cr_input;
+	for (i = 0; i < size_in; i++)
+		assert_int_equal(input[i], 0);
+	assert_int_equal(atomic_load(&other->crp_refcount), 1);
+	assert_int_equal(other->crp_pub.cr_opc, CRT_OPC_URI_LOOKUP);
+
+	/* Another opcode is cached separately and does not reuse the descriptor */
+	rpc_priv = rpc_create(crt_ctx, CRT_OPC_PROTO_QUERY);
+	assert_ptr_not_equal(rpc_priv, other);
+	other_info = rpc_priv->crp_opc_info;
+	assert_ptr_not_equal(other_info, opc_info);
+	crt_req_decref(&rpc_priv->crp_pub);
+	crt_req_decref(&other->crp_pub);
+	assert_int_equal(rpc_cache_num(ctx, opc_info), 1);
+	assert_int_equal(rpc_cache_num(ctx, other_info), 1);
+
+	/* Forwarded RPCs have no output buffer and are never cached */
+	rc = crt_rpc_priv_alloc(ctx, CRT_OPC_URI_LOOKUP, &rpc_priv, true /* forward */);
+	assert_int_equal(rc, 0);
+	assert_int_equal(rpc_cache_num(ctx, opc_info), 1);
+	rpc_priv->crp_pub.cr_ctx = crt_ctx;
+	crt_rpc_priv_free(rpc_priv);
+	assert_int_equal(rpc_cache_num(ctx, opc_info), 1);
+
+	/* The cache of one opcode is bounded */
+	for (i = 0; i < ARRAY_SIZE(rpcs); i++)
+		rpcs[i] = rpc_create(crt_ctx, CRT_OPC_URI_LOOKUP);
+	assert_int_equal(rpc_cache_num(ctx, opc_info), 0);
+	for (i = 0; i < ARRAY_SIZE(rpcs); i++)
+		crt_req_decref(&rpcs[i]->crp_pub);
+	assert_int_equal(rpc_cache_num(ctx, opc_info), CRT_RPC_CACHE_MAX_NUM);
+
+	/* Destroying the context releases the cached RPCs (checked by memcheck) */
+	rc = crt_context_destroy(crt_ctx, 0);
+	assert_int_equal(rc, 0);
+	rc = crt_finalize();
+	assert_int_equal(rc, 0);
+}
+
+/* Idle progress timeout (in us) used by the progress tests */
+#define UT_PROGRESS_TIMEOUT (100 * 1000)
+
+static void
+test_progress_default(void **state)
+{
+	struct crt_context *ctx;
+	crt_context_t       crt_ctx;
+	int                 rc;
+
+	rc = crt_init(NULL, CRT_FLAG_BIT_SERVER | CRT_FLAG_BIT_AUTO_SWIM_DISABLE);
+	assert_int_equal(rc, 0);
+
+	rc = crt_context_create(&crt_ctx);
+	assert_int_equal(rc, 0);
+	ctx = crt_ctx;
+	assert_false(ctx->cc_hg_ctx.chc_progress_adaptive);
+
+	rc = crt_progress(crt_ctx, 0);
+	assert_int_equal(rc, -DER_TIMEDOUT);
+	rc = crt_progress(crt_ctx, UT_PROGRESS_TIMEOUT);
+	assert_int_equal(rc, -DER_TIMEDOUT);
+	/* The default mode never backs off */
+	assert_int_equal(ctx->cc_hg_ctx.chc_poll_backoff, 0);
+
+	rc = crt_context_destroy(crt_ctx, 0);
+	assert_int_equal(rc, 0);
+	rc = crt_finalize();
+	assert_int_equal(rc, 0);
+}
+
+static void
+test_progress_adaptive(void **state)
+{
+	struct crt_context *ctx;
+	crt_context_t       crt_ctx;
+	uint64_t            start;
+	uint64_t            elapsed;
+	int                 rc;
+
+	d_setenv("D_PROGRESS_ADAPTIVE", "1", 1);
+	rc = crt_init(NULL, CRT_FLAG_BIT_SERVER | CRT_FLAG_BIT_AUTO_SWIM_DISABLE);
+	assert_int_equal(rc, 0);
+	d_unsetenv("D_PROGRESS_ADAPTIVE");
+
+	rc = crt_context_create(&crt_ctx);
+	assert_int_equal(rc, 0);
+	ctx = crt_ctx;
+	assert_true(ctx->cc_hg_ctx.chc_progress_adaptive);
+	assert_int_equal(ctx->cc_hg_ctx.chc_poll_backoff, 0);
+
+	/* A non-blocking poll of an idle context neither waits nor backs off */
+	rc = crt_progress(crt_ctx, 0);
+	assert_int_equal(rc, -DER_TIMEDOUT);
+	assert_int_equal(ctx->cc_hg_ctx.chc_poll_backoff, 0);
+	assert_int_equal(ctx->cc_hg_ctx.chc_poll_rate, 0);
+
+	/* An idle wait backs off up to the max and still honors the timeout */
+	start = d_timeus_secdiff(0);
+	rc    = crt_progress(crt_ctx, UT_PROGRESS_TIMEOUT);
+	assert_int_equal(rc, -DER_TIMEDOUT);
+	elapsed = d_timeus_secdiff(0) - start;
+	assert_true(elapsed >= UT_PROGRESS_TIMEOUT);
+	assert_true(elapsed < UT_PROGRESS_TIMEOUT + 1000 * 1000);
+	assert_int_equal(ctx->cc_hg_ctx.chc_poll_backoff, CRT_HG_POLL_BACKOFF_MAX);
+	assert_int_equal(ctx->cc_hg_ctx.chc_poll_rate, 0);
+
+	rc = crt_context_destroy(crt_ctx, 0);
+	assert_int_equal(rc, 0);
+	rc = crt_finalize();
+	assert_int_equal(rc, 0);
+}
+
+static int
+init_tests(void **state)
+{
+	d_setenv("D_PROVIDER", "ofi+tcp", 1);
+	d_setenv("D_INTERFACE", "lo", 1);
+
+	return 0;
+}
+
+static int
+fini_tests(void **state)
+{
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_rpc_cache),
+		cmocka_unit_test(test_progress_default),
+		cmocka_unit_test(test_progress_adaptive),
+	};
+
+	d_register_alt_assert(mock_assert);
+
+	return cmocka_run_group_tests_name("utest_rpc", tests, init_tests,
+		fini_tests);
+}
@@ -0,0 +1,31 @@
+'''
+  (C) Copyright 2025 Hewlett Packard Enterprise Development LP
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+'''
+
+from daos_core_base import DaosCoreBase
+
+
+class DaosCoreTestDtx(DaosCoreBase):
+    """Run daos_test distributed TX tests with non-default engine DTX settings.
+
+    :avocado: recursive
+    """
+
+    def test_dtx_pool_coalesce(self):
+        """Test the pool level coalescing of the DTX batched commit.
+
+        Test Description:
+            Run daos_test -T -u subtests=24,42 with DAOS_DTX_POOL_COALESCE set on the engines,
+            so that the batched commit of small batches is merged across containers.
+
+        Use cases:
+            Pool level coalescing of the DTX batched commit
+
+        :avocado: tags=all,daily_regression
+        :avocado: tags=hw,medium
+        :avocado: tags=daos_test,dtx
+        :avocado: tags=DaosCoreTestDtx,test_dtx_pool_coalesce
+        """
+        self.run_subtest()
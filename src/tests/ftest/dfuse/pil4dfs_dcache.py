@@ -1,5 +1,6 @@
 """
   (C) Copyright 2024 Intel Corporation.
+  (C) Copyright 2025 Hewlett Packard Enterprise Development LP
 
   SPDX-License-Identifier: BSD-2-Clause-Patent
 """
@@ -345,6 +346,10 @@ class Pil4dfsDcache(TestWithServers):
         "dcache_gc_rec": re.compile(r'^.+ il +DBUG .+ gc_reclaim\(\) remove expired .+$')
     }
 
+    _prefetch_re = re.compile(
+        r'^.+ il +DBUG .+ prefetch_stop\(\) dir-cache prefetch: dirs=(\d+), records=(\d+), '
+        r'hits=(\d+), drops=(\d+)$')
+
     __start_test_re__ = re.compile(r'^-- START of test_.+ --$')
     __end_test_re__ = re.compile(r'^-- END of test_.+ --$')
 
@@ -543,3 +548,45 @@ class Pil4dfsDcache(TestWithServers):
             self._check_result(test_case, result.all_stdout[hostname].split('\n'))
 
         self.log_step("Test passed")
+
+    def test_pil4dfs_dcache_prefetch(self):
+        """Test the prefetching of child directories into the dir-cache.
+
+        Test Description:
+            Mount a DFuse mount point
+            Run the prefetch unit test of test_pil4dfs_dcache with dir-cache prefetch enabled
+            Check that the prefetched child directories are hit by the following lookups
+
+        :avocado: tags=all,daily_regression
+        :avocado: tags=hw,medium
+        :avocado: tags=dcache,dfuse,pil4dfs
+        :avocado: tags=Pil4dfsDcache,test_pil4dfs_dcache_prefetch
+        """
+        self.log_step("Mount a DFuse mount point")
+        dfuse = self._mount_dfuse()
+
+        self.log_step("Run pil4dfs_dcache command")
+        hostname = self.hostlist_clients[0]
+        host = NodeSet(hostname)
+        mnt = dfuse.mount_dir.value
+        cmd = Pil4dfsDcacheCmd(host, self.prefix)
+        env_kwargs = {"D_IL_DCACHE_PREFETCH_MAX": 16, "D_IL_DCACHE_GC_PERIOD": 0}
+        self._update_cmd_env(cmd.env, mnt, **env_kwargs)
+        cmd.update_params(test_id=7)
+        result = cmd.run(raise_exception=True)
+
+        # '/' and '/pf' are enumerated, the 7 siblings of '/pf/d0' are added and then hit
+        self.log_step("Check the prefetch counters")
+        for line in result.all_stdout[hostname].split('\n'):
+            match = Pil4dfsDcache._prefetch_re.match(line)
+            if match:
+                dirs, records, hits, drops = (int(value) for value in match.groups())
+                self.assertEqual(dirs, 2, f"Unexpected number of prefetched dirs: {dirs}")
+                self.assertEqual(records, 7, f"Unexpected number of prefetched records: {records}")
+                self.assertEqual(hits, 7, f"Unexpected number of prefetch hits: {hits}")
+                self.assertEqual(drops, 0, f"Unexpected number of prefetch drops: {drops}")
+                break
+        else:
+            self.fail("Prefetch counters not found in the command output")
+
+        self.log_step("Test passed")
@@ -0,0 +1,330 @@
+/*
+ * (C) Copyright 2025 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * This tests the POSIX AIO interception of the DAOS libpil4dfs library.  It is run with
+ * libpil4dfs.so preloaded on a directory of a DFS container, with no fuse mount backing it.
+ */
+
+#include <unistd.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <aio.h>
+#include <errno.h>
+#include <stdatomic.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <gurt/common.h>
+
+#define AIO_BUF_SIZE (64 * 1024)
+#define AIO_LIO_NR   8
+
+static char test_dir[PATH_MAX];
+
+static int
+open_file(const char *name)
+{
+	char path[PATH_MAX];
+	int  fd;
+
+	snprintf(path, sizeof(path), "%s/%s", test_dir, name);
+	printf("Opening file '%s'\n", path);
+	fd = open(path, O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+	assert_return_code(fd, errno);
+
+	return fd;
+}
+
+static void
+remove_file(const char *name)
+{
+	char path[PATH_MAX];
+	int  rc;
+
+	snprintf(path, sizeof(path), "%s/%s", test_dir, name);
+	rc = unlink(path);
+	assert_return_code(rc, errno);
+}
+
+static void
+fill_buf(char *buf, size_t len, int seed)
+{
+	size_t i;
+
+	for (i = 0; i < len; i++)
+		buf[i] = (char)(i + seed);
+}
+
+/* Wait for a request and check its result */
+static void
+wait_aio(struct aiocb *cb, ssize_t expected)
+{
+	const struct aiocb *list[1] = {cb};
+	int                 rc;
+
+	while ((rc = aio_error(cb)) == EINPROGRESS) {
+		rc = aio_suspend(list, 1, NULL);
+		assert_return_code(rc, errno);
+	}
+	assert_int_equal(rc, 0);
+	assert_int_equal(aio_return(cb), expected);
+}
+
+static void
+test_aio_rw(void **state)
+{
+	struct aiocb cb = {0};
+	char        *wbuf;
+	char        *rbuf;
+	int          fd;
+	int          rc;
+
+	(void)state; /* unused */
+
+	D_ALLOC(wbuf, AIO_BUF_SIZE);
+	assert_non_null(wbuf);
+	D_ALLOC(rbuf, AIO_BUF_SIZE);
+	assert_non_null(rbuf);
+	fill_buf(wbuf, AIO_BUF_SIZE, 1);
+
+	fd = open_file("aio_rw");
+
+	cb.aio_fildes = fd;
+	cb.aio_buf    = wbuf;
+	cb.aio_nbytes = AIO_BUF_SIZE;
+	cb.aio_offset = AIO_BUF_SIZE;
+	rc            = aio_write(&cb);
+	assert_return_code(rc, errno);
+	wait_aio(&cb, AIO_BUF_SIZE);
+
+	rc = aio_fsync(O_SYNC, &cb);
+	assert_return_code(rc, errno);
+	wait_aio(&cb, 0);
+
+	/* The first half of the file is a hole */
+	cb.aio_buf    = rbuf;
+	cb.aio_offset = 0;
+	memset(rbuf, 0xff, AIO_BUF_SIZE);
+	rc = aio_read(&cb);
+	assert_return_code(rc, errno);
+	wait_aio(&cb, AIO_BUF_SIZE);
+	for (rc = 0; rc < AIO_BUF_SIZE; rc++)
+		assert_int_equal(rbuf[rc], 0);
+
+	cb.aio_offset = AIO_BUF_SIZE;
+	rc            = aio_read(&cb);
+	assert_return_code(rc, errno);
+	wait_aio(&cb, AIO_BUF_SIZE);
+	assert_memory_equal(rbuf, wbuf, AIO_BUF_SIZE);
+
+	/* Reads beyond the end of file are short */
+	cb.aio_offset = AIO_BUF_SIZE + AIO_BUF_SIZE / 2;
+	rc            = aio_read(&cb);
+	assert_return_code(rc, errno);
+	wait_aio(&cb, AIO_BUF_SIZE / 2);
+	assert_memory_equal(rbuf, wbuf + AIO_BUF_SIZE / 2, AIO_BUF_SIZE / 2);
+
+	rc = close(fd);
+	assert_return_code(rc, errno);
+	remove_file("aio_rw");
+	D_FREE(rbuf);
+	D_FREE(wbuf);
+}
+
+static void
+test_lio_listio(void **state)
+{
+	struct aiocb  cbs[AIO_LIO_NR] = {0};
+	struct aiocb *list[AIO_LIO_NR + 1];
+	char         *wbuf;
+	char         *rbuf;
+	int           fd;
+	int           i;
+	int           rc;
+
+	(void)state; /* unused */
+
+	D_ALLOC(wbuf, AIO_BUF_SIZE * AIO_LIO_NR);
+	assert_non_null(wbuf);
+	D_ALLOC(rbuf, AIO_BUF_SIZE * AIO_LIO_NR);
+	assert_non_null(rbuf);
+	fill_buf(wbuf, AIO_BUF_SIZE * AIO_LIO_NR, 7);
+
+	fd = open_file("lio_listio");
+
+	/* Writes in reverse order, with a NULL entry which is skipped */
+	for (i = 0; i < AIO_LIO_NR; i++) {
+		cbs[i].aio_fildes     = fd;
+		cbs[i].aio_lio_opcode = LIO_WRITE;
+		cbs[i].aio_buf        = wbuf + (AIO_LIO_NR - 1 - i) * AIO_BUF_SIZE;
+		cbs[i].aio_nbytes     = AIO_BUF_SIZE;
+		cbs[i].aio_offset     = (AIO_LIO_NR - 1 - i) * AIO_BUF_SIZE;
+		list[i]               = &cbs[i];
+	}
+	list[AIO_LIO_NR] = NULL;
+	rc               = lio_listio(LIO_WAIT, list, AIO_LIO_NR + 1, NULL);
+	assert_return_code(rc, errno);
+	for (i = 0; i < AIO_LIO_NR; i++) {
+		assert_int_equal(aio_error(&cbs[i]), 0);
+		assert_int_equal(aio_return(&cbs[i]), AIO_BUF_SIZE);
+	}
+
+	/* All the reads in flight at once */
+	for (i = 0; i < AIO_LIO_NR; i++) {
+		cbs[i].aio_lio_opcode = LIO_READ;
+		cbs[i].aio_buf        = rbuf + i * AIO_BUF_SIZE;
+		cbs[i].aio_offset     = i * AIO_BUF_SIZE;
+	}
+	rc = lio_listio(LIO_NOWAIT, list, AIO_LIO_NR, NULL);
+	assert_return_code(rc, errno);
+	for (i = 0; i < AIO_LIO_NR; i++)
+		wait_aio(&cbs[i], AIO_BUF_SIZE);
+	assert_memory_equal(rbuf, wbuf, AIO_BUF_SIZE * AIO_LIO_NR);
+
+	rc = close(fd);
+	assert_return_code(rc, errno);
+	remove_file("lio_listio");
+	D_FREE(rbuf);
+	D_FREE(wbuf);
+}
+
+static void
+test_aio_fsync(void **state)
+{
+	struct aiocb        cbs[AIO_LIO_NR] = {0};
+	struct aiocb        fcb             = {0};
+	const struct aiocb *list[1]         = {&fcb};
+	struct timespec     timeout         = {.tv_sec = 60};
+	char               *wbuf;
+	int                 fd;
+	int                 i;
+	int                 rc;
+
+	(void)state; /* unused */
+
+	D_ALLOC(wbuf, AIO_BUF_SIZE * AIO_LIO_NR);
+	assert_non_null(wbuf);
+	fill_buf(wbuf, AIO_BUF_SIZE * AIO_LIO_NR, 5);
+
+	fd = open_file("aio_fsync");
+
+	for (i = 0; i < AIO_LIO_NR; i++) {
+		cbs[i].aio_fildes = fd;
+		cbs[i].aio_buf    = wbuf + i * AIO_BUF_SIZE;
+		cbs[i].aio_nbytes = AIO_BUF_SIZE;
+		cbs[i].aio_offset = i * AIO_BUF_SIZE;
+		rc                = aio_write(&cbs[i]);
+		assert_return_code(rc, errno);
+	}
+
+	/* The fsync only completes once all the writes queued before it completed */
+	fcb.aio_fildes = fd;
+	rc             = aio_fsync(O_SYNC, &fcb);
+	assert_return_code(rc, errno);
+	while ((rc = aio_error(&fcb)) == EINPROGRESS) {
+		rc = aio_suspend(list, 1, &timeout);
+		assert_return_code(rc, errno);
+	}
+	assert_int_equal(rc, 0);
+	for (i = 0; i < AIO_LIO_NR; i++)
+		assert_int_equal(aio_error(&cbs[i]), 0);
+	assert_int_equal(aio_return(&fcb), 0);
+	for (i = 0; i < AIO_LIO_NR; i++)
+		assert_int_equal(aio_return(&cbs[i]), AIO_BUF_SIZE);
+
+	rc = close(fd);
+	assert_return_code(rc, errno);
+	remove_file("aio_fsync");
+	D_FREE(wbuf);
+}
+
+static _Atomic int notify_count;
+static _Atomic int notify_error;
+
+static void
+notify_cb(union sigval sv)
+{
+	struct aiocb *cb = sv.sival_ptr;
+
+	/* The request is complete when it is notified, checked by the test thread */
+	atomic_store(&notify_error, aio_error(cb));
+	atomic_fetch_add(&notify_count, 1);
+}
+
+static void
+test_aio_notify(void **state)
+{
+	struct aiocb cb = {0};
+	char         buf[4096];
+	int          fd;
+	int          rc;
+
+	(void)state; /* unused */
+
+	fill_buf(buf, sizeof(buf), 3);
+	fd = open_file("aio_notify");
+
+	cb.aio_fildes                         = fd;
+	cb.aio_buf                            = buf;
+	cb.aio_nbytes                         = sizeof(buf);
+	cb.aio_sigevent.sigev_notify          = SIGEV_THREAD;
+	cb.aio_sigevent.sigev_notify_function = notify_cb;
+	cb.aio_sigevent.sigev_value.sival_ptr = &cb;
+	atomic_store(&notify_count, 0);
+	atomic_store(&notify_error, EINPROGRESS);
+	rc = aio_write(&cb);
+	assert_return_code(rc, errno);
+	while (atomic_load(&notify_count) == 0)
+		usleep(1000);
+	assert_int_equal(atomic_load(&notify_count), 1);
+	assert_int_equal(atomic_load(&notify_error), 0);
+	assert_int_equal(aio_return(&cb), sizeof(buf));
+
+	/* Nothing is left in flight on the file */
+	assert_int_equal(aio_cancel(fd, NULL), AIO_ALLDONE);
+
+	rc = close(fd);
+	assert_return_code(rc, errno);
+	remove_file("aio_notify");
+}
+
+static int
+init_tests(void **state)
+{
+	return d_log_init();
+}
+
+static int
+fini_tests(void **state)
+{
+	d_log_fini();
+
+	return 0;
+}
+
+int
+main(int argc, char *argv[])
+{
+	const struct CMUnitTest tests[] = {
+	    cmocka_unit_test(test_aio_rw),
+	    cmocka_unit_test(test_lio_listio),
+	    cmocka_unit_test(test_aio_fsync),
+	    cmocka_unit_test(test_aio_notify),
+	};
+
+	d_register_alt_assert(mock_assert);
+
+	assert_int_equal(argc, 2);
+	assert_true(strnlen(argv[1], PATH_MAX) < PATH_MAX);
+	strncpy(test_dir, argv[1], PATH_MAX - 1);
+
+	return cmocka_run_group_tests_name("utest_pil4dfs_aio", tests, init_tests, fini_tests);
+}
@@ -1,5 +1,6 @@
 /*
  * (C) Copyright 2024 Intel Corporation.
+ * (C) Copyright 2025 Hewlett Packard Enterprise Development LP
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -415,6 +416,76 @@ test_garbage_collector(void **state)
 	assert_return_code(rc, errno);
 }
 
+#define PREFETCH_DIR_NR 8
+
+static void
+test_prefetch(void **state)
+{
+	char path[32];
+	int  fd;
+	int  file_fd;
+	int  i;
+	int  rc;
+
+	(void)state; /* unused */
+
+	printf("\n-- INIT of test_prefetch --\n");
+
+	printf("Opening path '%s'\n", mnt_path);
+	fd = open(mnt_path, O_DIRECTORY, O_RDWR);
+	assert_return_code(fd, errno);
+
+	printf("\n-- START of test_prefetch --\n");
+
+	printf("\ncreating directory '/pf'\n");
+	rc = mkdirat(fd, "pf", S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
+	assert_return_code(rc, errno);
+
+	for (i = 0; i < PREFETCH_DIR_NR; i++) {
+		snprintf(path, sizeof(path), "pf/d%d", i);
+		printf("\ncreating directory '/%s'\n", path);
+		rc = mkdirat(fd, path, S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
+		assert_return_code(rc, errno);
+	}
+
+	/* The miss on '/pf/d0' queues '/pf' for prefetching, which adds its other children */
+	for (i = 0; i < PREFETCH_DIR_NR; i++) {
+		snprintf(path, sizeof(path), "pf/d%d/foo", i);
+		printf("\ncreating empty file '/%s'\n", path);
+		file_fd = openat(fd, path, O_WRONLY | O_CREAT | O_TRUNC,
+				 S_IRWXU | S_IRGRP | S_IROTH);
+		assert_return_code(file_fd, errno);
+		rc = close(file_fd);
+		assert_return_code(rc, errno);
+
+		/* Give the prefetcher the time to enumerate '/pf' */
+		if (i == 0)
+			sleep(2);
+	}
+
+	for (i = 0; i < PREFETCH_DIR_NR; i++) {
+		snprintf(path, sizeof(path), "pf/d%d/foo", i);
+		printf("\nremoving file '/%s'\n", path);
+		rc = unlinkat(fd, path, 0);
+		assert_return_code(rc, errno);
+
+		snprintf(path, sizeof(path), "pf/d%d", i);
+		printf("\nremoving directory '/%s'\n", path);
+		rc = unlinkat(fd, path, AT_REMOVEDIR);
+		assert_return_code(rc, errno);
+	}
+
+	printf("\nremoving directory '/pf'\n");
+	rc = unlinkat(fd, "pf", AT_REMOVEDIR);
+	assert_return_code(rc, errno);
+
+	printf("\n-- END of test_prefetch --\n");
+
+	printf("Closing fd of path '%s'\n", mnt_path);
+	rc = close(fd);
+	assert_return_code(rc, errno);
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -425,7 +496,8 @@ main(int argc, char *argv[])
 				     cmocka_unit_test(test_rename),
 				     cmocka_unit_test(test_open_close),
 				     cmocka_unit_test(test_dup),
-				     cmocka_unit_test(test_garbage_collector)};
+				     cmocka_unit_test(test_garbage_collector),
+				     cmocka_unit_test(test_prefetch)};
 	struct CMUnitTest test[1];
 
 	d_register_alt_assert(mock_assert);
@@ -0,0 +1,236 @@
+/**
+ * (C) Copyright 2025 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/*
+ * Scaling benchmark of the collective RPC fan-out.
+ *
+ * It grows the primary group of a single server process (over the local
+ * transport, no RPC is actually sent) and, for each group size and excluded
+ * rank pattern, reports:
+ * - the encoded size of the excluded ranks in the corpc header, plain vs
+ *   compact (runs of consecutive ranks);
+ * - the cost of computing the children of a rank in the tree, for the first
+ *   hop (topology built) and for the following ones (topology cached).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <getopt.h>
+
+#include <cart/api.h>
+
+/* Testing internal interfaces */
+#include <cart/crt_internal.h>
+
+enum {
+	EXCL_NONE,
+	/* a block of 1/8 of the ranks, e.g. a rack is down */
+	EXCL_BLOCK,
+	/* one rank out of 16, e.g. one engine per node is down */
+	EXCL_STRIDE,
+	EXCL_MAX,
+};
+
+static const char *excl_names[EXCL_MAX] = {"none", "block", "stride"};
+
+static d_rank_list_t *
+excl_ranks_alloc(int pattern, uint32_t grp_size)
+{
+	d_rank_list_t	*ranks;
+	uint32_t	 nr = 0;
+	d_rank_t	 r;
+
+	ranks = d_rank_list_alloc(grp_size);
+	if (ranks == NULL)
+		return NULL;
+
+	/* rank 0 is the root, never excluded */
+	for (r = 1; r < grp_size; r++) {
+		switch (pattern) {
+		case EXCL_BLOCK:
+			if (r >= grp_size / 2 && r < grp_size / 2 + grp_size / 8)
+				ranks->rl_ranks[nr++] = r;
+			break;
+		case EXCL_STRIDE:
+			if (r % 16 == 15)
+				ranks->rl_ranks[nr++] = r;
+			break;
+		default:
+			break;
+		}
+	}
+	ranks->rl_nr = nr;
+
+	return ranks;
+}
+
+static int
+bench_one(struct crt_grp_priv *grp_priv, uint32_t grp_size, int pattern, int tree_topo)
+{
+	d_rank_list_t	*excl;
+	d_rank_list_t	*children;
+	uint32_t	 nruns;
+	uint32_t	 plain;
+	uint32_t	 compact;
+	uint32_t	 hops = 0;
+	uint32_t	 i = 0;
+	uint64_t	 start;
+	uint64_t	 cold;
+	uint64_t	 warm;
+	d_rank_t	 self;
+	int		 rc;
+
+	excl = excl_ranks_alloc(pattern, grp_size);
+	if (excl == NULL)
+		return -DER_NOMEM;
+
+	plain   = (excl->rl_nr + 1) * sizeof(uint32_t);
+	compact = crt_rank_set_size(excl, &nruns);
+
+	/* the root computes its children first, nothing cached yet */
+	start = d_timeus_secdiff(0);
+	rc = crt_tree_get_children(grp_priv, grp_priv->gp_membs_ver, false, excl, tree_topo,
+				   0, 0, &children, NULL);
+	cold = d_timeus_secdiff(0) - start;
+	if (rc != 0)
+		D_GOTO(out, rc);
+	d_rank_list_free(children);
+
+	/* then every other rank of the tree, as each hop of the broadcast does */
+	start = d_timeus_secdiff(0);
+	for (self = 1; self < grp_size; self++) {
+		/* excl is sorted */
+		if (i < excl->rl_nr && excl->rl_ranks[i] == self) {
+			i++;
+			continue;
+		}
+		rc = crt_tree_get_children(grp_priv, grp_priv->gp_membs_ver, false, excl,
+					   tree_topo, 0, self, &children, NULL);
+		if (rc != 0)
+			D_GOTO(out, rc);
+		d_rank_list_free(children);
+		hops++;
+	}
+	warm = d_timeus_secdiff(0) - start;
+
+	printf("%8u %-7s %8u %10u %10u %8u %12.2f %12.2f\n", grp_size, excl_names[pattern],
+	       excl->rl_nr, plain, compact, nruns, (double)cold,
+	       hops ? (double)warm / hops : 0.0);
+out:
+	d_rank_list_free(excl);
+	return rc;
+}
+
+static void
+print_usage(const char *prog)
+{
+	printf("Usage: %s [-n max_ranks] [-r tree_ratio]\n"
+	       "  -n, --ranks=N    largest simulated group (default 16384)\n"
+	       "  -r, --ratio=N    branch ratio of the knomial tree (default 4)\n",
+	       prog);
+}
+
+int
+main(int argc, char **argv)
+{
+	static struct option	 long_ops[] = {
+		{"ranks",	required_argument,	NULL,	'n'},
+		{"ratio",	required_argument,	NULL,	'r'},
+		{"help",	no_argument,		NULL,	'h'},
+		{NULL,		0,			NULL,	0},
+	};
+	struct crt_grp_priv	*grp_priv;
+	crt_context_t		 ctx;
+	uint32_t		 max_ranks = 16384;
+	uint32_t		 ratio = 4;
+	uint32_t		 grp_size;
+	char			*uri = NULL;
+	d_rank_t		 rank = 1;
+	int			 pattern;
+	int			 rc;
+	int			 opt;
+
+	while ((opt = getopt_long(argc, argv, "n:r:h", long_ops, NULL)) != -1) {
+		switch (opt) {
+		case 'n':
+			max_ranks = strtoul(optarg, NULL, 0);
+			break;
+		case 'r':
+			ratio = strtoul(optarg, NULL, 0);
+			break;
+		case 'h':
+			print_usage(argv[0]);
+			return 0;
+		default:
+			print_usage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (max_ranks < 64 || ratio < CRT_TREE_MIN_RATIO || ratio > CRT_TREE_MAX_RATIO) {
+		print_usage(argv[0]);
+		return 1;
+	}
+
+	/* local transport, the simulated ranks are never contacted */
+	d_setenv("D_PROVIDER", "ofi+tcp", 0);
+	d_setenv("D_INTERFACE", "lo", 0);
+	d_setenv("CRT_CORPC_RANK_RUNS", "1", 0);
+
+	rc = crt_init(NULL, CRT_FLAG_BIT_SERVER | CRT_FLAG_BIT_AUTO_SWIM_DISABLE);
+	if (rc != 0) {
+		fprintf(stderr, "crt_init failed: " DF_RC "\n", DP_RC(rc));
+		return 1;
+	}
+
+	rc = crt_context_create(&ctx);
+	if (rc != 0) {
+		fprintf(stderr, "crt_context_create failed: " DF_RC "\n", DP_RC(rc));
+		D_GOTO(out_fini, rc);
+	}
+
+	rc = crt_rank_self_set(0, 1 /* group_version_min */);
+	if (rc == 0)
+		rc = crt_self_uri_get(0, &uri);
+	if (rc != 0) {
+		fprintf(stderr, "failed to set up self rank: " DF_RC "\n", DP_RC(rc));
+		D_GOTO(out_ctx, rc);
+	}
+
+	grp_priv = crt_grp_pub2priv(NULL);
+
+	printf("%8s %-7s %8s %10s %10s %8s %12s %12s\n", "ranks", "excl", "excluded",
+	       "plain(B)", "compact(B)", "runs", "cold(us)", "hop(us)");
+
+	for (grp_size = 64; grp_size <= max_ranks; grp_size *= 2) {
+		/* all simulated ranks share the self URI */
+		for (; rank < grp_size; rank++) {
+			rc = crt_group_primary_rank_add(ctx, NULL, rank, uri);
+			if (rc != 0) {
+				fprintf(stderr, "failed to add rank %u: " DF_RC "\n", rank,
+					DP_RC(rc));
+				D_GOTO(out_uri, rc);
+			}
+		}
+
+		for (pattern = 0; pattern < EXCL_MAX; pattern++) {
+			rc = bench_one(grp_priv, grp_size, pattern,
+				       crt_tree_topo(CRT_TREE_KNOMIAL, ratio));
+			if (rc != 0) {
+				fprintf(stderr, "group size %u, pattern %s failed: " DF_RC "\n",
+					grp_size, excl_names[pattern], DP_RC(rc));
+				D_GOTO(out_uri, rc);
+			}
+		}
+	}
+
+out_uri:
+	D_FREE(uri);
+out_ctx:
+	crt_context_destroy(ctx, 1);
+out_fini:
+	crt_finalize();
+	return rc == 0 ? 0 : 1;
+}
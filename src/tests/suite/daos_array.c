@@ -932,6 +932,7 @@ strided_array(void **state)
 	daos_obj_id_t	oid;
 	daos_handle_t	oh;
 	daos_array_iod_t iod;
+	daos_array_siod_t siod;
 	d_sg_list_t	sgl;
 	int		*buf;
 	daos_size_t	i, j, nerrors = 0;
@@ -1000,6 +1001,53 @@ strided_array(void **state)
 		}
 	}
 
+	/** Read the same layout with a strided descriptor */
+	siod.arr_idx    = 0;
+	siod.arr_len    = sizeof(int);
+	siod.arr_stride = 2 * sizeof(int);
+	siod.arr_count  = NUM;
+
+	for (i = 0; i < NUM * 2; i++)
+		buf[i] = -1;
+
+	rc = daos_array_read_strided(oh, DAOS_TX_NONE, &siod, &sgl, NULL);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(siod.arr_nr_short_read, 0);
+	assert_int_equal(siod.arr_nr_read, NUM * sizeof(int));
+
+	for (i = 0; i < NUM * 2; i++) {
+		if (buf[i] != (i % 2 == 0 ? (int)i + 1 : -1)) {
+			printf("%zu: strided read %d\n", i, buf[i]);
+			nerrors++;
+		}
+	}
+
+	/** Strided write to the gaps, then read everything back */
+	siod.arr_idx = sizeof(int);
+	for (i = 0; i < NUM * 2; i++)
+		buf[i] = i + 1;
+	sgl.sg_nr = 1;
+	d_iov_set(&sgl.sg_iovs[0], buf, NUM * sizeof(int));
+	rc = daos_array_write_strided(oh, DAOS_TX_NONE, &siod, &sgl, NULL);
+	assert_rc_equal(rc, 0);
+
+	for (i = 0; i < NUM * 2; i++)
+		buf[i] = -1;
+	siod.arr_idx    = 0;
+	siod.arr_len    = 2 * NUM * sizeof(int);
+	siod.arr_stride = siod.arr_len;
+	siod.arr_count  = 1;
+	d_iov_set(&sgl.sg_iovs[0], buf, 2 * NUM * sizeof(int));
+	rc = daos_array_read_strided(oh, DAOS_TX_NONE, &siod, &sgl, NULL);
+	assert_rc_equal(rc, 0);
+
+	for (i = 0; i < NUM * 2; i++) {
+		if (buf[i] != (int)(i % 2 == 0 ? i + 1 : i / 2 + 1)) {
+			printf("%zu: read after strided write %d\n", i, buf[i]);
+			nerrors++;
+		}
+	}
+
 	if (nerrors)
 		print_message("Data verification found %zu errors\n", nerrors);
 
@@ -3103,6 +3103,82 @@ dtx_sub_teardown(void **state)
 	return rc;
 }
 
+#define DTX_CONT_CNT	4
+
+static void
+dtx_42(void **state)
+{
+	test_arg_t	*arg = *state;
+	const char	*dkey = dts_dtx_dkey;
+	const char	*akey = dts_dtx_akey;
+	daos_handle_t	 cohs[DTX_CONT_CNT];
+	daos_handle_t	 th = { 0 };
+	daos_obj_id_t	 oid;
+	struct ioreq	 reqs[DTX_CONT_CNT];
+	uuid_t		 uuid;
+	char		 strs[DTX_CONT_CNT][DAOS_UUID_STR_SIZE];
+	uint32_t	 val;
+	int		 i;
+
+	FAULT_INJECTION_REQUIRED();
+
+	print_message("DTX42: async batched commit across containers\n");
+
+	if (!test_runable(arg, 4))
+		skip();
+
+	/*
+	 * A few TXs per container, too few to trigger the batched commit by count. With
+	 * DAOS_DTX_POOL_COALESCE set on the engines, they are committed together via the
+	 * pool level batched commit, otherwise per container.
+	 */
+	print_message("Transactional update in %d containers\n", DTX_CONT_CNT);
+
+	for (i = 0, val = 0; i < DTX_CONT_CNT; i++, val++) {
+		MUST(daos_cont_create(arg->pool.poh, &uuid, NULL, NULL));
+		uuid_unparse(uuid, strs[i]);
+		MUST(daos_cont_open(arg->pool.poh, strs[i], DAOS_COO_RW, &cohs[i], NULL, NULL));
+
+		oid = daos_test_oid_gen(cohs[i], OC_RP_2G2, 0, 0, arg->myrank);
+		ioreq_init(&reqs[i], cohs[i], oid, DAOS_IOD_ARRAY, arg);
+
+		MUST(daos_tx_open(cohs[i], &th, 0, NULL));
+		insert_single(dkey, akey, 0, &val, sizeof(val), th, &reqs[i]);
+		MUST(daos_tx_commit(th, NULL));
+		MUST(daos_tx_close(th, NULL));
+	}
+
+	print_message("Sleep %d seconds for the batched commit...\n",
+		      DTX_COMMIT_THRESHOLD_AGE + 3);
+	sleep(DTX_COMMIT_THRESHOLD_AGE + 3);
+
+	/* Without DTX refresh, the data is only readable if its DTX has been committed. */
+	par_barrier(PAR_COMM_WORLD);
+	daos_fail_loc_set(DAOS_DTX_NO_RETRY | DAOS_FAIL_ALWAYS);
+	if (arg->myrank == 0)
+		daos_debug_set_params(arg->group, -1, DMG_KEY_FAIL_LOC,
+				      DAOS_DTX_NO_RETRY | DAOS_FAIL_ALWAYS, 0, NULL);
+	par_barrier(PAR_COMM_WORLD);
+
+	for (i = 0; i < DTX_CONT_CNT; i++) {
+		val = (uint32_t)-1;
+		lookup_single(dkey, akey, 0, &val, sizeof(val), DAOS_TX_NONE, &reqs[i]);
+		assert_int_equal(val, i);
+		ioreq_fini(&reqs[i]);
+	}
+
+	par_barrier(PAR_COMM_WORLD);
+	daos_fail_loc_set(0);
+	if (arg->myrank == 0)
+		daos_debug_set_params(arg->group, -1, DMG_KEY_FAIL_LOC, 0, 0, NULL);
+	par_barrier(PAR_COMM_WORLD);
+
+	for (i = 0; i < DTX_CONT_CNT; i++) {
+		MUST(daos_cont_close(cohs[i], NULL));
+		MUST(daos_cont_destroy(arg->pool.poh, strs[i], 0, NULL));
+	}
+}
+
 static const struct CMUnitTest dtx_tests[] = {
 	{"DTX0: SV fetch against EC obj",
 	 dtx_0, NULL, test_case_teardown},
@@ -3193,6 +3269,8 @@ static const struct CMUnitTest dtx_tests[] = {
 	 dtx_40, NULL, test_case_teardown},
 	{"DTX41: uncertain check - miss abort with delay",
 	 dtx_41, NULL, test_case_teardown},
+	{"DTX42: async batched commit across containers",
+	 dtx_42, NULL, test_case_teardown},
 };
 
 static int
@@ -352,6 +352,129 @@ kv_cond_ops(void **state)
 	print_message("all good\n");
 } /* End simple_put_get */
 
+#define KV_MULTI_NR	16
+
+static void
+kv_multi_init(const char *prefix, char key_bufs[][32], const char **keys, daos_size_t *sizes,
+	      const void **bufs, int *vals, int *rcs, int base)
+{
+	int i;
+
+	for (i = 0; i < KV_MULTI_NR; i++) {
+		sprintf(key_bufs[i], "%s_%d", prefix, i);
+		keys[i]  = key_bufs[i];
+		vals[i]  = base + i;
+		sizes[i] = sizeof(int);
+		bufs[i]  = &vals[i];
+		rcs[i]   = -DER_MISC;
+	}
+}
+
+static void
+kv_put_multi(void **state)
+{
+	test_arg_t	*arg = *state;
+	daos_obj_id_t	oid;
+	daos_handle_t	oh;
+	daos_handle_t	th;
+	char		key_bufs[KV_MULTI_NR][32];
+	const char	*keys[KV_MULTI_NR];
+	daos_size_t	sizes[KV_MULTI_NR];
+	const void	*bufs[KV_MULTI_NR];
+	int		vals[KV_MULTI_NR];
+	int		rcs[KV_MULTI_NR];
+	int		val_out;
+	size_t		size;
+	int		num_keys;
+	int		i;
+	int		rc;
+
+	oid = daos_test_oid_gen(arg->coh, OC_SX, type, 0, arg->myrank);
+
+	/** open the object */
+	rc = daos_kv_open(arg->coh, oid, DAOS_OO_RW, &oh, NULL);
+	assert_rc_equal(rc, 0);
+
+	print_message("Put %d keys in one batch (internal TX)\n", KV_MULTI_NR);
+	kv_multi_init("mkey", key_bufs, keys, sizes, bufs, vals, rcs, 0);
+	rc = daos_kv_put_multi(oh, DAOS_TX_NONE, 0, KV_MULTI_NR, keys, sizes, bufs, rcs, NULL);
+	assert_rc_equal(rc, 0);
+	for (i = 0; i < KV_MULTI_NR; i++) {
+		assert_rc_equal(rcs[i], 0);
+		size = sizeof(int);
+		rc = daos_kv_get(oh, DAOS_TX_NONE, 0, keys[i], &size, &val_out, NULL);
+		assert_rc_equal(rc, 0);
+		assert_int_equal(size, sizeof(int));
+		assert_int_equal(val_out, i);
+	}
+	list_keys(oh, &num_keys);
+	assert_int_equal(num_keys, KV_MULTI_NR);
+
+	print_message("Conditional batch INSERT with one existing Key (should fail)\n");
+	kv_multi_init("nkey", key_bufs, keys, sizes, bufs, vals, rcs, 100);
+	keys[KV_MULTI_NR / 2] = "mkey_0";
+	rc = daos_kv_put_multi(oh, DAOS_TX_NONE, DAOS_COND_KEY_INSERT, KV_MULTI_NR, keys, sizes,
+			       bufs, rcs, NULL);
+	assert_rc_equal(rc, -DER_EXIST);
+	/** The failed key reports its own error, the internal TX fails all the others. */
+	for (i = 0; i < KV_MULTI_NR; i++) {
+		if (i == KV_MULTI_NR / 2)
+			assert_rc_equal(rcs[i], -DER_EXIST);
+		else
+			assert_int_not_equal(rcs[i], 0);
+	}
+	print_message("Nothing of the failed batch is visible\n");
+	for (i = 0; i < KV_MULTI_NR; i++) {
+		if (i == KV_MULTI_NR / 2)
+			continue;
+		size = sizeof(int);
+		rc = daos_kv_get(oh, DAOS_TX_NONE, DAOS_COND_KEY_GET, keys[i], &size, &val_out,
+				 NULL);
+		assert_rc_equal(rc, -DER_NONEXIST);
+	}
+	size = sizeof(int);
+	rc = daos_kv_get(oh, DAOS_TX_NONE, 0, "mkey_0", &size, &val_out, NULL);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(val_out, 0);
+
+	print_message("Put a batch in a user TX\n");
+	rc = daos_tx_open(arg->coh, &th, 0, NULL);
+	assert_rc_equal(rc, 0);
+	kv_multi_init("tkey", key_bufs, keys, sizes, bufs, vals, rcs, 200);
+	rc = daos_kv_put_multi(oh, th, 0, KV_MULTI_NR, keys, sizes, bufs, rcs, NULL);
+	assert_rc_equal(rc, 0);
+	for (i = 0; i < KV_MULTI_NR; i++) {
+		assert_rc_equal(rcs[i], 0);
+		size = sizeof(int);
+		rc = daos_kv_get(oh, DAOS_TX_NONE, DAOS_COND_KEY_GET, keys[i], &size, &val_out,
+				 NULL);
+		assert_rc_equal(rc, -DER_NONEXIST);
+	}
+	rc = daos_tx_commit(th, NULL);
+	assert_rc_equal(rc, 0);
+	rc = daos_tx_close(th, NULL);
+	assert_rc_equal(rc, 0);
+
+	print_message("The user TX batch is visible after commit\n");
+	for (i = 0; i < KV_MULTI_NR; i++) {
+		size = sizeof(int);
+		rc = daos_kv_get(oh, DAOS_TX_NONE, 0, keys[i], &size, &val_out, NULL);
+		assert_rc_equal(rc, 0);
+		assert_int_equal(val_out, 200 + i);
+	}
+	list_keys(oh, &num_keys);
+	assert_int_equal(num_keys, KV_MULTI_NR * 2);
+
+	print_message("Destroying KV\n");
+	rc = daos_kv_destroy(oh, DAOS_TX_NONE, NULL);
+	assert_rc_equal(rc, 0);
+
+	rc = daos_kv_close(oh, NULL);
+	assert_rc_equal(rc, 0);
+
+	print_message("all good\n");
+}
+
 static const struct CMUnitTest kv_tests[] = {
 	{"KV: Object Put/GET (blocking)",
 	 simple_put_get, async_disable, NULL},
@@ -361,6 +484,8 @@ static const struct CMUnitTest kv_tests[] = {
 	 simple_put_get, async_enable, NULL},
 	{"KV: Object Conditional Ops (blocking)",
 	 kv_cond_ops, async_disable, NULL},
+	{"KV: Object Multi Put (blocking)",
+	 kv_put_multi, async_disable, NULL},
 };
 
 int
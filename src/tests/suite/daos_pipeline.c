@@ -1610,6 +1610,270 @@ simple_pipeline_arrays(void **state)
 	assert_rc_equal(rc, 0);
 }
 
+/** more records than a batch of the engine (PIPELINE_BATCH_DEF), with some left over */
+#define BATCH_NR_RECS	200
+
+struct batch_pipeline_res {
+	uint32_t	nr;
+	char		dkeys[BATCH_NR_RECS][STRING_MAX_LEN];
+	uint64_t	ages[BATCH_NR_RECS];
+	double		aggr;
+};
+
+static char *batch_owners[] = {"Benny", "Harold", "Gwen"};
+
+static void
+insert_batch_records(daos_handle_t oh, char *fields[])
+{
+	d_iov_t		dkey;
+	d_sg_list_t	sgls[NR_IODS];
+	d_iov_t		iovs[NR_IODS];
+	daos_iod_t	iods[NR_IODS];
+	char		name[STRING_MAX_LEN];
+	char		*strdata[NR_IODS - 1];
+	uint64_t	age;
+	uint32_t	i, j;
+	int		rc;
+
+	for (i = 0; i < BATCH_NR_RECS; i++) {
+		snprintf(name, sizeof(name), "rec%03u", i);
+		d_iov_set(&dkey, name, strlen(name));
+
+		strdata[0] = batch_owners[i % 3];
+		strdata[1] = (i % 2) ? "cat" : "dog";
+		strdata[2] = (i % 5) ? "f" : "m";
+		age        = i % 13;
+
+		for (j = 0; j < NR_IODS; j++) {
+			sgls[j].sg_nr     = 1;
+			sgls[j].sg_nr_out = 0;
+			sgls[j].sg_iovs   = &iovs[j];
+			if (j < NR_IODS - 1)
+				d_iov_set(&iovs[j], strdata[j], strlen(strdata[j]) + 1);
+			else
+				d_iov_set(&iovs[j], &age, sizeof(age));
+
+			d_iov_set(&iods[j].iod_name, (void *)fields[j], strlen(fields[j]));
+			iods[j].iod_nr    = 1;
+			iods[j].iod_size  = iovs[j].iov_len;
+			iods[j].iod_recxs = NULL;
+			iods[j].iod_type  = DAOS_IOD_SINGLE;
+		}
+
+		rc = daos_obj_update(oh, DAOS_TX_NONE, 0, &dkey, NR_IODS, iods, sgls, NULL);
+		assert_rc_equal(rc, 0);
+	}
+}
+
+/** run a pipeline to the end, asking for at most max_kds records per call */
+static void
+run_batch_pipeline(daos_handle_t coh, daos_handle_t oh, daos_pipeline_t *pipeline,
+		   char *fields[], int nr_aggr, uint32_t max_kds, struct batch_pipeline_res *res)
+{
+	daos_iod_t		iods[NR_IODS];
+	daos_key_desc_t		kds[BATCH_NR_RECS];
+	daos_size_t		recx_size[NR_IODS * BATCH_NR_RECS];
+	daos_anchor_t		anchor = {0};
+	daos_pipeline_stats_t	stats  = {0};
+	d_sg_list_t		sgl_keys;
+	d_sg_list_t		sgl_recx;
+	d_sg_list_t		sgl_aggr;
+	d_iov_t			iov_keys;
+	d_iov_t			iov_recx;
+	d_iov_t			iov_aggr;
+	char			*buf_keys;
+	char			*buf_recx;
+	double			aggr = 0;
+	uint32_t		nr_iods;
+	uint32_t		nr_kds;
+	uint32_t		i, j;
+	int			rc;
+
+	for (i = 0; i < NR_IODS; i++) {
+		iods[i].iod_nr    = 1;
+		iods[i].iod_size  = STRING_MAX_LEN;
+		iods[i].iod_recxs = NULL;
+		iods[i].iod_type  = DAOS_IOD_SINGLE;
+		d_iov_set(&iods[i].iod_name, (void *)fields[i], strlen(fields[i]));
+	}
+
+	buf_keys = malloc(max_kds * STRING_MAX_LEN);
+	assert_non_null(buf_keys);
+	d_iov_set(&iov_keys, buf_keys, max_kds * STRING_MAX_LEN);
+	sgl_keys.sg_nr   = 1;
+	sgl_keys.sg_iovs = &iov_keys;
+
+	buf_recx = malloc(NR_IODS * max_kds * STRING_MAX_LEN);
+	assert_non_null(buf_recx);
+	d_iov_set(&iov_recx, buf_recx, NR_IODS * max_kds * STRING_MAX_LEN);
+	sgl_recx.sg_nr   = 1;
+	sgl_recx.sg_iovs = &iov_recx;
+
+	d_iov_set(&iov_aggr, &aggr, sizeof(aggr));
+	sgl_aggr.sg_nr   = nr_aggr;
+	sgl_aggr.sg_iovs = &iov_aggr;
+
+	memset(res, 0, sizeof(*res));
+	while (!daos_anchor_is_eof(&anchor)) {
+		char *dkey, *rec;
+
+		nr_kds             = max_kds;
+		nr_iods            = NR_IODS;
+		sgl_keys.sg_nr_out = 0;
+		sgl_recx.sg_nr_out = 0;
+		sgl_aggr.sg_nr_out = 0;
+		rc = daos_pipeline_run(coh, oh, pipeline, DAOS_TX_NONE, 0, NULL, &nr_iods, iods,
+				       &anchor, &nr_kds, kds, &sgl_keys, &sgl_recx, recx_size,
+				       &sgl_aggr, &stats, NULL);
+		assert_rc_equal(rc, 0);
+		assert_true(nr_kds <= max_kds);
+		assert_true(res->nr + nr_kds <= BATCH_NR_RECS);
+
+		dkey = buf_keys;
+		rec  = buf_recx;
+		for (i = 0; i < nr_kds; i++) {
+			assert_true(kds[i].kd_key_len < STRING_MAX_LEN);
+			memcpy(res->dkeys[res->nr], dkey, kds[i].kd_key_len);
+			dkey += kds[i].kd_key_len;
+			for (j = 0; j < NR_IODS - 1; j++)
+				rec += recx_size[i * NR_IODS + j];
+			res->ages[res->nr] = *((uint64_t *)rec);
+			rec += sizeof(uint64_t);
+			res->nr++;
+		}
+		if (nr_aggr > 0)
+			res->aggr = aggr;
+	}
+
+	free(buf_keys);
+	free(buf_recx);
+}
+
+static void
+check_batch_pipeline_res(struct batch_pipeline_res *a, struct batch_pipeline_res *b)
+{
+	uint32_t i;
+
+	assert_int_equal(a->nr, b->nr);
+	for (i = 0; i < a->nr; i++) {
+		assert_string_equal(a->dkeys[i], b->dkeys[i]);
+		assert_int_equal(a->ages[i], b->ages[i]);
+	}
+	assert_true(a->aggr == b->aggr);
+}
+
+static void
+batch_pipeline(void **state)
+{
+	test_arg_t			*arg = *state;
+	daos_obj_id_t			oid;
+	daos_handle_t			coh, oh;
+	daos_pipeline_t			pipelines[3];
+	static char			*fields[NR_IODS] = {"Owner", "Species", "Sex", "Age"};
+	/** filter, filter + aggregation, integer filter */
+	int				nr_aggr[3] = {0, 1, 0};
+	/** a full batch per call, and fewer records per call than a batch */
+	uint32_t			max_kds[2] = {64, 5};
+	struct batch_pipeline_res	*res[2][2][3];
+	struct batch_pipeline_res	*batch;
+	uint32_t			nr_benny = 0;
+	uint32_t			nr_odd   = 0;
+	uint64_t			sum_benny = 0;
+	uint32_t			i, k, m, p;
+	int				rc;
+
+	rc = daos_cont_create_with_label(arg->pool.poh, "batch_pipeline_cont", NULL, NULL, NULL);
+	assert_rc_equal(rc, 0);
+
+	rc = daos_cont_open(arg->pool.poh, "batch_pipeline_cont", DAOS_COO_RW, &coh, NULL, NULL);
+	assert_rc_equal(rc, 0);
+
+	oid.hi = 0;
+	oid.lo = 5;
+	daos_obj_generate_oid(coh, &oid, DAOS_OT_MULTI_LEXICAL, OC_SX, 0, 0);
+
+	rc = daos_obj_open(coh, oid, DAOS_OO_RW, &oh, NULL);
+	assert_rc_equal(rc, 0);
+
+	insert_batch_records(oh, fields);
+	for (i = 0; i < BATCH_NR_RECS; i++) {
+		if (i % 3 == 0) {
+			nr_benny++;
+			sum_benny += i % 13;
+		}
+		if ((i % 13) & 1)
+			nr_odd++;
+	}
+
+	/** FILTER "Owner == Benny" */
+	daos_pipeline_init(&pipelines[0]);
+	build_simple_pipeline_one(&pipelines[0]);
+	/** FILTER "Owner == Benny", AGGREGATE "SUM(age)" */
+	daos_pipeline_init(&pipelines[1]);
+	build_simple_pipeline_three(&pipelines[1]);
+	/** FILTER "Age & 1" */
+	daos_pipeline_init(&pipelines[2]);
+	build_simple_pipeline_four(&pipelines[2]);
+	for (p = 0; p < 3; p++) {
+		rc = daos_pipeline_check(&pipelines[p]);
+		assert_rc_equal(rc, 0);
+	}
+
+	/** mode 0 is the default batch mode, mode 1 evaluates one record at a time */
+	for (m = 0; m < 2; m++) {
+		print_message("running the pipelines %s\n",
+			      m == 0 ? "in batch mode" : "one record at a time");
+		if (m == 1 && arg->myrank == 0)
+			daos_debug_set_params(arg->group, -1, DMG_KEY_FAIL_LOC,
+					      DAOS_PIPELINE_NO_BATCH | DAOS_FAIL_ALWAYS, 0, NULL);
+		par_barrier(PAR_COMM_WORLD);
+
+		for (k = 0; k < 2; k++) {
+			for (p = 0; p < 3; p++) {
+				res[m][k][p] = calloc(1, sizeof(struct batch_pipeline_res));
+				assert_non_null(res[m][k][p]);
+				run_batch_pipeline(coh, oh, &pipelines[p], fields, nr_aggr[p],
+						   max_kds[k], res[m][k][p]);
+			}
+		}
+	}
+	if (arg->myrank == 0)
+		daos_debug_set_params(arg->group, -1, DMG_KEY_FAIL_LOC, 0, 0, NULL);
+	par_barrier(PAR_COMM_WORLD);
+
+	/** both modes return the same records, whatever the number of records per call */
+	for (p = 0; p < 3; p++) {
+		batch = res[0][0][p];
+		check_batch_pipeline_res(batch, res[0][1][p]);
+		check_batch_pipeline_res(batch, res[1][0][p]);
+		check_batch_pipeline_res(batch, res[1][1][p]);
+	}
+
+	assert_int_equal(res[0][0][0]->nr, nr_benny);
+	/** aggregations return the first record passing the filters */
+	assert_int_equal(res[0][0][1]->nr, 1);
+	assert_true(res[0][0][1]->aggr == (double)sum_benny);
+	assert_int_equal(res[0][0][2]->nr, nr_odd);
+	for (i = 0; i < res[0][0][2]->nr; i++)
+		assert_true(res[0][0][2]->ages[i] & 1);
+
+	for (m = 0; m < 2; m++)
+		for (k = 0; k < 2; k++)
+			for (p = 0; p < 3; p++)
+				free(res[m][k][p]);
+	for (p = 0; p < 3; p++) {
+		rc = free_pipeline(&pipelines[p]);
+		assert_rc_equal(rc, 0);
+	}
+
+	rc = daos_obj_close(oh, NULL);
+	assert_rc_equal(rc, 0);
+	rc = daos_cont_close(coh, NULL);
+	assert_rc_equal(rc, 0);
+	rc = daos_cont_destroy(arg->pool.poh, "batch_pipeline_cont", 0, NULL);
+	assert_rc_equal(rc, 0);
+}
+
 #define FSIZE		15
 #define NUM_DKEYS	1024
 static time_t		ts;
@@ -2000,6 +2264,8 @@ static const struct CMUnitTest pipeline_tests[] = {
 	 simple_pipeline_arrays, async_disable, NULL},
 	{"DAOS_PIPELINE4: Testing simple pipeline for DFS Entry",
 	 simple_pipeline_dfs, async_disable, NULL},
+	{"DAOS_PIPELINE5: Comparing batch and per-record evaluation",
+	 batch_pipeline, async_disable, NULL},
 };
 
 int
@@ -10,6 +10,7 @@
 
 #include <getopt.h>
 #include <string.h>
+#include <gurt/list.h>
 #include <daos/metrics.h>
 #include <gurt/telemetry_common.h>
 #include <gurt/telemetry_consumer.h>
@@ -22,6 +23,7 @@ print_usage(const char *prog_name)
 	       "--srv_idx, -S\n"
 	       "\tShow telemetry data from this I/O Engine local index "
 	       "(default 0)\n"
+	       "\tA comma separated list of indexes may be given\n"
 	       "--path, -p\n"
 	       "\tDisplay metrics at or below the specified path\n"
 	       "\tDefault is root directory\n"
@@ -37,6 +39,10 @@ print_usage(const char *prog_name)
 	       "\tDisplay associated metric metadata\n"
 	       "--type, -T\n"
 	       "\tDisplay metric type\n"
+	       "--tail, -L\n"
+	       "\tMerge the log-linear latency histograms found at or below\n"
+	       "\tthe path across all targets and all selected I/O Engines,\n"
+	       "\tand display their tail percentiles\n"
 	       "--help, -h\n"
 	       "\tThis help text\n\n"
 	       "Customize the displayed data by specifying one or more "
@@ -63,6 +69,102 @@ print_usage(const char *prog_name)
 	       prog_name);
 }
 
+/** One merged log-linear histogram for --tail */
+struct tail_entry {
+	d_list_t		 te_link;
+	char			*te_path; /** metric path without the tgt_N leaf */
+	struct d_tm_hdr_t	*te_hdr;
+	int			 te_merged; /** number of histograms merged */
+};
+
+static void
+iter_tail(struct d_tm_context *ctx, struct d_tm_node_t *node, int level, char *path, int format,
+	  int opt_fields, void *arg)
+{
+	d_list_t		*head = arg;
+	struct tail_entry	*te;
+	struct d_tm_hdr_t	*hdr = NULL;
+	char			*name;
+	char			*key;
+
+	if (d_tm_get_hdr_histogram(ctx, &hdr, node) != 0)
+		return;
+
+	name = d_tm_get_name(ctx, node);
+	if (name == NULL)
+		name = "(null)";
+
+	/** skip the per-engine root directory so that engines merge together */
+	if (path != NULL) {
+		path = strchr(path, '/');
+		if (path != NULL)
+			path++;
+	}
+
+	/** per-target sensors are merged under their parent directory */
+	if (path == NULL)
+		D_STRNDUP(key, name, D_TM_MAX_NAME_LEN);
+	else if (strncmp(name, "tgt_", 4) == 0)
+		D_STRNDUP(key, path, D_TM_MAX_NAME_LEN);
+	else
+		D_ASPRINTF(key, "%s/%s", path, name);
+	if (key == NULL)
+		goto out;
+
+	d_list_for_each_entry(te, head, te_link) {
+		if (strcmp(te->te_path, key) != 0)
+			continue;
+		if (d_tm_hdr_merge(te->te_hdr, hdr) == 0)
+			te->te_merged++;
+		D_FREE(key);
+		goto out;
+	}
+
+	D_ALLOC_PTR(te);
+	if (te == NULL) {
+		D_FREE(key);
+		goto out;
+	}
+	te->te_path   = key;
+	te->te_hdr    = hdr;
+	te->te_merged = 1;
+	d_list_add_tail(&te->te_link, head);
+	hdr = NULL;
+out:
+	D_FREE(hdr);
+}
+
+static void
+print_tail(d_list_t *head, int format, FILE *stream)
+{
+	struct tail_entry	*te;
+	struct tail_entry	*tmp;
+
+	if (format == D_TM_CSV)
+		fprintf(stream, "name,histograms,samples,p50,p90,p99,p99.9,p99.99\n");
+
+	d_list_for_each_entry_safe(te, tmp, head, te_link) {
+		struct d_tm_hdr_t *hdr = te->te_hdr;
+
+		if (format == D_TM_CSV)
+			fprintf(stream, "%s,%d,%lu,%lu,%lu,%lu,%lu,%lu\n", te->te_path,
+				te->te_merged, d_tm_hdr_count(hdr), d_tm_hdr_percentile(hdr, 50),
+				d_tm_hdr_percentile(hdr, 90), d_tm_hdr_percentile(hdr, 99),
+				d_tm_hdr_percentile(hdr, 99.9), d_tm_hdr_percentile(hdr, 99.99));
+		else if (d_tm_hdr_count(hdr) > 0) {
+			fprintf(stream, "%s: %d histograms, %lu samples", te->te_path,
+				te->te_merged, d_tm_hdr_count(hdr));
+			d_tm_print_hdr(hdr, format, stream);
+			fprintf(stream, "\n");
+		}
+
+		d_list_del(&te->te_link);
+		D_FREE(te->te_path);
+		D_FREE(te->te_hdr);
+		D_FREE(te);
+	}
+}
+
 static int
 process_metrics(int metric_id, char *dirname, int format, int filter, int extra_descriptors,
 		int delay, int num_iter, d_tm_iter_cb_t iter_cb, void *arg)
@@ -91,6 +193,12 @@ process_metrics(int metric_id, char *dirname, int format, int filter, int extra_
 		}
 	}
 
+	if (iter_cb == iter_tail) {
+		/** one pass, the caller prints once all engines are merged */
+		d_tm_iterate(ctx, root, 0, filter, NULL, format, extra_descriptors, iter_cb, arg);
+		D_GOTO(out, rc = 0);
+	}
+
 	if (format == D_TM_CSV)
 		d_tm_print_field_descriptors(extra_descriptors, (FILE *)arg);
 
@@ -131,6 +239,11 @@ main(int argc, char **argv)
 	bool			show_meta = false;
 	bool			show_when_read = false;
 	bool			show_type = false;
+	bool			show_tail = false;
+	char			srv_list[D_TM_MAX_NAME_LEN] = "0";
+	char			*tok;
+	char			*saveptr = NULL;
+	d_list_t		tail_list;
 	int                     srv_idx                    = 0;
 	int			num_iter = 1;
 	int			filter = 0;
@@ -158,6 +271,7 @@ main(int argc, char **argv)
 						       {"meta", no_argument, NULL, 'M'},
 						       {"meminfo", no_argument, NULL, 'm'},
 						       {"type", no_argument, NULL, 'T'},
+						       {"tail", no_argument, NULL, 'L'},
 						       {"read", no_argument, NULL, 'r'},
 						       {"reset", no_argument, NULL, 'e'},
 						       {"jobid", required_argument, NULL, 'j'},
@@ -165,13 +279,13 @@ main(int argc, char **argv)
 						       {"help", no_argument, NULL, 'h'},
 						       {NULL, 0, NULL, 0}};
 
-		opt = getopt_long_only(argc, argv, "S:cCdtsgi:p:D:MmTrj:P:he", long_options, NULL);
+		opt = getopt_long_only(argc, argv, "S:cCdtsgi:p:D:MmTLrj:P:he", long_options, NULL);
 		if (opt == -1)
 			break;
 
 		switch (opt) {
 		case 'S':
-			srv_idx = atoi(optarg);
+			snprintf(srv_list, sizeof(srv_list), "%s", optarg);
 			break;
 		case 'c':
 			filter |= D_TM_COUNTER;
@@ -206,6 +320,9 @@ main(int argc, char **argv)
 		case 'T':
 			show_type = true;
 			break;
+		case 'L':
+			show_tail = true;
+			break;
 		case 'r':
 			show_when_read = true;
 			break;
@@ -229,6 +346,11 @@ main(int argc, char **argv)
 		}
 	}
 
+	if (show_tail) {
+		iter_cb = iter_tail;
+		filter  = D_TM_DURATION | D_TM_STATS_GAUGE;
+	}
+
 	if (iter_cb == NULL)
 		iter_cb = iter_print;
 
@@ -248,16 +370,24 @@ main(int argc, char **argv)
 	else
 		filter |= D_TM_DIRECTORY;
 
+	D_INIT_LIST_HEAD(&tail_list);
 	if (strlen(jobid) > 0) {
-		srv_idx = DC_TM_JOB_ROOT_ID;
+		snprintf(srv_list, sizeof(srv_list), "%d", DC_TM_JOB_ROOT_ID);
 		snprintf(dirname, sizeof(dirname), "%s", jobid);
 	} else if (cli_pid > 0) {
-		srv_idx = d_tm_cli_pid_key(cli_pid);
+		snprintf(srv_list, sizeof(srv_list), "%d", d_tm_cli_pid_key(cli_pid));
 	}
 
 	/* fetch metrics from server side */
-	rc = process_metrics(srv_idx, dirname, format, filter, extra_descriptors, delay, num_iter,
-			     iter_cb, stdout);
+	rc = 0;
+	for (tok = strtok_r(srv_list, ",", &saveptr); tok != NULL && rc == 0;
+	     tok = strtok_r(NULL, ",", &saveptr)) {
+		srv_idx = atoi(tok);
+		rc      = process_metrics(srv_idx, dirname, format, filter, extra_descriptors, delay,
+					  num_iter, iter_cb, show_tail ? (void *)&tail_list : stdout);
+	}
+	if (show_tail)
+		print_tail(&tail_list, format, stdout);
 	if (rc)
 		printf("Unable to attach to the shared memory for the server index: %d"
 		       "\nMake sure to run the I/O Engine with the same index to "
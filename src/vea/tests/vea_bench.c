@@ -0,0 +1,476 @@
+/**
+ * (C) Copyright 2025 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/*
+ * VEA allocation microbenchmark, it measures the latency of small block reserve,
+ * publish and free in a steady state where the allocated extents are freed in
+ * FIFO order once the working set reaches the specified size.
+ */
+
+#define D_LOGFAC	DD_FAC(tests)
+
+#include <stdio.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <getopt.h>
+
+#include <daos/tests_lib.h>
+#include <daos/common.h>
+#include <daos/btree_class.h>
+#include <daos_srv/vea.h>
+#include "../vea_internal.h"
+
+#define VB_BLK_SIZE		(1UL << 12)	/* 4k bytes */
+#define VB_BATCH_MAX		256
+
+#define DF_12U64		"%-12" PRIu64
+#define DF_10U64		"%-10" PRIu64
+
+char		pool_file[PATH_MAX];
+uint64_t	heap_size	= (256UL << 20);	/* 256MB */
+uint64_t	pool_capacity	= (64ULL << 30);	/* 64GB */
+unsigned int	blk_cnt_fixed;				/* 0: random in [1, VEA_MAG_MAX_CLASS] */
+unsigned int	batch_sz	= 16;			/* reservations per publish */
+unsigned int	working_set	= 65536;		/* extents kept allocated */
+uint64_t	op_total	= 1000000;		/* total reservations */
+unsigned int	rand_seed;
+
+enum {
+	VB_OP_RESERVE	= 0,
+	VB_OP_PUBLISH,
+	VB_OP_FREE,
+	VB_OP_MAX,
+};
+
+struct vb_perf_cntr {
+	uint64_t	vpc_count;		/* sample counter */
+	uint64_t	vpc_tot;		/* total ns */
+	uint64_t	vpc_max;		/* max ns */
+};
+
+struct vea_bench_pool {
+	struct umem_instance		 vbp_umm;
+	struct umem_tx_stage_data	 vbp_txd;
+	struct vea_space_df		*vbp_vsd;
+	struct vea_hint_df		*vbp_hd;
+	struct vea_space_info		*vbp_vsi;
+	struct vea_hint_context		*vbp_hc;
+	/* Ring of the allocated extents */
+	struct vea_free_extent		*vbp_exts;
+	uint64_t			 vbp_head;
+	uint64_t			 vbp_tail;
+	struct vb_perf_cntr		 vbp_cntr[VB_OP_MAX];
+};
+
+static inline uint64_t
+vb_now(void)
+{
+	struct timespec	ts;
+
+	d_gettime(&ts);
+	return ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+static void
+vb_counter_inc(struct vb_perf_cntr *cntr, uint64_t start, unsigned int nr)
+{
+	uint64_t elapsed = vb_now() - start;
+
+	cntr->vpc_count += nr;
+	cntr->vpc_tot += elapsed;
+	if (cntr->vpc_max < elapsed / nr)
+		cntr->vpc_max = elapsed / nr;
+}
+
+static inline unsigned int
+vb_blk_cnt(void)
+{
+	if (blk_cnt_fixed != 0)
+		return blk_cnt_fixed;
+
+	return (rand() % VEA_MAG_MAX_CLASS) + 1;
+}
+
+static int
+vb_free_batch(struct vea_bench_pool *vb_pool)
+{
+	struct vea_free_extent	*ext;
+	uint64_t		 start;
+	unsigned int		 i;
+	int			 rc;
+
+	start = vb_now();
+	rc = umem_tx_begin(&vb_pool->vbp_umm, &vb_pool->vbp_txd);
+	if (rc)
+		return rc;
+
+	for (i = 0; i < batch_sz && vb_pool->vbp_tail < vb_pool->vbp_head; i++) {
+		ext = &vb_pool->vbp_exts[vb_pool->vbp_tail % working_set];
+		rc = vea_free(vb_pool->vbp_vsi, ext->vfe_blk_off, ext->vfe_blk_cnt);
+		if (rc) {
+			fprintf(stderr, "failed to free ["DF_U64", %u]\n", ext->vfe_blk_off,
+				ext->vfe_blk_cnt);
+			break;
+		}
+		vb_pool->vbp_tail++;
+	}
+
+	rc = rc ? umem_tx_abort(&vb_pool->vbp_umm, rc) : umem_tx_commit(&vb_pool->vbp_umm);
+	if (rc == 0 && i > 0)
+		vb_counter_inc(&vb_pool->vbp_cntr[VB_OP_FREE], start, i);
+
+	return rc;
+}
+
+static int
+vb_update(struct vea_bench_pool *vb_pool)
+{
+	struct vea_resrvd_ext	*rsrvd;
+	struct vea_free_extent	*ext;
+	d_list_t		 r_list;
+	uint64_t		 start;
+	unsigned int		 i, blk_cnt;
+	int			 rc = 0;
+
+	/* Keep the working set size by freeing the oldest extents */
+	while (vb_pool->vbp_head - vb_pool->vbp_tail + batch_sz > working_set) {
+		rc = vb_free_batch(vb_pool);
+		if (rc)
+			return rc;
+	}
+
+	D_INIT_LIST_HEAD(&r_list);
+	for (i = 0; i < batch_sz; i++) {
+		blk_cnt = vb_blk_cnt();
+
+		start = vb_now();
+		rc = vea_reserve(vb_pool->vbp_vsi, blk_cnt, vb_pool->vbp_hc, &r_list);
+		if (rc) {
+			fprintf(stderr, "failed to reserve %u blks\n", blk_cnt);
+			vea_cancel(vb_pool->vbp_vsi, vb_pool->vbp_hc, &r_list);
+			return rc;
+		}
+		vb_counter_inc(&vb_pool->vbp_cntr[VB_OP_RESERVE], start, 1);
+	}
+
+	/* Reserved list will be freed on publish, track the allocated extents */
+	d_list_for_each_entry(rsrvd, &r_list, vre_link) {
+		ext = &vb_pool->vbp_exts[vb_pool->vbp_head % working_set];
+		ext->vfe_blk_off = rsrvd->vre_blk_off;
+		ext->vfe_blk_cnt = rsrvd->vre_blk_cnt;
+		vb_pool->vbp_head++;
+	}
+
+	start = vb_now();
+	rc = umem_tx_begin(&vb_pool->vbp_umm, &vb_pool->vbp_txd);
+	D_ASSERT(rc == 0);
+
+	rc = vea_tx_publish(vb_pool->vbp_vsi, vb_pool->vbp_hc, &r_list);
+	rc = rc ? umem_tx_abort(&vb_pool->vbp_umm, rc) : umem_tx_commit(&vb_pool->vbp_umm);
+	if (rc) {
+		fprintf(stderr, "failed to publish. "DF_RC"\n", DP_RC(rc));
+		return rc;
+	}
+	vb_counter_inc(&vb_pool->vbp_cntr[VB_OP_PUBLISH], start, batch_sz);
+
+	return 0;
+}
+
+static void
+vb_teardown_pool(struct vea_bench_pool *vb_pool)
+{
+	if (vb_pool->vbp_hc != NULL)
+		vea_hint_unload(vb_pool->vbp_hc);
+
+	if (vb_pool->vbp_vsi != NULL)
+		vea_unload(vb_pool->vbp_vsi);
+
+	if (vb_pool->vbp_umm.umm_pool != NULL)
+		umempobj_close(vb_pool->vbp_umm.umm_pool);
+
+	umem_fini_txd(&vb_pool->vbp_txd);
+	D_FREE(vb_pool->vbp_exts);
+	D_FREE(vb_pool);
+}
+
+static struct vea_bench_pool *
+vb_setup_pool(void)
+{
+	struct vea_bench_pool	*vb_pool;
+	struct umem_attr	 uma = { 0 };
+	struct vea_unmap_context unmap_ctxt = { 0 };
+	void			*root_addr;
+	int			 rc;
+
+	D_ALLOC_PTR(vb_pool);
+	if (vb_pool == NULL)
+		return NULL;
+
+	D_ALLOC_ARRAY(vb_pool->vbp_exts, working_set);
+	if (vb_pool->vbp_exts == NULL)
+		goto error;
+
+	rc = umem_init_txd(&vb_pool->vbp_txd);
+	if (rc) {
+		fprintf(stderr, "failed to init txd\n");
+		goto error;
+	}
+
+	unlink(pool_file);
+	uma.uma_id = UMEM_CLASS_PMEM;
+	uma.uma_pool = umempobj_create(pool_file, "vea_bench", UMEMPOBJ_ENABLE_STATS,
+				       heap_size, 0666, NULL);
+	if (uma.uma_pool == NULL) {
+		fprintf(stderr, "failed to create pobj pool\n");
+		goto error;
+	}
+
+	root_addr = umempobj_get_rootptr(uma.uma_pool, sizeof(struct vea_space_df) +
+					 sizeof(struct vea_hint_df));
+	if (root_addr == NULL) {
+		fprintf(stderr, "failed to get pobj pool root\n");
+		umempobj_close(uma.uma_pool);
+		goto error;
+	}
+
+	rc = umem_class_init(&uma, &vb_pool->vbp_umm);
+	if (rc) {
+		fprintf(stderr, "failed to initialize umm\n");
+		umempobj_close(uma.uma_pool);
+		goto error;
+	}
+
+	vb_pool->vbp_vsd = root_addr;
+	vb_pool->vbp_hd = root_addr + sizeof(struct vea_space_df);
+
+	rc = vea_format(&vb_pool->vbp_umm, &vb_pool->vbp_txd, vb_pool->vbp_vsd, VB_BLK_SIZE,
+			1, /* hdr blks */ pool_capacity, NULL, NULL, false, VEA_COMPAT_MASK);
+	if (rc) {
+		fprintf(stderr, "failed to format\n");
+		goto error;
+	}
+
+	rc = vea_load(&vb_pool->vbp_umm, &vb_pool->vbp_txd, vb_pool->vbp_vsd, &unmap_ctxt,
+		      NULL, &vb_pool->vbp_vsi);
+	if (rc) {
+		fprintf(stderr, "failed to load\n");
+		goto error;
+	}
+
+	rc = vea_hint_load(vb_pool->vbp_hd, &vb_pool->vbp_hc);
+	if (rc) {
+		fprintf(stderr, "failed to load hint\n");
+		goto error;
+	}
+
+	return vb_pool;
+error:
+	vb_teardown_pool(vb_pool);
+	return NULL;
+}
+
+static int
+vb_init(void)
+{
+	int	rc;
+
+	rc = daos_debug_init(DAOS_LOG_DEFAULT);
+	if (rc != 0) {
+		fprintf(stderr, "failed to init debug\n");
+		return rc;
+	}
+
+	rc = dbtree_class_register(DBTREE_CLASS_IFV, BTR_FEAT_UINT_KEY | BTR_FEAT_DIRECT_KEY,
+				   &dbtree_ifv_ops);
+	if (rc != 0 && rc != -DER_EXIST) {
+		fprintf(stderr, "failed to register DBTREE_CLASS_IFV\n");
+		daos_debug_fini();
+		return rc;
+	}
+	return 0;
+}
+
+const char vb_bench_options[] =
+"Available options are:\n"
+"-b <block_nr>		blocks per reservation, 0 for random in [1, 16]\n"
+"-B <batch_nr>		reservations per publish\n"
+"-C <capacity>		pool capacity\n"
+"-f <pool_file>		pmemobj pool filename\n"
+"-H <heap_size>		allocator heap size\n"
+"-n <op_nr>		total reservations\n"
+"-s <rand_seed>		rand seed\n"
+"-w <ext_nr>		working set in extents\n"
+"-h			help message\n";
+
+static void
+print_usage(void)
+{
+	fprintf(stdout, "vea_bench [options]\n");
+	fprintf(stdout, "%s\n", vb_bench_options);
+}
+
+static inline uint64_t
+val_unit(uint64_t val, char unit)
+{
+	switch (unit) {
+	default:
+		return val;
+	case 'k':
+	case 'K':
+		return (val << 10);
+	case 'm':
+	case 'M':
+		return (val << 20);
+	case 'g':
+	case 'G':
+		return (val << 30);
+	case 't':
+	case 'T':
+		return (val << 40);
+	}
+}
+
+static inline char *
+vb_op2str(unsigned int op)
+{
+	switch (op) {
+	case VB_OP_RESERVE:
+		return "reserve";
+	case VB_OP_PUBLISH:
+		return "tx_publish";
+	case VB_OP_FREE:
+		return "tx_free";
+	default:
+		break;
+	}
+	return "Unknown";
+}
+
+int main(int argc, char **argv)
+{
+	static struct option long_ops[] = {
+		{ "blocks",	required_argument,	NULL,	'b' },
+		{ "batch",	required_argument,	NULL,	'B' },
+		{ "capacity",	required_argument,	NULL,	'C' },
+		{ "file",	required_argument,	NULL,	'f' },
+		{ "heap",	required_argument,	NULL,	'H' },
+		{ "op_nr",	required_argument,	NULL,	'n' },
+		{ "seed",	required_argument,	NULL,	's' },
+		{ "working_set", required_argument,	NULL,	'w' },
+		{ "help",	no_argument,		NULL,	'h' },
+		{ NULL,		0,			NULL,	0   },
+	};
+	struct vea_bench_pool	*vb_pool;
+	struct vea_stat		 stat;
+	char			*endp;
+	uint64_t		 start, elapsed;
+	int			 i, rc;
+
+	rand_seed = (unsigned int)(time(NULL) & 0xFFFFFFFFUL);
+	memset(pool_file, 0, sizeof(pool_file));
+	while ((rc = getopt_long(argc, argv, "b:B:C:f:H:n:s:w:h", long_ops, NULL)) != -1) {
+		switch (rc) {
+		case 'b':
+			blk_cnt_fixed = atoi(optarg);
+			break;
+		case 'B':
+			batch_sz = atoi(optarg);
+			break;
+		case 'C':
+			pool_capacity = strtoul(optarg, &endp, 0);
+			pool_capacity = val_unit(pool_capacity, *endp);
+			break;
+		case 'f':
+			strncpy(pool_file, optarg, PATH_MAX - 1);
+			break;
+		case 'H':
+			heap_size = strtoul(optarg, &endp, 0);
+			heap_size = val_unit(heap_size, *endp);
+			break;
+		case 'n':
+			op_total = strtoull(optarg, NULL, 0);
+			break;
+		case 's':
+			rand_seed = atol(optarg);
+			break;
+		case 'w':
+			working_set = atoi(optarg);
+			break;
+		case 'h':
+			print_usage();
+			return 0;
+		default:
+			fprintf(stderr, "unknown option %c\n", rc);
+			print_usage();
+			return -1;
+		}
+	}
+
+	if (batch_sz == 0 || batch_sz > VB_BATCH_MAX || working_set < batch_sz ||
+	    blk_cnt_fixed > VEA_MAX_BITMAP_CLASS) {
+		print_usage();
+		return -1;
+	}
+
+	if (strlen(pool_file) == 0)
+		strncpy(pool_file, "/mnt/daos/vea_bench_pool", sizeof(pool_file));
+
+	fprintf(stdout, "Start VEA allocation benchmark\n");
+	fprintf(stdout, "pool_file  : %s\n", pool_file);
+	fprintf(stdout, "capacity   : "DF_U64" bytes\n", pool_capacity);
+	fprintf(stdout, "blocks     : %u\n", blk_cnt_fixed);
+	fprintf(stdout, "batch      : %u\n", batch_sz);
+	fprintf(stdout, "working_set: %u\n", working_set);
+	fprintf(stdout, "op_nr      : "DF_U64"\n", op_total);
+	fprintf(stdout, "rand_seed  : %u\n\n", rand_seed);
+
+	rc = vb_init();
+	if (rc)
+		return rc;
+
+	vb_pool = vb_setup_pool();
+	if (vb_pool == NULL) {
+		rc = -1;
+		goto fini;
+	}
+
+	srand(rand_seed);
+	start = vb_now();
+	while (vb_pool->vbp_head < op_total) {
+		rc = vb_update(vb_pool);
+		if (rc)
+			break;
+	}
+	elapsed = vb_now() - start;
+
+	if (rc) {
+		fprintf(stderr, "VEA benchmark failed. "DF_RC"\n", DP_RC(rc));
+		goto teardown;
+	}
+
+	fprintf(stdout, "%-11s %-12s %-12s %-10s %-10s\n",
+		"Operation", "Samples", "Time(us)", "Avg(ns)", "Max(ns)");
+	for (i = 0; i < VB_OP_MAX; i++) {
+		struct vb_perf_cntr *cntr = &vb_pool->vbp_cntr[i];
+
+		fprintf(stdout, "%-11s "DF_12U64" "DF_12U64" "DF_10U64" "DF_10U64"\n",
+			vb_op2str(i), cntr->vpc_count, cntr->vpc_tot / NSEC_PER_USEC,
+			cntr->vpc_count ? cntr->vpc_tot / cntr->vpc_count : 0, cntr->vpc_max);
+	}
+	fprintf(stdout, "\nThroughput : "DF_U64" reservations/s\n",
+		elapsed ? vb_pool->vbp_head * NSEC_PER_SEC / elapsed : 0);
+
+	rc = vea_query(vb_pool->vbp_vsi, NULL, &stat);
+	if (rc == 0)
+		fprintf(stdout, "r_hint:"DF_U64" r_large:"DF_U64" r_small:"DF_U64" "
+			"r_bitmap:"DF_U64" frags_bitmap:"DF_U64"\n", stat.vs_resrv_hint,
+			stat.vs_resrv_large, stat.vs_resrv_small, stat.vs_resrv_bitmap,
+			stat.vs_frags_bitmap);
+teardown:
+	vb_teardown_pool(vb_pool);
+fini:
+	daos_debug_fini();
+	return rc;
+}
@@ -1584,6 +1584,106 @@ ut_reclaim_unused_bitmap(void **state)
 	ut_teardown(&args);
 }
 
+static void
+ut_magazine(void **state)
+{
+	struct vea_ut_args	 args;
+	struct vea_unmap_context unmap_ctxt = { 0 };
+	struct vea_resrvd_ext	*ext;
+	struct vea_attr		 attr;
+	struct vea_stat		 stat;
+	d_list_t		*r_list;
+	uint64_t		 capacity = 1llu << 27; /* 128 MiB */
+	uint64_t		 off_a, off_b, free_blks;
+	uint64_t		 resrv_bitmap;
+	uint32_t		 nr;
+	int			 rc;
+
+	print_message("Test bitmap magazine\n");
+	ut_setup(&args);
+	rc = vea_format(&args.vua_umm, &args.vua_txd, args.vua_md, 4096, 1, capacity, NULL, NULL,
+			false, VEA_COMPAT_MASK);
+	assert_rc_equal(rc, 0);
+
+	rc = vea_load(&args.vua_umm, &args.vua_txd, args.vua_md, &unmap_ctxt, NULL,
+		      &args.vua_vsi);
+	assert_rc_equal(rc, 0);
+
+	/* The first reservation creates a new bitmap chunk, magazine is only filled once the
+	 * chunk is published.
+	 */
+	r_list = &args.vua_resrvd_list[0];
+	rc = vea_reserve(args.vua_vsi, 1, NULL, r_list);
+	assert_rc_equal(rc, 0);
+	ext = d_list_entry(r_list->prev, struct vea_resrvd_ext, vre_link);
+	assert_non_null(ext->vre_private);
+
+	rc = umem_tx_begin(&args.vua_umm, &args.vua_txd);
+	assert_int_equal(rc, 0);
+	rc = vea_tx_publish(args.vua_vsi, NULL, r_list);
+	assert_int_equal(rc, 0);
+	rc = umem_tx_commit(&args.vua_umm);
+	assert_int_equal(rc, 0);
+
+	rc = vea_query(args.vua_vsi, &attr, &stat);
+	assert_rc_equal(rc, 0);
+	free_blks = attr.va_free_blks;
+	resrv_bitmap = stat.vs_resrv_bitmap;
+
+	/* Reserved from the published chunk, the following slots are cached in magazine */
+	rc = vea_reserve(args.vua_vsi, 1, NULL, r_list);
+	assert_rc_equal(rc, 0);
+	ext = d_list_entry(r_list->prev, struct vea_resrvd_ext, vre_link);
+	off_a = ext->vre_blk_off;
+
+	/* Served by the magazine, the next slot in the chunk */
+	rc = vea_reserve(args.vua_vsi, 1, NULL, r_list);
+	assert_rc_equal(rc, 0);
+	ext = d_list_entry(r_list->prev, struct vea_resrvd_ext, vre_link);
+	off_b = ext->vre_blk_off;
+	assert_int_equal(off_b, off_a + 1);
+
+	/* Cached slots aren't reservable through the bitmap, but are still accounted free */
+	rc = vea_verify_alloc(args.vua_vsi, true, off_b + 1, 1, true);
+	assert_rc_equal(rc, 0);
+	rc = vea_query(args.vua_vsi, &attr, &stat);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(attr.va_free_blks, free_blks - 2);
+	assert_int_equal(stat.vs_resrv_bitmap, resrv_bitmap + 2);
+
+	/* Cancel returns the reserved slots to the bitmap, the magazine is untouched */
+	rc = vea_cancel(args.vua_vsi, NULL, r_list);
+	assert_rc_equal(rc, 0);
+	rc = vea_verify_alloc(args.vua_vsi, true, off_a, 1, true);
+	assert_rc_equal(rc, 1);
+	rc = vea_verify_alloc(args.vua_vsi, true, off_b, 1, true);
+	assert_rc_equal(rc, 1);
+	rc = vea_verify_alloc(args.vua_vsi, true, off_b + 1, 1, true);
+	assert_rc_equal(rc, 0);
+
+	/* Drain returns the remaining cached slots without changing the free accounting */
+	nr = vea_mag_drain(args.vua_vsi);
+	assert_int_equal(nr, VEA_MAG_SIZE - 1);
+	rc = vea_verify_alloc(args.vua_vsi, true, off_b + 1, VEA_MAG_SIZE - 1, true);
+	assert_rc_equal(rc, 1);
+	rc = vea_query(args.vua_vsi, &attr, NULL);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(attr.va_free_blks, free_blks);
+
+	/* Nothing left to drain, the next reservation refills the magazine */
+	assert_int_equal(vea_mag_drain(args.vua_vsi), 0);
+	rc = vea_reserve(args.vua_vsi, 1, NULL, r_list);
+	assert_rc_equal(rc, 0);
+	ext = d_list_entry(r_list->prev, struct vea_resrvd_ext, vre_link);
+	assert_int_equal(ext->vre_blk_off, off_a);
+	rc = vea_cancel(args.vua_vsi, NULL, r_list);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(vea_mag_drain(args.vua_vsi), VEA_MAG_SIZE);
+
+	vea_unload(args.vua_vsi);
+	ut_teardown(&args);
+}
+
 static const struct CMUnitTest vea_uts[] = {
 	{ "vea_format", ut_format, NULL, NULL},
 	{ "vea_load", ut_load, NULL, NULL},
@@ -1612,7 +1712,8 @@ static const struct CMUnitTest vea_uts[] = {
 	{ "vea_free_invalid_space", ut_free_invalid_space, NULL, NULL},
 	{ "vea_interleaved_ops", ut_interleaved_ops, NULL, NULL},
 	{ "vea_fragmentation", ut_fragmentation, NULL, NULL},
-	{ "vea_reclaim_unused_bitmap", ut_reclaim_unused_bitmap, NULL, NULL}
+	{ "vea_reclaim_unused_bitmap", ut_reclaim_unused_bitmap, NULL, NULL},
+	{ "vea_magazine", ut_magazine, NULL, NULL}
 };
 
 int main(int argc, char **argv)
@@ -299,6 +299,121 @@ get_bitmap_sz(uint32_t chunk_blks, uint16_t class)
 	return bits / 64;
 }
 
+static inline struct vea_magazine *
+get_magazine(struct vea_space_info *vsi, uint32_t blk_cnt)
+{
+	if (blk_cnt > VEA_MAG_MAX_CLASS)
+		return NULL;
+
+	return &vsi->vsi_class.vfc_mags[blk_cnt - 1];
+}
+
+static inline void
+mag_reset(struct vea_magazine *mag)
+{
+	mag->vm_bitmap = NULL;
+	mag->vm_head = 0;
+	mag->vm_cnt = 0;
+}
+
+/* Reserve from the magazine, return true on success */
+static bool
+mag_reserve(struct vea_space_info *vsi, uint32_t blk_cnt, struct vea_resrvd_ext *resrvd)
+{
+	struct vea_magazine	*mag = get_magazine(vsi, blk_cnt);
+	struct vea_free_bitmap	*vfb;
+	uint32_t		 bit;
+
+	if (mag == NULL || mag->vm_head == mag->vm_cnt)
+		return false;
+
+	D_ASSERT(mag->vm_bitmap != NULL);
+	vfb = &mag->vm_bitmap->vbe_bitmap;
+	D_ASSERT(vfb->vfb_class == blk_cnt);
+	D_ASSERT(mag->vm_bitmap->vbe_published_state == VEA_BITMAP_STATE_PUBLISHED);
+
+	bit = mag->vm_bits[mag->vm_head];
+	resrvd->vre_blk_off = vfb->vfb_blk_off + (bit * blk_cnt);
+	resrvd->vre_blk_cnt = blk_cnt;
+	resrvd->vre_private = (void *)mag->vm_bitmap;
+
+	mag->vm_head++;
+	if (mag->vm_head == mag->vm_cnt)
+		mag_reset(mag);
+
+	inc_stats(vsi, STAT_RESRV_BITMAP, 1);
+	return true;
+}
+
+/*
+ * Pre-reserve the free slots following @bit from a published bitmap chunk into the
+ * magazine. The slots are marked as used in the in-memory bitmap, so that they can't
+ * be reserved through the bitmap LRU, but they are still accounted as free space.
+ */
+static void
+mag_fill(struct vea_space_info *vsi, struct vea_bitmap_entry *bitmap_entry, uint32_t bit)
+{
+	struct vea_free_bitmap	*vfb = &bitmap_entry->vbe_bitmap;
+	struct vea_magazine	*mag = get_magazine(vsi, vfb->vfb_class);
+	uint32_t		 bits_max = vfb->vfb_bitmap_sz * 64;
+
+	if (mag == NULL || mag->vm_cnt != 0)
+		return;
+
+	if (bitmap_entry->vbe_published_state != VEA_BITMAP_STATE_PUBLISHED)
+		return;
+
+	for (bit = bit + 1; bit < bits_max && mag->vm_cnt < VEA_MAG_SIZE; bit++) {
+		/* Skip the fully used word */
+		if (vfb->vfb_bitmaps[bit >> 6] == UINT64_MAX) {
+			bit |= 63;
+			continue;
+		}
+		if (isset64(vfb->vfb_bitmaps, bit))
+			continue;
+
+		setbits64(vfb->vfb_bitmaps, bit, 1);
+		mag->vm_bits[mag->vm_cnt++] = bit;
+	}
+
+	if (mag->vm_cnt != 0)
+		mag->vm_bitmap = bitmap_entry;
+}
+
+/* Return all the cached slots back to bitmaps, return the number of drained blocks */
+uint32_t
+vea_mag_drain(struct vea_space_info *vsi)
+{
+	struct vea_magazine	*mag;
+	struct vea_free_entry	 vfe;
+	uint32_t		 nr = 0;
+	int			 i, rc;
+
+	for (i = 0; i < VEA_MAG_MAX_CLASS; i++) {
+		mag = &vsi->vsi_class.vfc_mags[i];
+
+		for (; mag->vm_head < mag->vm_cnt; mag->vm_head++) {
+			vfe.vfe_ext.vfe_blk_off = mag->vm_bitmap->vbe_bitmap.vfb_blk_off +
+						  mag->vm_bits[mag->vm_head] * (i + 1);
+			vfe.vfe_ext.vfe_blk_cnt = i + 1;
+			vfe.vfe_ext.vfe_age = 0;	/* Not used */
+			vfe.vfe_bitmap = mag->vm_bitmap;
+
+			/* The cached slots are still accounted as free */
+			rc = compound_free(vsi, &vfe, VEA_FL_NO_ACCOUNTING);
+			if (rc) {
+				DL_ERROR(rc, "Drain magazine slot ["DF_U64", %u] failed.",
+					 vfe.vfe_ext.vfe_blk_off, vfe.vfe_ext.vfe_blk_cnt);
+				continue;
+			}
+			nr += vfe.vfe_ext.vfe_blk_cnt;
+		}
+		mag_reset(mag);
+	}
+
+	return nr;
+}
+
 static int
 reserve_bitmap(struct vea_space_info *vsi, uint32_t blk_cnt,
 	      struct vea_resrvd_ext *resrvd)
@@ -320,6 +435,10 @@ reserve_bitmap(struct vea_space_info *vsi, uint32_t blk_cnt,
 		return 0;
 
 	D_ASSERT(blk_cnt > 0);
+	/* reserve from magazine */
+	if (mag_reserve(vsi, blk_cnt, resrvd))
+		return 0;
+
 	/* reserve from bitmap */
 	d_list_for_each_entry_safe(bitmap_entry, tmp_entry,
 				   &vsi->vsi_class.vfc_bitmap_lru[blk_cnt - 1], vbe_link) {
@@ -339,6 +458,7 @@ reserve_bitmap(struct vea_space_info *vsi, uint32_t blk_cnt,
 		resrvd->vre_blk_cnt = blk_cnt;
 		resrvd->vre_private = (void *)bitmap_entry;
 		setbits64(vfb->vfb_bitmaps, rc, 1);
+		mag_fill(vsi, bitmap_entry, rc);
 		rc = 0;
 		inc_stats(vsi, STAT_RESRV_BITMAP, 1);
 		return 0;
@@ -435,6 +435,8 @@ inline_aging_flush(struct vea_space_info *vsi, bool force, uint32_t nr_flush, ui
  *    half-and-half then reserve from the latter half. (lookup vfc_heap). Otherwise;
  * 3. Try to reserve from some small free extent (<= VEA_LARGE_EXT_MB) in best-fit,
  *    if it fails, reserve from the largest free extent. (lookup vfc_size_btr)
+ *    Small bitmap allocations are served from the per-class magazine first, it's
+ *    refilled from a published bitmap chunk in the bitmap LRU. (vfc_mags)
  * 4. Fail reserve with ENOMEM if all above attempts fail.
  */
 int
@@ -442,7 +444,7 @@ vea_reserve(struct vea_space_info *vsi, uint32_t blk_cnt,
 	    struct vea_hint_context *hint, d_list_t *resrvd_list)
 {
 	struct vea_resrvd_ext	*resrvd;
-	uint32_t		 nr_flushed;
+	uint32_t		 nr_flushed, nr_drained;
 	bool			 force = false;
 	int			 rc = 0;
 	bool			 try_hint = true;
@@ -486,8 +488,10 @@ retry:
 	rc = -DER_NOSPACE;
 	if (!force) {
 		force = true;
+		/* Return the slots cached in magazines, they could make bitmaps reclaimable */
+		nr_drained = vea_mag_drain(vsi);
 		inline_aging_flush(vsi, force, MAX_FLUSH_FRAGS * 10, &nr_flushed);
-		if (nr_flushed == 0)
+		if (nr_flushed == 0 && nr_drained == 0)
 			goto error;
 		goto retry;
 	} else {
@@ -24,6 +24,11 @@
 /* Max bitmap allocation class */
 #define VEA_MAX_BITMAP_CLASS	64
 
+/* Max allocation class cached in magazines, 64KiB for 4KiB block size */
+#define VEA_MAG_MAX_CLASS	16
+/* Max number of bitmap slots cached in a magazine */
+#define VEA_MAG_SIZE		32
+
 /* Bitmap chunk size */
 #define VEA_BITMAP_MIN_CHUNK_BLKS	256				/* 1MiB */
 #define VEA_BITMAP_MAX_CHUNK_BLKS	(VEA_MAX_BITMAP_CLASS * 256)	/* 64 MiB */
@@ -108,6 +113,21 @@ struct vea_sized_class {
 	d_list_t		vsc_extent_lru;
 };
 
+/*
+ * Per allocation class cache of bitmap slots pre-reserved from a published bitmap
+ * chunk, small reservations are served from it without scanning the bitmap LRU.
+ */
+struct vea_magazine {
+	/* Bitmap chunk the cached slots belong to */
+	struct vea_bitmap_entry	*vm_bitmap;
+	/* Next slot to be consumed */
+	uint16_t		 vm_head;
+	/* Number of cached slots */
+	uint16_t		 vm_cnt;
+	/* Bit index of cached slots, in ascending order */
+	uint32_t		 vm_bits[VEA_MAG_SIZE];
+};
+
 #define VEA_BITMAP_CHUNK_HINT_KEY	(~(0ULL))
 /*
  * Large free extents (>VEA_LARGE_EXT_MB) are tracked in max a heap, small
@@ -124,6 +144,8 @@ struct vea_free_class {
 	d_list_t		vfc_bitmap_lru[VEA_MAX_BITMAP_CLASS];
 	/* Empty bitmap list for different allocation class */
 	d_list_t		vfc_bitmap_empty[VEA_MAX_BITMAP_CLASS];
+	/* Magazines for small bitmap allocation classes */
+	struct vea_magazine	vfc_mags[VEA_MAG_MAX_CLASS];
 };
 
 enum {
@@ -287,6 +309,7 @@ int reserve_hint(struct vea_space_info *vsi, uint32_t blk_cnt,
 int reserve_single(struct vea_space_info *vsi, uint32_t blk_cnt,
 		   struct vea_resrvd_ext *resrvd);
 int persistent_alloc(struct vea_space_info *vsi, struct vea_free_entry *vfe);
+uint32_t vea_mag_drain(struct vea_space_info *vsi);
 int
 bitmap_tx_add_ptr(struct umem_instance *vsi_umem, uint64_t *bitmap,
 		  uint32_t bit_at, uint32_t bits_nr);
@@ -235,6 +235,11 @@ enum evt_find_opc {
 	EVT_FIND_OVERWRITE,
 	/** Find the exactly same extent. */
 	EVT_FIND_SAME,
+	/**
+	 * Same as EVT_FIND_ALL, but node summaries may be used to skip
+	 * punched subtrees and hole-only subtrees that hide no data.
+	 */
+	EVT_FIND_DATA,
 };
 
 /** Clone an evtree context
@@ -363,6 +368,9 @@ int evt_ent_array_sort(struct evt_context *tcx,
  *					EVT_FIND_FIRST: First record only
  *					EVT_FIND_SAME:  Same record only
  *					EVT_FIND_ALL:   All records
+ *					EVT_FIND_DATA:  All records, holes
+ *							hiding no data may
+ *							be skipped
  * \param[IN]		filter		Filters for records
  * \param[IN]		rect		The specific rectangle to match
  * \param[IN,OUT]	ent_array	The initialized array to fill
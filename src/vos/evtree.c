@@ -8,6 +8,9 @@
 
 #include <daos/checksum.h>
 #include "evt_priv.h"
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
 
 #ifdef VOS_DISABLE_TRACE
 #define V_TRACE(...) (void)0
@@ -218,6 +221,183 @@ evt_rect_overlap(const struct evt_rect *rt1, const struct evt_rect *rt2, int *ra
 		*range = RT_OVERLAP_PARTIAL;
 }
 
+/**
+ * Batched range overlap test for leaf nodes.
+ *
+ * Set bit @i of \a mask if the extent of leaf entry @i overlaps with the range
+ * [\a lo, \a hi], it's used to skip the entries which can't match a search without
+ * reading & translating every rectangle of the node.
+ */
+typedef void (*evt_overlap_fn_t)(const struct evt_node_entry *ne, int nr, uint64_t lo,
+				 uint64_t hi, uint64_t *mask);
+
+#define EVT_MASK_WORDS	(EVT_ORDER_MAX / 64)
+
+static inline void
+evt_leaf_overlap_tail(const struct evt_node_entry *ne, int start, int nr, uint64_t lo,
+		      uint64_t hi, uint64_t *mask)
+{
+	uint64_t	ent_lo;
+	uint64_t	ent_hi;
+	int		i;
+
+	for (i = start; i < nr; i++) {
+		ent_lo = ne[i].ne_rect.rd_lo;
+		ent_hi = ent_lo + evt_len_read(&ne[i].ne_rect) - 1;
+		if (ent_lo <= hi && ent_hi >= lo)
+			mask[i >> 6] |= 1ULL << (i & 63);
+	}
+}
+
+static void
+evt_leaf_overlap_scalar(const struct evt_node_entry *ne, int nr, uint64_t lo, uint64_t hi,
+			uint64_t *mask)
+{
+	evt_leaf_overlap_tail(ne, 0, nr, lo, hi, mask);
+}
+
+#if defined(__x86_64__)
+/*
+ * The vector kernels gather the low offset and the length word (rd_len_hi, rd_len_lo
+ * & rd_minor_epc) of each durable rectangle, they depend on the layout below.
+ */
+D_CASSERT(sizeof(struct evt_node_entry) == 32);
+D_CASSERT(offsetof(struct evt_node_entry, ne_rect.rd_len_hi) == 8);
+D_CASSERT(offsetof(struct evt_node_entry, ne_rect.rd_len_lo) == 12);
+D_CASSERT(offsetof(struct evt_node_entry, ne_rect.rd_lo) == 16);
+
+__attribute__((target("avx2"))) static void
+evt_leaf_overlap_avx2(const struct evt_node_entry *ne, int nr, uint64_t lo, uint64_t hi,
+		      uint64_t *mask)
+{
+	const __m256i	idx = _mm256_set_epi64x(12, 8, 4, 0);
+	const __m256i	sign = _mm256_set1_epi64x(INT64_MIN);
+	const __m256i	len_lo_mask = _mm256_set1_epi64x(0xffff);
+	const __m256i	len_hi_mask = _mm256_set1_epi64x(0xffffffff);
+	const __m256i	one = _mm256_set1_epi64x(1);
+	const __m256i	q_lo = _mm256_xor_si256(_mm256_set1_epi64x(lo), sign);
+	const __m256i	q_hi = _mm256_xor_si256(_mm256_set1_epi64x(hi), sign);
+	__m256i		ent_lo, ent_hi, len, word, out;
+	uint64_t	bits;
+	int		i;
+
+	for (i = 0; i + 4 <= nr; i += 4) {
+		ent_lo = _mm256_i64gather_epi64((const long long *)&ne[i].ne_rect.rd_lo, idx, 8);
+		word = _mm256_i64gather_epi64((const long long *)&ne[i].ne_rect.rd_len_hi, idx, 8);
+		len = _mm256_or_si256(_mm256_slli_epi64(_mm256_and_si256(word, len_hi_mask), 16),
+				      _mm256_and_si256(_mm256_srli_epi64(word, 32), len_lo_mask));
+		ent_hi = _mm256_sub_epi64(_mm256_add_epi64(ent_lo, len), one);
+
+		/* No unsigned 64-bit compare in AVX2, flip the sign bits for signed compare */
+		ent_lo = _mm256_xor_si256(ent_lo, sign);
+		ent_hi = _mm256_xor_si256(ent_hi, sign);
+		out = _mm256_or_si256(_mm256_cmpgt_epi64(ent_lo, q_hi),
+				      _mm256_cmpgt_epi64(q_lo, ent_hi));
+		bits = ~_mm256_movemask_pd(_mm256_castsi256_pd(out)) & 0xf;
+		mask[i >> 6] |= bits << (i & 63);
+	}
+
+	evt_leaf_overlap_tail(ne, i, nr, lo, hi, mask);
+}
+
+__attribute__((target("avx512f"))) static void
+evt_leaf_overlap_avx512(const struct evt_node_entry *ne, int nr, uint64_t lo, uint64_t hi,
+			uint64_t *mask)
+{
+	const __m512i	idx = _mm512_set_epi64(28, 24, 20, 16, 12, 8, 4, 0);
+	const __m512i	len_lo_mask = _mm512_set1_epi64(0xffff);
+	const __m512i	len_hi_mask = _mm512_set1_epi64(0xffffffff);
+	const __m512i	one = _mm512_set1_epi64(1);
+	const __m512i	q_lo = _mm512_set1_epi64(lo);
+	const __m512i	q_hi = _mm512_set1_epi64(hi);
+	__m512i		ent_lo, ent_hi, len, word;
+	uint64_t	bits;
+	int		i;
+
+	for (i = 0; i + 8 <= nr; i += 8) {
+		ent_lo = _mm512_i64gather_epi64(idx, &ne[i].ne_rect.rd_lo, 8);
+		word = _mm512_i64gather_epi64(idx, &ne[i].ne_rect.rd_len_hi, 8);
+		len = _mm512_or_si512(_mm512_slli_epi64(_mm512_and_si512(word, len_hi_mask), 16),
+				      _mm512_and_si512(_mm512_srli_epi64(word, 32), len_lo_mask));
+		ent_hi = _mm512_sub_epi64(_mm512_add_epi64(ent_lo, len), one);
+
+		bits = _mm512_cmple_epu64_mask(ent_lo, q_hi) & _mm512_cmpge_epu64_mask(ent_hi, q_lo);
+		mask[i >> 6] |= bits << (i & 63);
+	}
+
+	evt_leaf_overlap_tail(ne, i, nr, lo, hi, mask);
+}
+#endif
+
+static evt_overlap_fn_t evt_overlap_fn;
+
+static evt_overlap_fn_t
+evt_overlap_select(void)
+{
+	bool	simd = true;
+
+	d_getenv_bool("DAOS_EVT_SIMD", &simd);
+#if defined(__x86_64__)
+	__builtin_cpu_init();
+	if (simd && __builtin_cpu_supports("avx512f")) {
+		D_INFO("evtree overlap check uses AVX-512\n");
+		return evt_leaf_overlap_avx512;
+	}
+	if (simd && __builtin_cpu_supports("avx2")) {
+		D_INFO("evtree overlap check uses AVX2\n");
+		return evt_leaf_overlap_avx2;
+	}
+#endif
+	D_INFO("evtree overlap check uses scalar\n");
+	return evt_leaf_overlap_scalar;
+}
+
+static inline void
+evt_leaf_overlap(const struct evt_node_entry *ne, int nr, const struct evt_extent *ext,
+		 uint64_t *mask)
+{
+	/* Racing initialization is harmless, all callers select the same kernel */
+	if (unlikely(evt_overlap_fn == NULL))
+		evt_overlap_fn = evt_overlap_select();
+
+	memset(mask, 0, sizeof(*mask) * EVT_MASK_WORDS);
+	evt_overlap_fn(ne, nr, ext->ex_lo, ext->ex_hi, mask);
+}
+
+int
+evt_leaf_overlap_check(enum evt_overlap_kernel kernel, const struct evt_node_entry *ne, int nr,
+		       uint64_t lo, uint64_t hi, uint64_t *mask)
+{
+	evt_overlap_fn_t	fn;
+
+	D_ASSERT(nr >= 0 && nr <= EVT_ORDER_MAX);
+	switch (kernel) {
+	case EVT_OVERLAP_SCALAR:
+		fn = evt_leaf_overlap_scalar;
+		break;
+#if defined(__x86_64__)
+	case EVT_OVERLAP_AVX2:
+		__builtin_cpu_init();
+		if (!__builtin_cpu_supports("avx2"))
+			return -DER_NOSYS;
+		fn = evt_leaf_overlap_avx2;
+		break;
+	case EVT_OVERLAP_AVX512:
+		__builtin_cpu_init();
+		if (!__builtin_cpu_supports("avx512f"))
+			return -DER_NOSYS;
+		fn = evt_leaf_overlap_avx512;
+		break;
+#endif
+	default:
+		return -DER_NOSYS;
+	}
+
+	memset(mask, 0, sizeof(*mask) * EVT_MASK_WORDS);
+	fn(ne, nr, lo, hi, mask);
+	return 0;
+}
+
 /**
  * Calculate the Minimum Bounding Rectangle (MBR) of two rectangles and store
  * the MBR into the first rectangle \a rt1.
@@ -1004,6 +1184,105 @@ evt_find_visible(struct evt_context *tcx, const struct evt_filter *filter,
 	return 0;
 }
 
+/** Sort key of an entry, it's compared in the same order as evt_ent_cmp() */
+struct evt_sort_key {
+	uint64_t	sk_lo;
+	/** Inverted epoch, so later epoch sorts first */
+	uint64_t	sk_epc;
+	uint64_t	sk_hi;
+	/** Index of the entry in the array */
+	uint32_t	sk_idx;
+	/** Visibility priority, 0 if not sorting by visibility */
+	uint16_t	sk_prio;
+	/** Inverted minor epoch */
+	uint16_t	sk_minor_epc;
+};
+
+/** Arrays not larger than this are sorted in place */
+#define EVT_SORT_KEY_MIN	EVT_EMBEDDED_NR
+
+static int
+evt_sort_key_cmp(const void *p1, const void *p2)
+{
+	const struct evt_sort_key	*k1 = p1;
+	const struct evt_sort_key	*k2 = p2;
+
+	if (k1->sk_prio != k2->sk_prio)
+		return k1->sk_prio < k2->sk_prio ? -1 : 1;
+	if (k1->sk_lo != k2->sk_lo)
+		return k1->sk_lo < k2->sk_lo ? -1 : 1;
+	if (k1->sk_epc != k2->sk_epc)
+		return k1->sk_epc < k2->sk_epc ? -1 : 1;
+	if (k1->sk_minor_epc != k2->sk_minor_epc)
+		return k1->sk_minor_epc < k2->sk_minor_epc ? -1 : 1;
+	if (k1->sk_hi != k2->sk_hi)
+		return k1->sk_hi < k2->sk_hi ? -1 : 1;
+	return 0;
+}
+
+/**
+ * Sort the entry array, \a mask is used for prioritizing entries by visibility.
+ *
+ * Large arrays are sorted on the compact keys extracted from the entries, then the
+ * entries are permuted in place, so every entry is moved at most once.
+ */
+static void
+evt_ent_array_qsort(struct evt_entry_array *ent_array, const int mask[])
+{
+	struct evt_list_entry	*ents = ent_array->ea_ents;
+	struct evt_list_entry	 tmp;
+	struct evt_entry	*ent;
+	struct evt_sort_key	*keys;
+	uint32_t		 nr = ent_array->ea_ent_nr;
+	uint32_t		 i, j, k;
+
+	if (nr <= EVT_SORT_KEY_MIN)
+		goto fallback;
+
+	D_ALLOC_ARRAY_NZ(keys, nr);
+	if (keys == NULL)
+		goto fallback;
+
+	for (i = 0; i < nr; i++) {
+		ent = &ents[i].le_ent;
+		keys[i].sk_lo = ent->en_sel_ext.ex_lo;
+		keys[i].sk_hi = ent->en_sel_ext.ex_hi;
+		keys[i].sk_epc = ~ent->en_epoch;
+		keys[i].sk_minor_epc = ~ent->en_minor_epc;
+		keys[i].sk_idx = i;
+		if (mask != NULL) {
+			D_ASSERT(evt_flags_valid(ent->en_visibility));
+			keys[i].sk_prio = mask[evt_flags_get(ent->en_visibility)];
+		} else {
+			keys[i].sk_prio = 0;
+		}
+	}
+
+	qsort(keys, nr, sizeof(keys[0]), evt_sort_key_cmp);
+
+	/* Follow the permutation cycles, slot i takes the entry keys[i].sk_idx */
+	for (i = 0; i < nr; i++) {
+		if (keys[i].sk_idx == i)
+			continue;
+
+		tmp = ents[i];
+		j = i;
+		while ((k = keys[j].sk_idx) != i) {
+			ents[j] = ents[k];
+			keys[j].sk_idx = j;
+			j = k;
+		}
+		ents[j] = tmp;
+		keys[j].sk_idx = j;
+	}
+
+	D_FREE(keys);
+	return;
+fallback:
+	qsort(ents, nr, sizeof(ents[0]), mask != NULL ? evt_ent_list_cmp_visible :
+	      evt_ent_list_cmp);
+}
+
 /** Place all entries into covered list in sorted order based on selected
  * range.   Then walk through the range to find only extents that are visible
  * and place them in the main list.   Update the selection bounds for visible
@@ -1013,9 +1292,8 @@ int
 evt_ent_array_sort(struct evt_context *tcx, struct evt_entry_array *ent_array,
 		   const struct evt_filter *filter, int flags)
 {
-	struct evt_list_entry	*ents;
 	struct evt_entry	*ent;
-	int			(*compar)(const void *, const void *);
+	const int		*mask;
 	int			 total;
 	int			 num_visible = 0;
 	int			 rc;
@@ -1036,11 +1314,8 @@ evt_ent_array_sort(struct evt_context *tcx, struct evt_entry_array *ent_array,
 	}
 
 	for (;;) {
-		ents = ent_array->ea_ents;
-
 		/* Sort the array first */
-		qsort(ents, ent_array->ea_ent_nr, sizeof(ents[0]),
-		      evt_ent_list_cmp);
+		evt_ent_array_qsort(ent_array, NULL);
 
 		/* Now separate entries into covered and visible */
 		rc = evt_find_visible(tcx, filter, ent_array, &num_visible,
@@ -1054,19 +1329,18 @@ evt_ent_array_sort(struct evt_context *tcx, struct evt_entry_array *ent_array,
 	}
 
 re_sort:
-	ents = ent_array->ea_ents;
 	/* Now re-sort the entries */
 	if (flags & EVT_COVERED) {
 		total = ent_array->ea_ent_nr;
-		compar = evt_ent_list_cmp;
+		mask = NULL;
 	} else {
 		D_ASSERT(flags & (EVT_ITER_VISIBLE | EVT_ITER_REMOVALS));
-		compar = evt_ent_list_cmp_visible;
+		mask = vis_cmp_mask;
 		total = num_visible;
 	}
 
 	if (ent_array->ea_ent_nr != 1)
-		qsort(ents, ent_array->ea_ent_nr, sizeof(ents[0]), compar);
+		evt_ent_array_qsort(ent_array, mask);
 
 	ent_array->ea_ent_nr = total;
 
@@ -1433,7 +1707,151 @@ evt_order2size(int order, bool leaf)
 static inline int
 evt_node_size(struct evt_context *tcx, bool leaf)
 {
-	return evt_order2size(tcx->tc_order, leaf);
+	int	size = evt_order2size(tcx->tc_order, leaf);
+
+	if (tcx->tc_feats & EVT_FEAT_NODE_SUMMARY)
+		size += sizeof(struct evt_node_summary);
+	return size;
+}
+
+static inline struct evt_node_summary *
+evt_node_summary_at(struct evt_node *nd, int order, bool leaf)
+{
+	return (struct evt_node_summary *)((char *)nd + evt_order2size(order, leaf));
+}
+
+/** Return the subtree summary of \a nd, NULL if the tree doesn't keep one */
+static inline struct evt_node_summary *
+evt_node_summary(struct evt_context *tcx, struct evt_node *nd)
+{
+	if (!(tcx->tc_feats & EVT_FEAT_NODE_SUMMARY))
+		return NULL;
+
+	return evt_node_summary_at(nd, tcx->tc_order, evt_node_is_leaf(tcx, nd));
+}
+
+static inline void
+evt_summary_init(struct evt_node_summary *ns)
+{
+	ns->ns_max_epc = 0;
+	ns->ns_flags   = EVT_NS_HOLES;
+}
+
+/** Returns true if \a ns already accounts for a record at \a epc */
+static inline bool
+evt_summary_covers(const struct evt_node_summary *ns, daos_epoch_t epc, bool hole)
+{
+	return ns->ns_max_epc >= epc && (hole || !(ns->ns_flags & EVT_NS_HOLES));
+}
+
+static inline void
+evt_summary_merge(struct evt_node_summary *ns, daos_epoch_t epc, bool hole)
+{
+	if (ns->ns_max_epc < epc)
+		ns->ns_max_epc = epc;
+	if (!hole)
+		ns->ns_flags &= ~EVT_NS_HOLES;
+}
+
+/** Calculate the summary of \a nd from its records or children */
+static void
+evt_node_summary_cal(struct evt_context *tcx, struct evt_node *nd,
+		     struct evt_node_summary *ns)
+{
+	struct evt_node_summary	*child_ns;
+	struct evt_node		*child;
+	struct evt_rect		 rect;
+	struct evt_desc		*desc;
+	int			 i;
+
+	evt_summary_init(ns);
+	for (i = 0; i < nd->tn_nr; i++) {
+		if (evt_node_is_leaf(tcx, nd)) {
+			evt_node_rect_read_at(tcx, nd, i, &rect);
+			desc = evt_node_desc_at(tcx, nd, i);
+			evt_summary_merge(ns, rect.rc_epc, bio_addr_is_hole(&desc->dc_ex_addr));
+		} else {
+			child = evt_off2node(tcx, evt_node_child_at(tcx, nd, i));
+			child_ns = evt_node_summary(tcx, child);
+			evt_summary_merge(ns, child_ns->ns_max_epc,
+					  child_ns->ns_flags & EVT_NS_HOLES);
+		}
+	}
+}
+
+/**
+ * Recalculate the summary of \a nd, returns 1 if it changed. The node must
+ * have been added to the transaction unless \a tx_add is set.
+ */
+static int
+evt_node_summary_reset(struct evt_context *tcx, struct evt_node *nd, bool tx_add)
+{
+	struct evt_node_summary	*ns = evt_node_summary(tcx, nd);
+	struct evt_node_summary	 tmp;
+	int			 rc;
+
+	evt_node_summary_cal(tcx, nd, &tmp);
+	if (ns->ns_max_epc == tmp.ns_max_epc && ns->ns_flags == tmp.ns_flags)
+		return 0;
+
+	if (tx_add && evt_has_tx(tcx)) {
+		rc = umem_tx_add_ptr(evt_umm(tcx), ns, sizeof(*ns));
+		if (rc != 0)
+			return rc;
+	}
+	*ns = tmp;
+	return 1;
+}
+
+/**
+ * Merge a newly stored record into the summaries of all nodes on the trace.
+ * Nodes split away from the trace were recalculated while splitting, nodes
+ * left on the trace which no longer own the record just become conservative.
+ */
+static int
+evt_summary_trace_merge(struct evt_context *tcx, daos_epoch_t epc, bool hole)
+{
+	struct evt_node_summary	*ns;
+	struct evt_trace	*trace;
+	struct evt_node		*nd;
+	int			 level;
+	int			 rc;
+
+	for (level = tcx->tc_depth - 1; level >= 0; level--) {
+		trace = &tcx->tc_trace[level];
+		nd = evt_off2node(tcx, trace->tr_node);
+		ns = evt_node_summary(tcx, nd);
+		if (evt_summary_covers(ns, epc, hole))
+			continue;
+
+		if (!trace->tr_tx_added && evt_has_tx(tcx)) {
+			rc = umem_tx_add_ptr(evt_umm(tcx), ns, sizeof(*ns));
+			if (rc != 0)
+				return rc;
+		}
+		evt_summary_merge(ns, epc, hole);
+	}
+	return 0;
+}
+
+/**
+ * Recalculate the summaries from \a level up to the root after a record has
+ * been removed, stop as soon as one of them doesn't change.
+ */
+static int
+evt_summary_trace_reset(struct evt_context *tcx, int level)
+{
+	struct evt_trace	*trace;
+	int			 rc;
+
+	for (; level >= 0; level--) {
+		trace = &tcx->tc_trace[level];
+		rc = evt_node_summary_reset(tcx, evt_off2node(tcx, trace->tr_node),
+					    !trace->tr_tx_added);
+		if (rc <= 0)
+			return rc;
+	}
+	return 0;
 }
 
 /** Allocate a evtree node */
@@ -1455,6 +1873,8 @@ evt_node_alloc(struct evt_context *tcx, unsigned int flags,
 	nd = evt_off2ptr(tcx, nd_off);
 	nd->tn_flags = flags;
 	nd->tn_magic = EVT_NODE_MAGIC;
+	if (tcx->tc_feats & EVT_FEAT_NODE_SUMMARY)
+		evt_summary_init(evt_node_summary(tcx, nd));
 
 	*nd_off_p = nd_off;
 	return 0;
@@ -1590,6 +2010,11 @@ evt_node_split(struct evt_context *tcx, bool leaf,
 	if (rc == 0) { /* calculate MBR for both nodes */
 		evt_node_mbr_cal(tcx, src_nd);
 		evt_node_mbr_cal(tcx, dst_nd);
+		if (tcx->tc_feats & EVT_FEAT_NODE_SUMMARY) {
+			/* both nodes have been added to the transaction */
+			evt_node_summary_reset(tcx, src_nd, false);
+			evt_node_summary_reset(tcx, dst_nd, false);
+		}
 	}
 	return rc;
 }
@@ -1606,8 +2031,10 @@ evt_node_insert(struct evt_context *tcx, struct evt_node *nd, umem_off_t in_off,
 		const struct evt_entry_in *ent, bool *mbr_changed,
 		uint8_t **csum_bufp)
 {
-	int		 rc;
-	bool		 changed = 0;
+	struct evt_node_summary	*ns;
+	struct evt_node_summary	*child_ns;
+	int			 rc;
+	bool			 changed = 0;
 
 	V_TRACE(DB_TRACE, "Insert "DF_RECT" into "DF_MBR"\n",
 		DP_RECT(&ent->ei_rect), DP_MBR(nd));
@@ -1616,6 +2043,18 @@ evt_node_insert(struct evt_context *tcx, struct evt_node *nd, umem_off_t in_off,
 	if (rc != 0)
 		return rc;
 
+	ns = evt_node_summary(tcx, nd);
+	if (ns != NULL) {
+		if (evt_node_is_leaf(tcx, nd)) {
+			evt_summary_merge(ns, ent->ei_rect.rc_epc,
+					  bio_addr_is_hole(&ent->ei_addr));
+		} else {
+			child_ns = evt_node_summary(tcx, evt_off2node(tcx, in_off));
+			evt_summary_merge(ns, child_ns->ns_max_epc,
+					  child_ns->ns_flags & EVT_NS_HOLES);
+		}
+	}
+
 	V_TRACE(DB_TRACE, "New MBR is "DF_MBR", nr=%d\n", DP_MBR(nd),
 		nd->tn_nr);
 	if (mbr_changed)
@@ -1910,6 +2349,9 @@ evt_node_extend(struct evt_context *tcx, struct evt_trace *trace)
 
 	new_node = umem_off2ptr(evt_umm(tcx), new_off);
 	memcpy(new_node, nd_cur, old_size);
+	/* The summary sits right after the entries, move it to the new tail */
+	if (tcx->tc_feats & EVT_FEAT_NODE_SUMMARY)
+		*evt_node_summary(tcx, new_node) = *evt_node_summary_at(nd_cur, old_order, true);
 	rc = umem_free(evt_umm(tcx), trace->tr_node);
 	if (rc != 0)
 		goto failed;
@@ -2359,13 +2801,21 @@ run_tx:
 		 * overwrite for same epoch, full overwrite.
 		 * No copy for duplicate punch.
 		 */
-		if (entry->ei_inob > 0)
+		if (entry->ei_inob > 0) {
 			rc = evt_desc_copy(tcx, entry, csum_bufp);
+			/* The overwritten record may have been a hole */
+			if (rc == 0 && (tcx->tc_feats & EVT_FEAT_NODE_SUMMARY))
+				rc = evt_summary_trace_merge(tcx, entry->ei_rect.rc_epc,
+							     bio_addr_is_hole(&entry->ei_addr));
+		}
 		goto out;
 	}
 
 	/* Phase-2: Inserting */
 	rc = evt_insert_entry(tcx, entryp, csum_bufp);
+	if (rc == 0 && (tcx->tc_feats & EVT_FEAT_NODE_SUMMARY))
+		rc = evt_summary_trace_merge(tcx, entryp->ei_rect.rc_epc,
+					     bio_addr_is_hole(&entryp->ei_addr));
 
 	/* No need for evt_ent_array_fini as there will be no allocations
 	 * with 1 entry in the list
@@ -2573,6 +3023,53 @@ agg_check(const struct evt_extent *inserted, const struct evt_extent *intree)
 	return false;
 }
 
+/** A hole-only subtree which EVT_FIND_DATA only enters if it may hide data */
+struct evt_defer {
+	umem_off_t		df_off;
+	struct evt_extent	df_ex;
+	daos_epoch_t		df_max_epc;
+	int			df_level;
+};
+
+#define EVT_DEFER_MAX	16
+
+/** Returns true if no record of the subtree summarized by \a ns can match */
+static inline bool
+evt_summary_filtered(const struct evt_node_summary *ns, const struct evt_filter *filter,
+		     enum evt_find_opc find_opc)
+{
+	if (filter == NULL)
+		return false;
+
+	/* Every record would be filtered by its own epoch, see evt_filter_rect */
+	if (filter->fr_epr.epr_lo > ns->ns_max_epc)
+		return true;
+
+	/* Every record is covered by the higher level punch, so is invisible */
+	if (find_opc == EVT_FIND_DATA && ns->ns_max_epc < filter->fr_punch_epc &&
+	    ns->ns_max_epc <= filter->fr_epoch)
+		return true;
+
+	return false;
+}
+
+/** Returns true if a collected data record may be covered by the deferred subtree */
+static bool
+evt_defer_hides_data(struct evt_entry_array *ent_array, const struct evt_defer *df)
+{
+	struct evt_entry	*ent;
+
+	evt_ent_array_for_each(ent, ent_array) {
+		if (bio_addr_is_hole(&ent->en_addr) || ent->en_epoch > df->df_max_epc)
+			continue;
+		if (ent->en_sel_ext.ex_hi < df->df_ex.ex_lo ||
+		    ent->en_sel_ext.ex_lo > df->df_ex.ex_hi)
+			continue;
+		return true;
+	}
+	return false;
+}
+
 /**
  * See the description in evt_priv.h
  */
@@ -2584,7 +3081,11 @@ evt_ent_array_fill(struct evt_context *tcx, enum evt_find_opc find_opc,
 {
 	struct evt_data_loss_item	*edli;
 	d_list_t			 data_loss_list;
+	struct evt_defer		 defer[EVT_DEFER_MAX];
+	struct evt_defer		*df = NULL;
 	umem_off_t			 nd_off;
+	int				 defer_nr = 0;
+	int				 top = 0;
 	int				 level;
 	int				 at;
 	int				 i;
@@ -2609,7 +3110,9 @@ evt_ent_array_fill(struct evt_context *tcx, enum evt_find_opc find_opc,
 	nd_off = tcx->tc_root->tr_node;
 	while (1) {
 		struct evt_node		*node;
+		uint64_t		 mask[EVT_MASK_WORDS];
 		bool			 leaf;
+		bool			 masked = false;
 
 		node = evt_off2node(tcx, nd_off);
 		leaf = evt_node_is_leaf(tcx, node);
@@ -2619,6 +3122,16 @@ evt_ent_array_fill(struct evt_context *tcx, enum evt_find_opc find_opc,
 			"Checking mbr="DF_MBR"("DF_X64"), l=%d, a=%d, f=%d\n",
 			DP_MBR(node), nd_off, level, at, leaf);
 
+		/*
+		 * Filter out the leaf entries out of the searching range in batch. Overwrite
+		 * check needs to inspect all the filtered entries for aggregation.
+		 */
+		if (leaf && find_opc != EVT_FIND_OVERWRITE) {
+			evt_leaf_overlap(evt_node_entry_at(tcx, node, 0), node->tn_nr,
+					 &rect->rc_ex, mask);
+			masked = true;
+		}
+
 		for (i = at; i < node->tn_nr; i++) {
 			struct evt_entry	*ent;
 			struct evt_desc		*desc;
@@ -2626,6 +3139,9 @@ evt_ent_array_fill(struct evt_context *tcx, enum evt_find_opc find_opc,
 			int			 time_overlap;
 			int			 range_overlap;
 
+			if (masked && !(mask[i >> 6] & (1ULL << (i & 63))))
+				continue; /* skip, no overlap */
+
 			evt_node_rect_read_at(tcx, node, i, &rtmp);
 
 			if (evt_filter_rect(filter, &rtmp, leaf)) {
@@ -2675,6 +3191,31 @@ evt_ent_array_fill(struct evt_context *tcx, enum evt_find_opc find_opc,
 			}
 
 			if (!leaf) {
+				struct evt_node_summary	*ns;
+				umem_off_t		 child;
+
+				child = evt_node_child_at(tcx, node, i);
+				ns = evt_node_summary(tcx, evt_off2node(tcx, child));
+				if (ns != NULL && find_opc != EVT_FIND_OVERWRITE &&
+				    evt_summary_filtered(ns, filter, find_opc)) {
+					V_TRACE(DB_TRACE, "Pruned subtree "DF_RECT"\n",
+						DP_RECT(&rtmp));
+					continue;
+				}
+
+				/* Holes only matter if they cover data, decide
+				 * once everything else has been collected.
+				 */
+				if (ns != NULL && find_opc == EVT_FIND_DATA && top == 0 &&
+				    (ns->ns_flags & EVT_NS_HOLES) && defer_nr < EVT_DEFER_MAX) {
+					df = &defer[defer_nr++];
+					df->df_off     = child;
+					df->df_ex      = rtmp.rc_ex;
+					df->df_max_epc = ns->ns_max_epc;
+					df->df_level   = level + 1;
+					continue;
+				}
+
 				/* break the internal loop and enter the
 				 * child node.
 				 */
@@ -2748,6 +3289,7 @@ evt_ent_array_fill(struct evt_context *tcx, enum evt_find_opc find_opc,
 				if (rc < 0)
 					D_GOTO(out, rc);
 			case EVT_FIND_ALL:
+			case EVT_FIND_DATA:
 				if (rc == -DER_DATA_LOSS) {
 					if (evt_data_loss_add(&data_loss_list,
 							      &rtmp) == NULL)
@@ -2785,6 +3327,7 @@ replace_ent:
 				D_GOTO(out, rc = 0);
 
 			case EVT_FIND_ALL:
+			case EVT_FIND_DATA:
 				break;
 			}
 		}
@@ -2799,7 +3342,24 @@ replace_ent:
 		} else {
 			struct evt_trace *trace;
 
-			if (level == 0) { /* done with the root */
+			if (level == top) { /* done with the root or a deferred subtree */
+				df = NULL;
+				while (df == NULL && defer_nr > 0) {
+					df = &defer[--defer_nr];
+					if (d_list_empty(&data_loss_list) &&
+					    !evt_defer_hides_data(ent_array, df))
+						df = NULL; /* nothing to cover, skip it */
+				}
+
+				if (df != NULL) {
+					V_TRACE(DB_TRACE, "Enter deferred subtree, l=%d\n",
+						df->df_level);
+					nd_off = df->df_off;
+					level = top = df->df_level;
+					at = 0;
+					continue;
+				}
+
 				V_TRACE(DB_TRACE, "Found total %d rects\n",
 					ent_array ? ent_array->ea_ent_nr : 0);
 				return has_agg ? 1 : 0; /* succeed and return */
@@ -2838,12 +3398,10 @@ struct evt_max_rect {
 /**
  * Find all versioned extents intercepting with the input rectangle \a rect
  * and return their data pointers.
- *
- * Please check API comment in evtree.h for the details.
  */
-int
-evt_find(daos_handle_t toh, const struct evt_filter *filter,
-	 struct evt_entry_array *ent_array)
+static int
+evt_find_internal(daos_handle_t toh, enum evt_find_opc find_opc,
+		  const struct evt_filter *filter, struct evt_entry_array *ent_array)
 {
 	struct evt_context	*tcx;
 	struct evt_rect		 rect;
@@ -2860,7 +3418,7 @@ evt_find(daos_handle_t toh, const struct evt_filter *filter,
 	rect.rc_epc = filter->fr_epoch;
 	rect.rc_minor_epc = EVT_MINOR_EPC_MAX;
 
-	rc = evt_ent_array_fill(tcx, EVT_FIND_ALL, DAOS_INTENT_DEFAULT,
+	rc = evt_ent_array_fill(tcx, find_opc, DAOS_INTENT_DEFAULT,
 				filter, &rect, ent_array);
 
 	if (rc == 0)
@@ -2869,6 +3427,26 @@ evt_find(daos_handle_t toh, const struct evt_filter *filter,
 	return rc;
 }
 
+/** Please check API comment in evtree.h for the details. */
+int
+evt_find(daos_handle_t toh, const struct evt_filter *filter,
+	 struct evt_entry_array *ent_array)
+{
+	return evt_find_internal(toh, EVT_FIND_ALL, filter, ent_array);
+}
+
+/**
+ * Find visible data extents, punched and hole-only subtrees may be skipped.
+ *
+ * Please check API comment in evtree.h for the details.
+ */
+int
+evt_find_data(daos_handle_t toh, const struct evt_filter *filter,
+	      struct evt_entry_array *ent_array)
+{
+	return evt_find_internal(toh, EVT_FIND_DATA, filter, ent_array);
+}
+
 /** move the probing trace forward */
 bool
 evt_move_trace(struct evt_context *tcx)
@@ -3690,6 +4268,12 @@ evt_node_delete(struct evt_context *tcx)
 
 	changed_level = level;
 
+	if (tcx->tc_feats & EVT_FEAT_NODE_SUMMARY) {
+		rc = evt_summary_trace_reset(tcx, level);
+		if (rc != 0)
+			return rc;
+	}
+
 	/* Update MBR and bubble up */
 	while (1) {
 		struct evt_rect	rect;
@@ -759,6 +759,141 @@ ts_many_add(void)
 	D_FREE(seq);
 }
 
+
+static int
+ts_parse_perf_arg(char **argp, char key, int *val)
+{
+	char	*arg = *argp;
+	char	*tmp;
+
+	if (arg[0] != key || arg[1] != EVT_SEP_VAL) {
+		D_PRINT("Invalid parameter %s\n", arg);
+		return -DER_INVAL;
+	}
+	*val = strtol(&arg[2], &tmp, 0);
+	if (*val <= 0 || (*tmp != EVT_SEP && *tmp != '\0')) {
+		D_PRINT("Invalid parameter %s\n", arg);
+		return -DER_INVAL;
+	}
+	*argp = (*tmp == '\0') ? tmp : tmp + 1;
+	return 0;
+}
+
+/**
+ * Build a heavily overwritten array and time evt_find over it. Run with
+ * DAOS_EVT_SIMD=0 to compare against the scalar overlap filter.
+ */
+static void
+ts_perf(void)
+{
+	struct evt_entry_in	 entry = {0};
+	struct evt_filter	 filter = {0};
+	EVT_ENT_ARRAY_LG_PTR(ent_array);
+	bio_addr_t		 bio_addr = {0};
+	uint64_t		*seq;
+	uint64_t		 start;
+	uint64_t		 total;
+	uint64_t		 ents = 0;
+	uint64_t		 range;
+	char			*arg;
+	int			 layers;
+	int			 size;
+	int			 nr;
+	int			 finds;
+	int			 i;
+	int			 j;
+	int			 rc;
+
+	/* argument format: "o:LAYERS,e:NUM,n:NUM,f:NUM"
+	 * o: number of overwrite layers, each one at a new epoch
+	 * e: extent size
+	 * n: number of extents per layer
+	 * f: number of random finds to time
+	 */
+	arg = tst_fn_val.optval;
+	if (!arg) {
+		D_PRINT("need input parameters o:NUM,e:NUM,n:NUM,f:NUM\n");
+		fail();
+	}
+	if (ts_parse_perf_arg(&arg, 'o', &layers) ||
+	    ts_parse_perf_arg(&arg, 'e', &size) ||
+	    ts_parse_perf_arg(&arg, 'n', &nr) ||
+	    ts_parse_perf_arg(&arg, 'f', &finds))
+		fail();
+
+	range = (uint64_t)size * nr;
+	start = daos_getutime();
+	for (i = 0; i < layers; i++) {
+		seq = dts_rand_iarr_alloc_set(nr, 0, true);
+		if (!seq)
+			fail();
+
+		for (j = 0; j < nr; j++) {
+			/* Shift each layer by a random amount so extents
+			 * partially overlap the previous layers.
+			 */
+			entry.ei_rect.rc_ex.ex_lo = seq[j] * size + rand() % size;
+			entry.ei_rect.rc_ex.ex_hi = entry.ei_rect.rc_ex.ex_lo + size - 1;
+			entry.ei_rect.rc_epc = i + 1;
+			entry.ei_rect.rc_minor_epc = 0;
+
+			rc = bio_strdup(ts_utx, &bio_addr, "p");
+			if (rc != 0) {
+				D_FATAL("Insufficient memory for test\n");
+				fail();
+			}
+			entry.ei_bound = entry.ei_rect.rc_epc;
+			entry.ei_addr = bio_addr;
+			entry.ei_ver = 0;
+			entry.ei_inob = 1;
+
+			rc = evt_insert(ts_toh, &entry, NULL);
+			if (rc == 1)
+				rc = 0;
+			if (rc != 0) {
+				D_FATAL("Add rect %d failed "DF_RC"\n", j, DP_RC(rc));
+				fail();
+			}
+		}
+		D_FREE(seq);
+	}
+	D_PRINT("Inserted %d extents in %d layers: "DF_U64" us\n",
+		layers * nr, layers, daos_getutime() - start);
+
+	filter.fr_epr.epr_lo = 0;
+	filter.fr_epr.epr_hi = layers;
+	filter.fr_epoch = layers;
+	evt_ent_array_init(ent_array, 0);
+
+	start = daos_getutime();
+	for (i = 0; i < finds; i++) {
+		filter.fr_ex.ex_lo = rand() % range;
+		filter.fr_ex.ex_hi = filter.fr_ex.ex_lo + 4 * size - 1;
+		rc = evt_find(ts_toh, &filter, ent_array);
+		if (rc != 0) {
+			D_FATAL("Find failed "DF_RC"\n", DP_RC(rc));
+			fail();
+		}
+		ents += ent_array->ea_ent_nr;
+		evt_ent_array_fini(ent_array);
+		evt_ent_array_init(ent_array, 0);
+	}
+	total = daos_getutime() - start;
+	D_PRINT("%d window finds: %.2f us/find, "DF_U64" entries\n",
+		finds, (double)total / finds, ents);
+
+	filter.fr_ex.ex_lo = 0;
+	filter.fr_ex.ex_hi = range + size;
+	start = daos_getutime();
+	rc = evt_find(ts_toh, &filter, ent_array);
+	if (rc != 0) {
+		D_FATAL("Find failed "DF_RC"\n", DP_RC(rc));
+		fail();
+	}
+	D_PRINT("Full range find: "DF_U64" us, %d entries\n",
+		daos_getutime() - start, ent_array->ea_ent_nr);
+	evt_ent_array_fini(ent_array);
+}
 static void
 ts_tree_debug(void)
 {
@@ -1847,6 +1982,98 @@ test_evt_agg_check(void **state)
 	assert_rc_equal(rc, 0);
 }
 
+#define SUMMARY_NR_INSERTS	3000
+#define SUMMARY_NR_FINDS	500
+#define SUMMARY_RANGE		4096
+
+static void
+summary_data_collect(daos_handle_t toh, const struct evt_filter *filter, bool data_only,
+		     struct evt_entry *ents, int *nr)
+{
+	struct evt_entry	*ent;
+	EVT_ENT_ARRAY_LG_PTR(ent_array);
+	int			 rc;
+
+	evt_ent_array_init(ent_array, 0);
+	if (data_only)
+		rc = evt_find_data(toh, filter, ent_array);
+	else
+		rc = evt_find(toh, filter, ent_array);
+	assert_rc_equal(rc, 0);
+
+	*nr = 0;
+	evt_ent_array_for_each(ent, ent_array) {
+		if (bio_addr_is_hole(&ent->en_addr))
+			continue;
+		assert_true(*nr < SUMMARY_NR_INSERTS);
+		ents[(*nr)++] = *ent;
+	}
+	evt_ent_array_fini(ent_array);
+}
+
+/** Subtree pruning with node summaries must not change visible data */
+static void
+test_evt_summary_find(void **state)
+{
+	struct test_arg		*arg = *state;
+	struct evt_filter	 filter = {0};
+	struct evt_entry	*ents;
+	struct evt_entry	*ents_data;
+	static const char	*data = "0123456789abcdef0123456789abcdef";
+	daos_handle_t		 toh;
+	uint64_t		 offset;
+	uint64_t		 length;
+	int			 nr;
+	int			 nr_data;
+	int			 epoch;
+	int			 i;
+	int			 j;
+	int			 rc;
+
+	D_ALLOC_ARRAY(ents, SUMMARY_NR_INSERTS);
+	assert_non_null(ents);
+	D_ALLOC_ARRAY(ents_data, SUMMARY_NR_INSERTS);
+	assert_non_null(ents_data);
+
+	rc = evt_create(arg->ta_root, ts_feats | EVT_FEAT_NODE_SUMMARY, ORDER_DEF_INTERNAL,
+			arg->ta_uma, &ts_evt_desc_cbs, &toh);
+	assert_rc_equal(rc, 0);
+
+	/* Hole heavy array: mostly punched ranges with some data on top */
+	for (epoch = 1; epoch <= SUMMARY_NR_INSERTS; epoch++) {
+		offset = rand() % SUMMARY_RANGE;
+		length = (rand() % 32) + 1;
+		rc = insert_val(arg, toh, epoch, offset, (rand() % 4) ? NULL : data, length);
+		if (rc == 1)
+			rc = 0;
+		assert_rc_equal(rc, 0);
+	}
+
+	for (i = 0; i < SUMMARY_NR_FINDS; i++) {
+		filter.fr_ex.ex_lo = rand() % SUMMARY_RANGE;
+		filter.fr_ex.ex_hi = filter.fr_ex.ex_lo + (rand() % 256);
+		filter.fr_epoch = (rand() % SUMMARY_NR_INSERTS) + 1;
+		filter.fr_epr.epr_hi = filter.fr_epoch;
+		filter.fr_epr.epr_lo = (i % 3 == 0) ? rand() % filter.fr_epoch : 0;
+		filter.fr_punch_epc = (i % 4 == 0) ? rand() % filter.fr_epoch : 0;
+
+		summary_data_collect(toh, &filter, false, ents, &nr);
+		summary_data_collect(toh, &filter, true, ents_data, &nr_data);
+		assert_int_equal(nr, nr_data);
+		for (j = 0; j < nr; j++) {
+			assert_int_equal(ents[j].en_epoch, ents_data[j].en_epoch);
+			assert_int_equal(ents[j].en_sel_ext.ex_lo, ents_data[j].en_sel_ext.ex_lo);
+			assert_int_equal(ents[j].en_sel_ext.ex_hi, ents_data[j].en_sel_ext.ex_hi);
+			assert_int_equal(ents[j].en_addr.ba_off, ents_data[j].en_addr.ba_off);
+		}
+	}
+
+	rc = evt_destroy(toh);
+	assert_rc_equal(rc, 0);
+	D_FREE(ents);
+	D_FREE(ents_data);
+}
+
 static void
 test_evt_node_size_internal(void **state)
 {
@@ -2403,6 +2630,116 @@ test_dyn_root_yield(void **state)
 	assert_rc_equal(rc, 0);
 }
 
+#define OVERLAP_LOOPS	(EVT_ORDER_MAX * 32)
+#define OVERLAP_RANGE	(1ULL << 20)
+#define OVERLAP_LEN_MAX	((1ULL << 48) - 1)
+
+static uint64_t
+ts_rand64(void)
+{
+	return ((uint64_t)rand() << 40) ^ ((uint64_t)rand() << 20) ^ rand();
+}
+
+/**
+ * Generate an extent of OVERLAP_RANGE, either from offset 0 or ending at UINT64_MAX,
+ * with a few long ones to exercise the upper bits of the durable length.
+ */
+static void
+ts_rand_extent(bool top, uint64_t len_max, uint64_t *lo, uint64_t *hi)
+{
+	uint64_t	pos = rand() % OVERLAP_RANGE;
+	uint64_t	len;
+
+	if (rand() % 8 == 0)
+		len = ts_rand64() % OVERLAP_LEN_MAX + 1;
+	else
+		len = rand() % len_max + 1;
+
+	if (top) {
+		*hi = UINT64_MAX - pos;
+		*lo = *hi - len + 1;
+	} else {
+		*lo = pos;
+		*hi = pos + len - 1;
+	}
+}
+
+/** Vector overlap kernels must match the scalar one, including the tail entries */
+static void
+test_evt_leaf_overlap(void **state)
+{
+	static const char *const names[EVT_OVERLAP_MAX] = {"scalar", "avx2", "avx512"};
+	struct evt_node_entry	 ne[EVT_ORDER_MAX];
+	uint64_t		 expected[EVT_ORDER_MAX / 64];
+	uint64_t		 mask[EVT_ORDER_MAX / 64];
+	uint64_t		 lo, hi;
+	uint64_t		 ent_lo, ent_hi;
+	bool			 supported[EVT_OVERLAP_MAX];
+	bool			 top;
+	int			 kernel;
+	int			 loop;
+	int			 nr;
+	int			 i;
+	int			 rc;
+
+	for (kernel = 0; kernel < EVT_OVERLAP_MAX; kernel++) {
+		rc = evt_leaf_overlap_check(kernel, ne, 0, 0, 0, mask);
+		if (rc == -DER_NOSYS) {
+			print_message("%s kernel isn't supported, skipping it\n", names[kernel]);
+			supported[kernel] = false;
+			continue;
+		}
+		assert_rc_equal(rc, 0);
+		supported[kernel] = true;
+	}
+
+	srand(time(0));
+	for (loop = 0; loop < OVERLAP_LOOPS; loop++) {
+		/* Every leaf size, so all the tail lengths of the vector kernels are covered */
+		nr = loop % EVT_ORDER_MAX + 1;
+		top = (loop / EVT_ORDER_MAX) % 2;
+
+		memset(ne, 0, sizeof(ne));
+		for (i = 0; i < nr; i++) {
+			ts_rand_extent(top, 4096, &ent_lo, &ent_hi);
+			ne[i].ne_rect.rd_lo = ent_lo;
+			ne[i].ne_rect.rd_len_hi = (ent_hi - ent_lo + 1) >> 16;
+			ne[i].ne_rect.rd_len_lo = (ent_hi - ent_lo + 1) & 0xffff;
+			ne[i].ne_rect.rd_epc = rand();
+			ne[i].ne_rect.rd_minor_epc = rand();
+		}
+
+		if (loop % 16 == 0) {
+			lo = 0;
+			hi = UINT64_MAX;
+		} else {
+			ts_rand_extent(top, OVERLAP_RANGE, &lo, &hi);
+		}
+
+		memset(expected, 0, sizeof(expected));
+		for (i = 0; i < nr; i++) {
+			ent_lo = ne[i].ne_rect.rd_lo;
+			ent_hi = ent_lo + (((uint64_t)ne[i].ne_rect.rd_len_hi << 16) +
+					   ne[i].ne_rect.rd_len_lo) - 1;
+			if (ent_lo <= hi && ent_hi >= lo)
+				expected[i / 64] |= 1ULL << (i % 64);
+		}
+
+		for (kernel = 0; kernel < EVT_OVERLAP_MAX; kernel++) {
+			if (!supported[kernel])
+				continue;
+
+			rc = evt_leaf_overlap_check(kernel, ne, nr, lo, hi, mask);
+			assert_rc_equal(rc, 0);
+			if (memcmp(mask, expected, sizeof(mask)) != 0) {
+				print_message("%s kernel mismatch: nr=%d, lo=0x" DF_X64
+					      ", hi=0x" DF_X64 "\n", names[kernel], nr, lo, hi);
+				fail();
+			}
+		}
+	}
+}
+
 static int
 run_internal_tests(char *test_name)
 {
@@ -2427,6 +2764,8 @@ run_internal_tests(char *test_name)
 	    {"EVT020: evt_agg_check", test_evt_agg_check, setup_builtin, teardown_builtin},
 	    {"EVT021: dynamic root change during yield", test_dyn_root_yield, setup_builtin,
 	     teardown_builtin},
+	    {"EVT022: evt_summary_find", test_evt_summary_find, setup_builtin, teardown_builtin},
+	    {"EVT023: evt_leaf_overlap", test_evt_leaf_overlap, NULL, NULL},
 	    {NULL, NULL, NULL, NULL}};
 
 	return cmocka_run_group_tests_name(test_name, evt_builtin,
@@ -2448,6 +2787,7 @@ static struct option ts_ops[] = {
 	{ "debug",	required_argument,	NULL,	'b'	},
 	{ "test",	required_argument,	NULL,	't'	},
 	{ "sort",	required_argument,	NULL,	's'	},
+	{ "perf",	required_argument,	NULL,	'p'	},
 	{ NULL,		0,			NULL,	0	},
 };
 
@@ -2481,6 +2821,9 @@ ts_cmd_run(char opc, char *args)
 	case 'm':
 		ts_many_add();
 		break;
+	case 'p':
+		ts_perf();
+		break;
 	case 'e':
 		ts_drain();
 		break;
@@ -2506,6 +2849,8 @@ ts_cmd_run(char opc, char *args)
 			ts_feats = EVT_FEAT_SORT_SOFF;
 		else if (strcasecmp(args, "dist_even") == 0)
 			ts_feats = EVT_FEAT_SORT_DIST_EVEN;
+		else if (strcasecmp(args, "summary") == 0)
+			ts_feats |= EVT_FEAT_NODE_SUMMARY;
 		break;
 	default:
 		D_PRINT("Unsupported command %c\n", opc);
@@ -2523,7 +2868,7 @@ ts_group(void **state)
 	int	opc = 0;
 
 	while ((opc = getopt_long(test_group_argc, test_group_args,
-				  "C:a:m:e:f:g:d:b:Docl::ts:r:", ts_ops, NULL)) != -1) {
+				  "C:a:m:e:f:g:d:b:Docl::ts:r:p:", ts_ops, NULL)) != -1) {
 		ts_cmd_run(opc, optarg);
 	}
 }
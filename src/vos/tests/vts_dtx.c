@@ -861,6 +861,97 @@ dtx_18(void **state)
 	assert_memory_equal(update_buf, fetch_buf, UPDATE_BUF_SIZE);
 }
 
+/* DTX commit across two containers of the same pool in one local transaction */
+static void
+dtx_19(void **state)
+{
+	struct io_test_args		*args = *state;
+	struct dtx_handle		*dth = NULL;
+	struct dtx_id			 xid[2];
+	struct dtx_id			*dtis[2];
+	daos_handle_t			 cohs[2];
+	daos_iod_t			 iod[2];
+	d_sg_list_t			 sgl[2];
+	daos_recx_t			 rex[2];
+	daos_key_t			 dkey[2];
+	daos_key_t			 akey[2];
+	d_iov_t				 val_iov[2];
+	d_iov_t				 dkey_iov;
+	uuid_t				 co_uuid;
+	uint64_t			 epoch[2];
+	uint64_t			 dkey_hash;
+	char				 dkey_buf[2][UPDATE_DKEY_SIZE];
+	char				 akey_buf[2][UPDATE_AKEY_SIZE];
+	char				 update_buf[2][UPDATE_BUF_SIZE];
+	char				 fetch_buf[UPDATE_BUF_SIZE];
+	int				 counts[2] = { 1, 1 };
+	int				 rc;
+	int				 i;
+
+	uuid_generate(co_uuid);
+	rc = vos_cont_create(args->ctx.tc_po_hdl, co_uuid);
+	assert_rc_equal(rc, 0);
+	rc = vos_cont_open(args->ctx.tc_po_hdl, co_uuid, &cohs[1]);
+	assert_rc_equal(rc, 0);
+	cohs[0] = args->ctx.tc_co_hdl;
+
+	/* Assume I am the leader, prepare one update DTX per container. */
+	for (i = 0; i < 2; i++) {
+		vts_dtx_prep_update(args, &val_iov[i], &dkey_iov, &dkey[i], dkey_buf[i],
+				    &akey[i], akey_buf[i], &iod[i], &sgl[i], &rex[i],
+				    update_buf[i], UPDATE_BUF_SIZE, UPDATE_REC_SIZE,
+				    &dkey_hash, &epoch[i], false);
+
+		/* io_test_obj_update() works against the container of the test context */
+		args->ctx.tc_co_hdl = cohs[i];
+		vts_dtx_begin(&args->oid, cohs[i], epoch[i], dkey_hash, &dth);
+		rc = io_test_obj_update(args, epoch[i], 0, &dkey[i], &iod[i], &sgl[i], dth, true);
+		assert_rc_equal(rc, 0);
+		xid[i] = dth->dth_xid;
+		vts_dtx_end(dth);
+
+		dtis[i] = &xid[i];
+	}
+
+	/* Data records with update DTX are invisible before commit. */
+	for (i = 0; i < 2; i++) {
+		args->ctx.tc_co_hdl = cohs[i];
+		memset(fetch_buf, 0, UPDATE_BUF_SIZE);
+		d_iov_set(&val_iov[i], fetch_buf, UPDATE_BUF_SIZE);
+		iod[i].iod_size = DAOS_REC_ANY;
+		rc = io_test_obj_fetch(args, epoch[i], 0, &dkey[i], &iod[i], &sgl[i], true);
+		assert_rc_equal(rc, 0);
+		assert_memory_not_equal(update_buf[i], fetch_buf, UPDATE_BUF_SIZE);
+	}
+
+	rc = vos_dtx_commit_multi(cohs, dtis, counts, 2, false, NULL);
+	assert_rc_equal(rc, 2);
+
+	/* Both DTXs are committed and their data records are readable. */
+	for (i = 0; i < 2; i++) {
+		rc = vos_dtx_check(cohs[i], &xid[i], NULL, NULL, NULL, false);
+		assert_int_equal(rc, DTX_ST_COMMITTED);
+
+		args->ctx.tc_co_hdl = cohs[i];
+		memset(fetch_buf, 0, UPDATE_BUF_SIZE);
+		d_iov_set(&val_iov[i], fetch_buf, UPDATE_BUF_SIZE);
+		iod[i].iod_size = DAOS_REC_ANY;
+		rc = io_test_obj_fetch(args, epoch[i], 0, &dkey[i], &iod[i], &sgl[i], true);
+		assert_rc_equal(rc, 0);
+		assert_memory_equal(update_buf[i], fetch_buf, UPDATE_BUF_SIZE);
+	}
+
+	/* A DTX is only committed in its own container. */
+	rc = vos_dtx_check(cohs[1], &xid[0], NULL, NULL, NULL, false);
+	assert_rc_equal(rc, -DER_NONEXIST);
+
+	args->ctx.tc_co_hdl = cohs[0];
+	rc = vos_cont_close(cohs[1]);
+	assert_rc_equal(rc, 0);
+	rc = vos_cont_destroy(args->ctx.tc_po_hdl, co_uuid);
+	assert_rc_equal(rc, 0);
+}
+
 static int
 dtx_tst_teardown(void **state)
 {
@@ -895,6 +986,8 @@ static const struct CMUnitTest dtx_tests[] = {
 	  dtx_17, NULL, dtx_tst_teardown },
 	{ "VOS518: DTX aggregation",
 	  dtx_18, NULL, dtx_tst_teardown },
+	{ "VOS519: DTX commit across containers in one transaction",
+	  dtx_19, NULL, dtx_tst_teardown },
 };
 
 int
@@ -977,7 +977,7 @@ io_obj_cache_test(void **state)
 {
 	struct io_test_args	*arg = *state;
 	struct vos_test_ctx	*ctx = &arg->ctx;
-	struct daos_lru_cache	*occ = NULL;
+	struct vos_obj_cache	*occ = NULL;
 	struct vos_object	*objs[20];
 	struct umem_instance	*ummg;
 	struct umem_instance	*umml;
@@ -987,7 +987,7 @@ io_obj_cache_test(void **state)
 	char			*po_name;
 	uuid_t			 pool_uuid;
 	daos_handle_t		 l_poh, l_coh;
-	struct daos_lru_cache   *old_cache;
+	struct vos_obj_cache    *old_cache;
 	int			 i, rc;
 	struct vos_tls          *tls;
 
@@ -1123,6 +1123,76 @@ io_obj_cache_test(void **state)
 	free(po_name);
 }
 
+static void
+io_obj_cache_clock_test(void **state)
+{
+	struct io_test_args	*arg = *state;
+	struct vos_test_ctx	*ctx = &arg->ctx;
+	struct vos_container	*cont = vos_hdl2cont(ctx->tc_co_hdl);
+	struct umem_instance	*umm = vos_cont2umm(cont);
+	struct vos_obj_cache	*occ = NULL;
+	struct vos_obj_cache	*old_cache;
+	struct vos_object	*objs[32];
+	daos_unit_oid_t		 oids[32];
+	daos_epoch_range_t	 epr = {0, 1};
+	struct vos_tls		*tls;
+	uint32_t		 pool_max;
+	int			 i, rc;
+
+	/* 4 objects at most */
+	rc = vos_obj_cache_create(2, &occ);
+	assert_rc_equal(rc, 0);
+
+	tls             = vos_tls_get(true);
+	old_cache       = tls->vtl_ocache;
+	tls->vtl_ocache = occ;
+
+	/* Busy objects can't be evicted, the table has to grow */
+	for (i = 0; i < 32; i++) {
+		oids[i] = gen_oid(arg->otype);
+		rc = hold_obj(cont, oids[i], &epr, 0, VOS_OBJ_CREATE | VOS_OBJ_VISIBLE,
+			      DAOS_INTENT_UPDATE, &objs[i], 0, umm);
+		assert_rc_equal(rc, 0);
+	}
+	assert_int_equal(occ->voc_count, 32);
+	assert_true(occ->voc_mask + 1 >= 32 * 4 / 3);
+
+	/* Idle objects are trimmed back to the cache size */
+	for (i = 0; i < 32; i++)
+		vos_obj_release(objs[i], 0, false);
+	assert_true(occ->voc_count <= occ->voc_csize);
+
+	/* Every object is still reachable after the backward-shift deletions */
+	for (i = 0; i < 32; i++) {
+		rc = hold_obj(cont, oids[i], &epr, 0, VOS_OBJ_VISIBLE, DAOS_INTENT_DEFAULT,
+			      &objs[i], 0, NULL);
+		assert_rc_equal(rc, 0);
+		assert_int_equal(objs[i]->obj_id.id_pub.lo, oids[i].id_pub.lo);
+		vos_obj_release(objs[i], 0, false);
+	}
+
+	/* Per-pool limit */
+	vos_obj_cache_evict(cont);
+	pool_max = 2;
+	rc = vos_pool_ctl(ctx->tc_po_hdl, VOS_PO_CTL_SET_OBJ_CACHE, &pool_max);
+	assert_rc_equal(rc, 0);
+	for (i = 0; i < 8; i++) {
+		rc = hold_obj(cont, oids[i], &epr, 0, VOS_OBJ_VISIBLE, DAOS_INTENT_DEFAULT,
+			      &objs[i], 0, NULL);
+		assert_rc_equal(rc, 0);
+		vos_obj_release(objs[i], 0, false);
+		assert_true(cont->vc_pool->vp_ocache_cnt <= pool_max);
+	}
+	pool_max = 0;
+	rc = vos_pool_ctl(ctx->tc_po_hdl, VOS_PO_CTL_SET_OBJ_CACHE, &pool_max);
+	assert_rc_equal(rc, 0);
+
+	vos_obj_cache_evict(cont);
+	assert_int_equal(occ->voc_count, 0);
+	vos_obj_cache_destroy(occ);
+	tls->vtl_ocache = old_cache;
+}
+
 static void
 io_multiple_dkey_test(void **state, unsigned int flags)
 {
@@ -3085,6 +3155,7 @@ static const struct CMUnitTest io_tests[] = {
 static const struct CMUnitTest int_tests[] = {
     {"VOS201: VOS object IO index", io_oi_test, NULL, NULL},
     {"VOS202: VOS object cache test", io_obj_cache_test, NULL, NULL},
+    {"VOS202.1: VOS object cache CLOCK eviction test", io_obj_cache_clock_test, NULL, NULL},
     {"VOS300.1: Test key query punch with subsequent update", io_query_key_punch_update, NULL,
      NULL},
     {"VOS300.2: Key query test", io_query_key, NULL, NULL},
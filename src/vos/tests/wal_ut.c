@@ -871,6 +871,110 @@ wal_ut_holes(void **state)
 	ut_mc_fini(args);
 }
 
+struct ut_group_arg {
+	struct bio_ut_args	*ga_args;
+	struct umem_wal_tx	*ga_tx;
+	int			*ga_done;
+	int			 ga_rc;
+};
+
+static void
+ut_group_commit(void *arg)
+{
+	struct ut_group_arg	*ga = arg;
+
+	ga->ga_rc = bio_wal_reserve(ga->ga_args->bua_mc, &ga->ga_tx->utx_id, NULL);
+	if (ga->ga_rc == 0)
+		ga->ga_rc = bio_wal_commit(ga->ga_args->bua_mc, ga->ga_tx, NULL, NULL);
+	(*ga->ga_done)++;
+}
+
+/* Concurrent commits from many ULTs with group commit enabled */
+static void
+wal_ut_group(void **state)
+{
+	struct bio_ut_args	*args = *state;
+	uint64_t		 meta_sz = (128ULL << 20);	/* 128 MB */
+	unsigned int		 saved_group_us = bio_wal_group_us;
+	struct ut_tx_array	*txa;
+	struct ut_group_arg	*gas;
+	struct umem_wal_tx	*tx;
+	struct ut_fake_tx	*fake_tx;
+	ABT_thread		*thds;
+	ABT_xstream		 xs;
+	ABT_pool		 pool;
+	int			 i, tx_nr = 32, done = 0, rc;
+
+	rc = ut_mc_init(args, meta_sz, meta_sz, meta_sz);
+	assert_rc_equal(rc, 0);
+
+	txa = ut_txa_alloc(tx_nr);
+	assert_non_null(txa);
+	D_ALLOC_ARRAY(gas, tx_nr);
+	assert_non_null(gas);
+	D_ALLOC_ARRAY(thds, tx_nr);
+	assert_non_null(thds);
+
+	rc = ABT_xstream_self(&xs);
+	assert_int_equal(rc, ABT_SUCCESS);
+	rc = ABT_xstream_get_main_pools(xs, 1, &pool);
+	assert_int_equal(rc, ABT_SUCCESS);
+
+	/* Group commit is bypassed in self polling mode, poll from this ULT instead */
+	bio_wal_group_us = 1000;
+	args->bua_xs_ctxt->bxc_self_polling = 0;
+
+	for (i = 0; i < tx_nr; i++) {
+		tx = txa->ta_tx_ptrs[i];
+		ut_tx_add_action(tx, UMEM_ACT_COPY);
+		ut_tx_add_action(tx, UMEM_ACT_ASSIGN);
+		ut_tx_add_action(tx, UMEM_ACT_SET);
+
+		gas[i].ga_args = args;
+		gas[i].ga_tx = tx;
+		gas[i].ga_done = &done;
+		rc = ABT_thread_create(pool, ut_group_commit, &gas[i], ABT_THREAD_ATTR_NULL,
+				       &thds[i]);
+		assert_int_equal(rc, ABT_SUCCESS);
+	}
+
+	while (done < tx_nr) {
+		bio_nvme_poll(args->bua_xs_ctxt);
+		ABT_thread_yield();
+	}
+
+	args->bua_xs_ctxt->bxc_self_polling = 1;
+	bio_wal_group_us = saved_group_us;
+
+	for (i = 0; i < tx_nr; i++) {
+		ABT_thread_free(&thds[i]);
+		assert_rc_equal(gas[i].ga_rc, 0);
+	}
+
+	rc = bio_mc_close(args->bua_mc);
+	assert_rc_equal(rc, 0);
+
+	rc = bio_mc_open(args->bua_xs_ctxt, args->bua_pool_id, 0, &args->bua_mc);
+	assert_rc_equal(rc, 0);
+
+	/* All transactions are replayed in commit order */
+	txa->ta_replay_nr = txa->ta_tx_nr;
+	txa->ta_tx_idx = 0;
+
+	rc = bio_wal_replay(args->bua_mc, NULL, ut_replay_multi, txa);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(txa->ta_replayed_nr, txa->ta_replay_nr);
+
+	tx = txa->ta_tx_ptrs[txa->ta_tx_nr - 1];
+	fake_tx = (struct ut_fake_tx *)&tx->utx_private;
+	assert_int_equal(fake_tx->ft_act_nr, fake_tx->ft_act_idx);
+
+	D_FREE(thds);
+	D_FREE(gas);
+	ut_txa_free(txa);
+	ut_mc_fini(args);
+}
+
 static const struct CMUnitTest wal_uts[] = {
 	{ "single tx commit/replay", wal_ut_single, NULL, NULL},
 	{ "single tx with many acts", wal_ut_many_acts, NULL, NULL},
@@ -880,6 +984,7 @@ static const struct CMUnitTest wal_uts[] = {
 	{ "wal log wraps once", wal_ut_wrap, NULL, NULL},
 	{ "wal log wraps many", wal_ut_wrap_many, NULL, NULL},
 	{ "holes on replay", wal_ut_holes, NULL, NULL},
+	{ "group commit of concurrent txs", wal_ut_group, NULL, NULL},
 };
 
 static int
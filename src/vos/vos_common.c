@@ -536,7 +536,7 @@ vos_tls_init(int tags, int xs_id, int tgt_id)
 		return NULL;
 
 	D_INIT_LIST_HEAD(&tls->vtl_gc_pools);
-	rc = vos_obj_cache_create(LRU_CACHE_BITS, &tls->vtl_ocache);
+	rc = vos_obj_cache_create(vos_obj_cache_bits, &tls->vtl_ocache);
 	if (rc) {
 		D_ERROR("Error in creating object cache\n");
 		goto failed;
@@ -594,6 +594,8 @@ vos_tls_init(int tags, int xs_id, int tgt_id)
 		if (rc)
 			D_WARN("Failed to create vos obj cnt: "DF_RC"\n", DP_RC(rc));
 
+		vos_obj_cache_metrics_init(tls->vtl_ocache, tgt_id);
+
 	}
 
 	rc = d_tm_add_metric(&tls->vtl_lru_alloc_size, D_TM_GAUGE,
@@ -741,6 +743,18 @@ vos_mod_init(void)
 	}
 	D_INFO("Set DAOS VOS aggregation gap as %u (second)\n", vos_agg_gap);
 
+	d_getenv_uint("DAOS_VOS_OBJ_CACHE_BITS", &vos_obj_cache_bits);
+	if (vos_obj_cache_bits < VOS_OBJ_CACHE_BITS_MIN ||
+	    vos_obj_cache_bits > VOS_OBJ_CACHE_BITS_MAX) {
+		D_WARN("Invalid DAOS_VOS_OBJ_CACHE_BITS value, "
+		       "valid range [%u, %u], set it as default %u\n",
+		       VOS_OBJ_CACHE_BITS_MIN, VOS_OBJ_CACHE_BITS_MAX, LRU_CACHE_BITS);
+		vos_obj_cache_bits = LRU_CACHE_BITS;
+	}
+	d_getenv_uint("DAOS_VOS_OBJ_CACHE_POOL_MAX", &vos_obj_cache_pool_max);
+	D_INFO("Set VOS object cache size as 2^%u, per-pool limit %u\n", vos_obj_cache_bits,
+	       vos_obj_cache_pool_max);
+
 	return rc;
 }
 
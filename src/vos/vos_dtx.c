@@ -2557,6 +2557,96 @@ out:
 	return rc < 0 ? rc : tot_committed;
 }
 
+int
+vos_dtx_commit_multi(daos_handle_t cohs[], struct dtx_id *dtis[], int counts[], int nr,
+		     bool keep_act, bool *rm_cos[])
+{
+	struct vos_dtx_act_ent	**daes = NULL;
+	struct vos_dtx_cmt_ent	**dces = NULL;
+	struct vos_container	 *cont;
+	struct umem_instance	 *umm;
+	int			  tot_committed = 0, committed, total = 0;
+	int			  idx, rc = 0, i;
+
+	D_ASSERT(nr > 0);
+
+	cont = vos_hdl2cont(cohs[0]);
+	D_ASSERT(cont != NULL);
+
+	/*
+	 * The objects need to be pinned per container for evictable pool, that cannot be
+	 * shared by the containers, then commit them one by one.
+	 */
+	if (nr == 1 || vos_pool_is_evictable(vos_cont2pool(cont))) {
+		for (i = 0; i < nr; i++) {
+			if (counts[i] == 0)
+				continue;
+
+			committed = vos_dtx_commit(cohs[i], dtis[i], counts[i], keep_act,
+						   rm_cos != NULL ? rm_cos[i] : NULL);
+			if (committed >= 0)
+				tot_committed += committed;
+			else if (rc == 0)
+				rc = committed;
+		}
+
+		return rc < 0 ? rc : tot_committed;
+	}
+
+	for (i = 0; i < nr; i++)
+		total += counts[i];
+
+	D_ALLOC_ARRAY(daes, total);
+	if (daes == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	D_ALLOC_ARRAY(dces, total);
+	if (dces == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	/* All the containers share the same pool, then the same umem instance. */
+	umm = vos_cont2umm(cont);
+	rc = umem_tx_begin(umm, NULL);
+	if (rc != 0)
+		goto out;
+
+	for (i = 0, idx = 0; i < nr; idx += counts[i], i++) {
+		if (counts[i] == 0)
+			continue;
+
+		cont = vos_hdl2cont(cohs[i]);
+		D_ASSERT(vos_cont2umm(cont) == umm);
+
+		committed = vos_dtx_commit_internal(cont, dtis[i], counts[i], 0, keep_act,
+						    rm_cos != NULL ? rm_cos[i] : NULL,
+						    &daes[idx], &dces[idx]);
+		if (committed < 0) {
+			rc = committed;
+			break;
+		}
+		tot_committed += committed;
+	}
+
+	if (rc == 0) {
+		rc = umem_tx_commit(umm);
+		D_ASSERT(rc == 0);
+	} else {
+		rc = umem_tx_abort(umm, rc);
+	}
+
+	for (i = 0, idx = 0; i < nr; idx += counts[i], i++) {
+		if (counts[i] != 0)
+			vos_dtx_post_handle(vos_hdl2cont(cohs[i]), &daes[idx], &dces[idx],
+					    counts[i], false, rc != 0, keep_act);
+	}
+
+out:
+	D_FREE(daes);
+	D_FREE(dces);
+
+	return rc < 0 ? rc : tot_committed;
+}
+
 static int
 dtx_abort_pin(struct vos_container *cont, struct vos_dtx_act_ent *dae,
 	      struct umem_pin_handle **pin_hdl)
@@ -139,6 +139,10 @@ enum {
 	AGG_CREDS_MERGE_SLACK	= 2,
 };
 
+/* Range of the object cache size (power2 bits) */
+#define VOS_OBJ_CACHE_BITS_MIN	10
+#define VOS_OBJ_CACHE_BITS_MAX	24
+
 /* Throttle ENOSPACE error message */
 #define VOS_NOSPC_ERROR_INTVL	60	/* seconds */
 
@@ -149,6 +153,8 @@ extern uint32_t vos_agg_gap;
 #define VOS_AGG_GAP_MAX		180
 
 extern unsigned int vos_agg_nvme_thresh;
+extern unsigned int vos_obj_cache_bits;
+extern unsigned int vos_obj_cache_pool_max;
 extern bool vos_dkey_punch_propagate;
 extern bool vos_skip_old_partial_dtx;
 
@@ -221,6 +227,8 @@ struct vos_chkpt_metrics {
 	struct d_tm_node_t	*vcm_dirty_chunks;
 	struct d_tm_node_t	*vcm_iovs_copied;
 	struct d_tm_node_t	*vcm_wal_purged;
+	struct d_tm_node_t	*vcm_flush_rate;
+	struct d_tm_node_t	*vcm_lag;
 };
 
 void vos_chkpt_metrics_init(struct vos_chkpt_metrics *vc_metrics, const char *path, int tgt_id);
@@ -241,11 +249,14 @@ struct vos_wal_metrics {
 	struct d_tm_node_t *vwm_wal_qd;       /* WAL transaction queue depth */
 	struct d_tm_node_t *vwm_wal_waiters;  /* Waiters for WAL reclaiming */
 	struct d_tm_node_t *vwm_wal_dur;      /* WAL commit duration */
+	struct d_tm_node_t *vwm_wal_batch;    /* WAL group commit batch size */
+	struct d_tm_node_t *vwm_wal_batch_delay; /* WAL group commit queuing delay */
 	struct d_tm_node_t *vwm_replay_size;  /* WAL replay size in bytes */
 	struct d_tm_node_t *vwm_replay_time;  /* WAL replay time in us */
 	struct d_tm_node_t *vwm_replay_count; /* Total replay count */
 	struct d_tm_node_t *vwm_replay_tx;    /* Total replayed TX count */
 	struct d_tm_node_t *vwm_replay_ent;   /* Total replayed entry count */
+	struct d_tm_node_t *vwm_replay_tput;  /* WAL replay throughput in bytes/s */
 };
 
 void vos_wal_metrics_init(struct vos_wal_metrics *vw_metrics, const char *path, int tgt_id);
@@ -343,6 +354,10 @@ struct vos_pool {
 	uint32_t		 vp_data_thresh;
 	/** Space (in percentage) reserved for rebuild */
 	unsigned int		 vp_space_rb;
+	/** Number of objects of this pool in the object cache */
+	uint32_t		 vp_ocache_cnt;
+	/** Max number of cached objects for this pool, 0 means no limit */
+	uint32_t		 vp_ocache_max;
 	/* GC runtime for pool */
 	struct vos_gc_info	 vp_gc_info;
 };
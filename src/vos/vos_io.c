@@ -1070,7 +1070,7 @@ akey_fetch_recx(daos_handle_t toh, const daos_epoch_range_t *epr,
 		ioc->ic_akey_info.ii_prior_punch.pr_minor_epc;
 	evt_ent_array_init(ioc->ic_ent_array, 0);
 
-	rc = evt_find(toh, &filter, ioc->ic_ent_array);
+	rc = evt_find_data(toh, &filter, ioc->ic_ent_array);
 	if (rc != 0 || vos_dtx_hit_inprogress(standalone))
 		D_GOTO(failed, rc = (rc == 0 ? -DER_INPROGRESS : rc));
 
@@ -225,13 +225,14 @@ vos_iter_prepare(vos_iter_type_t type, vos_iter_param_t *param,
 	case VOS_ITER_AKEY:
 		rlevel = VOS_TS_READ_DKEY;
 		break;
+	case VOS_ITER_SINGLE:
 	case VOS_ITER_RECX:
 		rlevel = VOS_TS_READ_AKEY;
 		break;
 	default:
 		rlevel = 0;
 		/** There should not be any cases where a DTX is active outside
-		 *  of the four listed above.
+		 *  of the five listed above.
 		 */
 		D_ASSERT(!dtx_is_valid_handle(dth));
 		break;
@@ -100,7 +100,7 @@ struct vos_gc_bkt_df {
  */
 
 /** Current durable format version */
-#define POOL_DF_VERSION                         VOS_POOL_DF_2_8
+#define POOL_DF_VERSION                         VOS_POOL_DF_2_10
 
 /** 2.2 features.  Until we have an upgrade path for RDB, we need to support more than one old
  *  version.
@@ -116,6 +116,9 @@ struct vos_gc_bkt_df {
 /** 2.8 features */
 #define VOS_POOL_FEAT_2_8			(VOS_POOL_FEAT_GANG_SV)
 
+/** 2.10 features */
+#define VOS_POOL_FEAT_2_10			(VOS_POOL_FEAT_EVT_SUMMARY)
+
 /* VOS pool durable format extension */
 struct vos_pool_ext_df {
 	/* Extension for GC bucket */
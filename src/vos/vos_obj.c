@@ -702,7 +702,7 @@ vos_obj_delete_internal(daos_handle_t coh, daos_unit_oid_t oid, bool only_delete
 		return rc;
 	}
 
-	if (!daos_lru_is_last_user(&obj->obj_llink)) {
+	if (!vos_obj_is_last_user(obj)) {
 		rc = -DER_BUSY;
 		goto out;
 	}
@@ -1247,14 +1247,14 @@ static int singv_iter_fetch(struct vos_obj_iter *oiter,
  */
 static int
 singv_iter_prepare(struct vos_obj_iter *oiter, daos_key_t *dkey,
-		   daos_key_t *akey)
+		   daos_key_t *akey, struct vos_ts_set *ts_set)
 {
 	struct vos_krec_df      *krec = NULL;
 	daos_handle_t		 ak_toh;
 	daos_handle_t		 sv_toh;
 	int			 rc;
 
-	rc = key_ilog_prepare_dkey(oiter, dkey, &ak_toh, &krec, NULL);
+	rc = key_ilog_prepare_dkey(oiter, dkey, &ak_toh, &krec, ts_set);
 	if (rc != 0)
 		return rc;
 
@@ -1264,7 +1264,7 @@ singv_iter_prepare(struct vos_obj_iter *oiter, daos_key_t *dkey,
 	} else {
 		rc = key_ilog_prepare(oiter, ak_toh, VOS_BTR_AKEY, akey, 0, &sv_toh, NULL,
 				      &oiter->it_epr, &oiter->it_punched, &oiter->it_ilog_info,
-				      NULL);
+				      ts_set);
 		if (rc != 0)
 			D_GOTO(failed_1, rc);
 	}
@@ -1788,7 +1788,7 @@ vos_obj_iter_prep(vos_iter_type_t type, vos_iter_param_t *param,
 
 	case VOS_ITER_SINGLE:
 		rc = singv_iter_prepare(oiter, &param->ip_dkey,
-					&param->ip_akey);
+					&param->ip_akey, ts_set);
 		break;
 
 	case VOS_ITER_RECX:
@@ -17,7 +17,6 @@
 #define __VOS_OBJ_H__
 
 #include <daos/btree.h>
-#include <daos/lru.h>
 #include "vos_layout.h"
 #include "vos_ilog.h"
 #include "vos_ts.h"
@@ -26,13 +25,59 @@
 
 /* Internal container handle structure */
 struct vos_container;
+struct vos_object;
+
+/** Cache link of a VOS object */
+struct vos_obj_clink {
+	/** Hash value of the object key */
+	uint32_t			ocl_hash;
+	/** Refcount, the cache itself holds one while the object is cached */
+	uint32_t			ocl_ref;
+	/** The object has been evicted, it is freed on the last release */
+	uint32_t			ocl_evicted:1;
+};
+
+/** A bucket of the open-addressed object cache table */
+struct vos_obj_slot {
+	/** Cached object, NULL for an empty bucket */
+	struct vos_object		*os_obj;
+	/** Copy of the key hash, so probing doesn't touch the object */
+	uint32_t			 os_hash;
+	/** CLOCK reference bit, set on hit and cleared by the sweeping hand */
+	uint32_t			 os_ref_bit;
+};
+
+/**
+ * Per-xstream object cache.
+ *
+ * Objects are stored in an open-addressed (linear probing) table and evicted
+ * by a CLOCK (second-chance) policy, so a cache hit only sets the reference
+ * bit of the bucket instead of moving the object on a LRU list. The cache is
+ * only accessed by the owner xstream, no locking is required.
+ */
+struct vos_obj_cache {
+	/** Bucket array, power2 sized */
+	struct vos_obj_slot		*voc_slots;
+	/** Number of buckets - 1 */
+	uint32_t			 voc_mask;
+	/** Max number of cached objects */
+	uint32_t			 voc_csize;
+	/** Number of objects in the table, including the busy ones */
+	uint32_t			 voc_count;
+	/** CLOCK hand */
+	uint32_t			 voc_hand;
+	/** Cache hit/miss/eviction counters */
+	struct d_tm_node_t		*voc_hit;
+	struct d_tm_node_t		*voc_miss;
+	struct d_tm_node_t		*voc_evict;
+};
 
 /**
  * A cached object (DRAM data structure).
  */
 struct vos_object {
-	/** llink for daos lru cache */
-	struct daos_llink		obj_llink;
+	/** link for the object cache */
+	struct vos_obj_clink		obj_clink;
 	/** Cache of incarnation log */
 	struct vos_ilog_info		obj_ilog_info;
 	/** Key for searching, object ID within a container */
@@ -123,14 +168,30 @@ void vos_obj_evict(struct vos_object *obj);
 
 int vos_obj_evict_by_oid(struct vos_container *cont, daos_unit_oid_t oid);
 
+/** Return true if the caller is the last user of the cached object */
+static inline bool
+vos_obj_is_last_user(struct vos_object *obj)
+{
+	return obj->obj_clink.ocl_ref <= 2;
+}
+
 /**
  * Create an object cache.
  *
- * \param cache_size	[IN]	Cache size
+ * \param cache_size	[IN]	Cache size (power2 bits)
  * \param occ_p		[OUT]	Newly created cache.
  */
 int
-vos_obj_cache_create(int32_t cache_size, struct daos_lru_cache **occ_p);
+vos_obj_cache_create(int32_t cache_size, struct vos_obj_cache **occ_p);
+
+/**
+ * Register hit/miss/eviction telemetry of the object cache.
+ *
+ * \param occ		[IN]	Object cache
+ * \param tgt_id	[IN]	Target ID
+ */
+void
+vos_obj_cache_metrics_init(struct vos_obj_cache *occ, int tgt_id);
 
 /**
  * Destroy an object cache, and release all cached object references.
@@ -138,7 +199,7 @@ vos_obj_cache_create(int32_t cache_size, struct daos_lru_cache **occ_p);
  * \param occ	[IN]	Cache to be destroyed.
  */
 void
-vos_obj_cache_destroy(struct daos_lru_cache *occ);
+vos_obj_cache_destroy(struct vos_obj_cache *occ);
 
 /** evict cached objects for the specified container */
 void vos_obj_cache_evict(struct vos_container *cont);
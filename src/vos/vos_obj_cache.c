@@ -7,14 +7,17 @@
 /**
  * Object cache for VOS OI table.
  * Object index is in Persistent memory. This cache in DRAM
- * maintains an LRU which is accessible in the I/O path. The object
+ * maintains the objects which are accessible in the I/O path. The object
  * index API defined for PMEM are used here by the cache..
  *
- * LRU cache implementation:
- * Simple LRU based object cache for Object index table
- * Uses a hashtable and a doubly linked list to set and get
- * entries. The size of both hashtable and linked list are
- * fixed length.
+ * Cache implementation:
+ * Per-xstream CLOCK (second-chance) cache for Object index table.
+ * Objects are stored in a power2 sized open-addressed table with linear
+ * probing, the key hash is copied into the bucket so probing doesn't have
+ * to dereference the objects. A cache hit only sets the reference bit of
+ * the bucket, the CLOCK hand clears the bit and picks the first idle
+ * object without it as the eviction victim. Empty buckets are created by
+ * backward-shift deletion, so there are no tombstones.
  *
  * Author: Vishwanath Venkatesan <vishwanath.venkatesan@intel.com>
  */
@@ -27,9 +30,14 @@
 #include "vos_internal.h"
 #include <daos_errno.h>
 
+/** Power2 bits of the per-xstream object cache size */
+unsigned int	vos_obj_cache_bits = LRU_CACHE_BITS;
+/** Default max number of cached objects per pool, 0 means no limit */
+unsigned int	vos_obj_cache_pool_max;
+
 /**
- * Local type for VOS LRU key
- * VOS LRU key must consist of
+ * Local type for VOS object cache key
+ * VOS object cache key must consist of
  * Object ID and container UUID
  */
 struct obj_lru_key {
@@ -53,21 +61,14 @@ init_object(struct vos_object *obj, daos_unit_oid_t oid, struct vos_container *c
 }
 
 static int
-obj_lop_alloc(void *key, unsigned int ksize, void *args,
-	      struct daos_llink **llink_p)
+obj_alloc(struct obj_lru_key *lkey, struct vos_object **obj_p)
 {
 	struct vos_object	*obj;
-	struct obj_lru_key	*lkey;
-	struct vos_container	*cont;
+	struct vos_container	*cont = lkey->olk_cont;
 	struct vos_tls		*tls;
 	int			 rc;
 
-	cont = (struct vos_container *)args;
-	D_ASSERT(cont != NULL);
-
 	tls = vos_tls_get(cont->vc_pool->vp_sysdb);
-	lkey = (struct obj_lru_key *)key;
-	D_ASSERT(lkey != NULL);
 
 	D_DEBUG(DB_TRACE, "cont="DF_UUID", obj="DF_UOID"\n",
 		DP_UUID(cont->vc_id), DP_UOID(lkey->olk_oid));
@@ -96,7 +97,7 @@ obj_lop_alloc(void *key, unsigned int ksize, void *args,
 
 	init_object(obj, lkey->olk_oid, cont);
 	d_tm_inc_gauge(tls->vtl_obj_cnt, 1);
-	*llink_p = &obj->obj_llink;
+	*obj_p = obj;
 	return 0;
 
 free_alloting:
@@ -108,32 +109,17 @@ failed:
 	return rc;
 }
 
-static bool
-obj_lop_cmp_key(const void *key, unsigned int ksize, struct daos_llink *llink)
+static inline bool
+obj_cmp_key(struct obj_lru_key *lkey, struct vos_object *obj)
 {
-	struct vos_object	*obj;
-	struct obj_lru_key	*lkey = (struct obj_lru_key *)key;
-
-	D_ASSERT(ksize == sizeof(struct obj_lru_key));
-
-	obj = container_of(llink, struct vos_object, obj_llink);
 	return lkey->olk_cont == obj->obj_cont &&
 	       !memcmp(&lkey->olk_oid, &obj->obj_id, sizeof(obj->obj_id));
 }
 
-static uint32_t
-obj_lop_rec_hash(struct daos_llink *llink)
+static inline uint32_t
+obj_key_hash(struct obj_lru_key *lkey)
 {
-	struct obj_lru_key	 lkey;
-	struct vos_object	*obj;
-
-	obj = container_of(llink, struct vos_object, obj_llink);
-
-	/* Create the key for obj cache */
-	lkey.olk_cont = obj->obj_cont;
-	lkey.olk_oid  = obj->obj_id;
-
-	return d_hash_string_u32((const char *)&lkey, sizeof(lkey));
+	return d_hash_string_u32((const char *)lkey, sizeof(*lkey));
 }
 
 static inline void
@@ -147,14 +133,12 @@ clean_object(struct vos_object *obj)
 }
 
 static void
-obj_lop_free(struct daos_llink *llink)
+obj_free(struct vos_object *obj)
 {
-	struct vos_object	*obj;
 	struct vos_tls		*tls;
 
-	D_DEBUG(DB_TRACE, "lru free callback for vos_obj_cache\n");
+	D_DEBUG(DB_TRACE, "free callback for vos_obj_cache\n");
 
-	obj = container_of(llink, struct vos_object, obj_llink);
 	tls = vos_tls_get(obj->obj_cont->vc_pool->vp_sysdb);
 	d_tm_dec_gauge(tls->vtl_obj_cnt, 1);
 	clean_object(obj);
@@ -164,105 +148,370 @@ obj_lop_free(struct daos_llink *llink)
 	D_FREE(obj);
 }
 
+static int
+occ_slots_alloc(struct vos_obj_cache *occ, uint32_t nr)
+{
+	D_ASSERT(nr > 0 && (nr & (nr - 1)) == 0);
+	D_ALLOC_ARRAY(occ->voc_slots, nr);
+	if (occ->voc_slots == NULL)
+		return -DER_NOMEM;
+
+	occ->voc_mask = nr - 1;
+	occ->voc_hand = 0;
+	return 0;
+}
+
+static inline uint32_t
+occ_nslots(struct vos_obj_cache *occ)
+{
+	return occ->voc_mask + 1;
+}
+
+/** Find the bucket of @obj, it must be in the table */
+static uint32_t
+occ_slot_find(struct vos_obj_cache *occ, struct vos_object *obj)
+{
+	uint32_t	i = obj->obj_clink.ocl_hash & occ->voc_mask;
+
+	while (occ->voc_slots[i].os_obj != obj) {
+		D_ASSERT(occ->voc_slots[i].os_obj != NULL);
+		i = (i + 1) & occ->voc_mask;
+	}
+	return i;
+}
+
 static void
-obj_lop_print_key(void *key, unsigned int ksize)
+occ_slot_insert(struct vos_obj_cache *occ, struct vos_object *obj)
 {
-	struct obj_lru_key	*lkey = (struct obj_lru_key *)key;
-	struct vos_container	*cont = lkey->olk_cont;
+	uint32_t	i = obj->obj_clink.ocl_hash & occ->voc_mask;
 
-	D_DEBUG(DB_TRACE, "pool="DF_UUID" cont="DF_UUID", obj="DF_UOID"\n",
-		DP_UUID(cont->vc_pool->vp_id),
-		DP_UUID(cont->vc_id), DP_UOID(lkey->olk_oid));
+	while (occ->voc_slots[i].os_obj != NULL)
+		i = (i + 1) & occ->voc_mask;
+
+	occ->voc_slots[i].os_obj     = obj;
+	occ->voc_slots[i].os_hash    = obj->obj_clink.ocl_hash;
+	/* Newly inserted object gets a second chance */
+	occ->voc_slots[i].os_ref_bit = 1;
 }
 
-static struct daos_llink_ops obj_lru_ops = {
-	.lop_free_ref	= obj_lop_free,
-	.lop_alloc_ref	= obj_lop_alloc,
-	.lop_cmp_keys	= obj_lop_cmp_key,
-	.lop_rec_hash	= obj_lop_rec_hash,
-	.lop_print_key	= obj_lop_print_key,
-};
+/** Empty bucket @i with backward-shift deletion */
+static void
+occ_slot_delete(struct vos_obj_cache *occ, uint32_t i)
+{
+	struct vos_obj_slot	*slots = occ->voc_slots;
+	uint32_t		 j = i;
+	uint32_t		 home;
+
+	memset(&slots[i], 0, sizeof(slots[i]));
+	while (1) {
+		j = (j + 1) & occ->voc_mask;
+		if (slots[j].os_obj == NULL)
+			break;
+
+		home = slots[j].os_hash & occ->voc_mask;
+		/* Stay if the home bucket is cyclically within (i, j] */
+		if (i <= j ? (i < home && home <= j) : (i < home || home <= j))
+			continue;
+
+		slots[i] = slots[j];
+		memset(&slots[j], 0, sizeof(slots[j]));
+		i = j;
+	}
+}
+
+/** Remove the object in bucket @i from the cache and free it */
+static void
+occ_obj_delete(struct vos_obj_cache *occ, uint32_t i)
+{
+	struct vos_object	*obj = occ->voc_slots[i].os_obj;
+	struct vos_pool		*pool = obj->obj_cont->vc_pool;
+
+	D_ASSERT(obj->obj_clink.ocl_ref == 1);
+	D_ASSERT(occ->voc_count > 0);
+	D_ASSERT(pool->vp_ocache_cnt > 0);
+
+	occ_slot_delete(occ, i);
+	occ->voc_count--;
+	pool->vp_ocache_cnt--;
+	obj_free(obj);
+}
+
+/**
+ * Run the CLOCK hand to evict one idle object. If @pool isn't NULL, only the
+ * objects of that pool can be picked.
+ *
+ * \return	true if an object was evicted.
+ */
+static bool
+occ_clock_evict(struct vos_obj_cache *occ, struct vos_pool *pool)
+{
+	struct vos_obj_slot	*slot;
+	struct vos_object	*obj;
+	uint32_t		 steps;
+
+	/* Two rounds: the first one may only clear reference bits */
+	for (steps = 0; steps < 2 * occ_nslots(occ); steps++) {
+		slot = &occ->voc_slots[occ->voc_hand];
+		obj  = slot->os_obj;
+		if (obj == NULL || obj->obj_clink.ocl_ref > 1 ||
+		    (pool != NULL && obj->obj_cont->vc_pool != pool)) {
+			occ->voc_hand = (occ->voc_hand + 1) & occ->voc_mask;
+			continue;
+		}
+
+		if (slot->os_ref_bit && !obj->obj_clink.ocl_evicted) {
+			slot->os_ref_bit = 0;
+			occ->voc_hand = (occ->voc_hand + 1) & occ->voc_mask;
+			continue;
+		}
+
+		D_DEBUG(DB_TRACE, "Evict %p from object cache\n", obj);
+		d_tm_inc_counter(occ->voc_evict, 1);
+		/* The hand stays, deletion shifts the next object into this bucket */
+		occ_obj_delete(occ, occ->voc_hand);
+		return true;
+	}
+
+	return false;
+}
+
+/** Double the table, only happens if too many objects are busy */
+static int
+occ_grow(struct vos_obj_cache *occ)
+{
+	struct vos_obj_slot	*old = occ->voc_slots;
+	uint32_t		 nr = occ_nslots(occ);
+	uint32_t		 i;
+	int			 rc;
+
+	rc = occ_slots_alloc(occ, nr * 2);
+	if (rc) {
+		occ->voc_slots = old;
+		return rc;
+	}
+
+	D_DEBUG(DB_TRACE, "Grow object cache table from %u to %u buckets\n", nr, nr * 2);
+	for (i = 0; i < nr; i++) {
+		if (old[i].os_obj != NULL)
+			occ_slot_insert(occ, old[i].os_obj);
+	}
+	D_FREE(old);
+	return 0;
+}
+
+/** Make room for a new object of @pool */
+static int
+occ_reserve(struct vos_obj_cache *occ, struct vos_pool *pool)
+{
+	while (pool->vp_ocache_max != 0 && pool->vp_ocache_cnt >= pool->vp_ocache_max) {
+		if (!occ_clock_evict(occ, pool))
+			break;
+	}
+
+	while (occ->voc_count >= occ->voc_csize) {
+		if (!occ_clock_evict(occ, NULL))
+			break;
+	}
+
+	/* Keep load factor under 3/4, busy objects can't be evicted */
+	if ((occ->voc_count + 1) * 4 > occ_nslots(occ) * 3)
+		return occ_grow(occ);
+
+	return 0;
+}
 
 int
-vos_obj_cache_create(int32_t cache_size, struct daos_lru_cache **occ)
+vos_obj_cache_create(int32_t cache_size, struct vos_obj_cache **occ_p)
 {
-	int	rc;
+	struct vos_obj_cache	*occ;
+	int			 rc;
 
+	D_ASSERT(cache_size >= 0 && cache_size < 31);
 	D_DEBUG(DB_TRACE, "Creating an object cache %d\n", (1 << cache_size));
-	rc = daos_lru_cache_create(cache_size, D_HASH_FT_NOLOCK,
-				   &obj_lru_ops, occ);
-	if (rc)
-		D_ERROR("Error in creating lru cache: "DF_RC"\n", DP_RC(rc));
-	return rc;
+
+	D_ALLOC_PTR(occ);
+	if (occ == NULL)
+		return -DER_NOMEM;
+
+	occ->voc_csize = 1U << cache_size;
+	/* Twice as many buckets as cached objects to keep probe chains short */
+	rc = occ_slots_alloc(occ, occ->voc_csize * 2);
+	if (rc) {
+		D_ERROR("Error in creating object cache: "DF_RC"\n", DP_RC(rc));
+		D_FREE(occ);
+		return rc;
+	}
+
+	*occ_p = occ;
+	return 0;
 }
 
 void
-vos_obj_cache_destroy(struct daos_lru_cache *occ)
+vos_obj_cache_metrics_init(struct vos_obj_cache *occ, int tgt_id)
 {
-	D_ASSERT(occ != NULL);
-	daos_lru_cache_destroy(occ);
+	int	rc;
+
+	rc = d_tm_add_metric(&occ->voc_hit, D_TM_COUNTER, "Number of object cache hits", NULL,
+			     "mem/vos/obj_cache/hit/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create object cache hit counter: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&occ->voc_miss, D_TM_COUNTER, "Number of object cache misses",
+			     NULL, "mem/vos/obj_cache/miss/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create object cache miss counter: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&occ->voc_evict, D_TM_COUNTER,
+			     "Number of objects evicted by the object cache replacement", NULL,
+			     "mem/vos/obj_cache/evict/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create object cache evict counter: "DF_RC"\n", DP_RC(rc));
 }
 
-static bool
-obj_cache_evict_cond(struct daos_llink *llink, void *args)
+static void
+occ_evict(struct vos_obj_cache *occ, struct vos_container *cont)
 {
-	struct vos_container	*cont = (struct vos_container *)args;
 	struct vos_object	*obj;
+	uint32_t		 i = 0;
+	unsigned int		 count = 0;
+
+	while (i < occ_nslots(occ)) {
+		obj = occ->voc_slots[i].os_obj;
+		if (obj == NULL || (cont != NULL && obj->obj_cont != cont)) {
+			i++;
+			continue;
+		}
 
-	if (cont == NULL)
-		return true;
+		obj->obj_clink.ocl_evicted = 1;
+		if (obj->obj_clink.ocl_ref > 1) {
+			i++;
+			continue;
+		}
+		/* Check bucket @i again, deletion may shift another object into it */
+		occ_obj_delete(occ, i);
+		count++;
+	}
+	D_DEBUG(DB_TRACE, "Evicted %u items, total count %u of %u\n",
+		count, occ->voc_count, occ->voc_csize);
+}
+
+void
+vos_obj_cache_destroy(struct vos_obj_cache *occ)
+{
+	D_ASSERT(occ != NULL);
 
-	obj = container_of(llink, struct vos_object, obj_llink);
-	return obj->obj_cont == cont;
+	D_DEBUG(DB_TRACE, "Destroying object cache\n");
+	occ_evict(occ, NULL);
+	if (occ->voc_count != 0)
+		D_ERROR("%u objects are still held by users\n", occ->voc_count);
+	D_FREE(occ->voc_slots);
+	D_FREE(occ);
 }
 
 void
 vos_obj_cache_evict(struct vos_container *cont)
 {
-	struct daos_lru_cache	*occ;
+	struct vos_obj_cache	*occ;
 
 	occ = vos_obj_cache_get(cont->vc_pool->vp_sysdb);
 	D_ASSERT(occ != NULL);
 
-	daos_lru_cache_evict(occ, obj_cache_evict_cond, cont);
+	occ_evict(occ, cont);
 }
 
 static __thread struct vos_object	 obj_local = {0};
 
 static inline void
-obj_put(struct daos_lru_cache *occ, struct vos_object *obj, bool evict)
+obj_evict(struct vos_object *obj)
 {
+	obj->obj_clink.ocl_evicted = 1;
+}
+
+static inline void
+obj_put(struct vos_obj_cache *occ, struct vos_object *obj, bool evict)
+{
+	struct vos_obj_clink	*clink = &obj->obj_clink;
+
+	D_ASSERT(clink->ocl_ref > 1);
 	if (evict)
-		daos_lru_ref_evict(occ, &obj->obj_llink);
-	daos_lru_ref_release(occ, &obj->obj_llink);
+		obj_evict(obj);
+
+	clink->ocl_ref--;
+	if (clink->ocl_ref > 1)
+		return;
+
+	if (clink->ocl_evicted) {
+		occ_obj_delete(occ, occ_slot_find(occ, obj));
+		return;
+	}
+
+	/* The object becomes idle, trim the cache if it overflowed while objects were busy */
+	while (occ->voc_count > occ->voc_csize && occ_clock_evict(occ, NULL))
+		;
 }
 
 static int
-obj_get(struct daos_lru_cache *occ, struct vos_container *cont, daos_unit_oid_t oid,
+obj_get(struct vos_obj_cache *occ, struct vos_container *cont, daos_unit_oid_t oid,
 	bool create, struct vos_object **obj_p)
 {
+	struct vos_obj_slot	*slot;
 	struct vos_object	*obj;
-	struct daos_llink	*lret;
 	struct obj_lru_key	 lkey;
+	uint32_t		 hash;
+	uint32_t		 i;
 	int			 rc;
-	void			*create_flag;
 
 	if (cont->vc_pool->vp_dying)
 		D_GOTO(out, rc = -DER_SHUTDOWN);
 
-	create_flag = create ? cont : NULL;
 	lkey.olk_cont = cont;
 	lkey.olk_oid = oid;
-
-	rc = daos_lru_ref_hold(occ, &lkey, sizeof(lkey), create_flag, &lret);
-	if (rc == 0) {
-		obj = container_of(lret, struct vos_object, obj_llink);
+	hash = obj_key_hash(&lkey);
+
+	for (i = hash & occ->voc_mask; occ->voc_slots[i].os_obj != NULL;
+	     i = (i + 1) & occ->voc_mask) {
+		slot = &occ->voc_slots[i];
+		if (slot->os_hash != hash)
+			continue;
+
+		obj = slot->os_obj;
+		/* nobody should use an evicted object */
+		if (obj->obj_clink.ocl_evicted || !obj_cmp_key(&lkey, obj))
+			continue;
+
+		if (!slot->os_ref_bit)
+			slot->os_ref_bit = 1;
+		obj->obj_clink.ocl_ref++;
+		d_tm_inc_counter(occ->voc_hit, 1);
 		*obj_p = obj;
 		return 0;
 	}
+
+	d_tm_inc_counter(occ->voc_miss, 1);
+	if (!create)
+		D_GOTO(out, rc = -DER_NONEXIST);
+
+	rc = occ_reserve(occ, cont->vc_pool);
+	if (rc)
+		D_GOTO(out, rc);
+
+	rc = obj_alloc(&lkey, &obj);
+	if (rc)
+		D_GOTO(out, rc);
+
+	D_DEBUG(DB_TRACE, "Inserting %p item into object cache\n", obj);
+	obj->obj_clink.ocl_hash    = hash;
+	obj->obj_clink.ocl_evicted = 0;
+	obj->obj_clink.ocl_ref     = 2; /* 1 for cache, 1 for caller */
+	occ_slot_insert(occ, obj);
+	occ->voc_count++;
+	cont->vc_pool->vp_ocache_cnt++;
+
+	*obj_p = obj;
+	return 0;
 out:
 	if (rc == -DER_NONEXIST) {
-		D_ASSERT(create_flag == NULL);
+		D_ASSERT(!create);
 		D_DEBUG(DB_TRACE, DF_CONT": Object "DF_UOID" doesn't exist.\n",
 			DP_CONT(cont->vc_pool->vp_id, cont->vc_id), DP_UOID(oid));
 	} else if (rc) {
@@ -279,7 +528,7 @@ vos_obj_unpin(struct vos_object *obj)
 	struct vos_pool		*pool = vos_obj2pool(obj);
 	struct umem_store	*store = vos_pool2store(pool);
 
-	if (obj->obj_pin_hdl != NULL && daos_lru_is_last_user(&obj->obj_llink)) {
+	if (obj->obj_pin_hdl != NULL && vos_obj_is_last_user(obj)) {
 		umem_cache_unpin(store, obj->obj_pin_hdl);
 		obj->obj_pin_hdl = NULL;
 	}
@@ -394,7 +643,7 @@ vos_obj_pin(struct vos_object *obj)
 }
 
 static inline void
-obj_release(struct daos_lru_cache *occ, struct vos_object *obj, bool evict)
+obj_release(struct vos_obj_cache *occ, struct vos_object *obj, bool evict)
 {
 
 	D_ASSERT(obj != NULL);
@@ -412,7 +661,7 @@ obj_release(struct daos_lru_cache *occ, struct vos_object *obj, bool evict)
 void
 vos_obj_release(struct vos_object *obj, uint64_t flags, bool evict)
 {
-	struct daos_lru_cache	*occ;
+	struct vos_obj_cache	*occ;
 
 	D_ASSERT(obj != &obj_local);
 
@@ -427,9 +676,9 @@ vos_obj_release(struct vos_object *obj, uint64_t flags, bool evict)
 	obj_release(occ, obj, evict);
 }
 
-/** Move local object to the lru cache */
+/** Move local object to the object cache */
 static inline int
-cache_object(struct daos_lru_cache *occ, struct vos_object **objp)
+cache_object(struct vos_obj_cache *occ, struct vos_object **objp)
 {
 	struct vos_object	*obj_new;
 	int			 rc;
@@ -500,7 +749,7 @@ int
 vos_obj_check_discard(struct vos_container *cont, daos_unit_oid_t oid, uint64_t flags)
 {
 	struct vos_object	*obj;
-	struct daos_lru_cache	*occ;
+	struct vos_obj_cache	*occ;
 	int			 rc;
 
 	D_ASSERT(cont != NULL);
@@ -615,7 +864,7 @@ vos_obj_hold(struct vos_container *cont, daos_unit_oid_t oid, daos_epoch_range_t
 	     struct vos_ts_set *ts_set)
 {
 	struct vos_object	*obj;
-	struct daos_lru_cache	*occ;
+	struct vos_obj_cache	*occ;
 	int			 rc, tmprc;
 	bool			 create = false;
 
@@ -758,19 +1007,14 @@ fail_log:
 void
 vos_obj_evict(struct vos_object *obj)
 {
-	struct daos_lru_cache	*occ;
-
 	D_ASSERT(obj != &obj_local);
-	occ = vos_obj_cache_get(obj->obj_cont->vc_pool->vp_sysdb);
-	D_ASSERT(occ != NULL);
-
-	daos_lru_ref_evict(occ, &obj->obj_llink);
+	obj_evict(obj);
 }
 
 int
 vos_obj_evict_by_oid(struct vos_container *cont, daos_unit_oid_t oid)
 {
-	struct daos_lru_cache	*occ;
+	struct vos_obj_cache	*occ;
 	struct vos_object	*obj;
 	int			 rc;
 
@@ -930,7 +1174,7 @@ vos_obj_acquire(struct vos_container *cont, daos_unit_oid_t oid, bool pin,
 		struct vos_object **obj_p)
 {
 	struct vos_object	*obj;
-	struct daos_lru_cache	*occ;
+	struct vos_obj_cache	*occ;
 	int			 rc;
 
 	D_ASSERT(cont != NULL);
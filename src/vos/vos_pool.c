@@ -396,6 +396,17 @@ vos_wal_metrics_init(struct vos_wal_metrics *vw_metrics, const char *path, int t
 	if (rc)
 		D_WARN("Failed to create WAL commit duration telemetry: " DF_RC "\n", DP_RC(rc));
 
+	rc = d_tm_add_metric(&vw_metrics->vwm_wal_batch, D_TM_STATS_GAUGE, "WAL group commit size",
+			     "transactions", "%s/%s/wal_batch/tgt_%d", path, VOS_WAL_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create WAL batch telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&vw_metrics->vwm_wal_batch_delay, D_TM_STATS_GAUGE,
+			     "WAL group commit delay", "us", "%s/%s/wal_batch_delay/tgt_%d", path,
+			     VOS_WAL_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create WAL batch delay telemetry: "DF_RC"\n", DP_RC(rc));
+
 	/* Initialize metrics for WAL replay */
 	rc = d_tm_add_metric(&vw_metrics->vwm_replay_count, D_TM_COUNTER, "Number of WAL replays",
 			     NULL, "%s/%s/replay_count/tgt_%u", path, VOS_WAL_DIR, tgt_id);
@@ -424,6 +435,11 @@ vos_wal_metrics_init(struct vos_wal_metrics *vw_metrics, const char *path, int t
 			     "%s/%s/replay_entries/tgt_%u", path, VOS_WAL_DIR, tgt_id);
 	if (rc)
 		D_WARN("Failed to create 'replay_entries' telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&vw_metrics->vwm_replay_tput, D_TM_GAUGE, "WAL replay throughput",
+			     "bytes/s", "%s/%s/replay_throughput/tgt_%u", path, VOS_WAL_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'replay_throughput' telemetry: "DF_RC"\n", DP_RC(rc));
 }
 
 #define VOS_CACHE_DIR	"vos_cache"
@@ -557,6 +573,10 @@ vos_wal_commit(struct umem_store *store, struct umem_wal_tx *wal_tx, void *data_
 	} else if (vwm != NULL) {
 		d_tm_set_gauge(vwm->vwm_wal_sz, ws.ws_size);
 		d_tm_set_gauge(vwm->vwm_wal_qd, ws.ws_qd);
+		if (ws.ws_batch != 0) {
+			d_tm_set_gauge(vwm->vwm_wal_batch, ws.ws_batch);
+			d_tm_set_gauge(vwm->vwm_wal_batch_delay, ws.ws_batch_delay);
+		}
 	}
 
 	bio_wal_query(store->stor_priv, &wal_info);
@@ -594,6 +614,7 @@ vos_wal_replay(struct umem_store *store,
 		d_tm_set_gauge(vwm->vwm_replay_time, wrs.wrs_tm);
 		d_tm_inc_counter(vwm->vwm_replay_tx, wrs.wrs_tx_cnt);
 		d_tm_inc_counter(vwm->vwm_replay_ent, wrs.wrs_entries);
+		d_tm_set_gauge(vwm->vwm_replay_tput, wrs.wrs_tput);
 	}
 	return rc;
 }
@@ -658,6 +679,17 @@ vos_chkpt_metrics_init(struct vos_chkpt_metrics *vc_metrics, const char *path, i
 	if (rc)
 		D_WARN("failed to create checkpoint_wal_purged metric: "DF_RC"\n", DP_RC(rc));
 
+	rc = d_tm_add_metric(&vc_metrics->vcm_flush_rate, D_TM_STATS_GAUGE,
+			     "Pages flushed per second by the checkpoint", "pages/s",
+			     "%s/%s/flush_rate/tgt_%d", path, CHKPT_TELEMETRY_DIR, tgt_id);
+	if (rc)
+		D_WARN("failed to create checkpoint_flush_rate metric: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&vc_metrics->vcm_lag, D_TM_GAUGE,
+			     "WAL blocks not checkpointed yet", "4KiB",
+			     "%s/%s/lag/tgt_%d", path, CHKPT_TELEMETRY_DIR, tgt_id);
+	if (rc)
+		D_WARN("failed to create checkpoint_lag metric: "DF_RC"\n", DP_RC(rc));
 }
 
 void
@@ -719,16 +751,16 @@ vos_pool_needs_checkpoint(daos_handle_t poh)
 	return bio_nvme_configured(SMD_DEV_TYPE_META);
 }
 
-int
-vos_pool_checkpoint(daos_handle_t poh)
+static int
+pool_checkpoint(daos_handle_t poh, uint32_t nr_blks, uint32_t *nr_pages)
 {
 	struct vos_pool               *pool;
-	uint64_t                       tx_id;
+	uint64_t                       tx_id, upto_id;
 	struct umem_instance          *umm;
 	struct umem_store             *store;
 	struct bio_wal_info            wal_info;
 	int                            rc;
-	uint64_t                       purge_size = 0;
+	uint64_t                       purge_size = 0, start_us;
 	struct umem_cache_chkpt_stats  stats = { 0 };
 	struct vos_chkpt_metrics      *chkpt_metrics = NULL;
 
@@ -738,11 +770,15 @@ vos_pool_checkpoint(daos_handle_t poh)
 	umm   = vos_pool2umm(pool);
 	store = &umm->umm_pool->up_store;
 
+	if (nr_pages != NULL)
+		*nr_pages = 0;
+
 	if (pool->vp_metrics != NULL)
 		chkpt_metrics = &pool->vp_metrics->vp_chkpt_metrics;
 
 	if (chkpt_metrics != NULL)
 		d_tm_mark_duration_start(chkpt_metrics->vcm_duration, D_TM_CLOCK_REALTIME);
+	start_us = daos_getutime();
 
 	bio_wal_query(store->stor_priv, &wal_info);
 	tx_id = wal_info.wi_commit_id;
@@ -751,16 +787,24 @@ vos_pool_checkpoint(daos_handle_t poh)
 		return 0;
 	}
 
-	D_DEBUG(DB_MD, "Checkpoint started pool=" DF_UUID ", committed_id=" DF_X64 "\n",
-		DP_UUID(pool->vp_id), tx_id);
+	D_DEBUG(DB_MD, "Checkpoint started pool=" DF_UUID ", committed_id=" DF_X64 ", blks=%u\n",
+		DP_UUID(pool->vp_id), tx_id, nr_blks);
 
 	rc = bio_meta_clear_empty(store->stor_priv);
 	if (rc)
 		return rc;
 
-	rc = umem_cache_checkpoint(store, pool->vp_wait_cb, pool->vp_chkpt_arg, &tx_id, &stats);
+	if (nr_blks == 0) {
+		rc = umem_cache_checkpoint(store, pool->vp_wait_cb, pool->vp_chkpt_arg, &tx_id,
+					   &stats);
+	} else {
+		upto_id = bio_wal_ckp_target(store->stor_priv, nr_blks);
+		tx_id = wal_info.wi_ckp_id;
+		rc = umem_cache_checkpoint_upto(store, pool->vp_wait_cb, pool->vp_chkpt_arg,
+						upto_id, &tx_id, &stats);
+	}
 
-	if (rc == 0)
+	if (rc == 0 && tx_id != wal_info.wi_ckp_id)
 		rc = bio_wal_checkpoint(store->stor_priv, tx_id, &purge_size);
 
 	bio_wal_query(store->stor_priv, &wal_info);
@@ -773,18 +817,39 @@ vos_pool_checkpoint(daos_handle_t poh)
 		"Checkpoint finished pool=" DF_UUID ", committed_id=" DF_X64 ", rc=" DF_RC "\n",
 		DP_UUID(pool->vp_id), tx_id, DP_RC(rc));
 
+	if (nr_pages != NULL)
+		*nr_pages = stats.uccs_nr_pages;
+
 	if (chkpt_metrics != NULL) {
 		d_tm_mark_duration_end(chkpt_metrics->vcm_duration);
+		d_tm_set_gauge(chkpt_metrics->vcm_lag, wal_info.wi_used_blks);
 		if (!rc) {
 			d_tm_set_gauge(chkpt_metrics->vcm_dirty_pages, stats.uccs_nr_pages);
 			d_tm_set_gauge(chkpt_metrics->vcm_dirty_chunks, stats.uccs_nr_dchunks);
 			d_tm_set_gauge(chkpt_metrics->vcm_iovs_copied, stats.uccs_nr_iovs);
 			d_tm_set_gauge(chkpt_metrics->vcm_wal_purged, purge_size);
+			if (stats.uccs_nr_pages != 0)
+				d_tm_set_gauge(chkpt_metrics->vcm_flush_rate,
+					       stats.uccs_nr_pages * 1000000ULL /
+					       max(daos_getutime() - start_us, 1));
 		}
 	}
 	return rc;
 }
 
+int
+vos_pool_checkpoint(daos_handle_t poh)
+{
+	return pool_checkpoint(poh, 0, NULL);
+}
+
+int
+vos_pool_checkpoint_incr(daos_handle_t poh, uint32_t nr_blks, uint32_t *nr_pages)
+{
+	D_ASSERT(nr_blks > 0);
+	return pool_checkpoint(poh, nr_blks, nr_pages);
+}
+
 int
 vos_pool_settings_init(bool md_on_ssd)
 {
@@ -1673,6 +1738,8 @@ pool_open_post(struct umem_pool **p_ph, struct vos_pool_df *pool_df, unsigned in
 		pool->vp_feats |= VOS_POOL_FEAT_2_6;
 	if (pool_df->pd_version >= VOS_POOL_DF_2_8)
 		pool->vp_feats |= VOS_POOL_FEAT_2_8;
+	if (pool_df->pd_version >= VOS_POOL_DF_2_10)
+		pool->vp_feats |= VOS_POOL_FEAT_2_10;
 	pool->vp_pool_df = pool_df;
 
 	/* Initialize dummy data I/O context */
@@ -1718,6 +1785,8 @@ pool_open_post(struct umem_pool **p_ph, struct vos_pool_df *pool_df, unsigned in
 			pool->vp_data_thresh = DAOS_PROP_PO_DATA_THRESH_DEFAULT;
 	}
 
+	pool->vp_ocache_max = vos_obj_cache_pool_max;
+
 	rc = vos_dedup_init(pool);
 	if (rc)
 		goto out;
@@ -1909,6 +1978,8 @@ end:
 		pool->vp_feats |= VOS_POOL_FEAT_2_6;
 	if (version >= VOS_POOL_DF_2_8)
 		pool->vp_feats |= VOS_POOL_FEAT_2_8;
+	if (version >= VOS_POOL_DF_2_10)
+		pool->vp_feats |= VOS_POOL_FEAT_2_10;
 
 	return 0;
 }
@@ -2050,6 +2121,12 @@ vos_pool_ctl(daos_handle_t poh, enum vos_pool_opc opc, void *param)
 		}
 		pool->vp_space_rb = i;
 		break;
+	case VOS_PO_CTL_SET_OBJ_CACHE:
+		if (param == NULL)
+			return -DER_INVAL;
+
+		pool->vp_ocache_max = *((uint32_t *)param);
+		break;
 	}
 
 	return 0;
@@ -952,6 +952,8 @@ create:
 	if (flags & SUBTR_EVT) {
 		if (pool->vp_feats & VOS_POOL_FEAT_DYN_ROOT)
 			feats |= EVT_FEAT_DYNAMIC_ROOT;
+		if (pool->vp_feats & VOS_POOL_FEAT_EVT_SUMMARY)
+			feats |= EVT_FEAT_NODE_SUMMARY;
 		rc = evt_create(&krec->kr_evt, feats, VOS_EVT_ORDER, uma, &cbs, sub_toh);
 		if (rc != 0) {
 			D_ERROR("Failed to create evtree: "DF_RC"\n",
@@ -1107,7 +1107,8 @@ class DaosServer():
 
         cmd_env = get_base_env()
 
-        with tempfile.NamedTemporaryFile(prefix=f'dnt_pil4dfs_{cmd[0]}_{get_inc_id()}_',
+        with tempfile.NamedTemporaryFile(prefix=f'dnt_pil4dfs_{os.path.basename(cmd[0])}_'
+                                         f'{get_inc_id()}_',
                                          suffix='.log',
                                          dir=self.conf.tmp_dir,
                                          delete=False) as log_file:
@@ -2394,6 +2395,103 @@ class PosixTests():
         assert len(data5) == 0
         assert raw_data1 == data6
 
+    def test_readahead(self):
+        """Test the dfuse readahead.
+
+        Read a file sequentially and another one with a constant stride, both previously unknown
+        to dfuse, and check that reads are served from readahead.  Then overwrite part of the
+        sequential file from another handle and check that the stale readahead is not returned.
+        """
+        mib = 1024 * 1024
+        seq_data = bytes(random.choices(b'daos', k=8 * mib))  # nosec
+        strided_data = bytes(random.choices(b'daos', k=8 * mib))  # nosec
+
+        dfuse = DFuse(self.server, self.conf, caching=False, container=self.container)
+        dfuse.start(v_hint='readahead_0')
+
+        with open(join(dfuse.dir, 'seq'), 'wb') as fd:
+            fd.write(seq_data)
+        with open(join(dfuse.dir, 'strided'), 'wb') as fd:
+            fd.write(strided_data)
+
+        if dfuse.stop():
+            self.fatal_errors = True
+
+        dfuse = DFuse(self.server, self.conf, caching=True, container=self.container)
+        dfuse.start(v_hint='readahead_1')
+
+        def _ra_hits():
+            return dfuse.check_usage()['statistics'].get('readahead_hit', 0)
+
+        # Sequential reads, readahead is fetched ahead of the kernel.
+        seq_fd = os.open(join(dfuse.dir, 'seq'), os.O_RDONLY)
+        data = os.pread(seq_fd, 4 * mib, 0)
+        assert data == seq_data[:4 * mib]
+        hits = _ra_hits()
+        print(f'Readahead hits after sequential reads {hits}')
+        assert hits > 0
+
+        # Strided reads, kernel readahead is turned off so dfuse sees the reads as issued.
+        fd = os.open(join(dfuse.dir, 'strided'), os.O_RDONLY)
+        os.posix_fadvise(fd, 0, 0, os.POSIX_FADV_RANDOM)
+        for offset in range(0, 8 * mib, mib):
+            data = os.pread(fd, 64 * 1024, offset)
+            assert data == strided_data[offset:offset + 64 * 1024]
+        os.close(fd)
+        strided_hits = _ra_hits() - hits
+        print(f'Readahead hits after strided reads {strided_hits}')
+        assert strided_hits > 0
+
+        # Overwrite a range which has been read ahead, then drop it from the page cache so the
+        # next read goes to dfuse, which should return the new data.
+        new_data = bytes(random.choices(b'DAOS', k=mib))  # nosec
+        fd = os.open(join(dfuse.dir, 'seq'), os.O_WRONLY)
+        os.pwrite(fd, new_data, 5 * mib)
+        os.fsync(fd)
+        os.close(fd)
+        os.posix_fadvise(seq_fd, 0, 0, os.POSIX_FADV_DONTNEED)
+        data = os.pread(seq_fd, 4 * mib, 4 * mib)
+        assert data == seq_data[4 * mib:5 * mib] + new_data + seq_data[6 * mib:]
+        os.close(seq_fd)
+
+        if dfuse.stop():
+            self.fatal_errors = True
+
+    def test_write_coalesce(self):
+        """Test the coalescing of small writes.
+
+        Use O_DIRECT so that dfuse sees the writes as issued.  Make a small write, which is
+        buffered, then a 1MiB overwrite of the same range which is made directly, then a small
+        overwrite of the middle of that, and check that the file holds the writes in order.
+        """
+        mib = 1024 * 1024
+        self.container.set_attrs({'dfuse-write-coalesce': 'on'})
+
+        dfuse = DFuse(self.server, self.conf, caching=True, container=self.container)
+        dfuse.start(v_hint='write_coalesce')
+
+        file_name = join(dfuse.dir, 'file')
+        small_data = b'a' * 4096
+        large_data = b'b' * mib
+        mid_data = b'c' * 4096
+
+        fd = os.open(file_name, os.O_RDWR | os.O_CREAT | os.O_DIRECT)
+        os.pwrite(fd, small_data, 0)
+        os.pwrite(fd, large_data, 0)
+        os.pwrite(fd, mid_data, 8192)
+        os.fsync(fd)
+
+        data = os.pread(fd, mib, 0)
+        os.close(fd)
+        assert data == large_data[:8192] + mid_data + large_data[12288:]
+
+        stats = dfuse.check_usage()['statistics']
+        print(stats)
+        assert stats.get('write_coalesced', 0) > 0
+
+        if dfuse.stop():
+            self.fatal_errors = True
+
     def test_two_mounts(self):
         """Create two mounts, and check that a file created in one can be read from the other"""
         dfuse0 = DFuse(self.server,
@@ -4483,6 +4581,11 @@ class PosixTests():
         print(rc.stdout)
         assert rc.stdout == b'sh\n', rc
 
+    def test_pil4dfs_aio(self):
+        """Test POSIX AIO with pil4dfs and no fuse instance, so the requests must be intercepted"""
+        pil4dfs_aio = join(self.conf['PREFIX'], 'lib/daos/TESTING/tests/', 'pil4dfs_aio')
+        self.server.run_daos_client_cmd_pil4dfs([pil4dfs_aio, '.'], container=self.container)
+
     @needs_dfuse
     def test_pil4dfs(self):
         """Test interception library libpil4dfs.so"""